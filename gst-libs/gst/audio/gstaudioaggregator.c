@@ -29,6 +29,10 @@
  * aggregating their buffers for raw audio
  * @see_also: #GstAggregator
  *
+ * Subclasses that use #GstAudioAggregatorConvertPad for their sink pads
+ * can accept a different format, rate and channel layout on every pad.
+ * The input is converted to the output format in the streaming thread of
+ * the aggregator, right before it is mixed.
  */
 
 
@@ -51,6 +55,9 @@ struct _GstAudioAggregatorPadPrivate
                                    for comparison with collect.buffer
                                    to see if we need to update our
                                    cached values. */
+  gboolean converted;           /* buffer was converted to the output
+                                   format and is not the queued input
+                                   buffer itself */
   guint position, size;
 
   guint64 output_offset;        /* Sample offset in output segment relative to
@@ -136,6 +143,315 @@ gst_audio_aggregator_pad_flush_pad (GstAggregatorPad * aggpad,
 
 
 
+/************************************************
+ * GstAudioAggregatorConvertPad implementation  *
+ ************************************************/
+
+struct _GstAudioAggregatorConvertPadPrivate
+{
+  /* All members are protected by the pad object lock */
+
+  GstAudioConverter *converter;
+  GstStructure *converter_config;
+  gboolean converter_config_changed;
+
+  /* formats the converter was created for */
+  GstAudioInfo in_info;
+  GstAudioInfo out_info;
+
+  /* recycles the converted buffers, which are all about the same size */
+  GstBufferPool *pool;
+  gsize pool_size;
+};
+
+enum
+{
+  PROP_CONVERT_PAD_0,
+  PROP_CONVERT_PAD_CONVERTER_CONFIG,
+};
+
+G_DEFINE_TYPE (GstAudioAggregatorConvertPad, gst_audio_aggregator_convert_pad,
+    GST_TYPE_AUDIO_AGGREGATOR_PAD);
+
+static void
+gst_audio_aggregator_convert_pad_free_pool (GstAudioAggregatorConvertPad *
+    cpad)
+{
+  if (cpad->priv->pool) {
+    gst_buffer_pool_set_active (cpad->priv->pool, FALSE);
+    gst_object_unref (cpad->priv->pool);
+    cpad->priv->pool = NULL;
+  }
+  cpad->priv->pool_size = 0;
+}
+
+static void
+gst_audio_aggregator_convert_pad_free_converter (GstAudioAggregatorConvertPad
+    * cpad)
+{
+  if (cpad->priv->converter) {
+    gst_audio_converter_free (cpad->priv->converter);
+    cpad->priv->converter = NULL;
+  }
+}
+
+static gboolean
+gst_audio_aggregator_convert_pad_update_converter (GstAudioAggregatorConvertPad
+    * cpad, GstAudioInfo * in_info, GstAudioInfo * out_info)
+{
+  if (cpad->priv->converter && !cpad->priv->converter_config_changed
+      && gst_audio_info_is_equal (in_info, &cpad->priv->in_info)
+      && gst_audio_info_is_equal (out_info, &cpad->priv->out_info))
+    return TRUE;
+
+  gst_audio_aggregator_convert_pad_free_converter (cpad);
+
+  cpad->priv->converter =
+      gst_audio_converter_new (GST_AUDIO_CONVERTER_FLAG_NONE, in_info,
+      out_info, cpad->priv->converter_config ?
+      gst_structure_copy (cpad->priv->converter_config) : NULL);
+  cpad->priv->converter_config_changed = FALSE;
+
+  if (!cpad->priv->converter)
+    return FALSE;
+
+  cpad->priv->in_info = *in_info;
+  cpad->priv->out_info = *out_info;
+
+  return TRUE;
+}
+
+static GstBuffer *
+gst_audio_aggregator_convert_pad_acquire_buffer (GstAudioAggregatorConvertPad
+    * cpad, gsize size)
+{
+  GstBuffer *outbuf = NULL;
+
+  /* The resampler may not produce any output for tiny buffers */
+  if (size == 0)
+    return gst_buffer_new ();
+
+  if (!cpad->priv->pool || size > cpad->priv->pool_size) {
+    GstStructure *config;
+    gsize pool_size;
+
+    gst_audio_aggregator_convert_pad_free_pool (cpad);
+
+    /* Leave some room so that input buffers of slightly varying size, and
+     * the resampler producing a frame more or less, don't need a new pool */
+    pool_size = size + size / 8;
+
+    cpad->priv->pool = gst_buffer_pool_new ();
+    config = gst_buffer_pool_get_config (cpad->priv->pool);
+    gst_buffer_pool_config_set_params (config, NULL, pool_size, 0, 0);
+    if (!gst_buffer_pool_set_config (cpad->priv->pool, config)
+        || !gst_buffer_pool_set_active (cpad->priv->pool, TRUE)) {
+      gst_audio_aggregator_convert_pad_free_pool (cpad);
+      return gst_buffer_new_allocate (NULL, size, NULL);
+    }
+    cpad->priv->pool_size = pool_size;
+  }
+
+  if (gst_buffer_pool_acquire_buffer (cpad->priv->pool, &outbuf,
+          NULL) != GST_FLOW_OK)
+    return gst_buffer_new_allocate (NULL, size, NULL);
+
+  gst_buffer_resize (outbuf, 0, size);
+
+  return outbuf;
+}
+
+static void
+gst_audio_aggregator_convert_pad_get_planes (GstAudioInfo * info,
+    guint8 * data, gsize frames, gpointer * planes)
+{
+  gint i;
+
+  if (GST_AUDIO_INFO_LAYOUT (info) == GST_AUDIO_LAYOUT_NON_INTERLEAVED) {
+    for (i = 0; i < GST_AUDIO_INFO_CHANNELS (info); i++)
+      planes[i] = data + i * frames * GST_AUDIO_INFO_BPS (info);
+  } else {
+    planes[0] = data;
+  }
+}
+
+/* Called with the pad object lock held */
+static GstBuffer *
+gst_audio_aggregator_convert_pad_convert_buffer (GstAudioAggregatorPad * pad,
+    GstAudioInfo * in_info, GstAudioInfo * out_info, GstBuffer * buffer)
+{
+  GstAudioAggregatorConvertPad *cpad = GST_AUDIO_AGGREGATOR_CONVERT_PAD (pad);
+  gpointer in_planes[64], out_planes[64];
+  GstMapInfo inmap, outmap;
+  gsize in_frames, out_frames;
+  GstBuffer *outbuf;
+  gboolean ret;
+
+  if (!gst_audio_aggregator_convert_pad_update_converter (cpad, in_info,
+          out_info)) {
+    GST_ERROR_OBJECT (pad, "Can't create converter");
+    return NULL;
+  }
+
+  if (GST_BUFFER_IS_DISCONT (buffer)
+      || GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_RESYNC))
+    gst_audio_converter_reset (cpad->priv->converter);
+
+  in_frames = gst_buffer_get_size (buffer) / GST_AUDIO_INFO_BPF (in_info);
+  out_frames =
+      gst_audio_converter_get_out_frames (cpad->priv->converter, in_frames);
+
+  outbuf = gst_audio_aggregator_convert_pad_acquire_buffer (cpad,
+      out_frames * GST_AUDIO_INFO_BPF (out_info));
+  gst_buffer_copy_into (outbuf, buffer,
+      GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS, 0, -1);
+
+  /* The content of GAP buffers is never mixed, only their size matters */
+  if (GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_GAP))
+    return outbuf;
+
+  gst_buffer_map (buffer, &inmap, GST_MAP_READ);
+  gst_buffer_map (outbuf, &outmap, GST_MAP_WRITE);
+
+  gst_audio_aggregator_convert_pad_get_planes (in_info, inmap.data, in_frames,
+      in_planes);
+  gst_audio_aggregator_convert_pad_get_planes (out_info, outmap.data,
+      out_frames, out_planes);
+
+  ret = gst_audio_converter_samples (cpad->priv->converter,
+      GST_AUDIO_CONVERTER_FLAG_NONE, in_planes, in_frames, out_planes,
+      out_frames);
+
+  gst_buffer_unmap (outbuf, &outmap);
+  gst_buffer_unmap (buffer, &inmap);
+
+  if (!ret) {
+    GST_ERROR_OBJECT (pad, "Failed to convert %" G_GSIZE_FORMAT " frames",
+        in_frames);
+    gst_buffer_unref (outbuf);
+    return NULL;
+  }
+
+  GST_LOG_OBJECT (pad, "Converted %" G_GSIZE_FORMAT " frames to %"
+      G_GSIZE_FORMAT, in_frames, out_frames);
+
+  return outbuf;
+}
+
+static GstFlowReturn
+gst_audio_aggregator_convert_pad_flush (GstAggregatorPad * aggpad,
+    GstAggregator * aggregator)
+{
+  GstAudioAggregatorConvertPad *cpad =
+      GST_AUDIO_AGGREGATOR_CONVERT_PAD (aggpad);
+
+  GST_OBJECT_LOCK (aggpad);
+  if (cpad->priv->converter)
+    gst_audio_converter_reset (cpad->priv->converter);
+  GST_OBJECT_UNLOCK (aggpad);
+
+  return
+      GST_AGGREGATOR_PAD_CLASS
+      (gst_audio_aggregator_convert_pad_parent_class)->flush (aggpad,
+      aggregator);
+}
+
+static void
+gst_audio_aggregator_convert_pad_finalize (GObject * object)
+{
+  GstAudioAggregatorConvertPad *cpad = (GstAudioAggregatorConvertPad *) object;
+
+  gst_audio_aggregator_convert_pad_free_converter (cpad);
+  gst_audio_aggregator_convert_pad_free_pool (cpad);
+  if (cpad->priv->converter_config)
+    gst_structure_free (cpad->priv->converter_config);
+
+  G_OBJECT_CLASS (gst_audio_aggregator_convert_pad_parent_class)->finalize
+      (object);
+}
+
+static void
+gst_audio_aggregator_convert_pad_get_property (GObject * object,
+    guint prop_id, GValue * value, GParamSpec * pspec)
+{
+  GstAudioAggregatorConvertPad *cpad = GST_AUDIO_AGGREGATOR_CONVERT_PAD (object);
+
+  switch (prop_id) {
+    case PROP_CONVERT_PAD_CONVERTER_CONFIG:
+      GST_OBJECT_LOCK (cpad);
+      g_value_set_boxed (value, cpad->priv->converter_config);
+      GST_OBJECT_UNLOCK (cpad);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_audio_aggregator_convert_pad_set_property (GObject * object,
+    guint prop_id, const GValue * value, GParamSpec * pspec)
+{
+  GstAudioAggregatorConvertPad *cpad = GST_AUDIO_AGGREGATOR_CONVERT_PAD (object);
+
+  switch (prop_id) {
+    case PROP_CONVERT_PAD_CONVERTER_CONFIG:
+      GST_OBJECT_LOCK (cpad);
+      if (cpad->priv->converter_config)
+        gst_structure_free (cpad->priv->converter_config);
+      cpad->priv->converter_config = g_value_dup_boxed (value);
+      cpad->priv->converter_config_changed = TRUE;
+      GST_OBJECT_UNLOCK (cpad);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_audio_aggregator_convert_pad_class_init (GstAudioAggregatorConvertPadClass *
+    klass)
+{
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+  GstAggregatorPadClass *aggpadclass = (GstAggregatorPadClass *) klass;
+  GstAudioAggregatorPadClass *aaggpadclass =
+      (GstAudioAggregatorPadClass *) klass;
+
+  g_type_class_add_private (klass,
+      sizeof (GstAudioAggregatorConvertPadPrivate));
+
+  gobject_class->finalize = gst_audio_aggregator_convert_pad_finalize;
+  gobject_class->set_property = gst_audio_aggregator_convert_pad_set_property;
+  gobject_class->get_property = gst_audio_aggregator_convert_pad_get_property;
+
+  g_object_class_install_property (gobject_class,
+      PROP_CONVERT_PAD_CONVERTER_CONFIG,
+      g_param_spec_boxed ("converter-config", "Converter configuration",
+          "A GstStructure describing the configuration that should be used "
+          "when converting this pad's audio buffers",
+          GST_TYPE_STRUCTURE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  aggpadclass->flush =
+      GST_DEBUG_FUNCPTR (gst_audio_aggregator_convert_pad_flush);
+  aaggpadclass->convert_buffer =
+      GST_DEBUG_FUNCPTR (gst_audio_aggregator_convert_pad_convert_buffer);
+}
+
+static void
+gst_audio_aggregator_convert_pad_init (GstAudioAggregatorConvertPad * cpad)
+{
+  cpad->priv =
+      G_TYPE_INSTANCE_GET_PRIVATE (cpad, GST_TYPE_AUDIO_AGGREGATOR_CONVERT_PAD,
+      GstAudioAggregatorConvertPadPrivate);
+
+  cpad->priv->converter = NULL;
+  cpad->priv->converter_config = NULL;
+  cpad->priv->pool = NULL;
+  cpad->priv->pool_size = 0;
+}
+
+
 /**************************************
  * GstAudioAggregator implementation  *
  **************************************/
@@ -153,8 +469,18 @@ struct _GstAudioAggregatorPrivate
   GstClockTime discont_wait;
 
   /* Protected by srcpad stream clock */
-  /* Buffer starting at offset containing block_size frames */
+  /* Buffer starting at offset containing block_size frames, only created
+   * once something audible has to be mixed into it */
   GstBuffer *current_buffer;
+  /* Input data that is forwarded as current buffer if nothing else is
+   * mixed into it */
+  GstBuffer *passthrough_buffer;
+  /* Output buffer created without the object lock for the next time
+   * something audible has to be mixed, kept until then */
+  GstBuffer *mix_buffer;
+  /* Read-only silence of block_size frames that is output when nothing
+   * audible was mixed */
+  GstBuffer *silence_buffer;
 
   /* counters to keep track of timestamps */
   /* Readable with object lock, writable with both aag lock and object lock */
@@ -675,6 +1001,8 @@ gst_audio_aggregator_set_src_caps (GstAudioAggregator * aagg, GstCaps * caps)
 
     memcpy (&aagg->info, &info, sizeof (info));
     aagg->priv->send_caps = TRUE;
+    gst_buffer_replace (&aagg->priv->silence_buffer, NULL);
+    gst_buffer_replace (&aagg->priv->mix_buffer, NULL);
 
   }
 
@@ -701,6 +1029,9 @@ gst_audio_aggregator_reset (GstAudioAggregator * aagg)
   gst_audio_info_init (&aagg->info);
   gst_caps_replace (&aagg->current_caps, NULL);
   gst_buffer_replace (&aagg->priv->current_buffer, NULL);
+  gst_buffer_replace (&aagg->priv->passthrough_buffer, NULL);
+  gst_buffer_replace (&aagg->priv->silence_buffer, NULL);
+  gst_buffer_replace (&aagg->priv->mix_buffer, NULL);
   GST_OBJECT_UNLOCK (aagg);
   GST_AUDIO_AGGREGATOR_UNLOCK (aagg);
 }
@@ -735,6 +1066,7 @@ gst_audio_aggregator_flush (GstAggregator * agg)
   agg->segment.position = -1;
   aagg->priv->offset = -1;
   gst_buffer_replace (&aagg->priv->current_buffer, NULL);
+  gst_buffer_replace (&aagg->priv->passthrough_buffer, NULL);
   GST_OBJECT_UNLOCK (aagg);
   GST_AUDIO_AGGREGATOR_UNLOCK (aagg);
 
@@ -776,8 +1108,14 @@ gst_audio_aggregator_fill_buffer (GstAudioAggregator * aagg,
 
   g_assert (pad->priv->buffer == NULL);
 
-  rate = GST_AUDIO_INFO_RATE (&pad->info);
-  bpf = GST_AUDIO_INFO_BPF (&pad->info);
+  /* Converted buffers are in the output format already */
+  if (pad->priv->converted) {
+    rate = GST_AUDIO_INFO_RATE (&aagg->info);
+    bpf = GST_AUDIO_INFO_BPF (&aagg->info);
+  } else {
+    rate = GST_AUDIO_INFO_RATE (&pad->info);
+    bpf = GST_AUDIO_INFO_BPF (&pad->info);
+  }
 
   pad->priv->position = 0;
   pad->priv->size = gst_buffer_get_size (inbuf) / bpf;
@@ -964,16 +1302,73 @@ done:
   return TRUE;
 }
 
-/* Called with pad object lock held */
+/* Called with the object lock for both the element and pad held,
+ * as well as the aagg lock. Takes ownership of inbuf and returns the
+ * buffer to mix, or NULL if inbuf could not be converted.
+ */
+static GstBuffer *
+gst_audio_aggregator_convert_buffer (GstAudioAggregator * aagg,
+    GstAudioAggregatorPad * pad, GstBuffer * inbuf)
+{
+  GstAudioAggregatorPadClass *klass = GST_AUDIO_AGGREGATOR_PAD_GET_CLASS (pad);
+  GstBuffer *outbuf;
+
+  pad->priv->converted = FALSE;
+
+  if (!klass->convert_buffer || gst_audio_info_is_equal (&pad->info,
+          &aagg->info))
+    return inbuf;
+
+  outbuf = klass->convert_buffer (pad, &pad->info, &aagg->info, inbuf);
+  gst_buffer_unref (inbuf);
+
+  if (outbuf)
+    pad->priv->converted = TRUE;
+
+  return outbuf;
+}
 
+/* Returns the output buffer to mix into, taking the prepared mix buffer
+ * the first time something audible is mixed for the current offset.
+ *
+ * Called with the object lock for both the element and pad held,
+ * as well as the aagg lock
+ */
+static GstBuffer *
+gst_audio_aggregator_get_mix_buffer (GstAudioAggregator * aagg)
+{
+  if (aagg->priv->current_buffer)
+    return aagg->priv->current_buffer;
+
+  if (aagg->priv->passthrough_buffer) {
+    /* Mixing a pad at unity volume into silence is a plain copy */
+    aagg->priv->current_buffer =
+        gst_buffer_copy_deep (aagg->priv->passthrough_buffer);
+    gst_buffer_replace (&aagg->priv->passthrough_buffer, NULL);
+  } else {
+    g_assert (aagg->priv->mix_buffer);
+    aagg->priv->current_buffer = aagg->priv->mix_buffer;
+    aagg->priv->mix_buffer = NULL;
+    GST_BUFFER_FLAG_SET (aagg->priv->current_buffer, GST_BUFFER_FLAG_GAP);
+  }
+
+  return aagg->priv->current_buffer;
+}
+
+/* Called with the object lock for both the element and pad held,
+ * as well as the aagg lock
+ */
 static gboolean
 gst_audio_aggregator_mix_buffer (GstAudioAggregator * aagg,
-    GstAudioAggregatorPad * pad, GstBuffer * inbuf, GstBuffer * outbuf)
+    GstAudioAggregatorPad * pad, GstBuffer * inbuf)
 {
+  GstAudioAggregatorClass *klass = GST_AUDIO_AGGREGATOR_GET_CLASS (aagg);
   guint overlap;
   guint out_start;
   gboolean filled;
   guint blocksize;
+  gdouble volume;
+  GstBuffer *outbuf;
 
   blocksize = gst_util_uint64_scale (aagg->priv->output_buffer_duration,
       GST_AUDIO_INFO_RATE (&aagg->info), GST_SECOND);
@@ -999,11 +1394,28 @@ gst_audio_aggregator_mix_buffer (GstAudioAggregator * aagg,
     return FALSE;
   }
 
-  filled = GST_AUDIO_AGGREGATOR_GET_CLASS (aagg)->aggregate_one_buffer (aagg,
-      pad, inbuf, pad->priv->position, outbuf, out_start, overlap);
+  /* Without a way to tell, every pad is assumed to need mixing */
+  volume = klass->get_pad_volume ? klass->get_pad_volume (aagg, pad) : -1.0;
+
+  if (volume == 0.0) {
+    GST_LOG_OBJECT (pad, "skipping silent pad");
+  } else if (volume == 1.0 && out_start == 0 && overlap == blocksize
+      && !aagg->priv->current_buffer && !aagg->priv->passthrough_buffer) {
+    guint bpf = GST_AUDIO_INFO_BPF (&aagg->info);
 
-  if (filled)
-    GST_BUFFER_FLAG_UNSET (outbuf, GST_BUFFER_FLAG_GAP);
+    /* The only audible pad so far covers the whole output buffer, forward
+     * its data unless some other pad has to be mixed in too */
+    GST_LOG_OBJECT (pad, "passing through buffer");
+    aagg->priv->passthrough_buffer = gst_buffer_copy_region (inbuf,
+        GST_BUFFER_COPY_MEMORY, pad->priv->position * bpf, overlap * bpf);
+  } else {
+    outbuf = gst_audio_aggregator_get_mix_buffer (aagg);
+    filled = klass->aggregate_one_buffer (aagg, pad, inbuf,
+        pad->priv->position, outbuf, out_start, overlap);
+
+    if (filled)
+      GST_BUFFER_FLAG_UNSET (outbuf, GST_BUFFER_FLAG_GAP);
+  }
 
   pad->priv->position += overlap;
   pad->priv->output_offset += overlap;
@@ -1018,6 +1430,37 @@ gst_audio_aggregator_mix_buffer (GstAudioAggregator * aagg,
   return TRUE;
 }
 
+/* Returns a GAP buffer of silence that shares the read-only memory of
+ * all previous silent output buffers. Called with the aagg lock held */
+static GstBuffer *
+gst_audio_aggregator_get_silence_buffer (GstAudioAggregator * aagg,
+    guint num_frames)
+{
+  gsize size = num_frames * GST_AUDIO_INFO_BPF (&aagg->info);
+  GstBuffer *outbuf;
+
+  if (!aagg->priv->silence_buffer
+      || gst_buffer_get_size (aagg->priv->silence_buffer) != size) {
+    GstBuffer *silence = gst_buffer_new_allocate (NULL, size, NULL);
+    GstMapInfo map;
+
+    gst_buffer_map (silence, &map, GST_MAP_WRITE);
+    gst_audio_format_fill_silence (aagg->info.finfo, map.data, map.size);
+    gst_buffer_unmap (silence, &map);
+    GST_MINI_OBJECT_FLAG_SET (gst_buffer_peek_memory (silence, 0),
+        GST_MEMORY_FLAG_READONLY);
+
+    gst_buffer_replace (&aagg->priv->silence_buffer, NULL);
+    aagg->priv->silence_buffer = silence;
+  }
+
+  outbuf = gst_buffer_copy_region (aagg->priv->silence_buffer,
+      GST_BUFFER_COPY_MEMORY, 0, size);
+  GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_GAP);
+
+  return outbuf;
+}
+
 static GstBuffer *
 gst_audio_aggregator_create_output_buffer (GstAudioAggregator * aagg,
     guint num_frames)
@@ -1177,16 +1620,22 @@ gst_audio_aggregator_aggregate (GstAggregator * agg, gboolean timeout)
       agg->segment.start + gst_util_uint64_scale (next_offset, GST_SECOND,
       rate);
 
-  if (aagg->priv->current_buffer == NULL) {
+  /* The buffer to mix into is only used if something audible is mixed, but
+   * it has to be created before as create_output_buffer() is called without
+   * the object lock. An unused one is kept for the next offset */
+  if (aagg->priv->current_buffer == NULL && (aagg->priv->mix_buffer == NULL
+          || gst_buffer_get_size (aagg->priv->mix_buffer) != blocksize * bpf)) {
+    GstBuffer *mix_buffer;
+
+    gst_buffer_replace (&aagg->priv->mix_buffer, NULL);
     GST_OBJECT_UNLOCK (agg);
-    aagg->priv->current_buffer =
+    mix_buffer =
         GST_AUDIO_AGGREGATOR_GET_CLASS (aagg)->create_output_buffer (aagg,
         blocksize);
     /* Be careful, some things could have changed ? */
     GST_OBJECT_LOCK (agg);
-    GST_BUFFER_FLAG_SET (aagg->priv->current_buffer, GST_BUFFER_FLAG_GAP);
+    aagg->priv->mix_buffer = mix_buffer;
   }
-  outbuf = aagg->priv->current_buffer;
 
   GST_LOG_OBJECT (agg,
       "Starting to mix %u samples for offset %" G_GINT64_FORMAT
@@ -1222,10 +1671,20 @@ gst_audio_aggregator_aggregate (GstAggregator * agg, gboolean timeout)
       continue;
     }
 
-    g_assert (!pad->priv->buffer || pad->priv->buffer == inbuf);
+    g_assert (!pad->priv->buffer || pad->priv->converted
+        || pad->priv->buffer == inbuf);
 
     /* New buffer? */
     if (!pad->priv->buffer) {
+      inbuf = gst_audio_aggregator_convert_buffer (aagg, pad, inbuf);
+      if (!inbuf) {
+        GST_WARNING_OBJECT (pad, "Could not convert buffer, dropping");
+        dropped = TRUE;
+        GST_OBJECT_UNLOCK (pad);
+        gst_aggregator_pad_drop_buffer (aggpad);
+        continue;
+      }
+
       /* Takes ownership of buffer */
       if (!gst_audio_aggregator_fill_buffer (aagg, pad, inbuf)) {
         dropped = TRUE;
@@ -1275,8 +1734,8 @@ gst_audio_aggregator_aggregate (GstAggregator * agg, gboolean timeout)
         && pad->priv->output_offset <
         aagg->priv->offset + blocksize && pad->priv->buffer) {
       GST_LOG_OBJECT (aggpad, "Mixing buffer for current offset");
-      drop_buf = !gst_audio_aggregator_mix_buffer (aagg, pad, pad->priv->buffer,
-          outbuf);
+      drop_buf = !gst_audio_aggregator_mix_buffer (aagg, pad,
+          pad->priv->buffer);
       if (pad->priv->output_offset >= next_offset) {
         GST_LOG_OBJECT (pad,
             "Pad is at or after current offset: %" G_GUINT64_FORMAT " >= %"
@@ -1308,6 +1767,19 @@ gst_audio_aggregator_aggregate (GstAggregator * agg, gboolean timeout)
     return GST_FLOW_OK;
   }
 
+  if (aagg->priv->current_buffer == NULL) {
+    if (aagg->priv->passthrough_buffer) {
+      GST_LOG_OBJECT (aagg, "Only one pad was audible, forwarding its data");
+      aagg->priv->current_buffer = aagg->priv->passthrough_buffer;
+      aagg->priv->passthrough_buffer = NULL;
+    } else {
+      GST_LOG_OBJECT (aagg, "Nothing audible was mixed, outputting silence");
+      aagg->priv->current_buffer =
+          gst_audio_aggregator_get_silence_buffer (aagg, blocksize);
+    }
+  }
+  outbuf = aagg->priv->current_buffer;
+
   if (is_eos) {
     gint64 max_offset = 0;
 
@@ -1324,6 +1796,7 @@ gst_audio_aggregator_aggregate (GstAggregator * agg, gboolean timeout)
     /* This means EOS or nothing mixed in at all */
     if (aagg->priv->offset == max_offset) {
       gst_buffer_replace (&aagg->priv->current_buffer, NULL);
+      gst_buffer_replace (&aagg->priv->passthrough_buffer, NULL);
       GST_AUDIO_AGGREGATOR_UNLOCK (aagg);
       return GST_FLOW_EOS;
     }
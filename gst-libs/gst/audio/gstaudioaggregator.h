@@ -83,18 +83,79 @@ struct _GstAudioAggregatorPad
 
 /**
  * GstAudioAggregatorPadClass:
+ * @convert_buffer: Optional. Converts @buffer from @in_info, the format
+ *  of the pad, to @out_info, the output format of the aggregator. Called
+ *  from the aggregator's streaming thread for every new input buffer of
+ *  a pad whose format differs from the output format, with the object
+ *  lock of the aggregator and of the pad held. Returns a new buffer or
+ *  %NULL if the buffer could not be converted; @buffer is not unreffed.
  *
  */
 struct _GstAudioAggregatorPadClass
 {
   GstAggregatorPadClass   parent_class;
 
+  GstBuffer * (* convert_buffer) (GstAudioAggregatorPad * pad,
+      GstAudioInfo * in_info, GstAudioInfo * out_info, GstBuffer * buffer);
+
   /*< private >*/
-  gpointer      _gst_reserved[GST_PADDING];
+  gpointer      _gst_reserved[GST_PADDING - 1];
 };
 
 GType gst_audio_aggregator_pad_get_type           (void);
 
+/****************************************
+ * GstAudioAggregatorConvertPad API     *
+ ****************************************/
+
+#define GST_TYPE_AUDIO_AGGREGATOR_CONVERT_PAD            (gst_audio_aggregator_convert_pad_get_type())
+#define GST_AUDIO_AGGREGATOR_CONVERT_PAD(obj)            (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_AUDIO_AGGREGATOR_CONVERT_PAD, GstAudioAggregatorConvertPad))
+#define GST_AUDIO_AGGREGATOR_CONVERT_PAD_CLASS(klass)    (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_AUDIO_AGGREGATOR_CONVERT_PAD, GstAudioAggregatorConvertPadClass))
+#define GST_AUDIO_AGGREGATOR_CONVERT_PAD_GET_CLASS(obj)  (G_TYPE_INSTANCE_GET_CLASS ((obj),GST_TYPE_AUDIO_AGGREGATOR_CONVERT_PAD, GstAudioAggregatorConvertPadClass))
+#define GST_IS_AUDIO_AGGREGATOR_CONVERT_PAD(obj)         (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_AUDIO_AGGREGATOR_CONVERT_PAD))
+#define GST_IS_AUDIO_AGGREGATOR_CONVERT_PAD_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_AUDIO_AGGREGATOR_CONVERT_PAD))
+
+/****************************************
+ * GstAudioAggregatorConvertPad Structs *
+ ****************************************/
+
+typedef struct _GstAudioAggregatorConvertPad GstAudioAggregatorConvertPad;
+typedef struct _GstAudioAggregatorConvertPadClass GstAudioAggregatorConvertPadClass;
+typedef struct _GstAudioAggregatorConvertPadPrivate GstAudioAggregatorConvertPadPrivate;
+
+/**
+ * GstAudioAggregatorConvertPad:
+ * @parent: The parent #GstAudioAggregatorPad
+ *
+ * An implementation of the GstPad to use with #GstAudioAggregator that
+ * converts its input to the output format (sample format, rate and
+ * channel layout) of the aggregator before mixing, so the caps of the
+ * sink pads do not all have to be the same.
+ */
+struct _GstAudioAggregatorConvertPad
+{
+  GstAudioAggregatorPad             parent;
+
+  /*< private >*/
+  GstAudioAggregatorConvertPadPrivate * priv;
+
+  gpointer _gst_reserved[GST_PADDING];
+};
+
+/**
+ * GstAudioAggregatorConvertPadClass:
+ *
+ */
+struct _GstAudioAggregatorConvertPadClass
+{
+  GstAudioAggregatorPadClass   parent_class;
+
+  /*< private >*/
+  gpointer      _gst_reserved[GST_PADDING];
+};
+
+GType gst_audio_aggregator_convert_pad_get_type   (void);
+
 /**************************
  * GstAudioAggregator API *
  **************************/
@@ -134,10 +195,17 @@ struct _GstAudioAggregator
 /**
  * GstAudioAggregatorClass:
  * @create_output_buffer: Create a new output buffer contains num_frames frames.
+ *  Called without the object lock held. The buffer is only output once
+ *  something audible was mixed into it and kept for later otherwise.
  * @aggregate_one_buffer: Aggregates one input buffer to the output
  *  buffer.  The in_offset and out_offset are in "frames", which is
  *  the size of a sample times the number of channels. Returns TRUE if
  *  any non-silence was added to the buffer
+ * @get_pad_volume: Optional. Returns the volume the data of @pad is
+ *  mixed with: 0.0 if the pad is silent, 1.0 if mixing its data into
+ *  silence would leave it unchanged. Silent pads are skipped and if only
+ *  one pad at unity volume is audible, its data is output without mixing.
+ *  Called with the object lock of the pad held.
  */
 struct _GstAudioAggregatorClass {
   GstAggregatorClass   parent_class;
@@ -147,9 +215,11 @@ struct _GstAudioAggregatorClass {
   gboolean (* aggregate_one_buffer) (GstAudioAggregator * aagg,
       GstAudioAggregatorPad * pad, GstBuffer * inbuf, guint in_offset,
       GstBuffer * outbuf, guint out_offset, guint num_frames);
+  gdouble (* get_pad_volume) (GstAudioAggregator * aagg,
+      GstAudioAggregatorPad * pad);
 
   /*< private >*/
-  gpointer          _gst_reserved[GST_PADDING];
+  gpointer          _gst_reserved[GST_PADDING - 1];
 };
 
 /*************************
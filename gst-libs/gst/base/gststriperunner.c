@@ -0,0 +1,255 @@
+/* GStreamer stripe runner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+/**
+ * SECTION: gststriperunner
+ * @short_description: processes the rows of a frame in parallel stripes
+ *
+ * A #GstStripeRunner splits a number of rows (of a video frame, or any
+ * other kind of work items) into stripes of consecutive rows, and processes
+ * the stripes concurrently. The first stripe is processed by the calling
+ * thread, the others by worker threads which are created on demand and kept
+ * around for the next run. gst_stripe_runner_run() returns once all stripes
+ * are done.
+ *
+ * The rows are split into as many stripes as threads are requested, but
+ * stripes never get smaller than a minimum number of rows, below which the
+ * synchronization would cost more than it saves. Since the split only
+ * depends on the parameters of the run, callers can use
+ * gst_stripe_runner_get_n_stripes() to allocate per-stripe results up front.
+ *
+ * A runner can only do one run at a time.
+ *
+ * Since: 1.12
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "gststriperunner.h"
+
+GST_DEBUG_CATEGORY_STATIC (stripe_runner_debug);
+#define GST_CAT_DEFAULT stripe_runner_debug
+
+struct _GstStripeRunner
+{
+  /* Workers processing all but the first stripe, created on demand */
+  GThreadPool *pool;
+
+  /* Number of stripes still being processed by the workers */
+  guint pending;
+  GMutex lock;
+  GCond cond;
+
+  /* Parameters of the current run */
+  GstStripeRunnerFunc func;
+  gpointer user_data;
+  guint n_rows;
+  guint stripe_rows;
+};
+
+static guint
+gst_stripe_runner_get_stripe_rows (guint n_threads, guint n_rows,
+    guint min_rows, guint align)
+{
+  guint stripe_rows;
+
+  if (n_threads == 0)
+    n_threads = g_get_num_processors ();
+  align = MAX (align, 1);
+
+  stripe_rows = (n_rows + n_threads - 1) / n_threads;
+  stripe_rows = (stripe_rows + align - 1) / align * align;
+  stripe_rows = MAX (stripe_rows, min_rows);
+
+  return MAX (stripe_rows, 1);
+}
+
+static void
+gst_stripe_runner_process_stripe (GstStripeRunner * runner, guint stripe)
+{
+  guint start = stripe * runner->stripe_rows;
+  guint end = MIN (start + runner->stripe_rows, runner->n_rows);
+
+  runner->func (stripe, start, end, runner->user_data);
+}
+
+static void
+gst_stripe_runner_worker_func (gpointer data, GstStripeRunner * runner)
+{
+  /* The stripe index is offset by one, as NULL can't be pushed */
+  gst_stripe_runner_process_stripe (runner, GPOINTER_TO_UINT (data) - 1);
+
+  g_mutex_lock (&runner->lock);
+  if (--runner->pending == 0)
+    g_cond_signal (&runner->cond);
+  g_mutex_unlock (&runner->lock);
+}
+
+/**
+ * gst_stripe_runner_new:
+ *
+ * Creates a new #GstStripeRunner. No threads are created until a run
+ * needs them.
+ *
+ * Returns: (transfer full): a new #GstStripeRunner. Free with
+ *     gst_stripe_runner_free().
+ *
+ * Since: 1.12
+ */
+GstStripeRunner *
+gst_stripe_runner_new (void)
+{
+  static volatile gsize _init = 0;
+  GstStripeRunner *runner;
+
+  if (g_once_init_enter (&_init)) {
+    GST_DEBUG_CATEGORY_INIT (stripe_runner_debug, "striperunner", 0,
+        "stripe runner");
+    g_once_init_leave (&_init, 1);
+  }
+
+  runner = g_slice_new0 (GstStripeRunner);
+  g_mutex_init (&runner->lock);
+  g_cond_init (&runner->cond);
+
+  return runner;
+}
+
+/**
+ * gst_stripe_runner_free:
+ * @runner: a #GstStripeRunner
+ *
+ * Frees @runner and stops its worker threads. Must not be called while a
+ * run is in progress.
+ *
+ * Since: 1.12
+ */
+void
+gst_stripe_runner_free (GstStripeRunner * runner)
+{
+  g_return_if_fail (runner != NULL);
+
+  if (runner->pool)
+    g_thread_pool_free (runner->pool, FALSE, TRUE);
+  g_mutex_clear (&runner->lock);
+  g_cond_clear (&runner->cond);
+
+  g_slice_free (GstStripeRunner, runner);
+}
+
+/**
+ * gst_stripe_runner_get_n_stripes:
+ * @n_threads: the maximum number of threads, 0 for one per processor
+ * @n_rows: the number of rows
+ * @min_rows: the minimum number of rows per stripe
+ * @align: the number of rows of a stripe (except for the last one) is a
+ *     multiple of this
+ *
+ * Gets the number of stripes gst_stripe_runner_run() splits @n_rows rows
+ * into, given the same parameters.
+ *
+ * Returns: the number of stripes
+ *
+ * Since: 1.12
+ */
+guint
+gst_stripe_runner_get_n_stripes (guint n_threads, guint n_rows,
+    guint min_rows, guint align)
+{
+  guint stripe_rows;
+
+  stripe_rows = gst_stripe_runner_get_stripe_rows (n_threads, n_rows,
+      min_rows, align);
+
+  return (n_rows + stripe_rows - 1) / stripe_rows;
+}
+
+/**
+ * gst_stripe_runner_run:
+ * @runner: a #GstStripeRunner
+ * @n_threads: the maximum number of threads, 0 for one per processor
+ * @n_rows: the number of rows
+ * @min_rows: the minimum number of rows per stripe, should be a multiple
+ *     of @align
+ * @align: the number of rows of a stripe (except for the last one) is a
+ *     multiple of this
+ * @func: (scope call): the function processing one stripe
+ * @user_data: user data passed to @func
+ *
+ * Splits @n_rows rows into stripes, and calls @func for every stripe. The
+ * stripes are processed concurrently, on up to @n_threads threads including
+ * the calling one. Returns once all stripes are done.
+ *
+ * Returns: the number of stripes that were processed
+ *
+ * Since: 1.12
+ */
+guint
+gst_stripe_runner_run (GstStripeRunner * runner, guint n_threads,
+    guint n_rows, guint min_rows, guint align, GstStripeRunnerFunc func,
+    gpointer user_data)
+{
+  guint n_stripes, i;
+
+  g_return_val_if_fail (runner != NULL, 0);
+  g_return_val_if_fail (func != NULL, 0);
+
+  if (n_rows == 0)
+    return 0;
+
+  runner->func = func;
+  runner->user_data = user_data;
+  runner->n_rows = n_rows;
+  runner->stripe_rows = gst_stripe_runner_get_stripe_rows (n_threads, n_rows,
+      min_rows, align);
+  n_stripes = (n_rows + runner->stripe_rows - 1) / runner->stripe_rows;
+
+  GST_LOG ("processing %u rows in %u stripes of %u rows", n_rows, n_stripes,
+      runner->stripe_rows);
+
+  if (n_stripes > 1) {
+    if (runner->pool == NULL) {
+      runner->pool =
+          g_thread_pool_new ((GFunc) gst_stripe_runner_worker_func, runner,
+          n_stripes - 1, FALSE, NULL);
+    } else if (g_thread_pool_get_max_threads (runner->pool) <
+        (gint) n_stripes - 1) {
+      g_thread_pool_set_max_threads (runner->pool, n_stripes - 1, NULL);
+    }
+
+    g_mutex_lock (&runner->lock);
+    runner->pending = n_stripes - 1;
+    g_mutex_unlock (&runner->lock);
+
+    for (i = 1; i < n_stripes; i++)
+      g_thread_pool_push (runner->pool, GUINT_TO_POINTER (i + 1), NULL);
+  }
+
+  /* The first stripe is done by this thread while the others are running */
+  gst_stripe_runner_process_stripe (runner, 0);
+
+  if (n_stripes > 1) {
+    g_mutex_lock (&runner->lock);
+    while (runner->pending > 0)
+      g_cond_wait (&runner->cond, &runner->lock);
+    g_mutex_unlock (&runner->lock);
+  }
+
+  return n_stripes;
+}
@@ -0,0 +1,68 @@
+/* GStreamer stripe runner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_STRIPE_RUNNER_H__
+#define __GST_STRIPE_RUNNER_H__
+
+#ifndef GST_USE_UNSTABLE_API
+#warning "The Base library from gst-plugins-bad is unstable API and may change in future."
+#warning "You can define GST_USE_UNSTABLE_API to avoid this warning."
+#endif
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GstStripeRunner GstStripeRunner;
+
+/**
+ * GstStripeRunnerFunc:
+ * @stripe: the index of the stripe
+ * @start: the first row of the stripe
+ * @end: the row after the last row of the stripe
+ * @user_data: the user data passed to gst_stripe_runner_run()
+ *
+ * Processes the rows [@start, @end) of one stripe. The stripes of a run are
+ * processed concurrently, so the function must only touch data that belongs
+ * to its own stripe.
+ *
+ * Since: 1.12
+ */
+typedef void (*GstStripeRunnerFunc) (guint stripe, guint start, guint end,
+    gpointer user_data);
+
+GstStripeRunner * gst_stripe_runner_new           (void);
+
+void              gst_stripe_runner_free          (GstStripeRunner * runner);
+
+guint             gst_stripe_runner_get_n_stripes (guint n_threads,
+                                                   guint n_rows,
+                                                   guint min_rows,
+                                                   guint align);
+
+guint             gst_stripe_runner_run           (GstStripeRunner * runner,
+                                                   guint n_threads,
+                                                   guint n_rows,
+                                                   guint min_rows,
+                                                   guint align,
+                                                   GstStripeRunnerFunc func,
+                                                   gpointer user_data);
+
+G_END_DECLS
+
+#endif /* __GST_STRIPE_RUNNER_H__ */
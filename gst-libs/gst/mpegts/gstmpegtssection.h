@@ -396,6 +396,8 @@ GstMpegtsSection *gst_mpegts_section_new (guint16 pid,
 
 guint8 *gst_mpegts_section_packetize (GstMpegtsSection * section, gsize * output_size);
 
+guint32 gst_mpegts_crc32 (const guint8 * data, gsize length);
+
 G_END_DECLS
 
 #endif				/* GST_MPEGTS_SECTION_H */
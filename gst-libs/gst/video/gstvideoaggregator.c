@@ -27,7 +27,8 @@
  * output parameters. Indeed output video frames will have the geometry of the
  * biggest incoming video stream and the framerate of the fastest incoming one.
  *
- * VideoAggregator will do colorspace conversion.
+ * VideoAggregator will do colorspace conversion. The frames of all pads are
+ * prepared (and converted) in parallel, see #GstVideoAggregator:n-threads.
  *
  * Zorder for each input stream can be configured on the
  * #GstVideoAggregatorPad.
@@ -40,6 +41,8 @@
 
 #include <string.h>
 
+#include <gst/base/gststriperunner.h>
+
 #include "gstvideoaggregator.h"
 #include "gstvideoaggregatorpad.h"
 
@@ -71,6 +74,9 @@ struct _GstVideoAggregatorPadPrivate
   /* caps used for conversion if needed */
   GstVideoInfo conversion_info;
   GstBuffer *converted_buffer;
+  /* Pool recycling the conversion buffers, whose size is converted_size */
+  GstBufferPool *converted_pool;
+  gsize converted_size;
 
   GstClockTime start_time;
   GstClockTime end_time;
@@ -225,9 +231,69 @@ gst_video_aggregator_pad_finalize (GObject * o)
     gst_video_converter_free (vaggpad->priv->convert);
   vaggpad->priv->convert = NULL;
 
+  if (vaggpad->priv->converted_pool) {
+    gst_buffer_pool_set_active (vaggpad->priv->converted_pool, FALSE);
+    gst_object_unref (vaggpad->priv->converted_pool);
+    vaggpad->priv->converted_pool = NULL;
+  }
+
   G_OBJECT_CLASS (gst_video_aggregator_pad_parent_class)->finalize (o);
 }
 
+/**
+ * gst_video_aggregator_pad_acquire_converted_buffer:
+ * @pad: a #GstVideoAggregatorPad
+ * @size: the size of the buffer
+ *
+ * Gets a buffer of @size bytes for the converted frame of @pad. The buffers
+ * are recycled from the previous frames whenever possible. Subclasses that
+ * implement their own @prepare_frame can use this for their conversions.
+ *
+ * Returns: (transfer full): a buffer of @size bytes
+ *
+ * Since: 1.12
+ */
+GstBuffer *
+gst_video_aggregator_pad_acquire_converted_buffer (GstVideoAggregatorPad * pad,
+    gsize size)
+{
+  static GstAllocationParams params = { 0, 15, 0, 0, };
+  GstVideoAggregatorPadPrivate *priv;
+  GstBuffer *buf = NULL;
+
+  g_return_val_if_fail (GST_IS_VIDEO_AGGREGATOR_PAD (pad), NULL);
+
+  priv = pad->priv;
+
+  if (priv->converted_pool == NULL || priv->converted_size != size) {
+    GstStructure *config;
+
+    if (priv->converted_pool) {
+      gst_buffer_pool_set_active (priv->converted_pool, FALSE);
+      gst_object_unref (priv->converted_pool);
+    }
+
+    priv->converted_pool = gst_buffer_pool_new ();
+    priv->converted_size = size;
+    config = gst_buffer_pool_get_config (priv->converted_pool);
+    gst_buffer_pool_config_set_params (config, NULL, size, 0, 0);
+    gst_buffer_pool_config_set_allocator (config, NULL, &params);
+    if (!gst_buffer_pool_set_config (priv->converted_pool, config) ||
+        !gst_buffer_pool_set_active (priv->converted_pool, TRUE)) {
+      GST_WARNING_OBJECT (pad, "Could not set up conversion buffer pool");
+      gst_object_unref (priv->converted_pool);
+      priv->converted_pool = NULL;
+    }
+  }
+
+  if (priv->converted_pool == NULL ||
+      gst_buffer_pool_acquire_buffer (priv->converted_pool, &buf,
+          NULL) != GST_FLOW_OK)
+    buf = gst_buffer_new_allocate (NULL, size, &params);
+
+  return buf;
+}
+
 static gboolean
 gst_video_aggregator_pad_prepare_frame (GstVideoAggregatorPad * pad,
     GstVideoAggregator * vagg)
@@ -236,7 +302,6 @@ gst_video_aggregator_pad_prepare_frame (GstVideoAggregatorPad * pad,
   GstVideoFrame *converted_frame;
   GstBuffer *converted_buf = NULL;
   GstVideoFrame *frame;
-  static GstAllocationParams params = { 0, 15, 0, 0, };
 
   if (!pad->buffer)
     return TRUE;
@@ -258,12 +323,15 @@ gst_video_aggregator_pad_prepare_frame (GstVideoAggregatorPad * pad,
     converted_size = pad->priv->conversion_info.size;
     outsize = GST_VIDEO_INFO_SIZE (&vagg->info);
     converted_size = converted_size > outsize ? converted_size : outsize;
-    converted_buf = gst_buffer_new_allocate (NULL, converted_size, &params);
+    converted_buf =
+        gst_video_aggregator_pad_acquire_converted_buffer (pad, converted_size);
 
     if (!gst_video_frame_map (converted_frame, &(pad->priv->conversion_info),
             converted_buf, GST_MAP_READWRITE)) {
       GST_WARNING_OBJECT (vagg, "Could not map converted frame");
 
+      gst_buffer_unref (converted_buf);
+
       g_slice_free (GstVideoFrame, converted_frame);
       gst_video_frame_unmap (frame);
       g_slice_free (GstVideoFrame, frame);
@@ -429,6 +497,18 @@ struct _GstVideoAggregatorPrivate
   GstCaps *current_caps;
 
   gboolean live;
+
+  /* Maximum number of threads preparing pad frames, 0 for automatic */
+  guint n_threads;
+  /* Prepares the frames of the pads in parallel */
+  GstStripeRunner *prepare_runner;
+};
+
+#define DEFAULT_N_THREADS 0
+enum
+{
+  PROP_0,
+  PROP_N_THREADS,
 };
 
 /* Can't use the G_DEFINE_TYPE macros because we need the
@@ -1318,6 +1398,55 @@ prepare_frames (GstVideoAggregator * vagg, GstVideoAggregatorPad * pad)
   return vaggpad_class->prepare_frame (pad, vagg);
 }
 
+typedef struct
+{
+  GstVideoAggregator *vagg;
+  GPtrArray *pads;
+} PrepareFramesData;
+
+static void
+prepare_frames_stripe_func (guint stripe, guint start, guint end,
+    PrepareFramesData * data)
+{
+  guint i;
+
+  for (i = start; i < end; i++)
+    prepare_frames (data->vagg, g_ptr_array_index (data->pads, i));
+}
+
+/* Prepares the frames of all pads, in parallel if more than one pad has a
+ * buffer. The pads are independent of each other, so their conversions can
+ * run concurrently. */
+static void
+gst_video_aggregator_prepare_all_frames (GstVideoAggregator * vagg)
+{
+  GstVideoAggregatorPrivate *priv = vagg->priv;
+  PrepareFramesData data;
+  GPtrArray *pads;
+  guint n_threads;
+  GList *l;
+
+  pads = g_ptr_array_new_with_free_func (gst_object_unref);
+
+  GST_OBJECT_LOCK (vagg);
+  for (l = GST_ELEMENT (vagg)->sinkpads; l; l = l->next) {
+    GstVideoAggregatorPad *pad = l->data;
+
+    if (pad->buffer)
+      g_ptr_array_add (pads, gst_object_ref (pad));
+  }
+  n_threads = priv->n_threads;
+  GST_OBJECT_UNLOCK (vagg);
+
+  data.vagg = vagg;
+  data.pads = pads;
+
+  gst_stripe_runner_run (priv->prepare_runner, n_threads, pads->len, 1, 1,
+      (GstStripeRunnerFunc) prepare_frames_stripe_func, &data);
+
+  g_ptr_array_unref (pads);
+}
+
 static gboolean
 clean_pad (GstVideoAggregator * vagg, GstVideoAggregatorPad * pad)
 {
@@ -1361,8 +1490,8 @@ gst_video_aggregator_do_aggregate (GstVideoAggregator * vagg,
       (GstAggregatorPadForeachFunc) sync_pad_values, NULL);
 
   /* Convert all the frames the subclass has before aggregating */
-  gst_aggregator_iterate_sinkpads (GST_AGGREGATOR (vagg),
-      (GstAggregatorPadForeachFunc) prepare_frames, NULL);
+  if (vaggpad_class->prepare_frame)
+    gst_video_aggregator_prepare_all_frames (vagg);
 
   ret = vagg_klass->aggregate_frames (vagg, *outbuf);
 
@@ -2057,6 +2186,7 @@ gst_video_aggregator_finalize (GObject * o)
 {
   GstVideoAggregator *vagg = GST_VIDEO_AGGREGATOR (o);
 
+  gst_stripe_runner_free (vagg->priv->prepare_runner);
   g_mutex_clear (&vagg->priv->lock);
 
   G_OBJECT_CLASS (gst_video_aggregator_parent_class)->finalize (o);
@@ -2076,7 +2206,14 @@ static void
 gst_video_aggregator_get_property (GObject * object,
     guint prop_id, GValue * value, GParamSpec * pspec)
 {
+  GstVideoAggregator *vagg = GST_VIDEO_AGGREGATOR (object);
+
   switch (prop_id) {
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (vagg);
+      g_value_set_uint (value, vagg->priv->n_threads);
+      GST_OBJECT_UNLOCK (vagg);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2087,7 +2224,14 @@ static void
 gst_video_aggregator_set_property (GObject * object,
     guint prop_id, const GValue * value, GParamSpec * pspec)
 {
+  GstVideoAggregator *vagg = GST_VIDEO_AGGREGATOR (object);
+
   switch (prop_id) {
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (vagg);
+      vagg->priv->n_threads = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (vagg);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2115,6 +2259,12 @@ gst_video_aggregator_class_init (GstVideoAggregatorClass * klass)
   gobject_class->get_property = gst_video_aggregator_get_property;
   gobject_class->set_property = gst_video_aggregator_set_property;
 
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Number of threads",
+          "Maximum number of threads preparing and converting the pad "
+          "frames in parallel (0 = number of processors)", 0, G_MAXUINT,
+          DEFAULT_N_THREADS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->request_new_pad =
       GST_DEBUG_FUNCPTR (gst_video_aggregator_request_new_pad);
   gstelement_class->release_pad =
@@ -2222,8 +2372,10 @@ gst_video_aggregator_init (GstVideoAggregator * vagg,
       GstVideoAggregatorPrivate);
 
   vagg->priv->current_caps = NULL;
+  vagg->priv->n_threads = DEFAULT_N_THREADS;
 
   g_mutex_init (&vagg->priv->lock);
+  vagg->priv->prepare_runner = gst_stripe_runner_new ();
 
   /* initialize variables */
   g_mutex_lock (&sink_caps_mutex);
@@ -41,6 +41,11 @@
  * </listitem>
  * </itemizedlist>
  *
+ * The first caps received on any sink pad define the output format. Later
+ * sink pads preferably negotiate the same caps, but inputs with a different
+ * format, rate or number of channels are converted to the output format
+ * before mixing.
+ *
  * <refsect2>
  * <title>Example launch line</title>
  * |[
@@ -88,7 +93,7 @@ enum
 };
 
 G_DEFINE_TYPE (GstAudioMixerPad, gst_audiomixer_pad,
-    GST_TYPE_AUDIO_AGGREGATOR_PAD);
+    GST_TYPE_AUDIO_AGGREGATOR_CONVERT_PAD);
 
 static void
 gst_audiomixer_pad_get_property (GObject * object, guint prop_id,
@@ -216,6 +221,8 @@ static gboolean
 gst_audiomixer_aggregate_one_buffer (GstAudioAggregator * aagg,
     GstAudioAggregatorPad * aaggpad, GstBuffer * inbuf, guint in_offset,
     GstBuffer * outbuf, guint out_offset, guint num_samples);
+static gdouble gst_audiomixer_get_pad_volume (GstAudioAggregator * aagg,
+    GstAudioAggregatorPad * aaggpad);
 
 
 /* we can only accept caps that we and downstream can handle.
@@ -227,7 +234,7 @@ gst_audiomixer_sink_getcaps (GstAggregator * agg, GstPad * pad,
 {
   GstAudioAggregator *aagg;
   GstAudioMixer *audiomixer;
-  GstCaps *result, *peercaps, *current_caps, *filter_caps;
+  GstCaps *result, *peercaps, *current_caps, *filter_caps, *template_caps;
   GstStructure *s;
   gint i, n;
 
@@ -290,6 +297,17 @@ gst_audiomixer_sink_getcaps (GstAggregator * agg, GstPad * pad,
     }
   }
 
+  /* Anything else we can convert from comes after the preferred caps */
+  template_caps = gst_pad_get_pad_template_caps (pad);
+  if (filter) {
+    GstCaps *tmp = gst_caps_intersect_full (filter, template_caps,
+        GST_CAPS_INTERSECT_FIRST);
+
+    gst_caps_unref (template_caps);
+    template_caps = tmp;
+  }
+  result = gst_caps_merge (result, template_caps);
+
   result = gst_caps_make_writable (result);
 
   n = gst_caps_get_size (result);
@@ -343,7 +361,7 @@ gst_audiomixer_sink_query (GstAggregator * agg, GstAggregatorPad * aggpad,
 }
 
 /* the first caps we receive on any of the sinkpads will define the caps for all
- * the other sinkpads because we can only mix streams with the same caps.
+ * the other sinkpads; streams with other caps are converted before mixing.
  */
 static gboolean
 gst_audiomixer_setcaps (GstAudioMixer * audiomixer, GstPad * pad,
@@ -355,6 +373,7 @@ gst_audiomixer_setcaps (GstAudioMixer * audiomixer, GstPad * pad,
   GstAudioInfo info;
   GstStructure *s;
   gint channels = 0;
+  gboolean first_caps;
   gboolean ret;
 
   caps = gst_caps_copy (orig_caps);
@@ -367,6 +386,52 @@ gst_audiomixer_setcaps (GstAudioMixer * audiomixer, GstPad * pad,
   if (!gst_audio_info_from_caps (&info, caps))
     goto invalid_format;
 
+  GST_OBJECT_LOCK (audiomixer);
+  first_caps = aagg->current_caps == NULL;
+  GST_OBJECT_UNLOCK (audiomixer);
+
+  /* The input can be converted, so if downstream or the caps property don't
+   * allow these caps, mix in a format that they do allow instead */
+  if (first_caps) {
+    GstCaps *downstream_caps;
+
+    downstream_caps = gst_pad_peer_query_caps (agg->srcpad,
+        audiomixer->filter_caps);
+
+    if (downstream_caps && !gst_caps_can_intersect (downstream_caps, caps)) {
+      gst_caps_unref (caps);
+      caps = downstream_caps;
+
+      if (gst_caps_is_empty (caps)) {
+        gst_caps_unref (caps);
+        return FALSE;
+      }
+
+      /* stay as close to the input as possible */
+      caps = gst_caps_truncate (caps);
+      s = gst_caps_get_structure (caps, 0);
+      gst_structure_fixate_field_nearest_int (s, "rate",
+          GST_AUDIO_INFO_RATE (&info));
+      gst_structure_fixate_field_nearest_int (s, "channels",
+          GST_AUDIO_INFO_CHANNELS (&info));
+      caps = gst_caps_fixate (caps);
+
+      s = gst_caps_get_structure (caps, 0);
+      channels = 0;
+      if (gst_structure_get_int (s, "channels", &channels))
+        if (channels <= 2)
+          gst_structure_remove_field (s, "channel-mask");
+
+      GST_INFO_OBJECT (pad, "converting input caps %" GST_PTR_FORMAT
+          " to %" GST_PTR_FORMAT, orig_caps, caps);
+
+      if (!gst_audio_info_from_caps (&info, caps))
+        goto invalid_format;
+    } else if (downstream_caps) {
+      gst_caps_unref (downstream_caps);
+    }
+  }
+
   if (channels == 1) {
     GstCaps *filter;
     GstCaps *downstream_caps;
@@ -393,25 +458,19 @@ gst_audiomixer_setcaps (GstAudioMixer * audiomixer, GstPad * pad,
   }
 
   GST_OBJECT_LOCK (audiomixer);
-  /* don't allow reconfiguration for now; there's still a race between the
-   * different upstream threads doing query_caps + accept_caps + sending
-   * (possibly different) CAPS events, but there's not much we can do about
-   * that, upstream needs to deal with it. */
+  /* don't allow reconfiguration of the output for now; there's still a race
+   * between the different upstream threads doing query_caps + accept_caps +
+   * sending (possibly different) CAPS events. Input that doesn't match the
+   * current caps is converted by the pad instead. */
   if (aagg->current_caps != NULL) {
-    if (gst_audio_info_is_equal (&info, &aagg->info)) {
-      GST_OBJECT_UNLOCK (audiomixer);
-      gst_caps_unref (caps);
-      gst_audio_aggregator_set_sink_caps (aagg, GST_AUDIO_AGGREGATOR_PAD (pad),
-          orig_caps);
-      return TRUE;
-    } else {
-      GST_DEBUG_OBJECT (pad, "got input caps %" GST_PTR_FORMAT ", but "
-          "current caps are %" GST_PTR_FORMAT, caps, aagg->current_caps);
-      GST_OBJECT_UNLOCK (audiomixer);
-      gst_pad_push_event (pad, gst_event_new_reconfigure ());
-      gst_caps_unref (caps);
-      return FALSE;
-    }
+    if (!gst_audio_info_is_equal (&info, &aagg->info))
+      GST_DEBUG_OBJECT (pad, "got input caps %" GST_PTR_FORMAT ", converting "
+          "to current caps %" GST_PTR_FORMAT, caps, aagg->current_caps);
+    GST_OBJECT_UNLOCK (audiomixer);
+    gst_caps_unref (caps);
+    gst_audio_aggregator_set_sink_caps (aagg, GST_AUDIO_AGGREGATOR_PAD (pad),
+        orig_caps);
+    return TRUE;
   }
   GST_OBJECT_UNLOCK (audiomixer);
 
@@ -504,6 +563,7 @@ gst_audiomixer_class_init (GstAudioMixerClass * klass)
   agg_class->sink_event = GST_DEBUG_FUNCPTR (gst_audiomixer_sink_event);
 
   aagg_class->aggregate_one_buffer = gst_audiomixer_aggregate_one_buffer;
+  aagg_class->get_pad_volume = gst_audiomixer_get_pad_volume;
 }
 
 static void
@@ -738,6 +798,18 @@ gst_audiomixer_aggregate_one_buffer (GstAudioAggregator * aagg,
   return TRUE;
 }
 
+/* Called with pad object lock held */
+static gdouble
+gst_audiomixer_get_pad_volume (GstAudioAggregator * aagg,
+    GstAudioAggregatorPad * aaggpad)
+{
+  GstAudioMixerPad *pad = GST_AUDIO_MIXER_PAD (aaggpad);
+
+  if (pad->mute || pad->volume < G_MINDOUBLE)
+    return 0.0;
+
+  return pad->volume;
+}
 
 /* GstChildProxy implementation */
 static GObject *
@@ -37,6 +37,8 @@ extern BlendFunction gst_compositor_overlay_bgra;
 #define gst_compositor_overlay_ayuv gst_compositor_overlay_argb
 #define gst_compositor_overlay_abgr gst_compositor_overlay_argb
 #define gst_compositor_overlay_rgba gst_compositor_overlay_bgra
+/* Copies frames without any alpha, for all 32 bit formats */
+extern BlendFunction gst_compositor_copy_a32;
 extern BlendFunction gst_compositor_blend_i420;
 #define gst_compositor_blend_yv12 gst_compositor_blend_i420
 extern BlendFunction gst_compositor_blend_nv12;
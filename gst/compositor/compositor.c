@@ -29,6 +29,9 @@
  * biggest incoming video stream and the framerate of the fastest incoming one.
  *
  * Compositor will do colorspace conversion.
+ *
+ * The output frame is composited in horizontal bands on as many threads as
+ * set by the #GstVideoAggregator:n-threads property.
  * 
  * Individual parameters for each input stream can be configured on the
  * #GstCompositorPad:
@@ -379,7 +382,6 @@ gst_compositor_pad_prepare_frame (GstVideoAggregatorPad * pad,
   GstVideoFrame *converted_frame;
   GstBuffer *converted_buf = NULL;
   GstVideoFrame *frame;
-  static GstAllocationParams params = { 0, 15, 0, 0, };
   gint width, height;
   gboolean frame_obscured = FALSE;
   GList *l;
@@ -548,12 +550,16 @@ gst_compositor_pad_prepare_frame (GstVideoAggregatorPad * pad,
     converted_size = GST_VIDEO_INFO_SIZE (&cpad->conversion_info);
     outsize = GST_VIDEO_INFO_SIZE (&vagg->info);
     converted_size = converted_size > outsize ? converted_size : outsize;
-    converted_buf = gst_buffer_new_allocate (NULL, converted_size, &params);
+    converted_buf =
+        gst_video_aggregator_pad_acquire_converted_buffer (pad,
+        converted_size);
 
     if (!gst_video_frame_map (converted_frame, &(cpad->conversion_info),
             converted_buf, GST_MAP_READWRITE)) {
       GST_WARNING_OBJECT (vagg, "Could not map converted frame");
 
+      gst_buffer_unref (converted_buf);
+
       g_slice_free (GstVideoFrame, converted_frame);
       gst_video_frame_unmap (frame);
       g_slice_free (GstVideoFrame, frame);
@@ -725,6 +731,7 @@ set_functions (GstCompositor * self, GstVideoInfo * info)
 
   self->blend = NULL;
   self->overlay = NULL;
+  self->copy = NULL;
   self->fill_checker = NULL;
   self->fill_color = NULL;
 
@@ -732,6 +739,7 @@ set_functions (GstCompositor * self, GstVideoInfo * info)
     case GST_VIDEO_FORMAT_AYUV:
       self->blend = gst_compositor_blend_ayuv;
       self->overlay = gst_compositor_overlay_ayuv;
+      self->copy = gst_compositor_copy_a32;
       self->fill_checker = gst_compositor_fill_checker_ayuv;
       self->fill_color = gst_compositor_fill_color_ayuv;
       ret = TRUE;
@@ -739,6 +747,7 @@ set_functions (GstCompositor * self, GstVideoInfo * info)
     case GST_VIDEO_FORMAT_ARGB:
       self->blend = gst_compositor_blend_argb;
       self->overlay = gst_compositor_overlay_argb;
+      self->copy = gst_compositor_copy_a32;
       self->fill_checker = gst_compositor_fill_checker_argb;
       self->fill_color = gst_compositor_fill_color_argb;
       ret = TRUE;
@@ -746,6 +755,7 @@ set_functions (GstCompositor * self, GstVideoInfo * info)
     case GST_VIDEO_FORMAT_BGRA:
       self->blend = gst_compositor_blend_bgra;
       self->overlay = gst_compositor_overlay_bgra;
+      self->copy = gst_compositor_copy_a32;
       self->fill_checker = gst_compositor_fill_checker_bgra;
       self->fill_color = gst_compositor_fill_color_bgra;
       ret = TRUE;
@@ -753,6 +763,7 @@ set_functions (GstCompositor * self, GstVideoInfo * info)
     case GST_VIDEO_FORMAT_ABGR:
       self->blend = gst_compositor_blend_abgr;
       self->overlay = gst_compositor_overlay_abgr;
+      self->copy = gst_compositor_copy_a32;
       self->fill_checker = gst_compositor_fill_checker_abgr;
       self->fill_color = gst_compositor_fill_color_abgr;
       ret = TRUE;
@@ -760,6 +771,7 @@ set_functions (GstCompositor * self, GstVideoInfo * info)
     case GST_VIDEO_FORMAT_RGBA:
       self->blend = gst_compositor_blend_rgba;
       self->overlay = gst_compositor_overlay_rgba;
+      self->copy = gst_compositor_copy_a32;
       self->fill_checker = gst_compositor_fill_checker_rgba;
       self->fill_color = gst_compositor_fill_color_rgba;
       ret = TRUE;
@@ -880,6 +892,10 @@ set_functions (GstCompositor * self, GstVideoInfo * info)
       break;
   }
 
+  /* All other blend functions plainly copy frames with an alpha of 1.0 */
+  if (self->copy == NULL)
+    self->copy = self->blend;
+
   return ret;
 }
 
@@ -976,24 +992,112 @@ _negotiated_caps (GstVideoAggregator * vagg, GstCaps * caps)
   return TRUE;
 }
 
-static GstFlowReturn
-gst_compositor_aggregate_frames (GstVideoAggregator * vagg, GstBuffer * outbuf)
+/* Output frames are composited in horizontal bands whose height is a multiple
+ * of this, so the chroma rows of subsampled formats and the checker pattern
+ * line up with those of the complete frame. The background is drawn in
+ * chunks of this many rows, for the same reason. */
+#define COMPOSITOR_BAND_ALIGN 16
+/* Don't bother splitting frames into bands smaller than this */
+#define COMPOSITOR_MIN_BAND_HEIGHT 64
+
+typedef struct
 {
-  GList *l;
-  GstCompositor *self = GST_COMPOSITOR (vagg);
+  GstVideoAggregatorPad *pad;
+  /* The part of the output the pad may draw to. The blend functions round
+   * the position up to the chroma subsampling, so this is a bit generous */
+  GstVideoRectangle rect;
+  /* TRUE if the pad completely replaces what's below it in opaque_rect,
+   * which is the part of the output it is guaranteed to draw to */
+  gboolean opaque;
+  GstVideoRectangle opaque_rect;
+} CompositorLayer;
+
+typedef struct
+{
+  GstCompositor *self;
+  /* The rows of the output frame this band covers */
+  GstVideoFrame frame;
+  gint y;
   BlendFunction composite;
-  GstVideoFrame out_frame, *outframe;
+  /* All pads with a frame, in z-order */
+  const CompositorLayer *layers;
+  guint n_layers;
+} CompositorBand;
 
-  if (!gst_video_frame_map (&out_frame, &vagg->info, outbuf, GST_MAP_WRITE)) {
-    GST_WARNING_OBJECT (vagg, "Could not map output buffer");
-    return GST_FLOW_ERROR;
+/* What all bands of an output frame have in common */
+typedef struct
+{
+  GstCompositor *self;
+  const GstVideoFrame *out_frame;
+  BlendFunction composite;
+  const CompositorLayer *layers;
+  guint n_layers;
+} CompositorBlend;
+
+/* Makes @band a view of the rows @y to @y + @height of @frame */
+static void
+_init_band_frame (GstVideoFrame * band, const GstVideoFrame * frame, gint y,
+    gint height)
+{
+  const GstVideoFormatInfo *finfo = frame->info.finfo;
+  guint plane, comp;
+
+  *band = *frame;
+  band->info.height = height;
+
+  for (plane = 0; plane < GST_VIDEO_FRAME_N_PLANES (frame); plane++) {
+    for (comp = 0; comp < GST_VIDEO_FRAME_N_COMPONENTS (frame) - 1; comp++) {
+      if (GST_VIDEO_FORMAT_INFO_PLANE (finfo, comp) == plane)
+        break;
+    }
+
+    band->data[plane] = (guint8 *) frame->data[plane] +
+        GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT (finfo, comp, y) *
+        GST_VIDEO_FRAME_PLANE_STRIDE (frame, plane);
+  }
+}
+
+/* Checks if the area from (@x0,@y0) to (@x1,@y1) is completely covered by
+ * the opaque layers from @first on */
+static gboolean
+_is_area_covered (const CompositorLayer * layers, guint first,
+    guint n_layers, gint x0, gint y0, gint x1, gint y1)
+{
+  gint x, y, next_y;
+  gboolean extended;
+  guint i;
+
+  y = y0;
+  while (y < y1) {
+    /* Walk the row from the left for as long as it is covered, and find
+     * until which row all the rectangles used for that extend */
+    x = x0;
+    next_y = y1;
+    do {
+      extended = FALSE;
+      for (i = first; i < n_layers && x < x1; i++) {
+        const GstVideoRectangle *r = &layers[i].opaque_rect;
+
+        if (layers[i].opaque && r->y <= y && r->y + r->h > y && r->x <= x
+            && r->x + r->w > x) {
+          x = r->x + r->w;
+          next_y = MIN (next_y, r->y + r->h);
+          extended = TRUE;
+        }
+      }
+    } while (extended && x < x1);
+
+    if (x < x1)
+      return FALSE;
+    y = next_y;
   }
 
-  outframe = &out_frame;
-  /* default to blending */
-  composite = self->blend;
-  /* TODO: If the frames to be composited completely obscure the background,
-   * don't bother drawing the background at all. */
+  return TRUE;
+}
+
+static void
+_draw_background (GstCompositor * self, GstVideoFrame * outframe)
+{
   switch (self->background) {
     case COMPOSITOR_BACKGROUND_CHECKER:
       self->fill_checker (outframe);
@@ -1023,26 +1127,307 @@ gst_compositor_aggregate_frames (GstVideoAggregator * vagg, GstBuffer * outbuf)
           pdata += plane_stride;
         }
       }
-
-      /* use overlay to keep background transparent */
-      composite = self->overlay;
       break;
     }
   }
+}
+
+/* Draws the background of the band, skipping the rows that are covered by
+ * opaque pads anyway */
+static void
+_draw_band_background (CompositorBand * band)
+{
+  gint width = GST_VIDEO_FRAME_WIDTH (&band->frame);
+  gint height = GST_VIDEO_FRAME_HEIGHT (&band->frame);
+  gint y, chunk_end, fill_start = -1;
+  GstVideoFrame chunk;
+
+  for (y = 0; y < height; y = chunk_end) {
+    gboolean covered;
+
+    chunk_end = MIN (y + COMPOSITOR_BAND_ALIGN, height);
+    covered = _is_area_covered (band->layers, 0, band->n_layers, 0,
+        band->y + y, width, band->y + chunk_end);
+
+    if (!covered && fill_start < 0)
+      fill_start = y;
+
+    if (fill_start >= 0 && (covered || chunk_end == height)) {
+      gint fill_end = covered ? y : chunk_end;
+
+      _init_band_frame (&chunk, &band->frame, fill_start,
+          fill_end - fill_start);
+      _draw_background (band->self, &chunk);
+      fill_start = -1;
+    }
+  }
+}
+
+/* Draws the background and all pads, in z-order, into one band of the output
+ * frame. Called with the OBJECT_LOCK of the compositor held by the thread
+ * that aggregates. */
+static void
+_composite_band (CompositorBand * band)
+{
+  gint height = GST_VIDEO_FRAME_HEIGHT (&band->frame);
+  guint i;
+
+  _draw_band_background (band);
+
+  for (i = 0; i < band->n_layers; i++) {
+    const CompositorLayer *layer = &band->layers[i];
+    GstCompositorPad *compo_pad = GST_COMPOSITOR_PAD (layer->pad);
+    gint y0, y1;
+
+    /* Skip pads that are completely outside of this band, or hidden by
+     * opaque pads above them */
+    y0 = MAX (layer->rect.y, band->y);
+    y1 = MIN (layer->rect.y + layer->rect.h, band->y + height);
+    if (y0 >= y1)
+      continue;
+
+    if (_is_area_covered (band->layers, i + 1, band->n_layers, layer->rect.x,
+            y0, layer->rect.x + layer->rect.w, y1))
+      continue;
+
+    if (layer->opaque)
+      band->self->copy (layer->pad->aggregated_frame, compo_pad->xpos,
+          compo_pad->ypos - band->y, 1.0, &band->frame);
+    else
+      band->composite (layer->pad->aggregated_frame, compo_pad->xpos,
+          compo_pad->ypos - band->y, compo_pad->alpha, &band->frame);
+  }
+}
+
+static void
+_composite_band_func (guint stripe, guint start, guint end,
+    const CompositorBlend * blend)
+{
+  CompositorBand band;
+
+  band.self = blend->self;
+  band.y = start;
+  band.composite = blend->composite;
+  band.layers = blend->layers;
+  band.n_layers = blend->n_layers;
+  _init_band_frame (&band.frame, blend->out_frame, start, end - start);
+
+  _composite_band (&band);
+}
+
+/* Collects the pads that have a frame to composite. Must be called with the
+ * OBJECT_LOCK */
+static CompositorLayer *
+_get_layers (GstCompositor * self, guint * n_layers)
+{
+  GstVideoAggregator *vagg = GST_VIDEO_AGGREGATOR (self);
+  gint out_width = GST_VIDEO_INFO_WIDTH (&vagg->info);
+  gint out_height = GST_VIDEO_INFO_HEIGHT (&vagg->info);
+  CompositorLayer *layers;
+  GList *l;
+  guint n = 0;
+
+  layers = g_new (CompositorLayer, GST_ELEMENT (vagg)->numsinkpads);
 
-  GST_OBJECT_LOCK (vagg);
   for (l = GST_ELEMENT (vagg)->sinkpads; l; l = l->next) {
     GstVideoAggregatorPad *pad = l->data;
     GstCompositorPad *compo_pad = GST_COMPOSITOR_PAD (pad);
+    CompositorLayer *layer = &layers[n];
+    gint width, height;
+
+    if (pad->aggregated_frame == NULL)
+      continue;
+
+    width = GST_VIDEO_FRAME_WIDTH (pad->aggregated_frame);
+    height = GST_VIDEO_FRAME_HEIGHT (pad->aggregated_frame);
+
+    layer->pad = pad;
+    layer->rect = clamp_rectangle (compo_pad->xpos, compo_pad->ypos,
+        width + 3, height + 1, out_width, out_height);
+    layer->opaque = compo_pad->alpha == 1.0 &&
+        (!GST_VIDEO_INFO_HAS_ALPHA (&pad->info) ||
+        !GST_VIDEO_INFO_HAS_ALPHA (&vagg->info));
+    layer->opaque_rect = clamp_rectangle (GST_ROUND_UP_4 (compo_pad->xpos),
+        GST_ROUND_UP_2 (compo_pad->ypos),
+        compo_pad->xpos + width - GST_ROUND_UP_4 (compo_pad->xpos),
+        compo_pad->ypos + height - GST_ROUND_UP_2 (compo_pad->ypos),
+        out_width, out_height);
+    n++;
+  }
+
+  *n_layers = n;
+
+  return layers;
+}
+
+/* Returns TRUE if @meta describes a frame laid out exactly as @info */
+static gboolean
+_video_meta_matches_info (const GstVideoMeta * meta, const GstVideoInfo * info)
+{
+  guint i;
+
+  if (meta->format != GST_VIDEO_INFO_FORMAT (info)
+      || meta->width != GST_VIDEO_INFO_WIDTH (info)
+      || meta->height != GST_VIDEO_INFO_HEIGHT (info)
+      || meta->n_planes != GST_VIDEO_INFO_N_PLANES (info))
+    return FALSE;
+
+  for (i = 0; i < meta->n_planes; i++) {
+    if (meta->offset[i] != GST_VIDEO_INFO_PLANE_OFFSET (info, i)
+        || meta->stride[i] != GST_VIDEO_INFO_PLANE_STRIDE (info, i))
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/* Returns the pad whose buffer can be pushed as is because it is the only
+ * one visible, covers the whole output and needs no conversion. Must be
+ * called with the OBJECT_LOCK */
+static GstVideoAggregatorPad *
+_get_passthrough_pad (GstCompositor * self)
+{
+  GstVideoAggregator *vagg = GST_VIDEO_AGGREGATOR (self);
+  GstVideoInfo *out_info = &vagg->info;
+  GList *l;
+  guint i;
+
+  /* Find the topmost pad that draws anything */
+  for (l = g_list_last (GST_ELEMENT (vagg)->sinkpads); l; l = l->prev) {
+    GstVideoAggregatorPad *pad = l->data;
+    GstCompositorPad *compo_pad = GST_COMPOSITOR_PAD (pad);
+    GstVideoInfo *info = &pad->buffer_vinfo;
+    GstVideoMeta *meta;
+    GstVideoRectangle rect;
+    gint width, height;
+
+    if (pad->buffer == NULL || compo_pad->alpha == 0.0)
+      continue;
+
+    _mixer_pad_get_output_size (self, compo_pad,
+        GST_VIDEO_INFO_PAR_N (out_info), GST_VIDEO_INFO_PAR_D (out_info),
+        &width, &height);
+    rect = clamp_rectangle (compo_pad->xpos, compo_pad->ypos, width, height,
+        GST_VIDEO_INFO_WIDTH (out_info), GST_VIDEO_INFO_HEIGHT (out_info));
+    if (rect.w == 0 || rect.h == 0)
+      continue;
 
-    if (pad->aggregated_frame != NULL) {
-      composite (pad->aggregated_frame, compo_pad->xpos, compo_pad->ypos,
-          compo_pad->alpha, outframe);
+    if (compo_pad->alpha != 1.0 || GST_VIDEO_INFO_HAS_ALPHA (&pad->info)
+        || compo_pad->xpos != 0 || compo_pad->ypos != 0
+        || width != GST_VIDEO_INFO_WIDTH (out_info)
+        || height != GST_VIDEO_INFO_HEIGHT (out_info))
+      return NULL;
+
+    /* The buffer must already be in the output format and layout */
+    if (GST_VIDEO_INFO_FORMAT (info) != GST_VIDEO_INFO_FORMAT (out_info)
+        || GST_VIDEO_INFO_WIDTH (info) != GST_VIDEO_INFO_WIDTH (out_info)
+        || GST_VIDEO_INFO_HEIGHT (info) != GST_VIDEO_INFO_HEIGHT (out_info)
+        || info->chroma_site != out_info->chroma_site
+        || !gst_video_colorimetry_is_equal (&info->colorimetry,
+            &out_info->colorimetry)
+        || gst_buffer_get_size (pad->buffer) < GST_VIDEO_INFO_SIZE (out_info))
+      return NULL;
+
+    for (i = 0; i < GST_VIDEO_INFO_N_PLANES (out_info); i++) {
+      if (GST_VIDEO_INFO_PLANE_OFFSET (info, i) !=
+          GST_VIDEO_INFO_PLANE_OFFSET (out_info, i)
+          || GST_VIDEO_INFO_PLANE_STRIDE (info, i) !=
+          GST_VIDEO_INFO_PLANE_STRIDE (out_info, i))
+        return NULL;
     }
+
+    /* The caps may match while a video meta describes a padded layout,
+     * which downstream would not get from the default output layout */
+    meta = gst_buffer_get_video_meta (pad->buffer);
+    if (meta && !_video_meta_matches_info (meta, out_info))
+      return NULL;
+
+    return pad;
+  }
+
+  return NULL;
+}
+
+static GstFlowReturn
+gst_compositor_get_output_buffer (GstVideoAggregator * vagg,
+    GstBuffer ** outbuf)
+{
+  GstVideoAggregatorPad *pad;
+
+  GST_OBJECT_LOCK (vagg);
+  pad = _get_passthrough_pad (GST_COMPOSITOR (vagg));
+  if (pad) {
+    /* Share the memory of the input buffer with the output buffer */
+    *outbuf = gst_buffer_new ();
+    gst_buffer_copy_into (*outbuf, pad->buffer, GST_BUFFER_COPY_MEMORY, 0,
+        -1);
   }
   GST_OBJECT_UNLOCK (vagg);
 
-  gst_video_frame_unmap (outframe);
+  if (pad) {
+    GST_LOG_OBJECT (vagg, "Passing through buffer of %s", GST_PAD_NAME (pad));
+    return GST_FLOW_OK;
+  }
+
+  return GST_VIDEO_AGGREGATOR_CLASS (parent_class)->get_output_buffer (vagg,
+      outbuf);
+}
+
+static GstFlowReturn
+gst_compositor_aggregate_frames (GstVideoAggregator * vagg, GstBuffer * outbuf)
+{
+  GstCompositor *self = GST_COMPOSITOR (vagg);
+  BlendFunction composite;
+  GstVideoAggregatorPad *passthrough_pad;
+  GstVideoFrame out_frame;
+  CompositorBlend blend;
+  CompositorLayer *layers;
+  guint n_threads;
+
+  /* Nothing to do if the output buffer already is the only visible frame.
+   * The pads could've changed since the output buffer was chosen though, in
+   * which case the output is composited normally */
+  GST_OBJECT_LOCK (vagg);
+  passthrough_pad = _get_passthrough_pad (self);
+  if (passthrough_pad && gst_buffer_n_memory (outbuf) > 0
+      && gst_buffer_peek_memory (outbuf, 0) ==
+      gst_buffer_peek_memory (passthrough_pad->buffer, 0)) {
+    GST_OBJECT_UNLOCK (vagg);
+    return GST_FLOW_OK;
+  }
+  GST_OBJECT_UNLOCK (vagg);
+
+  if (!gst_video_frame_map (&out_frame, &vagg->info, outbuf, GST_MAP_WRITE)) {
+    GST_WARNING_OBJECT (vagg, "Could not map output buffer");
+    return GST_FLOW_ERROR;
+  }
+
+  /* default to blending, but use overlay to keep the background
+   * transparent */
+  if (self->background == COMPOSITOR_BACKGROUND_TRANSPARENT)
+    composite = self->overlay;
+  else
+    composite = self->blend;
+
+  g_object_get (vagg, "n-threads", &n_threads, NULL);
+
+  blend.self = self;
+  blend.out_frame = &out_frame;
+  blend.composite = composite;
+
+  GST_OBJECT_LOCK (vagg);
+  /* Pads and background hidden by opaque pads are skipped, per band */
+  blend.layers = layers = _get_layers (self, &blend.n_layers);
+
+  /* Split the frame into one band per thread */
+  gst_stripe_runner_run (self->blend_runner, n_threads,
+      GST_VIDEO_FRAME_HEIGHT (&out_frame), COMPOSITOR_MIN_BAND_HEIGHT,
+      COMPOSITOR_BAND_ALIGN, (GstStripeRunnerFunc) _composite_band_func,
+      &blend);
+  GST_OBJECT_UNLOCK (vagg);
+
+  g_free (layers);
+  gst_video_frame_unmap (&out_frame);
 
   return GST_FLOW_OK;
 }
@@ -1099,6 +1484,7 @@ gst_compositor_class_init (GstCompositorClass * klass)
       (GstVideoAggregatorClass *) klass;
   GstAggregatorClass *agg_class = (GstAggregatorClass *) klass;
 
+  gobject_class->finalize = gst_compositor_finalize;
   gobject_class->get_property = gst_compositor_get_property;
   gobject_class->set_property = gst_compositor_set_property;
 
@@ -1107,6 +1493,7 @@ gst_compositor_class_init (GstCompositorClass * klass)
   videoaggregator_class->fixate_caps = _fixate_caps;
   videoaggregator_class->negotiated_caps = _negotiated_caps;
   videoaggregator_class->aggregate_frames = gst_compositor_aggregate_frames;
+  videoaggregator_class->get_output_buffer = gst_compositor_get_output_buffer;
 
   g_object_class_install_property (gobject_class, PROP_BACKGROUND,
       g_param_spec_enum ("background", "Background", "Background type",
@@ -1122,11 +1509,22 @@ gst_compositor_class_init (GstCompositorClass * klass)
       "Sebastian Dröge <sebastian.droege@collabora.co.uk>");
 }
 
+static void
+gst_compositor_finalize (GObject * object)
+{
+  GstCompositor *self = GST_COMPOSITOR (object);
+
+  gst_stripe_runner_free (self->blend_runner);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
 static void
 gst_compositor_init (GstCompositor * self)
 {
   self->background = DEFAULT_BACKGROUND;
   /* initialize variables */
+  self->blend_runner = gst_stripe_runner_new ();
 }
 
 /* Element registration */
@@ -24,6 +24,7 @@
 #include <gst/gst.h>
 #include <gst/video/video.h>
 #include <gst/video/gstvideoaggregator.h>
+#include <gst/base/gststriperunner.h>
 
 #include "blend.h"
 
@@ -71,8 +72,13 @@ struct _GstCompositor
   GstCompositorBackground background;
 
   BlendFunction blend, overlay;
+  /* Used instead of blend or overlay for frames that are opaque */
+  BlendFunction copy;
   FillCheckerFunction fill_checker;
   FillColorFunction fill_color;
+
+  /* Composites horizontal bands of the output frame in parallel */
+  GstStripeRunner *blend_runner;
 };
 
 struct _GstCompositorClass
@@ -24,12 +24,14 @@
 #include "config.h"
 #endif
 #include <string.h>
+#include <math.h>
 
 #include <gst/gst.h>
 #include <gst/base/gstcollectpads.h>
 #include <gst/video/video.h>
 
 #include "gstcompare.h"
+#include "gstdebugutilsbadorc.h"
 
 GST_DEBUG_CATEGORY_STATIC (compare_debug);
 #define GST_CAT_DEFAULT   compare_debug
@@ -55,7 +57,8 @@ enum GstCompareMethod
 {
   GST_COMPARE_METHOD_MEM,
   GST_COMPARE_METHOD_MAX,
-  GST_COMPARE_METHOD_SSIM
+  GST_COMPARE_METHOD_SSIM,
+  GST_COMPARE_METHOD_PSNR
 };
 
 #define GST_COMPARE_METHOD_TYPE (gst_compare_method_get_type())
@@ -68,6 +71,7 @@ gst_compare_method_get_type (void)
     {GST_COMPARE_METHOD_MEM, "Memory", "mem"},
     {GST_COMPARE_METHOD_MAX, "Maximum metric", "max"},
     {GST_COMPARE_METHOD_SSIM, "SSIM (raw video)", "ssim"},
+    {GST_COMPARE_METHOD_PSNR, "PSNR (raw video)", "psnr"},
     {0, NULL, NULL}
   };
 
@@ -91,7 +95,9 @@ enum
   PROP_OFFSET_TS,
   PROP_METHOD,
   PROP_THRESHOLD,
-  PROP_UPPER
+  PROP_UPPER,
+  PROP_POST_MESSAGES,
+  PROP_N_THREADS
 };
 
 #define DEFAULT_META             GST_BUFFER_COPY_ALL
@@ -99,6 +105,8 @@ enum
 #define DEFAULT_METHOD           GST_COMPARE_METHOD_MEM
 #define DEFAULT_THRESHOLD        0
 #define DEFAULT_UPPER            TRUE
+#define DEFAULT_POST_MESSAGES    FALSE
+#define DEFAULT_N_THREADS        0
 
 static void gst_compare_set_property (GObject * object,
     guint prop_id, const GValue * value, GParamSpec * pspec);
@@ -125,6 +133,8 @@ gst_compare_finalize (GObject * object)
 
   gst_object_unref (comp->cpads);
 
+  gst_stripe_runner_free (comp->stripe_runner);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -168,6 +178,34 @@ gst_compare_class_init (GstCompareClass * klass)
       g_param_spec_boolean ("upper", "Threshold Upper Bound",
           "Whether threshold value is upper bound or lower bound for difference measure",
           DEFAULT_UPPER, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstCompare:post-messages:
+   *
+   * Post an element message with the metrics of every pair of frames
+   * compared with the ssim or psnr method. The "compare" message has the
+   * "timestamp" of the frame, its "ssim" and "psnr", and arrays with the
+   * SSIM and PSNR of each component in "component-ssim" and
+   * "component-psnr". Identical frames have an infinite PSNR.
+   *
+   * Since: 1.12
+   */
+  g_object_class_install_property (gobject_class, PROP_POST_MESSAGES,
+      g_param_spec_boolean ("post-messages", "Post Messages",
+          "Post a message with the SSIM and PSNR of every frame (raw video methods)",
+          DEFAULT_POST_MESSAGES, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstCompare:n-threads:
+   *
+   * Maximum number of threads evaluating the SSIM and PSNR of a frame in
+   * parallel, in stripes of lines. 0 uses one thread per processor.
+   *
+   * Since: 1.12
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Number of threads",
+          "Maximum number of threads evaluating the raw video methods (0 = number of processors)",
+          0, G_MAXUINT, DEFAULT_N_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_static_pad_template (gstelement_class, &src_factory);
   gst_element_class_add_static_pad_template (gstelement_class, &sink_factory);
@@ -210,6 +248,10 @@ gst_compare_init (GstCompare * comp)
   comp->method = DEFAULT_METHOD;
   comp->threshold = DEFAULT_THRESHOLD;
   comp->upper = DEFAULT_UPPER;
+  comp->post_messages = DEFAULT_POST_MESSAGES;
+  comp->n_threads = DEFAULT_N_THREADS;
+
+  comp->stripe_runner = gst_stripe_runner_new ();
 
   gst_compare_reset (comp);
 }
@@ -346,13 +388,111 @@ gst_compare_max (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
   return delta;
 }
 
-static double
-gst_compare_ssim_window (GstCompare * comp, guint8 * data1, guint8 * data2,
-    gint width, gint height, gint step, gint stride)
+/* The SSIM of a component is the average SSIM of windows of 16x16 samples,
+ * every 8 samples in both directions (or less at the right and bottom
+ * edges). The sums over a window are those of the 2x2 blocks of 8x8 samples
+ * it covers, so they are accumulated once per block rather than once for
+ * each of the four windows overlapping a block. The same sums give the
+ * squared error for the PSNR. */
+#define SSIM_BLOCK 8
+
+/* Don't bother splitting a component into stripes of fewer block rows */
+#define SSIM_MIN_STRIPE_ROWS 4
+
+typedef struct
+{
+  guint32 sum1;
+  guint32 sum2;
+  /* sum of the squares of the samples of both frames */
+  guint32 sq;
+  /* sum of the products of the samples of both frames */
+  guint32 cross;
+} GstCompareBlock;
+
+/* a component of both frames */
+typedef struct
+{
+  const guint8 *data1, *data2;
+  gint width, height, step, stride1, stride2;
+  guint n_blocks_x, n_blocks_y;
+
+  /* per block row, the sum of the SSIM of the windows starting in the row
+   * and the sum of the squared differences of its samples */
+  gdouble *row_ssim;
+  guint64 *row_sse;
+} GstCompareComponent;
+
+/* The metrics of the raw video methods, per component and for the whole
+ * frame */
+typedef struct
+{
+  gint n_components;
+  gdouble ssim[GST_VIDEO_MAX_COMPONENTS];
+  gdouble psnr[GST_VIDEO_MAX_COMPONENTS];
+  gdouble total_ssim;
+  gdouble total_psnr;
+} GstCompareMetrics;
+
+/* scratch space of a stripe */
+typedef struct
+{
+  guint16 *sum1, *sum2;
+  guint32 *sq, *cross;
+  guint8 *line1, *line2;
+} GstCompareColumns;
+
+/* Computes the sums of the blocks of block row @by */
+static void
+gst_compare_ssim_block_row (GstCompareComponent * c, guint by,
+    GstCompareColumns * cols, GstCompareBlock * blocks)
+{
+  gint x, y, y_end;
+  guint bx;
+
+  memset (cols->sum1, 0, c->width * sizeof (guint16));
+  memset (cols->sum2, 0, c->width * sizeof (guint16));
+  memset (cols->sq, 0, c->width * sizeof (guint32));
+  memset (cols->cross, 0, c->width * sizeof (guint32));
+
+  y_end = MIN ((by + 1) * SSIM_BLOCK, c->height);
+  for (y = by * SSIM_BLOCK; y < y_end; y++) {
+    const guint8 *line1 = c->data1 + y * c->stride1;
+    const guint8 *line2 = c->data2 + y * c->stride2;
+
+    /* gather the samples of packed formats */
+    if (c->step != 1) {
+      for (x = 0; x < c->width; x++) {
+        cols->line1[x] = line1[x * c->step];
+        cols->line2[x] = line2[x * c->step];
+      }
+      line1 = cols->line1;
+      line2 = cols->line2;
+    }
+
+    compare_orc_ssim_sums (cols->sum1, cols->sum2, cols->sq, cols->cross,
+        line1, line2, c->width);
+  }
+
+  for (bx = 0; bx < c->n_blocks_x; bx++) {
+    GstCompareBlock *b = &blocks[bx];
+    gint x_end = MIN ((bx + 1) * SSIM_BLOCK, c->width);
+
+    b->sum1 = b->sum2 = b->sq = b->cross = 0;
+    for (x = bx * SSIM_BLOCK; x < x_end; x++) {
+      b->sum1 += cols->sum1[x];
+      b->sum2 += cols->sum2[x];
+      b->sq += cols->sq[x];
+      b->cross += cols->cross[x];
+    }
+  }
+}
+
+/* @count is the number of samples in the window */
+static gdouble
+gst_compare_ssim_window (const GstCompareBlock * top,
+    const GstCompareBlock * bottom, gint count)
 {
-  gint count = 0, i, j;
-  gint sum1 = 0, sum2 = 0, ssum1 = 0, ssum2 = 0, acov = 0;
-  gdouble avg1, avg2, var1, var2, cov;
+  gdouble avg1, avg2, var, cov;
 
   const gdouble k1 = 0.01;
   const gdouble k2 = 0.03;
@@ -360,76 +500,156 @@ gst_compare_ssim_window (GstCompare * comp, guint8 * data1, guint8 * data2,
   const gdouble c1 = (k1 * L) * (k1 * L);
   const gdouble c2 = (k2 * L) * (k2 * L);
 
-  /* For empty images, return maximum similarity */
-  if (height <= 0 || width <= 0)
-    return 1.0;
-
-  /* plain and simple; no fancy optimizations */
-  for (i = 0; i < height; i++) {
-    for (j = 0; j < width; j++) {
-      sum1 += *data1;
-      sum2 += *data2;
-      ssum1 += *data1 * *data1;
-      ssum2 += *data2 * *data2;
-      acov += *data1 * *data2;
-      count++;
-      data1 += step;
-      data2 += step;
+  avg1 = (gdouble) (top[0].sum1 + top[1].sum1 + bottom[0].sum1 +
+      bottom[1].sum1) / count;
+  avg2 = (gdouble) (top[0].sum2 + top[1].sum2 + bottom[0].sum2 +
+      bottom[1].sum2) / count;
+  /* sum of the variances of both frames */
+  var = (gdouble) (top[0].sq + top[1].sq + bottom[0].sq + bottom[1].sq) /
+      count - avg1 * avg1 - avg2 * avg2;
+  cov = (gdouble) (top[0].cross + top[1].cross + bottom[0].cross +
+      bottom[1].cross) / count - avg1 * avg2;
+
+  return (2 * avg1 * avg2 + c1) * (2 * cov + c2) /
+      ((avg1 * avg1 + avg2 * avg2 + c1) * (var + c2));
+}
+
+/* Evaluates the block rows [start, end) of a component */
+static void
+gst_compare_ssim_rows (GstCompareComponent * c, guint start, guint end)
+{
+  GstCompareColumns cols;
+  GstCompareBlock *blocks, *row, *next, *tmp;
+  guint bx, by;
+
+  cols.sum1 = g_new (guint16, 2 * c->width);
+  cols.sum2 = cols.sum1 + c->width;
+  cols.sq = g_new (guint32, 2 * c->width);
+  cols.cross = cols.sq + c->width;
+  cols.line1 = cols.line2 = NULL;
+  if (c->step != 1) {
+    cols.line1 = g_malloc (2 * c->width);
+    cols.line2 = cols.line1 + c->width;
+  }
+  blocks = g_new (GstCompareBlock, 2 * c->n_blocks_x);
+  row = blocks;
+  next = blocks + c->n_blocks_x;
+
+  gst_compare_ssim_block_row (c, start, &cols, row);
+
+  for (by = start; by < end; by++) {
+    gdouble ssim_sum = 0;
+    guint64 sse = 0;
+    gint height;
+
+    /* the sum of the squares minus twice the products is the sum of the
+     * squared differences */
+    for (bx = 0; bx < c->n_blocks_x; bx++)
+      sse += row[bx].sq - 2 * (guint64) row[bx].cross;
+    c->row_sse[by] = sse;
+
+    /* windows are only started while they extend past the block */
+    if (by + 1 < c->n_blocks_y) {
+      gst_compare_ssim_block_row (c, by + 1, &cols, next);
+
+      height = MIN (2 * SSIM_BLOCK, c->height - by * SSIM_BLOCK);
+      for (bx = 0; bx + 1 < c->n_blocks_x; bx++) {
+        gint width = MIN (2 * SSIM_BLOCK, c->width - bx * SSIM_BLOCK);
+        gdouble ssim;
+
+        ssim = gst_compare_ssim_window (&row[bx], &next[bx], width * height);
+        GST_LOG ("ssim for %dx%d at (%d, %d) = %f", width, height,
+            bx * SSIM_BLOCK, by * SSIM_BLOCK, ssim);
+        ssim_sum += ssim;
+      }
     }
-    data1 -= j * step;
-    data2 -= j * step;
-    data1 += stride;
-    data2 += stride;
+    c->row_ssim[by] = ssim_sum;
+
+    tmp = row;
+    row = next;
+    next = tmp;
   }
 
-  avg1 = sum1 / count;
-  avg2 = sum2 / count;
-  var1 = ssum1 / count - avg1 * avg1;
-  var2 = ssum2 / count - avg2 * avg2;
-  cov = acov / count - avg1 * avg2;
+  g_free (blocks);
+  g_free (cols.line1);
+  g_free (cols.sq);
+  g_free (cols.sum1);
+}
 
-  return (2 * avg1 * avg2 + c1) * (2 * cov + c2) /
-      ((avg1 * avg1 + avg2 * avg2 + c1) * (var1 + var2 + c2));
+static void
+gst_compare_ssim_stripe (guint stripe, guint start, guint end,
+    GstCompareComponent * c)
+{
+  gst_compare_ssim_rows (c, start, end);
 }
 
-/* @width etc are for the particular component */
-static gdouble
-gst_compare_ssim_component (GstCompare * comp, guint8 * data1, guint8 * data2,
-    gint width, gint height, gint step, gint stride)
+/* Evaluates the SSIM and the mean squared error of a component, in stripes
+ * of block rows computed on as many threads as configured. The per row
+ * results are added up in order, so they don't depend on the number of
+ * stripes. */
+static void
+gst_compare_ssim_component (GstCompare * comp, GstCompareComponent * c,
+    gdouble * ssim, gdouble * mse)
 {
-  const gint window = 16;
+  guint i;
   gdouble ssim_sum = 0;
-  gint count = 0, i, j;
-
-  for (j = 0; j + (window / 2) < height; j += (window / 2)) {
-    for (i = 0; i + (window / 2) < width; i += (window / 2)) {
-      gdouble ssim;
-
-      ssim = gst_compare_ssim_window (comp, data1 + step * i + j * stride,
-          data2 + step * i + j * stride,
-          MIN (window, width - i), MIN (window, height - j), step, stride);
-      GST_LOG_OBJECT (comp, "ssim for %dx%d at (%d, %d) = %f", window, window,
-          i, j, ssim);
-      ssim_sum += ssim;
-      count++;
-    }
-  }
+  guint64 sse = 0;
+  guint n_windows;
 
   /* For empty images, return maximum similarity */
-  if (count == 0)
-    return 1.0;
+  *ssim = 1.0;
+  *mse = 0.0;
+  if (c->width <= 0 || c->height <= 0)
+    return;
+
+  c->n_blocks_x = (c->width + SSIM_BLOCK - 1) / SSIM_BLOCK;
+  c->n_blocks_y = (c->height + SSIM_BLOCK - 1) / SSIM_BLOCK;
+  c->row_ssim = g_new (gdouble, c->n_blocks_y);
+  c->row_sse = g_new (guint64, c->n_blocks_y);
+
+  gst_stripe_runner_run (comp->stripe_runner, comp->n_threads,
+      c->n_blocks_y, SSIM_MIN_STRIPE_ROWS, 1,
+      (GstStripeRunnerFunc) gst_compare_ssim_stripe, c);
+
+  for (i = 0; i < c->n_blocks_y; i++) {
+    ssim_sum += c->row_ssim[i];
+    sse += c->row_sse[i];
+  }
+
+  n_windows = (c->n_blocks_x - 1) * (c->n_blocks_y - 1);
+  if (n_windows > 0)
+    *ssim = ssim_sum / n_windows;
+  *mse = (gdouble) sse / ((gdouble) c->width * c->height);
 
-  return (ssim_sum / count);
+  g_free (c->row_ssim);
+  g_free (c->row_sse);
 }
 
 static gdouble
-gst_compare_ssim (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
-    GstBuffer * buf2, GstCaps * caps2)
+gst_compare_psnr_from_mse (gdouble mse)
+{
+  if (mse <= 0)
+    return INFINITY;
+
+  return 10 * log10 (255.0 * 255.0 / mse);
+}
+
+/* Evaluates the SSIM and the PSNR of each component and of the frame, with
+ * the luma weighted as much as the chroma for YUV formats. Returns the
+ * metric of the configured method, and sets the number of components of
+ * @metrics to 0 if the frames could not be compared. */
+static gdouble
+gst_compare_video (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
+    GstBuffer * buf2, GstCaps * caps2, GstCompareMetrics * metrics)
 {
   GstVideoInfo info1, info2;
   GstVideoFrame frame1, frame2;
   gint i, comps;
-  gdouble cssim[4], ssim, c[4] = { 1.0, 0.0, 0.0, 0.0 };
+  gdouble c[4] = { 1.0, 0.0, 0.0, 0.0 };
+  gdouble mse[4] = { 0.0, 0.0, 0.0, 0.0 };
+  gdouble total_mse = 0;
+
+  metrics->n_components = 0;
 
   if (!caps1)
     goto invalid_input;
@@ -440,7 +660,7 @@ gst_compare_ssim (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
   if (!caps2)
     goto invalid_input;
 
-  if (!gst_video_info_from_caps (&info2, caps1))
+  if (!gst_video_info_from_caps (&info2, caps2))
     goto invalid_input;
 
   if (GST_VIDEO_INFO_FORMAT (&info1) != GST_VIDEO_INFO_FORMAT (&info2) ||
@@ -449,6 +669,12 @@ gst_compare_ssim (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
     return comp->threshold + 1;
 
   comps = GST_VIDEO_INFO_N_COMPONENTS (&info1);
+  /* only support most common formats */
+  for (i = 0; i < comps; i++) {
+    if (GST_VIDEO_INFO_COMP_DEPTH (&info1, i) != 8)
+      goto unsupported_input;
+  }
+
   /* note that some are reported both yuv and gray */
   for (i = 0; i < comps; ++i)
     c[i] = 1.0;
@@ -459,44 +685,57 @@ gst_compare_ssim (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
     c[i] /= (GST_VIDEO_INFO_IS_YUV (&info1) && (comps > 1)) ?
         2 * (comps - 1) : comps;
 
-  gst_video_frame_map (&frame1, &info1, buf1, GST_MAP_READ);
-  gst_video_frame_map (&frame2, &info2, buf2, GST_MAP_READ);
+  if (!gst_video_frame_map (&frame1, &info1, buf1, GST_MAP_READ))
+    goto invalid_input;
+  if (!gst_video_frame_map (&frame2, &info2, buf2, GST_MAP_READ)) {
+    gst_video_frame_unmap (&frame1);
+    goto invalid_input;
+  }
 
+  metrics->total_ssim = 0;
   for (i = 0; i < comps; i++) {
-    gint cw, ch, step, stride;
+    GstCompareComponent component;
 
-    /* only support most common formats */
-    if (GST_VIDEO_INFO_COMP_DEPTH (&info1, i) != 8)
-      goto unsupported_input;
-    cw = GST_VIDEO_FRAME_COMP_WIDTH (&frame1, i);
-    ch = GST_VIDEO_FRAME_COMP_HEIGHT (&frame1, i);
-    step = GST_VIDEO_FRAME_COMP_PSTRIDE (&frame1, i);
-    stride = GST_VIDEO_FRAME_COMP_STRIDE (&frame1, i);
+    component.data1 = GST_VIDEO_FRAME_COMP_DATA (&frame1, i);
+    component.data2 = GST_VIDEO_FRAME_COMP_DATA (&frame2, i);
+    component.width = GST_VIDEO_FRAME_COMP_WIDTH (&frame1, i);
+    component.height = GST_VIDEO_FRAME_COMP_HEIGHT (&frame1, i);
+    component.step = GST_VIDEO_FRAME_COMP_PSTRIDE (&frame1, i);
+    component.stride1 = GST_VIDEO_FRAME_COMP_STRIDE (&frame1, i);
+    component.stride2 = GST_VIDEO_FRAME_COMP_STRIDE (&frame2, i);
 
     GST_LOG_OBJECT (comp, "component %d", i);
-    cssim[i] = gst_compare_ssim_component (comp,
-        GST_VIDEO_FRAME_COMP_DATA (&frame1, i),
-        GST_VIDEO_FRAME_COMP_DATA (&frame2, i), cw, ch, step, stride);
-    GST_LOG_OBJECT (comp, "ssim[%d] = %f", i, cssim[i]);
+    gst_compare_ssim_component (comp, &component, &metrics->ssim[i], &mse[i]);
+    metrics->psnr[i] = gst_compare_psnr_from_mse (mse[i]);
+    GST_LOG_OBJECT (comp, "ssim[%d] = %f, psnr[%d] = %f", i, metrics->ssim[i],
+        i, metrics->psnr[i]);
+
+    metrics->total_ssim += metrics->ssim[i] * c[i];
+    total_mse += mse[i] * c[i];
   }
+  metrics->total_psnr = gst_compare_psnr_from_mse (total_mse);
+  metrics->n_components = comps;
 
   gst_video_frame_unmap (&frame1);
   gst_video_frame_unmap (&frame2);
 
 #ifndef GST_DISABLE_GST_DEBUG
-  for (i = 0; i < 4; i++) {
-    GST_DEBUG_OBJECT (comp, "ssim[%d] = %f, c[%d] = %f", i, cssim[i], i, c[i]);
+  for (i = 0; i < comps; i++) {
+    GST_DEBUG_OBJECT (comp, "ssim[%d] = %f, mse[%d] = %f, c[%d] = %f", i,
+        metrics->ssim[i], i, mse[i], i, c[i]);
   }
 #endif
 
-  ssim = cssim[0] * c[0] + cssim[1] * c[1] + cssim[2] * c[2] + cssim[3] * c[3];
+  if (comp->method == GST_COMPARE_METHOD_PSNR)
+    return metrics->total_psnr;
 
-  return ssim;
+  return metrics->total_ssim;
 
   /* ERRORS */
 invalid_input:
   {
-    GST_ERROR_OBJECT (comp, "ssim method needs raw video input");
+    GST_ERROR_OBJECT (comp, "%s method needs raw video input",
+        comp->method == GST_COMPARE_METHOD_PSNR ? "psnr" : "ssim");
     return 0;
   }
 unsupported_input:
@@ -507,18 +746,53 @@ unsupported_input:
   }
 }
 
+static void
+gst_compare_post_metrics (GstCompare * comp, GstBuffer * buf,
+    GstCompareMetrics * metrics)
+{
+  GstStructure *s;
+  GValue ssim = G_VALUE_INIT;
+  GValue psnr = G_VALUE_INIT;
+  GValue v = G_VALUE_INIT;
+  gint i;
+
+  g_value_init (&ssim, GST_TYPE_ARRAY);
+  g_value_init (&psnr, GST_TYPE_ARRAY);
+  g_value_init (&v, G_TYPE_DOUBLE);
+  for (i = 0; i < metrics->n_components; i++) {
+    g_value_set_double (&v, metrics->ssim[i]);
+    gst_value_array_append_value (&ssim, &v);
+    g_value_set_double (&v, metrics->psnr[i]);
+    gst_value_array_append_value (&psnr, &v);
+  }
+  g_value_unset (&v);
+
+  s = gst_structure_new ("compare",
+      "timestamp", G_TYPE_UINT64, GST_BUFFER_PTS (buf),
+      "ssim", G_TYPE_DOUBLE, metrics->total_ssim,
+      "psnr", G_TYPE_DOUBLE, metrics->total_psnr, NULL);
+  gst_structure_take_value (s, "component-ssim", &ssim);
+  gst_structure_take_value (s, "component-psnr", &psnr);
+
+  gst_element_post_message (GST_ELEMENT (comp),
+      gst_message_new_element (GST_OBJECT (comp), s));
+}
+
 static void
 gst_compare_buffers (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
     GstBuffer * buf2, GstCaps * caps2)
 {
   gdouble delta = 0;
   gsize size1, size2;
+  GstCompareMetrics metrics;
+
+  metrics.n_components = 0;
 
   /* first check metadata */
   gst_compare_meta (comp, buf1, caps1, buf2, caps2);
 
   size1 = gst_buffer_get_size (buf1);
-  size2 = gst_buffer_get_size (buf1);
+  size2 = gst_buffer_get_size (buf2);
 
   /* check content according to method */
   /* but at least size should match */
@@ -541,7 +815,8 @@ gst_compare_buffers (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
         delta = gst_compare_max (comp, buf1, caps1, buf2, caps2);
         break;
       case GST_COMPARE_METHOD_SSIM:
-        delta = gst_compare_ssim (comp, buf1, caps1, buf2, caps2);
+      case GST_COMPARE_METHOD_PSNR:
+        delta = gst_compare_video (comp, buf1, caps1, buf2, caps2, &metrics);
         break;
       default:
         g_assert_not_reached ();
@@ -559,6 +834,9 @@ gst_compare_buffers (GstCompare * comp, GstBuffer * buf1, GstCaps * caps1,
             gst_structure_new ("delta", "content", G_TYPE_DOUBLE, delta,
                 NULL)));
   }
+
+  if (comp->post_messages && metrics.n_components > 0)
+    gst_compare_post_metrics (comp, buf1, &metrics);
 }
 
 static GstFlowReturn
@@ -627,6 +905,12 @@ gst_compare_set_property (GObject * object, guint prop_id,
     case PROP_UPPER:
       comp->upper = g_value_get_boolean (value);
       break;
+    case PROP_POST_MESSAGES:
+      comp->post_messages = g_value_get_boolean (value);
+      break;
+    case PROP_N_THREADS:
+      comp->n_threads = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -655,6 +939,12 @@ gst_compare_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_UPPER:
       g_value_set_boolean (value, comp->upper);
       break;
+    case PROP_POST_MESSAGES:
+      g_value_set_boolean (value, comp->post_messages);
+      break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, comp->n_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -26,6 +26,7 @@
 
 
 #include <gst/gst.h>
+#include <gst/base/gststriperunner.h>
 
 G_BEGIN_DECLS
 
@@ -62,6 +63,11 @@ struct _GstCompare {
   gint method;
   gdouble threshold;
   gboolean upper;
+  gboolean post_messages;
+  guint n_threads; /* maximum number of threads evaluating a frame, 0 for one per processor */
+
+  /* evaluates the video metrics in stripes of rows on other threads */
+  GstStripeRunner *stripe_runner;
 };
 
 struct _GstCompareClass {
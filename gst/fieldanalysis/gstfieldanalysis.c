@@ -82,6 +82,7 @@ GST_DEBUG_CATEGORY_STATIC (gst_field_analysis_debug);
 #define DEFAULT_BLOCK_HEIGHT 16
 #define DEFAULT_BLOCK_THRESH 80
 #define DEFAULT_IGNORED_LINES 2
+#define DEFAULT_N_THREADS 0
 
 enum
 {
@@ -96,7 +97,8 @@ enum
   PROP_BLOCK_WIDTH,
   PROP_BLOCK_HEIGHT,
   PROP_BLOCK_THRESH,
-  PROP_IGNORED_LINES
+  PROP_IGNORED_LINES,
+  PROP_N_THREADS
 };
 
 static GstStaticPadTemplate sink_factory =
@@ -274,6 +276,19 @@ gst_field_analysis_class_init (GstFieldAnalysisClass * klass)
           "Ignore this many lines from the top and bottom for windowed comb detection",
           2, G_MAXUINT64, DEFAULT_IGNORED_LINES,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstFieldAnalysis:n-threads:
+   *
+   * Maximum number of threads computing the metrics of a frame in parallel,
+   * in stripes of lines. 0 uses one thread per processor.
+   *
+   * Since: 1.12
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Number of threads",
+          "Maximum number of threads computing the metrics (0 = number of processors)",
+          0, G_MAXUINT, DEFAULT_N_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_field_analysis_change_state);
@@ -297,12 +312,6 @@ static gfloat same_parity_3_tap (GstFieldAnalysis * filter,
     FieldAnalysisFields (*history)[2]);
 static gfloat opposite_parity_5_tap (GstFieldAnalysis * filter,
     FieldAnalysisFields (*history)[2]);
-static guint64 block_score_for_row_32detect (GstFieldAnalysis * filter,
-    FieldAnalysisFields (*history)[2], guint8 * base_fj, guint8 * base_fjp1);
-static guint64 block_score_for_row_iscombed (GstFieldAnalysis * filter,
-    FieldAnalysisFields (*history)[2], guint8 * base_fj, guint8 * base_fjp1);
-static guint64 block_score_for_row_5_tap (GstFieldAnalysis * filter,
-    FieldAnalysisFields (*history)[2], guint8 * base_fj, guint8 * base_fjp1);
 static gfloat opposite_parity_windowed_comb (GstFieldAnalysis * filter,
     FieldAnalysisFields (*history)[2]);
 
@@ -325,10 +334,6 @@ gst_field_analysis_reset (GstFieldAnalysis * filter)
   filter->is_telecine = FALSE;
   filter->first_buffer = TRUE;
   gst_video_info_init (&filter->vinfo);
-  g_free (filter->comb_mask);
-  filter->comb_mask = NULL;
-  g_free (filter->block_scores);
-  filter->block_scores = NULL;
 }
 
 static void
@@ -352,12 +357,14 @@ gst_field_analysis_init (GstFieldAnalysis * filter)
   filter->same_frame = &opposite_parity_5_tap;
   filter->frame_thresh = DEFAULT_FRAME_THRESH;
   filter->noise_floor = DEFAULT_NOISE_FLOOR;
-  filter->block_score_for_row = &block_score_for_row_5_tap;
+  filter->comb_method = DEFAULT_COMB_METHOD;
   filter->spatial_thresh = DEFAULT_SPATIAL_THRESH;
   filter->block_width = DEFAULT_BLOCK_WIDTH;
   filter->block_height = DEFAULT_BLOCK_HEIGHT;
   filter->block_thresh = DEFAULT_BLOCK_THRESH;
   filter->ignored_lines = DEFAULT_IGNORED_LINES;
+  filter->n_threads = DEFAULT_N_THREADS;
+  filter->stripe_runner = gst_stripe_runner_new ();
 }
 
 static void
@@ -366,6 +373,7 @@ gst_field_analysis_set_property (GObject * object, guint prop_id,
 {
   GstFieldAnalysis *filter = GST_FIELDANALYSIS (object);
 
+  GST_OBJECT_LOCK (filter);
   switch (prop_id) {
     case PROP_FIELD_METRIC:
       switch (g_value_get_enum (value)) {
@@ -404,37 +412,13 @@ gst_field_analysis_set_property (GObject * object, guint prop_id,
       filter->frame_thresh = g_value_get_float (value);
       break;
     case PROP_COMB_METHOD:
-      switch (g_value_get_enum (value)) {
-        case METHOD_32DETECT:
-          filter->block_score_for_row = &block_score_for_row_32detect;
-          break;
-        case METHOD_IS_COMBED:
-          filter->block_score_for_row = &block_score_for_row_iscombed;
-          break;
-        case METHOD_5_TAP:
-          filter->block_score_for_row = &block_score_for_row_5_tap;
-          break;
-        default:
-          break;
-      }
+      filter->comb_method = g_value_get_enum (value);
       break;
     case PROP_SPATIAL_THRESH:
       filter->spatial_thresh = g_value_get_int64 (value);
       break;
     case PROP_BLOCK_WIDTH:
       filter->block_width = g_value_get_uint64 (value);
-      if (GST_VIDEO_FRAME_WIDTH (&filter->frames[0].frame)) {
-        const gint frame_width =
-            GST_VIDEO_FRAME_WIDTH (&filter->frames[0].frame);
-        if (filter->block_scores) {
-          gsize nbytes = (frame_width / filter->block_width) * sizeof (guint);
-          filter->block_scores = g_realloc (filter->block_scores, nbytes);
-          memset (filter->block_scores, 0, nbytes);
-        } else {
-          filter->block_scores =
-              g_malloc0 ((frame_width / filter->block_width) * sizeof (guint));
-        }
-      }
       break;
     case PROP_BLOCK_HEIGHT:
       filter->block_height = g_value_get_uint64 (value);
@@ -445,10 +429,14 @@ gst_field_analysis_set_property (GObject * object, guint prop_id,
     case PROP_IGNORED_LINES:
       filter->ignored_lines = g_value_get_uint64 (value);
       break;
+    case PROP_N_THREADS:
+      filter->n_threads = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
+  GST_OBJECT_UNLOCK (filter);
 }
 
 static void
@@ -457,6 +445,7 @@ gst_field_analysis_get_property (GObject * object, guint prop_id,
 {
   GstFieldAnalysis *filter = GST_FIELDANALYSIS (object);
 
+  GST_OBJECT_LOCK (filter);
   switch (prop_id) {
     case PROP_FIELD_METRIC:
     {
@@ -492,18 +481,8 @@ gst_field_analysis_get_property (GObject * object, guint prop_id,
       g_value_set_float (value, filter->frame_thresh);
       break;
     case PROP_COMB_METHOD:
-    {
-      FieldAnalysisCombMethod method = DEFAULT_COMB_METHOD;
-      if (filter->block_score_for_row == &block_score_for_row_32detect) {
-        method = METHOD_32DETECT;
-      } else if (filter->block_score_for_row == &block_score_for_row_iscombed) {
-        method = METHOD_IS_COMBED;
-      } else if (filter->block_score_for_row == &block_score_for_row_5_tap) {
-        method = METHOD_5_TAP;
-      }
-      g_value_set_enum (value, method);
+      g_value_set_enum (value, filter->comb_method);
       break;
-    }
     case PROP_SPATIAL_THRESH:
       g_value_set_int64 (value, filter->spatial_thresh);
       break;
@@ -519,16 +498,19 @@ gst_field_analysis_get_property (GObject * object, guint prop_id,
     case PROP_IGNORED_LINES:
       g_value_set_uint64 (value, filter->ignored_lines);
       break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, filter->n_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
+  GST_OBJECT_UNLOCK (filter);
 }
 
 static void
 gst_field_analysis_update_format (GstFieldAnalysis * filter, GstCaps * caps)
 {
-  gint width;
   GQueue *outbufs;
   GstVideoInfo vinfo;
 
@@ -565,22 +547,6 @@ gst_field_analysis_update_format (GstFieldAnalysis * filter, GstCaps * caps)
   filter->flushing = FALSE;
 
   filter->vinfo = vinfo;
-  width = GST_VIDEO_INFO_WIDTH (&filter->vinfo);
-
-  /* update allocations for metric scores */
-  if (filter->comb_mask) {
-    filter->comb_mask = g_realloc (filter->comb_mask, width);
-  } else {
-    filter->comb_mask = g_malloc (width);
-  }
-  if (filter->block_scores) {
-    gsize nbytes = (width / filter->block_width) * sizeof (guint);
-    filter->block_scores = g_realloc (filter->block_scores, nbytes);
-    memset (filter->block_scores, 0, nbytes);
-  } else {
-    filter->block_scores =
-        g_malloc0 ((width / filter->block_width) * sizeof (guint));
-  }
 
   GST_OBJECT_UNLOCK (filter);
   return;
@@ -802,121 +768,217 @@ gst_field_analysis_sink_event (GstPad * pad, GstObject * parent,
 }
 
 
-static gfloat
-same_parity_sad (GstFieldAnalysis * filter, FieldAnalysisFields (*history)[2])
+/* Computes a metric over the rows [start, end) of the fields and returns the
+ * sum of the per-pixel values (or the highest block score, for the windowed
+ * comb detection) */
+typedef guint64 (*FieldAnalysisStripeFunc) (GstFieldAnalysis * filter,
+    FieldAnalysisFields (*history)[2], guint start, guint end);
+
+typedef struct
 {
-  gint j;
-  gfloat sum;
-  guint8 *f1j, *f2j;
+  GstFieldAnalysis *filter;
+  FieldAnalysisFields (*history)[2];
+  FieldAnalysisStripeFunc func;
+  guint64 *results;
+} FieldAnalysisStripes;
 
-  const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
-  const gint height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
-  const gint stride0x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0) << 1;
-  const gint stride1x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame, 0) << 1;
-  const guint32 noise_floor = filter->noise_floor;
+/* Don't bother splitting metrics into stripes of fewer lines than this */
+#define FIELD_ANALYSIS_MIN_STRIPE_LINES 32
 
-  f1j =
-      GST_VIDEO_FRAME_COMP_DATA (&(*history)[0].frame,
-      0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[0].frame,
-      0) +
-      (*history)[0].parity * GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame,
-      0);
-  f2j =
-      GST_VIDEO_FRAME_COMP_DATA (&(*history)[1].frame,
-      0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[1].frame,
-      0) +
-      (*history)[1].parity * GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame,
+static void
+gst_field_analysis_stripe_func (guint stripe, guint start, guint end,
+    const FieldAnalysisStripes * stripes)
+{
+  stripes->results[stripe] =
+      stripes->func (stripes->filter, stripes->history, start, end);
+}
+
+/* Computes a metric over @n_rows rows, split into stripes of at least
+ * @min_rows rows computed on as many threads as configured. Returns the sum
+ * of the results of the stripes, or their maximum if @max is TRUE. The
+ * integer sums make the result independent of the number of stripes. */
+static guint64
+gst_field_analysis_run_stripes (GstFieldAnalysis * filter,
+    FieldAnalysisFields (*history)[2], FieldAnalysisStripeFunc func,
+    guint n_rows, guint min_rows, gboolean max)
+{
+  FieldAnalysisStripes stripes;
+  /* the number of stripes must match the run, so only read the property
+   * once */
+  guint n_threads = filter->n_threads;
+  guint n_stripes, i;
+  guint64 result = 0;
+
+  if (n_rows == 0)
+    return 0;
+
+  n_stripes = gst_stripe_runner_get_n_stripes (n_threads, n_rows, min_rows, 1);
+
+  stripes.filter = filter;
+  stripes.history = history;
+  stripes.func = func;
+  stripes.results = g_newa (guint64, n_stripes);
+
+  gst_stripe_runner_run (filter->stripe_runner, n_threads, n_rows,
+      min_rows, 1, (GstStripeRunnerFunc) gst_field_analysis_stripe_func,
+      &stripes);
+
+  for (i = 0; i < n_stripes; i++) {
+    if (max)
+      result = MAX (result, stripes.results[i]);
+    else
+      result += stripes.results[i];
+  }
+
+  return result;
+}
+
+/* line j of the field of the given parity */
+static inline guint8 *
+field_line (FieldAnalysisFields * fields, guint j)
+{
+  return GST_VIDEO_FRAME_COMP_DATA (&fields->frame, 0) +
+      (2 * j + fields->parity) * GST_VIDEO_FRAME_COMP_STRIDE (&fields->frame,
       0);
+}
+
+/* line k of the frame made from the top field lines of the 0th field's frame
+ * if its parity is top, or of the 1st field's frame otherwise, and from the
+ * bottom field lines of the other frame */
+static inline guint8 *
+woven_line (FieldAnalysisFields (*history)[2], guint k)
+{
+  GstVideoFrame *frame;
+
+  if (((*history)[0].parity == TOP_FIELD) == ((k & 1) == 0))
+    frame = &(*history)[0].frame;
+  else
+    frame = &(*history)[1].frame;
 
-  sum = 0.0f;
-  for (j = 0; j < (height >> 1); j++) {
+  return GST_VIDEO_FRAME_COMP_DATA (frame, 0) +
+      k * GST_VIDEO_FRAME_COMP_STRIDE (frame, 0);
+}
+
+/* Number of lines comb_mask_line() needs around the line it works on */
+#define COMB_MASK_LINES 5
+
+/* line k of the woven frame as contiguous luma samples. planar formats have
+ * them in place. the luma of packed formats is unpacked into the line of
+ * @cache for the lines with the same index modulo COMB_MASK_LINES, whose
+ * index is kept in @cached_lines, so the lines needed by consecutive calls
+ * to comb_mask_line() are only unpacked once. */
+static inline const guint8 *
+luma_line (FieldAnalysisFields (*history)[2], guint64 k, guint8 * cache,
+    guint64 * cached_lines, gint width)
+{
+  const GstVideoFormatInfo *finfo = (*history)[0].frame.info.finfo;
+  const guint slot = k % COMB_MASK_LINES;
+  guint8 *line = woven_line (history, k);
+
+  if (GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, 0) == 1)
+    return line;
+
+  if (cached_lines[slot] != k) {
+    /* the luma is either the first or the second byte of each sample */
+    if (GST_VIDEO_FORMAT_INFO_POFFSET (finfo, 0) == 0)
+      fieldanalysis_orc_select0_packed_yuv (cache + slot * width,
+          (const guint16 *) line, width);
+    else
+      fieldanalysis_orc_select1_packed_yuv (cache + slot * width,
+          (const guint16 *) (line - 1), width);
+    cached_lines[slot] = k;
+  }
+
+  return cache + slot * width;
+}
+
+static guint64
+same_parity_sad_rows (GstFieldAnalysis * filter,
+    FieldAnalysisFields (*history)[2], guint start, guint end)
+{
+  guint j;
+  guint64 sum = 0;
+
+  const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
+  const guint32 noise_floor = filter->noise_floor;
+
+  for (j = start; j < end; j++) {
     guint32 tempsum = 0;
-    fieldanalysis_orc_same_parity_sad_planar_yuv (&tempsum, f1j, f2j,
+    fieldanalysis_orc_same_parity_sad_planar_yuv (&tempsum,
+        field_line (&(*history)[0], j), field_line (&(*history)[1], j),
         noise_floor, width);
     sum += tempsum;
-    f1j += stride0x2;
-    f2j += stride1x2;
   }
 
-  return sum / (0.5f * width * height);
+  return sum;
 }
 
 static gfloat
-same_parity_ssd (GstFieldAnalysis * filter, FieldAnalysisFields (*history)[2])
+same_parity_sad (GstFieldAnalysis * filter, FieldAnalysisFields (*history)[2])
 {
-  gint j;
-  gfloat sum;
-  guint8 *f1j, *f2j;
+  guint64 sum;
 
   const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
   const gint height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
-  const gint stride0x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0) << 1;
-  const gint stride1x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame, 0) << 1;
+
+  sum = gst_field_analysis_run_stripes (filter, history, same_parity_sad_rows,
+      height >> 1, FIELD_ANALYSIS_MIN_STRIPE_LINES, FALSE);
+
+  return sum / (0.5f * width * height);
+}
+
+static guint64
+same_parity_ssd_rows (GstFieldAnalysis * filter,
+    FieldAnalysisFields (*history)[2], guint start, guint end)
+{
+  guint j;
+  guint64 sum = 0;
+
+  const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
   /* noise floor needs to be squared for SSD */
   const guint32 noise_floor = filter->noise_floor * filter->noise_floor;
 
-  f1j =
-      GST_VIDEO_FRAME_COMP_DATA (&(*history)[0].frame,
-      0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[0].frame,
-      0) +
-      (*history)[0].parity * GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame,
-      0);
-  f2j =
-      GST_VIDEO_FRAME_COMP_DATA (&(*history)[1].frame,
-      0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[1].frame,
-      0) +
-      (*history)[1].parity * GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame,
-      0);
-
-  sum = 0.0f;
-  for (j = 0; j < (height >> 1); j++) {
+  for (j = start; j < end; j++) {
     guint32 tempsum = 0;
-    fieldanalysis_orc_same_parity_ssd_planar_yuv (&tempsum, f1j, f2j,
+    fieldanalysis_orc_same_parity_ssd_planar_yuv (&tempsum,
+        field_line (&(*history)[0], j), field_line (&(*history)[1], j),
         noise_floor, width);
     sum += tempsum;
-    f1j += stride0x2;
-    f2j += stride1x2;
   }
 
-  return sum / (0.5f * width * height); /* field is half height */
+  return sum;
 }
 
-/* horizontal [1,4,1] diff between fields - is this a good idea or should the
- * current sample be emphasised more or less? */
 static gfloat
-same_parity_3_tap (GstFieldAnalysis * filter, FieldAnalysisFields (*history)[2])
+same_parity_ssd (GstFieldAnalysis * filter, FieldAnalysisFields (*history)[2])
 {
-  gint i, j;
-  gfloat sum;
-  guint8 *f1j, *f2j;
+  guint64 sum;
 
   const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
   const gint height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
-  const gint stride0x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0) << 1;
-  const gint stride1x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame, 0) << 1;
+
+  sum = gst_field_analysis_run_stripes (filter, history, same_parity_ssd_rows,
+      height >> 1, FIELD_ANALYSIS_MIN_STRIPE_LINES, FALSE);
+
+  return sum / (0.5f * width * height); /* field is half height */
+}
+
+static guint64
+same_parity_3_tap_rows (GstFieldAnalysis * filter,
+    FieldAnalysisFields (*history)[2], guint start, guint end)
+{
+  gint i;
+  guint j;
+  guint64 sum = 0;
+
+  const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
   const gint incr = GST_VIDEO_FRAME_COMP_PSTRIDE (&(*history)[0].frame, 0);
   /* noise floor needs to be *6 for [1,4,1] */
   const guint32 noise_floor = filter->noise_floor * 6;
 
-  f1j = GST_VIDEO_FRAME_COMP_DATA (&(*history)[0].frame, 0) +
-      GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[0].frame, 0) +
-      (*history)[0].parity * GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame,
-      0);
-  f2j =
-      GST_VIDEO_FRAME_COMP_DATA (&(*history)[1].frame,
-      0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[1].frame,
-      0) +
-      (*history)[1].parity * GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame,
-      0);
-
-  sum = 0.0f;
-  for (j = 0; j < (height >> 1); j++) {
+  for (j = start; j < end; j++) {
+    guint8 *f1j = field_line (&(*history)[0], j);
+    guint8 *f2j = field_line (&(*history)[1], j);
     guint32 tempsum = 0;
     guint32 diff;
 
@@ -937,383 +999,210 @@ same_parity_3_tap (GstFieldAnalysis * filter, FieldAnalysisFields (*history)[2])
         - ((f2j[i - incr] << 1) + (f2j[i] << 2)));
     if (diff > noise_floor)
       sum += diff;
-
-    f1j += stride0x2;
-    f2j += stride1x2;
   }
 
-  return sum / ((6.0f / 2.0f) * width * height);        /* 1 + 4 + 1 = 6; field is half height */
+  return sum;
 }
 
-/* vertical [1,-3,4,-3,1] - same as is used in FieldDiff from TIVTC,
- * tritical's AVISynth IVTC filter */
-/* 0th field's parity defines operation */
+/* horizontal [1,4,1] diff between fields - is this a good idea or should the
+ * current sample be emphasised more or less? */
 static gfloat
-opposite_parity_5_tap (GstFieldAnalysis * filter,
-    FieldAnalysisFields (*history)[2])
+same_parity_3_tap (GstFieldAnalysis * filter, FieldAnalysisFields (*history)[2])
 {
-  gint j;
-  gfloat sum;
-  guint8 *fjm2, *fjm1, *fj, *fjp1, *fjp2;
-  guint32 tempsum;
+  guint64 sum;
 
   const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
   const gint height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
-  const gint stride0x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0) << 1;
-  const gint stride1x2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame, 0) << 1;
-  /* noise floor needs to be *6 for [1,-3,4,-3,1] */
-  const guint32 noise_floor = filter->noise_floor * 6;
 
-  sum = 0.0f;
+  sum = gst_field_analysis_run_stripes (filter, history,
+      same_parity_3_tap_rows, height >> 1, FIELD_ANALYSIS_MIN_STRIPE_LINES,
+      FALSE);
 
-  /* fj is line j of the combined frame made from the top field even lines of
-   *   field 0 and the bottom field odd lines from field 1
-   * fjp1 is one line down from fj
-   * fjm2 is two lines up from fj
-   * fj with j == 0 is the 0th line of the top field
-   * fj with j == 1 is the 0th line of the bottom field or the 1st field of
-   *   the frame*/
+  return sum / ((6.0f / 2.0f) * width * height);        /* 1 + 4 + 1 = 6; field is half height */
+}
 
-  /* unroll first line as it is a special case */
-  if ((*history)[0].parity == TOP_FIELD) {
-    fj = GST_VIDEO_FRAME_COMP_DATA (&(*history)[0].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[0].frame, 0);
-    fjp1 =
-        GST_VIDEO_FRAME_COMP_DATA (&(*history)[1].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[1].frame,
-        0) + GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame, 0);
-    fjp2 = fj + stride0x2;
-  } else {
-    fj = GST_VIDEO_FRAME_COMP_DATA (&(*history)[1].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[1].frame, 0);
-    fjp1 =
-        GST_VIDEO_FRAME_COMP_DATA (&(*history)[0].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[0].frame,
-        0) + GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0);
-    fjp2 = fj + stride1x2;
-  }
+static guint64
+opposite_parity_5_tap_rows (GstFieldAnalysis * filter,
+    FieldAnalysisFields (*history)[2], guint start, guint end)
+{
+  guint j;
+  guint64 sum = 0;
+
+  const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
+  const guint last = (GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame) >> 1) - 1;
+  /* noise floor needs to be *6 for [1,-3,4,-3,1] */
+  const guint32 noise_floor = filter->noise_floor * 6;
 
-  tempsum = 0;
-  fieldanalysis_orc_opposite_parity_5_tap_planar_yuv (&tempsum, fjp2, fjp1, fj,
-      fjp1, fjp2, noise_floor, width);
-  sum += tempsum;
-
-  for (j = 1; j < (height >> 1) - 1; j++) {
-    /* shift everything down a line in the field of interest (means += stridex2) */
-    fjm2 = fj;
-    fjm1 = fjp1;
-    fj = fjp2;
-    if ((*history)[0].parity == TOP_FIELD) {
-      fjp1 += stride1x2;
-      fjp2 += stride0x2;
+  /* fj is line j of the field of interest, which is line 2 * j of the woven
+   * frame. The first and last lines have no lines above or below them
+   * respectively, so they use the lines on their other side instead. */
+  for (j = start; j < end; j++) {
+    guint8 *fjm2, *fjm1, *fj, *fjp1, *fjp2;
+    guint32 tempsum = 0;
+    const guint k = j << 1;
+
+    fj = woven_line (history, k);
+    if (j == 0) {
+      fjm2 = fjp2 = woven_line (history, k + 2);
+      fjm1 = fjp1 = woven_line (history, k + 1);
+    } else if (j == last) {
+      fjm2 = fjp2 = woven_line (history, k - 2);
+      fjm1 = fjp1 = woven_line (history, k - 1);
     } else {
-      fjp1 += stride0x2;
-      fjp2 += stride1x2;
+      fjm2 = woven_line (history, k - 2);
+      fjm1 = woven_line (history, k - 1);
+      fjp1 = woven_line (history, k + 1);
+      fjp2 = woven_line (history, k + 2);
     }
 
-    tempsum = 0;
     fieldanalysis_orc_opposite_parity_5_tap_planar_yuv (&tempsum, fjm2, fjm1,
         fj, fjp1, fjp2, noise_floor, width);
     sum += tempsum;
   }
 
-  /* unroll the last line as it is a special case */
-  /* shift everything down a line in the field of interest (means += stridex2) */
-  fjm2 = fj;
-  fjm1 = fjp1;
-  fj = fjp2;
-
-  tempsum = 0;
-  fieldanalysis_orc_opposite_parity_5_tap_planar_yuv (&tempsum, fjm2, fjm1, fj,
-      fjm1, fjm2, noise_floor, width);
-  sum += tempsum;
-
-  return sum / ((6.0f / 2.0f) * width * height);        /* 1 + 4 + 1 == 3 + 3 == 6; field is half height */
+  return sum;
 }
 
-/* this metric was sourced from HandBrake but originally from transcode
- * the return value is the highest block score for the row of blocks */
-static inline guint64
-block_score_for_row_32detect (GstFieldAnalysis * filter,
-    FieldAnalysisFields (*history)[2], guint8 * base_fj, guint8 * base_fjp1)
+/* vertical [1,-3,4,-3,1] - same as is used in FieldDiff from TIVTC,
+ * tritical's AVISynth IVTC filter */
+/* 0th field's parity defines operation */
+static gfloat
+opposite_parity_5_tap (GstFieldAnalysis * filter,
+    FieldAnalysisFields (*history)[2])
 {
-  guint64 i, j;
-  guint8 *comb_mask = filter->comb_mask;
-  guint *block_scores = filter->block_scores;
-  guint64 block_score;
-  guint8 *fjm2, *fjm1, *fj, *fjp1;
-  const gint incr = GST_VIDEO_FRAME_COMP_PSTRIDE (&(*history)[0].frame, 0);
-  const gint stridex2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0) << 1;
-  const guint64 block_width = filter->block_width;
-  const guint64 block_height = filter->block_height;
-  const gint64 spatial_thresh = filter->spatial_thresh;
-  const gint width =
-      GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame) -
-      (GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame) % block_width);
+  guint64 sum;
 
-  fjm2 = base_fj - stridex2;
-  fjm1 = base_fjp1 - stridex2;
-  fj = base_fj;
-  fjp1 = base_fjp1;
-
-  for (j = 0; j < block_height; j++) {
-    /* we have to work one result ahead of ourselves which results in some small
-     * peculiarities below */
-    gint diff1, diff2;
-
-    diff1 = fj[0] - fjm1[0];
-    diff2 = fj[0] - fjp1[0];
-    /* change in the same direction */
-    if ((diff1 > spatial_thresh && diff2 > spatial_thresh)
-        || (diff1 < -spatial_thresh && diff2 < -spatial_thresh)) {
-      comb_mask[0] = abs (fj[0] - fjm2[0]) < 10 && abs (fj[0] - fjm1[0]) > 15;
-    } else {
-      comb_mask[0] = FALSE;
-    }
+  const gint width = GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame);
+  const gint height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
 
-    for (i = 1; i < width; i++) {
-      const guint64 idx = i * incr;
-      const guint64 res_idx = (i - 1) / block_width;
+  /* fj is line j of the combined frame made from the top field even lines of
+   *   field 0 and the bottom field odd lines from field 1
+   * fjp1 is one line down from fj
+   * fjm2 is two lines up from fj
+   * fj with j == 0 is the 0th line of the top field
+   * fj with j == 1 is the 0th line of the bottom field or the 1st field of
+   *   the frame*/
+  sum = gst_field_analysis_run_stripes (filter, history,
+      opposite_parity_5_tap_rows, height >> 1, FIELD_ANALYSIS_MIN_STRIPE_LINES,
+      FALSE);
 
-      diff1 = fj[idx] - fjm1[idx];
-      diff2 = fj[idx] - fjp1[idx];
-      if ((diff1 > spatial_thresh && diff2 > spatial_thresh)
-          || (diff1 < -spatial_thresh && diff2 < -spatial_thresh)) {
-        comb_mask[i] = abs (fj[idx] - fjm2[idx]) < 10
-            && abs (fj[idx] - fjm1[idx]) > 15;
-      } else {
-        comb_mask[i] = FALSE;
-      }
+  return sum / ((6.0f / 2.0f) * width * height);        /* 1 + 4 + 1 == 3 + 3 == 6; field is half height */
+}
 
-      if (i == 1 && comb_mask[i - 1] && comb_mask[i]) {
-        /* left edge */
-        block_scores[res_idx]++;
-      } else if (i == width - 1) {
-        /* right edge */
-        if (comb_mask[i - 2] && comb_mask[i - 1] && comb_mask[i])
-          block_scores[res_idx]++;
-        if (comb_mask[i - 1] && comb_mask[i])
-          block_scores[i / block_width]++;
-      } else if (comb_mask[i - 2] && comb_mask[i - 1] && comb_mask[i]) {
-        block_scores[res_idx]++;
-      }
-    }
-    /* advance down a line */
-    fjm2 = fjm1;
-    fjm1 = fj;
-    fj = fjp1;
-    fjp1 = fjm1 + stridex2;
-  }
+/* marks the samples of line fj that are combed, i.e. that differ from both of
+ * their vertical neighbours in the same direction by more than the spatial
+ * threshold and pass the test of the comb method:
+ * - 32detect was sourced from HandBrake but originally from transcode
+ * - isCombed was sourced from HandBrake but originally from tritical's
+ *   isCombedT Avisynth function
+ * - 5-tap is the [1,-3,4,-3,1] filter of opposite_parity_5_tap
+ * The lines are contiguous luma samples, see luma_line(). The spatial
+ * threshold must be lower than 255. */
+static void
+comb_mask_line (GstFieldAnalysis * filter, guint8 * comb_mask,
+    const guint8 * fjm2, const guint8 * fjm1, const guint8 * fj,
+    const guint8 * fjp1, const guint8 * fjp2, gint width)
+{
+  const gint spatial_thresh = filter->spatial_thresh;
 
-  block_score = 0;
-  for (i = 0; i < width / block_width; i++) {
-    if (block_scores[i] > block_score)
-      block_score = block_scores[i];
+  switch (filter->comb_method) {
+    case METHOD_32DETECT:
+      fieldanalysis_orc_comb_mask_32detect_planar_yuv (comb_mask, fjm2, fjm1,
+          fj, fjp1, spatial_thresh, -spatial_thresh, width);
+      break;
+    case METHOD_IS_COMBED:
+      fieldanalysis_orc_comb_mask_iscombed_planar_yuv (comb_mask, fjm1, fj,
+          fjp1, spatial_thresh, -spatial_thresh,
+          spatial_thresh * spatial_thresh, width);
+      break;
+    case METHOD_5_TAP:
+    default:
+      fieldanalysis_orc_comb_mask_5_tap_planar_yuv (comb_mask, fjm2, fjm1, fj,
+          fjp1, fjp2, spatial_thresh, -spatial_thresh, 6 * spatial_thresh,
+          width);
+      break;
   }
-
-  g_free (block_scores);
-  g_free (comb_mask);
-  return block_score;
 }
 
-/* this metric was sourced from HandBrake but originally from
- * tritical's isCombedT Avisynth function
- * the return value is the highest block score for the row of blocks */
-static inline guint64
-block_score_for_row_iscombed (GstFieldAnalysis * filter,
-    FieldAnalysisFields (*history)[2], guint8 * base_fj, guint8 * base_fjp1)
+/* if the samples to the left and right of a combed sample are combed, it
+ * contributes to the score of its block. the samples at the edges only need
+ * their one neighbour to be combed. */
+static void
+add_block_scores (guint * block_scores, const guint8 * comb_mask, gint width,
+    gint block_width)
 {
-  guint64 i, j;
-  guint8 *comb_mask = filter->comb_mask;
-  guint *block_scores = filter->block_scores;
-  guint64 block_score;
-  guint8 *fjm1, *fj, *fjp1;
-  const gint incr = GST_VIDEO_FRAME_COMP_PSTRIDE (&(*history)[0].frame, 0);
-  const gint stridex2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0) << 1;
-  const guint64 block_width = filter->block_width;
-  const guint64 block_height = filter->block_height;
-  const gint64 spatial_thresh = filter->spatial_thresh;
-  const gint64 spatial_thresh_squared = spatial_thresh * spatial_thresh;
-  const gint width =
-      GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame) -
-      (GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame) % block_width);
+  gint i, block;
+  const gint n_blocks = width / block_width;
 
-  fjm1 = base_fjp1 - stridex2;
-  fj = base_fj;
-  fjp1 = base_fjp1;
-
-  for (j = 0; j < block_height; j++) {
-    /* we have to work one result ahead of ourselves which results in some small
-     * peculiarities below */
-    gint diff1, diff2;
-
-    diff1 = fj[0] - fjm1[0];
-    diff2 = fj[0] - fjp1[0];
-    /* change in the same direction */
-    if ((diff1 > spatial_thresh && diff2 > spatial_thresh)
-        || (diff1 < -spatial_thresh && diff2 < -spatial_thresh)) {
-      comb_mask[0] =
-          (fjm1[0] - fj[0]) * (fjp1[0] - fj[0]) > spatial_thresh_squared;
-    } else {
-      comb_mask[0] = FALSE;
-    }
-
-    for (i = 1; i < width; i++) {
-      const guint64 idx = i * incr;
-      const guint64 res_idx = (i - 1) / block_width;
-
-      diff1 = fj[idx] - fjm1[idx];
-      diff2 = fj[idx] - fjp1[idx];
-      if ((diff1 > spatial_thresh && diff2 > spatial_thresh)
-          || (diff1 < -spatial_thresh && diff2 < -spatial_thresh)) {
-        comb_mask[i] =
-            (fjm1[idx] - fj[idx]) * (fjp1[idx] - fj[idx]) >
-            spatial_thresh_squared;
-      } else {
-        comb_mask[i] = FALSE;
-      }
+  if (width < 2)
+    return;
 
-      if (i == 1 && comb_mask[i - 1] && comb_mask[i]) {
-        /* left edge */
-        block_scores[res_idx]++;
-      } else if (i == width - 1) {
-        /* right edge */
-        if (comb_mask[i - 2] && comb_mask[i - 1] && comb_mask[i])
-          block_scores[res_idx]++;
-        if (comb_mask[i - 1] && comb_mask[i])
-          block_scores[i / block_width]++;
-      } else if (comb_mask[i - 2] && comb_mask[i - 1] && comb_mask[i]) {
-        block_scores[res_idx]++;
-      }
-    }
-    /* advance down a line */
-    fjm1 = fj;
-    fj = fjp1;
-    fjp1 = fjm1 + stridex2;
-  }
+  block_scores[0] += comb_mask[0] & comb_mask[1];
+  for (block = 0, i = 1; block < n_blocks; block++) {
+    const gint end = MIN ((block + 1) * block_width, width - 1);
+    guint score = 0;
 
-  block_score = 0;
-  for (i = 0; i < width / block_width; i++) {
-    if (block_scores[i] > block_score)
-      block_score = block_scores[i];
+    for (; i < end; i++)
+      score += comb_mask[i - 1] & comb_mask[i] & comb_mask[i + 1];
+    block_scores[block] += score;
   }
-
-  g_free (block_scores);
-  g_free (comb_mask);
-  return block_score;
+  block_scores[n_blocks - 1] += comb_mask[width - 2] & comb_mask[width - 1];
 }
 
-/* this metric was sourced from HandBrake but originally from
- * tritical's isCombedT Avisynth function
- * the return value is the highest block score for the row of blocks */
-static inline guint64
-block_score_for_row_5_tap (GstFieldAnalysis * filter,
-    FieldAnalysisFields (*history)[2], guint8 * base_fj, guint8 * base_fjp1)
+/* the return value is the highest block score for the rows of blocks
+ * [start, end), or the first one above the threshold */
+static guint64
+opposite_parity_windowed_comb_rows (GstFieldAnalysis * filter,
+    FieldAnalysisFields (*history)[2], guint start, guint end)
 {
+  guint r;
   guint64 i, j;
-  guint8 *comb_mask = filter->comb_mask;
-  guint *block_scores = filter->block_scores;
-  guint64 block_score;
-  guint8 *fjm2, *fjm1, *fj, *fjp1, *fjp2;
-  const gint incr = GST_VIDEO_FRAME_COMP_PSTRIDE (&(*history)[0].frame, 0);
-  const gint stridex2 =
-      GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0) << 1;
+  guint8 *comb_mask, *luma_cache;
+  guint64 cached_lines[COMB_MASK_LINES];
+  guint *block_scores;
+  guint64 block_score = 0;
+
   const guint64 block_width = filter->block_width;
   const guint64 block_height = filter->block_height;
-  const gint64 spatial_thresh = filter->spatial_thresh;
-  const gint64 spatial_threshx6 = 6 * spatial_thresh;
   const gint width =
       GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame) -
       (GST_VIDEO_FRAME_WIDTH (&(*history)[0].frame) % block_width);
-
-
-  fjm2 = base_fj - stridex2;
-  fjm1 = base_fjp1 - stridex2;
-  fj = base_fj;
-  fjp1 = base_fjp1;
-  fjp2 = fj + stridex2;
-
-  for (j = 0; j < block_height; j++) {
-    /* we have to work one result ahead of ourselves which results in some small
-     * peculiarities below */
-    gint diff1, diff2;
-
-    diff1 = fj[0] - fjm1[0];
-    diff2 = fj[0] - fjp1[0];
-    /* change in the same direction */
-    if ((diff1 > spatial_thresh && diff2 > spatial_thresh)
-        || (diff1 < -spatial_thresh && diff2 < -spatial_thresh)) {
-      comb_mask[0] =
-          abs (fjm2[0] + (fj[0] << 2) + fjp2[0] - 3 * (fjm1[0] + fjp1[0])) >
-          spatial_threshx6;
-
-      /* motion detection that needs previous and next frames
-         this isn't really necessary, but acts as an optimisation if the
-         additional delay isn't a problem
-         if (motion_detection) {
-         if (abs(fpj[idx] - fj[idx]               ) > motion_thresh &&
-         abs(           fjm1[idx] - fnjm1[idx]) > motion_thresh &&
-         abs(           fjp1[idx] - fnjp1[idx]) > motion_thresh)
-         motion++;
-         if (abs(             fj[idx]   - fnj[idx]) > motion_thresh &&
-         abs(fpjm1[idx] - fjm1[idx]           ) > motion_thresh &&
-         abs(fpjp1[idx] - fjp1[idx]           ) > motion_thresh)
-         motion++;
-         } else {
-         motion = 1;
-         }
-       */
-    } else {
-      comb_mask[0] = FALSE;
+  const guint64 n_blocks = width / block_width;
+
+  if (n_blocks == 0)
+    return 0;
+
+  comb_mask = g_malloc (width);
+  luma_cache = g_malloc (COMB_MASK_LINES * width);
+  for (i = 0; i < COMB_MASK_LINES; i++)
+    cached_lines[i] = G_MAXUINT64;
+  block_scores = g_new (guint, n_blocks);
+
+  for (r = start; r < end; r++) {
+    const guint64 first_line = filter->ignored_lines + r * block_height;
+
+    memset (block_scores, 0, n_blocks * sizeof (guint));
+    for (j = first_line; j < first_line + block_height; j++) {
+      comb_mask_line (filter, comb_mask,
+          luma_line (history, j - 2, luma_cache, cached_lines, width),
+          luma_line (history, j - 1, luma_cache, cached_lines, width),
+          luma_line (history, j, luma_cache, cached_lines, width),
+          luma_line (history, j + 1, luma_cache, cached_lines, width),
+          luma_line (history, j + 2, luma_cache, cached_lines, width), width);
+      add_block_scores (block_scores, comb_mask, width, block_width);
     }
 
-    for (i = 1; i < width; i++) {
-      const guint64 idx = i * incr;
-      const guint64 res_idx = (i - 1) / block_width;
-
-      diff1 = fj[idx] - fjm1[idx];
-      diff2 = fj[idx] - fjp1[idx];
-      if ((diff1 > spatial_thresh && diff2 > spatial_thresh)
-          || (diff1 < -spatial_thresh && diff2 < -spatial_thresh)) {
-        comb_mask[i] =
-            abs (fjm2[idx] + (fj[idx] << 2) + fjp2[idx] - 3 * (fjm1[idx] +
-                fjp1[idx])) > spatial_threshx6;
-      } else {
-        comb_mask[i] = FALSE;
-      }
-
-      if (i == 1 && comb_mask[i - 1] && comb_mask[i]) {
-        /* left edge */
-        block_scores[res_idx]++;
-      } else if (i == width - 1) {
-        /* right edge */
-        if (comb_mask[i - 2] && comb_mask[i - 1] && comb_mask[i])
-          block_scores[res_idx]++;
-        if (comb_mask[i - 1] && comb_mask[i])
-          block_scores[i / block_width]++;
-      } else if (comb_mask[i - 2] && comb_mask[i - 1] && comb_mask[i]) {
-        block_scores[res_idx]++;
-      }
+    for (i = 0; i < n_blocks; i++) {
+      if (block_scores[i] > block_score)
+        block_score = block_scores[i];
     }
-    /* advance down a line */
-    fjm2 = fjm1;
-    fjm1 = fj;
-    fj = fjp1;
-    fjp1 = fjp2;
-    fjp2 = fj + stridex2;
-  }
-
-  block_score = 0;
-  for (i = 0; i < width / block_width; i++) {
-    if (block_scores[i] > block_score)
-      block_score = block_scores[i];
+    /* the frame is combed whatever the other rows of blocks look like */
+    if (block_score > filter->block_thresh)
+      break;
   }
 
   g_free (block_scores);
+  g_free (luma_cache);
   g_free (comb_mask);
   return block_score;
 }
@@ -1331,57 +1220,38 @@ static gfloat
 opposite_parity_windowed_comb (GstFieldAnalysis * filter,
     FieldAnalysisFields (*history)[2])
 {
-  gint j;
-  gboolean slightly_combed;
+  guint n_rows;
+  guint64 block_score;
 
-  const gint height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
-  const gint stride = GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0);
+  const guint64 height = GST_VIDEO_FRAME_HEIGHT (&(*history)[0].frame);
   const guint64 block_thresh = filter->block_thresh;
   const guint64 block_height = filter->block_height;
-  guint8 *base_fj, *base_fjp1;
-
-  if ((*history)[0].parity == TOP_FIELD) {
-    base_fj =
-        GST_VIDEO_FRAME_COMP_DATA (&(*history)[0].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[0].frame, 0);
-    base_fjp1 =
-        GST_VIDEO_FRAME_COMP_DATA (&(*history)[1].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[1].frame,
-        0) + GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[1].frame, 0);
-  } else {
-    base_fj =
-        GST_VIDEO_FRAME_COMP_DATA (&(*history)[1].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[1].frame, 0);
-    base_fjp1 =
-        GST_VIDEO_FRAME_COMP_DATA (&(*history)[0].frame,
-        0) + GST_VIDEO_FRAME_COMP_OFFSET (&(*history)[0].frame,
-        0) + GST_VIDEO_FRAME_COMP_STRIDE (&(*history)[0].frame, 0);
-  }
+  const guint64 ignored_lines = filter->ignored_lines;
 
-  /* we operate on a row of blocks of height block_height through each iteration */
-  slightly_combed = FALSE;
-  for (j = 0; j <= height - filter->ignored_lines - block_height;
-      j += block_height) {
-    guint64 line_offset = (filter->ignored_lines + j) * stride;
-    guint block_score =
-        filter->block_score_for_row (filter, history, base_fj + line_offset,
-        base_fjp1 + line_offset);
-
-    if (block_score > (block_thresh >> 1)
-        && block_score <= block_thresh) {
-      /* blend if nothing more combed comes along */
-      slightly_combed = TRUE;
-    } else if (block_score > block_thresh) {
-      if (GST_VIDEO_INFO_INTERLACE_MODE (&(*history)[0].frame.info) ==
-          GST_VIDEO_INTERLACE_MODE_INTERLEAVED) {
-        return 1.0f;            /* blend */
-      } else {
-        return 2.0f;            /* deinterlace */
-      }
+  /* differences between samples can't be above this threshold */
+  if (filter->spatial_thresh >= 255 || block_height == 0)
+    return 0.0f;
+
+  /* we operate on rows of blocks of height block_height, leaving out the
+   * ignored lines at the top and bottom */
+  if (height < 2 * ignored_lines + block_height)
+    return 0.0f;
+  n_rows = (height - 2 * ignored_lines - block_height) / block_height + 1;
+
+  block_score = gst_field_analysis_run_stripes (filter, history,
+      opposite_parity_windowed_comb_rows, n_rows, 1, TRUE);
+
+  if (block_score > block_thresh) {
+    if (GST_VIDEO_INFO_INTERLACE_MODE (&(*history)[0].frame.info) ==
+        GST_VIDEO_INTERLACE_MODE_INTERLEAVED) {
+      return 1.0f;              /* blend */
+    } else {
+      return 2.0f;              /* deinterlace */
     }
   }
 
-  return (gfloat) slightly_combed;      /* TRUE means blend, else don't */
+  /* blend if the block is slightly combed */
+  return (gfloat) (block_score > (block_thresh >> 1));
 }
 
 /* this is where the magic happens
@@ -1832,6 +1702,8 @@ gst_field_analysis_finalize (GObject * object)
 
   gst_field_analysis_reset (filter);
 
+  gst_stripe_runner_free (filter->stripe_runner);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -45,6 +45,7 @@
 #define __GST_FIELDANALYSIS_H__
 
 #include <gst/gst.h>
+#include <gst/base/gststriperunner.h>
 
 G_BEGIN_DECLS
 #define GST_TYPE_FIELDANALYSIS \
@@ -119,12 +120,10 @@ struct _GstFieldAnalysis
   GstVideoInfo vinfo;
   gfloat (*same_field) (GstFieldAnalysis *, FieldAnalysisFields (*)[2]);
   gfloat (*same_frame) (GstFieldAnalysis *, FieldAnalysisFields (*)[2]);
-  guint64 (*block_score_for_row) (GstFieldAnalysis *, FieldAnalysisFields (*)[2], guint8 *, guint8 *);
+  FieldAnalysisCombMethod comb_method;
   gboolean is_telecine;
   gboolean first_buffer; /* indicates the first buffer for which a buffer will be output
                           * after a discont or flushing seek */
-  guint8 *comb_mask;
-  guint *block_scores;
   gboolean flushing;     /* indicates whether we are flushing or not */
 
   /* properties */
@@ -135,6 +134,10 @@ struct _GstFieldAnalysis
   guint64 block_width, block_height; /* width/height of window used for comb clusted detection */
   guint64 block_thresh;
   guint64 ignored_lines;
+  guint n_threads; /* maximum number of threads computing a metric, 0 for one per processor */
+
+  /* computes the metrics in stripes of rows on other threads */
+  GstStripeRunner *stripe_runner;
 };
 
 struct _GstFieldAnalysisClass
@@ -111,6 +111,22 @@ void fieldanalysis_orc_opposite_parity_5_tap_planar_yuv (guint32 *
     const orc_uint8 * ORC_RESTRICT s2, const orc_uint8 * ORC_RESTRICT s3,
     const orc_uint8 * ORC_RESTRICT s4, const orc_uint8 * ORC_RESTRICT s5,
     int p1, int n);
+void fieldanalysis_orc_comb_mask_32detect_planar_yuv (orc_uint8 *
+    ORC_RESTRICT d1, const orc_uint8 * ORC_RESTRICT s1,
+    const orc_uint8 * ORC_RESTRICT s2, const orc_uint8 * ORC_RESTRICT s3,
+    const orc_uint8 * ORC_RESTRICT s4, int p1, int p2, int n);
+void fieldanalysis_orc_comb_mask_iscombed_planar_yuv (orc_uint8 *
+    ORC_RESTRICT d1, const orc_uint8 * ORC_RESTRICT s1,
+    const orc_uint8 * ORC_RESTRICT s2, const orc_uint8 * ORC_RESTRICT s3,
+    int p1, int p2, int p3, int n);
+void fieldanalysis_orc_comb_mask_5_tap_planar_yuv (orc_uint8 * ORC_RESTRICT d1,
+    const orc_uint8 * ORC_RESTRICT s1, const orc_uint8 * ORC_RESTRICT s2,
+    const orc_uint8 * ORC_RESTRICT s3, const orc_uint8 * ORC_RESTRICT s4,
+    const orc_uint8 * ORC_RESTRICT s5, int p1, int p2, int p3, int n);
+void fieldanalysis_orc_select0_packed_yuv (guint8 * ORC_RESTRICT d1,
+    const guint16 * ORC_RESTRICT s1, int n);
+void fieldanalysis_orc_select1_packed_yuv (guint8 * ORC_RESTRICT d1,
+    const guint16 * ORC_RESTRICT s1, int n);
 
 
 /* begin Orc C target preamble */
@@ -1181,3 +1197,1381 @@ fieldanalysis_orc_opposite_parity_5_tap_planar_yuv (guint32 * ORC_RESTRICT a1,
   *a1 = orc_executor_get_accumulator (ex, ORC_VAR_A1);
 }
 #endif
+
+
+/* fieldanalysis_orc_comb_mask_32detect_planar_yuv */
+#ifdef DISABLE_ORC
+void
+fieldanalysis_orc_comb_mask_32detect_planar_yuv (orc_uint8 * ORC_RESTRICT d1,
+    const orc_uint8 * ORC_RESTRICT s1, const orc_uint8 * ORC_RESTRICT s2,
+    const orc_uint8 * ORC_RESTRICT s3, const orc_uint8 * ORC_RESTRICT s4,
+    int p1, int p2, int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  const orc_int8 *ORC_RESTRICT ptr7;
+  orc_int8 var37;
+  orc_int8 var38;
+  orc_int8 var39;
+  orc_union16 var40;
+  orc_union16 var41;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var42;
+#else
+  orc_union16 var42;
+#endif
+  orc_int8 var43;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var44;
+#else
+  orc_union16 var44;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var45;
+#else
+  orc_union16 var45;
+#endif
+  orc_int8 var46;
+  orc_union16 var47;
+  orc_union16 var48;
+  orc_union16 var49;
+  orc_union16 var50;
+  orc_union16 var51;
+  orc_union16 var52;
+  orc_union16 var53;
+  orc_union16 var54;
+  orc_union16 var55;
+  orc_union16 var56;
+  orc_union16 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+  orc_union16 var63;
+  orc_union16 var64;
+  orc_union16 var65;
+  orc_union16 var66;
+  orc_union16 var67;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr4 = (orc_int8 *) s1;
+  ptr5 = (orc_int8 *) s2;
+  ptr6 = (orc_int8 *) s3;
+  ptr7 = (orc_int8 *) s4;
+
+  /* 8: loadpw */
+  var40.i = p1;
+  /* 12: loadpw */
+  var41.i = p2;
+  /* 18: loadpw */
+  var42.i = (int) 0x0000000f;   /* 15 or 7.41098e-323f */
+  /* 25: loadpw */
+  var44.i = (int) 0x0000000a;   /* 10 or 4.94066e-323f */
+  /* 28: loadpw */
+  var45.i = (int) 0x00000001;   /* 1 or 4.94066e-324f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var37 = ptr6[i];
+    /* 1: convubw */
+    var47.i = (orc_uint8) var37;
+    /* 2: loadb */
+    var38 = ptr5[i];
+    /* 3: convubw */
+    var48.i = (orc_uint8) var38;
+    /* 4: subw */
+    var49.i = var47.i - var48.i;
+    /* 5: loadb */
+    var39 = ptr7[i];
+    /* 6: convubw */
+    var50.i = (orc_uint8) var39;
+    /* 7: subw */
+    var51.i = var47.i - var50.i;
+    /* 9: cmpgtsw */
+    var52.i = (var49.i > var40.i) ? (~0) : 0;
+    /* 10: cmpgtsw */
+    var53.i = (var51.i > var40.i) ? (~0) : 0;
+    /* 11: andw */
+    var54.i = var52.i & var53.i;
+    /* 13: cmpgtsw */
+    var55.i = (var41.i > var49.i) ? (~0) : 0;
+    /* 14: cmpgtsw */
+    var56.i = (var41.i > var51.i) ? (~0) : 0;
+    /* 15: andw */
+    var57.i = var55.i & var56.i;
+    /* 16: orw */
+    var58.i = var54.i | var57.i;
+    /* 17: absw */
+    var59.i = ORC_ABS (var49.i);
+    /* 19: cmpgtsw */
+    var60.i = (var59.i > var42.i) ? (~0) : 0;
+    /* 20: andw */
+    var61.i = var58.i & var60.i;
+    /* 21: loadb */
+    var43 = ptr4[i];
+    /* 22: convubw */
+    var62.i = (orc_uint8) var43;
+    /* 23: subw */
+    var63.i = var47.i - var62.i;
+    /* 24: absw */
+    var64.i = ORC_ABS (var63.i);
+    /* 26: cmpgtsw */
+    var65.i = (var44.i > var64.i) ? (~0) : 0;
+    /* 27: andw */
+    var66.i = var61.i & var65.i;
+    /* 29: andw */
+    var67.i = var66.i & var45.i;
+    /* 30: convsuswb */
+    var46 = ORC_CLAMP_UB (var67.i);
+    /* 31: storeb */
+    ptr0[i] = var46;
+  }
+
+}
+
+#else
+static void
+_backup_fieldanalysis_orc_comb_mask_32detect_planar_yuv (OrcExecutor *
+    ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  const orc_int8 *ORC_RESTRICT ptr7;
+  orc_int8 var37;
+  orc_int8 var38;
+  orc_int8 var39;
+  orc_union16 var40;
+  orc_union16 var41;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var42;
+#else
+  orc_union16 var42;
+#endif
+  orc_int8 var43;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var44;
+#else
+  orc_union16 var44;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var45;
+#else
+  orc_union16 var45;
+#endif
+  orc_int8 var46;
+  orc_union16 var47;
+  orc_union16 var48;
+  orc_union16 var49;
+  orc_union16 var50;
+  orc_union16 var51;
+  orc_union16 var52;
+  orc_union16 var53;
+  orc_union16 var54;
+  orc_union16 var55;
+  orc_union16 var56;
+  orc_union16 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+  orc_union16 var63;
+  orc_union16 var64;
+  orc_union16 var65;
+  orc_union16 var66;
+  orc_union16 var67;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr4 = (orc_int8 *) ex->arrays[4];
+  ptr5 = (orc_int8 *) ex->arrays[5];
+  ptr6 = (orc_int8 *) ex->arrays[6];
+  ptr7 = (orc_int8 *) ex->arrays[7];
+
+  /* 8: loadpw */
+  var40.i = ex->params[24];
+  /* 12: loadpw */
+  var41.i = ex->params[25];
+  /* 18: loadpw */
+  var42.i = (int) 0x0000000f;   /* 15 or 7.41098e-323f */
+  /* 25: loadpw */
+  var44.i = (int) 0x0000000a;   /* 10 or 4.94066e-323f */
+  /* 28: loadpw */
+  var45.i = (int) 0x00000001;   /* 1 or 4.94066e-324f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var37 = ptr6[i];
+    /* 1: convubw */
+    var47.i = (orc_uint8) var37;
+    /* 2: loadb */
+    var38 = ptr5[i];
+    /* 3: convubw */
+    var48.i = (orc_uint8) var38;
+    /* 4: subw */
+    var49.i = var47.i - var48.i;
+    /* 5: loadb */
+    var39 = ptr7[i];
+    /* 6: convubw */
+    var50.i = (orc_uint8) var39;
+    /* 7: subw */
+    var51.i = var47.i - var50.i;
+    /* 9: cmpgtsw */
+    var52.i = (var49.i > var40.i) ? (~0) : 0;
+    /* 10: cmpgtsw */
+    var53.i = (var51.i > var40.i) ? (~0) : 0;
+    /* 11: andw */
+    var54.i = var52.i & var53.i;
+    /* 13: cmpgtsw */
+    var55.i = (var41.i > var49.i) ? (~0) : 0;
+    /* 14: cmpgtsw */
+    var56.i = (var41.i > var51.i) ? (~0) : 0;
+    /* 15: andw */
+    var57.i = var55.i & var56.i;
+    /* 16: orw */
+    var58.i = var54.i | var57.i;
+    /* 17: absw */
+    var59.i = ORC_ABS (var49.i);
+    /* 19: cmpgtsw */
+    var60.i = (var59.i > var42.i) ? (~0) : 0;
+    /* 20: andw */
+    var61.i = var58.i & var60.i;
+    /* 21: loadb */
+    var43 = ptr4[i];
+    /* 22: convubw */
+    var62.i = (orc_uint8) var43;
+    /* 23: subw */
+    var63.i = var47.i - var62.i;
+    /* 24: absw */
+    var64.i = ORC_ABS (var63.i);
+    /* 26: cmpgtsw */
+    var65.i = (var44.i > var64.i) ? (~0) : 0;
+    /* 27: andw */
+    var66.i = var61.i & var65.i;
+    /* 29: andw */
+    var67.i = var66.i & var45.i;
+    /* 30: convsuswb */
+    var46 = ORC_CLAMP_UB (var67.i);
+    /* 31: storeb */
+    ptr0[i] = var46;
+  }
+
+}
+
+void
+fieldanalysis_orc_comb_mask_32detect_planar_yuv (orc_uint8 * ORC_RESTRICT d1,
+    const orc_uint8 * ORC_RESTRICT s1, const orc_uint8 * ORC_RESTRICT s2,
+    const orc_uint8 * ORC_RESTRICT s3, const orc_uint8 * ORC_RESTRICT s4,
+    int p1, int p2, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 47, 102, 105, 101, 108, 100, 97, 110, 97, 108, 121, 115, 105, 115,
+        95, 111, 114, 99, 95, 99, 111, 109, 98, 95, 109, 97, 115, 107, 95, 51,
+        50, 100, 101, 116, 101, 99, 116, 95, 112, 108, 97, 110, 97, 114, 95,
+            121,
+        117, 118, 11, 1, 1, 12, 1, 1, 12, 1, 1, 12, 1, 1, 12, 1,
+        1, 14, 2, 15, 0, 0, 0, 14, 2, 10, 0, 0, 0, 14, 2, 1,
+        0, 0, 0, 16, 2, 16, 2, 20, 2, 20, 2, 20, 2, 20, 2, 20,
+        2, 150, 32, 6, 150, 33, 5, 98, 33, 32, 33, 150, 34, 7, 98, 34,
+        32, 34, 78, 35, 33, 24, 78, 36, 34, 24, 73, 35, 35, 36, 78, 36,
+        25, 33, 78, 34, 25, 34, 73, 36, 36, 34, 92, 35, 35, 36, 69, 33,
+        33, 78, 33, 33, 16, 73, 35, 35, 33, 150, 34, 4, 98, 34, 32, 34,
+        69, 34, 34, 78, 34, 17, 34, 73, 35, 35, 34, 73, 35, 35, 18, 160,
+        0, 35, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p,
+          _backup_fieldanalysis_orc_comb_mask_32detect_planar_yuv);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p,
+          "fieldanalysis_orc_comb_mask_32detect_planar_yuv");
+      orc_program_set_backup_function (p,
+          _backup_fieldanalysis_orc_comb_mask_32detect_planar_yuv);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_source (p, 1, "s1");
+      orc_program_add_source (p, 1, "s2");
+      orc_program_add_source (p, 1, "s3");
+      orc_program_add_source (p, 1, "s4");
+      orc_program_add_constant (p, 2, 0x0000000f, "c1");
+      orc_program_add_constant (p, 2, 0x0000000a, "c2");
+      orc_program_add_constant (p, 2, 0x00000001, "c3");
+      orc_program_add_parameter (p, 2, "p1");
+      orc_program_add_parameter (p, 2, "p2");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 2, "t3");
+      orc_program_add_temporary (p, 2, "t4");
+      orc_program_add_temporary (p, 2, "t5");
+
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T1, ORC_VAR_S3, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T2, ORC_VAR_S2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T3, ORC_VAR_S4, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T4, ORC_VAR_T2, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T5, ORC_VAR_T3, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T4, ORC_VAR_T4, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T5, ORC_VAR_P2, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T3, ORC_VAR_P2, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T5, ORC_VAR_T5, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "orw", 0, ORC_VAR_T4, ORC_VAR_T4, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "absw", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T4, ORC_VAR_T4, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T3, ORC_VAR_S1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "absw", 0, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T3, ORC_VAR_C2, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T4, ORC_VAR_T4, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T4, ORC_VAR_T4, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 0, ORC_VAR_D1, ORC_VAR_T4,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+  ex->params[ORC_VAR_P1] = p1;
+  ex->params[ORC_VAR_P2] = p2;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* fieldanalysis_orc_comb_mask_iscombed_planar_yuv */
+#ifdef DISABLE_ORC
+void
+fieldanalysis_orc_comb_mask_iscombed_planar_yuv (orc_uint8 * ORC_RESTRICT d1,
+    const orc_uint8 * ORC_RESTRICT s1, const orc_uint8 * ORC_RESTRICT s2,
+    const orc_uint8 * ORC_RESTRICT s3, int p1, int p2, int p3, int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  orc_int8 var38;
+  orc_int8 var39;
+  orc_int8 var40;
+  orc_union16 var41;
+  orc_union16 var42;
+  orc_union32 var43;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var44;
+#else
+  orc_union16 var44;
+#endif
+  orc_int8 var45;
+  orc_union16 var46;
+  orc_union16 var47;
+  orc_union16 var48;
+  orc_union16 var49;
+  orc_union16 var50;
+  orc_union16 var51;
+  orc_union16 var52;
+  orc_union16 var53;
+  orc_union16 var54;
+  orc_union16 var55;
+  orc_union16 var56;
+  orc_union16 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr4 = (orc_int8 *) s1;
+  ptr5 = (orc_int8 *) s2;
+  ptr6 = (orc_int8 *) s3;
+
+  /* 8: loadpw */
+  var41.i = p1;
+  /* 12: loadpw */
+  var42.i = p2;
+  /* 18: loadpl */
+  var43.i = p3;
+  /* 22: loadpw */
+  var44.i = (int) 0x00000001;   /* 1 or 4.94066e-324f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var38 = ptr5[i];
+    /* 1: convubw */
+    var46.i = (orc_uint8) var38;
+    /* 2: loadb */
+    var39 = ptr4[i];
+    /* 3: convubw */
+    var47.i = (orc_uint8) var39;
+    /* 4: subw */
+    var48.i = var46.i - var47.i;
+    /* 5: loadb */
+    var40 = ptr6[i];
+    /* 6: convubw */
+    var49.i = (orc_uint8) var40;
+    /* 7: subw */
+    var50.i = var46.i - var49.i;
+    /* 9: cmpgtsw */
+    var51.i = (var48.i > var41.i) ? (~0) : 0;
+    /* 10: cmpgtsw */
+    var52.i = (var50.i > var41.i) ? (~0) : 0;
+    /* 11: andw */
+    var53.i = var51.i & var52.i;
+    /* 13: cmpgtsw */
+    var54.i = (var42.i > var48.i) ? (~0) : 0;
+    /* 14: cmpgtsw */
+    var55.i = (var42.i > var50.i) ? (~0) : 0;
+    /* 15: andw */
+    var56.i = var54.i & var55.i;
+    /* 16: orw */
+    var57.i = var53.i | var56.i;
+    /* 17: mulswl */
+    var58.i = var48.i * var50.i;
+    /* 19: cmpgtsl */
+    var59.i = (var58.i > var43.i) ? (~0) : 0;
+    /* 20: convssslw */
+    var60.i = ORC_CLAMP_SW (var59.i);
+    /* 21: andw */
+    var61.i = var57.i & var60.i;
+    /* 23: andw */
+    var62.i = var61.i & var44.i;
+    /* 24: convsuswb */
+    var45 = ORC_CLAMP_UB (var62.i);
+    /* 25: storeb */
+    ptr0[i] = var45;
+  }
+
+}
+
+#else
+static void
+_backup_fieldanalysis_orc_comb_mask_iscombed_planar_yuv (OrcExecutor *
+    ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  orc_int8 var38;
+  orc_int8 var39;
+  orc_int8 var40;
+  orc_union16 var41;
+  orc_union16 var42;
+  orc_union32 var43;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var44;
+#else
+  orc_union16 var44;
+#endif
+  orc_int8 var45;
+  orc_union16 var46;
+  orc_union16 var47;
+  orc_union16 var48;
+  orc_union16 var49;
+  orc_union16 var50;
+  orc_union16 var51;
+  orc_union16 var52;
+  orc_union16 var53;
+  orc_union16 var54;
+  orc_union16 var55;
+  orc_union16 var56;
+  orc_union16 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr4 = (orc_int8 *) ex->arrays[4];
+  ptr5 = (orc_int8 *) ex->arrays[5];
+  ptr6 = (orc_int8 *) ex->arrays[6];
+
+  /* 8: loadpw */
+  var41.i = ex->params[24];
+  /* 12: loadpw */
+  var42.i = ex->params[25];
+  /* 18: loadpl */
+  var43.i = ex->params[26];
+  /* 22: loadpw */
+  var44.i = (int) 0x00000001;   /* 1 or 4.94066e-324f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var38 = ptr5[i];
+    /* 1: convubw */
+    var46.i = (orc_uint8) var38;
+    /* 2: loadb */
+    var39 = ptr4[i];
+    /* 3: convubw */
+    var47.i = (orc_uint8) var39;
+    /* 4: subw */
+    var48.i = var46.i - var47.i;
+    /* 5: loadb */
+    var40 = ptr6[i];
+    /* 6: convubw */
+    var49.i = (orc_uint8) var40;
+    /* 7: subw */
+    var50.i = var46.i - var49.i;
+    /* 9: cmpgtsw */
+    var51.i = (var48.i > var41.i) ? (~0) : 0;
+    /* 10: cmpgtsw */
+    var52.i = (var50.i > var41.i) ? (~0) : 0;
+    /* 11: andw */
+    var53.i = var51.i & var52.i;
+    /* 13: cmpgtsw */
+    var54.i = (var42.i > var48.i) ? (~0) : 0;
+    /* 14: cmpgtsw */
+    var55.i = (var42.i > var50.i) ? (~0) : 0;
+    /* 15: andw */
+    var56.i = var54.i & var55.i;
+    /* 16: orw */
+    var57.i = var53.i | var56.i;
+    /* 17: mulswl */
+    var58.i = var48.i * var50.i;
+    /* 19: cmpgtsl */
+    var59.i = (var58.i > var43.i) ? (~0) : 0;
+    /* 20: convssslw */
+    var60.i = ORC_CLAMP_SW (var59.i);
+    /* 21: andw */
+    var61.i = var57.i & var60.i;
+    /* 23: andw */
+    var62.i = var61.i & var44.i;
+    /* 24: convsuswb */
+    var45 = ORC_CLAMP_UB (var62.i);
+    /* 25: storeb */
+    ptr0[i] = var45;
+  }
+
+}
+
+void
+fieldanalysis_orc_comb_mask_iscombed_planar_yuv (orc_uint8 * ORC_RESTRICT d1,
+    const orc_uint8 * ORC_RESTRICT s1, const orc_uint8 * ORC_RESTRICT s2,
+    const orc_uint8 * ORC_RESTRICT s3, int p1, int p2, int p3, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 47, 102, 105, 101, 108, 100, 97, 110, 97, 108, 121, 115, 105, 115,
+        95, 111, 114, 99, 95, 99, 111, 109, 98, 95, 109, 97, 115, 107, 95, 105,
+        115, 99, 111, 109, 98, 101, 100, 95, 112, 108, 97, 110, 97, 114, 95,
+            121,
+        117, 118, 11, 1, 1, 12, 1, 1, 12, 1, 1, 12, 1, 1, 14, 2,
+        1, 0, 0, 0, 16, 2, 16, 2, 16, 4, 20, 2, 20, 2, 20, 2,
+        20, 2, 20, 2, 20, 4, 150, 32, 5, 150, 33, 4, 98, 34, 32, 33,
+        150, 33, 6, 98, 35, 32, 33, 78, 32, 34, 24, 78, 33, 35, 24, 73,
+        32, 32, 33, 78, 33, 25, 34, 78, 36, 25, 35, 73, 33, 33, 36, 92,
+        32, 32, 33, 176, 37, 34, 35, 111, 37, 37, 26, 165, 33, 37, 73, 32,
+        32, 33, 73, 32, 32, 16, 160, 0, 32, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p,
+          _backup_fieldanalysis_orc_comb_mask_iscombed_planar_yuv);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p,
+          "fieldanalysis_orc_comb_mask_iscombed_planar_yuv");
+      orc_program_set_backup_function (p,
+          _backup_fieldanalysis_orc_comb_mask_iscombed_planar_yuv);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_source (p, 1, "s1");
+      orc_program_add_source (p, 1, "s2");
+      orc_program_add_source (p, 1, "s3");
+      orc_program_add_constant (p, 2, 0x00000001, "c1");
+      orc_program_add_parameter (p, 2, "p1");
+      orc_program_add_parameter (p, 2, "p2");
+      orc_program_add_parameter (p, 4, "p3");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 2, "t3");
+      orc_program_add_temporary (p, 2, "t4");
+      orc_program_add_temporary (p, 2, "t5");
+      orc_program_add_temporary (p, 4, "t6");
+
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T1, ORC_VAR_S2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T2, ORC_VAR_S1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T2, ORC_VAR_S3, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T4, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T1, ORC_VAR_T3, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T2, ORC_VAR_T4, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T2, ORC_VAR_P2, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T5, ORC_VAR_P2, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "orw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T6, ORC_VAR_T3, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsl", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_P3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convssslw", 0, ORC_VAR_T2, ORC_VAR_T6,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 0, ORC_VAR_D1, ORC_VAR_T1,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->params[ORC_VAR_P1] = p1;
+  ex->params[ORC_VAR_P2] = p2;
+  ex->params[ORC_VAR_P3] = p3;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* fieldanalysis_orc_comb_mask_5_tap_planar_yuv */
+#ifdef DISABLE_ORC
+void
+fieldanalysis_orc_comb_mask_5_tap_planar_yuv (orc_uint8 * ORC_RESTRICT d1,
+    const orc_uint8 * ORC_RESTRICT s1, const orc_uint8 * ORC_RESTRICT s2,
+    const orc_uint8 * ORC_RESTRICT s3, const orc_uint8 * ORC_RESTRICT s4,
+    const orc_uint8 * ORC_RESTRICT s5, int p1, int p2, int p3, int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  const orc_int8 *ORC_RESTRICT ptr7;
+  const orc_int8 *ORC_RESTRICT ptr8;
+  orc_int8 var39;
+  orc_int8 var40;
+  orc_int8 var41;
+  orc_union16 var42;
+  orc_union16 var43;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var44;
+#else
+  orc_union16 var44;
+#endif
+  orc_int8 var45;
+  orc_int8 var46;
+  orc_union16 var47;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var48;
+#else
+  orc_union16 var48;
+#endif
+  orc_int8 var49;
+  orc_union16 var50;
+  orc_union16 var51;
+  orc_union16 var52;
+  orc_union16 var53;
+  orc_union16 var54;
+  orc_union16 var55;
+  orc_union16 var56;
+  orc_union16 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+  orc_union16 var63;
+  orc_union16 var64;
+  orc_union16 var65;
+  orc_union16 var66;
+  orc_union16 var67;
+  orc_union16 var68;
+  orc_union16 var69;
+  orc_union16 var70;
+  orc_union16 var71;
+  orc_union16 var72;
+  orc_union16 var73;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr4 = (orc_int8 *) s1;
+  ptr5 = (orc_int8 *) s2;
+  ptr6 = (orc_int8 *) s3;
+  ptr7 = (orc_int8 *) s4;
+  ptr8 = (orc_int8 *) s5;
+
+  /* 8: loadpw */
+  var42.i = p1;
+  /* 12: loadpw */
+  var43.i = p2;
+  /* 18: loadpw */
+  var44.i = (int) 0x00000003;   /* 3 or 1.4822e-323f */
+  /* 29: loadpw */
+  var47.i = p3;
+  /* 32: loadpw */
+  var48.i = (int) 0x00000001;   /* 1 or 4.94066e-324f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var39 = ptr6[i];
+    /* 1: convubw */
+    var50.i = (orc_uint8) var39;
+    /* 2: loadb */
+    var40 = ptr5[i];
+    /* 3: convubw */
+    var51.i = (orc_uint8) var40;
+    /* 4: subw */
+    var52.i = var50.i - var51.i;
+    /* 5: loadb */
+    var41 = ptr7[i];
+    /* 6: convubw */
+    var53.i = (orc_uint8) var41;
+    /* 7: subw */
+    var54.i = var50.i - var53.i;
+    /* 9: cmpgtsw */
+    var55.i = (var52.i > var42.i) ? (~0) : 0;
+    /* 10: cmpgtsw */
+    var56.i = (var54.i > var42.i) ? (~0) : 0;
+    /* 11: andw */
+    var57.i = var55.i & var56.i;
+    /* 13: cmpgtsw */
+    var58.i = (var43.i > var52.i) ? (~0) : 0;
+    /* 14: cmpgtsw */
+    var59.i = (var43.i > var54.i) ? (~0) : 0;
+    /* 15: andw */
+    var60.i = var58.i & var59.i;
+    /* 16: orw */
+    var61.i = var57.i | var60.i;
+    /* 17: addw */
+    var62.i = var51.i + var53.i;
+    /* 19: mullw */
+    var63.i = (var62.i * var44.i) & 0xffff;
+    /* 20: shlw */
+    var64.i = ((orc_uint16) var50.i) << 2;
+    /* 21: loadb */
+    var45 = ptr4[i];
+    /* 22: convubw */
+    var65.i = (orc_uint8) var45;
+    /* 23: addw */
+    var66.i = var64.i + var65.i;
+    /* 24: loadb */
+    var46 = ptr8[i];
+    /* 25: convubw */
+    var67.i = (orc_uint8) var46;
+    /* 26: addw */
+    var68.i = var66.i + var67.i;
+    /* 27: subw */
+    var69.i = var68.i - var63.i;
+    /* 28: absw */
+    var70.i = ORC_ABS (var69.i);
+    /* 30: cmpgtsw */
+    var71.i = (var70.i > var47.i) ? (~0) : 0;
+    /* 31: andw */
+    var72.i = var61.i & var71.i;
+    /* 33: andw */
+    var73.i = var72.i & var48.i;
+    /* 34: convsuswb */
+    var49 = ORC_CLAMP_UB (var73.i);
+    /* 35: storeb */
+    ptr0[i] = var49;
+  }
+
+}
+
+#else
+static void
+_backup_fieldanalysis_orc_comb_mask_5_tap_planar_yuv (OrcExecutor *
+    ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  const orc_int8 *ORC_RESTRICT ptr7;
+  const orc_int8 *ORC_RESTRICT ptr8;
+  orc_int8 var39;
+  orc_int8 var40;
+  orc_int8 var41;
+  orc_union16 var42;
+  orc_union16 var43;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var44;
+#else
+  orc_union16 var44;
+#endif
+  orc_int8 var45;
+  orc_int8 var46;
+  orc_union16 var47;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var48;
+#else
+  orc_union16 var48;
+#endif
+  orc_int8 var49;
+  orc_union16 var50;
+  orc_union16 var51;
+  orc_union16 var52;
+  orc_union16 var53;
+  orc_union16 var54;
+  orc_union16 var55;
+  orc_union16 var56;
+  orc_union16 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+  orc_union16 var63;
+  orc_union16 var64;
+  orc_union16 var65;
+  orc_union16 var66;
+  orc_union16 var67;
+  orc_union16 var68;
+  orc_union16 var69;
+  orc_union16 var70;
+  orc_union16 var71;
+  orc_union16 var72;
+  orc_union16 var73;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr4 = (orc_int8 *) ex->arrays[4];
+  ptr5 = (orc_int8 *) ex->arrays[5];
+  ptr6 = (orc_int8 *) ex->arrays[6];
+  ptr7 = (orc_int8 *) ex->arrays[7];
+  ptr8 = (orc_int8 *) ex->arrays[8];
+
+  /* 8: loadpw */
+  var42.i = ex->params[24];
+  /* 12: loadpw */
+  var43.i = ex->params[25];
+  /* 18: loadpw */
+  var44.i = (int) 0x00000003;   /* 3 or 1.4822e-323f */
+  /* 29: loadpw */
+  var47.i = ex->params[26];
+  /* 32: loadpw */
+  var48.i = (int) 0x00000001;   /* 1 or 4.94066e-324f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var39 = ptr6[i];
+    /* 1: convubw */
+    var50.i = (orc_uint8) var39;
+    /* 2: loadb */
+    var40 = ptr5[i];
+    /* 3: convubw */
+    var51.i = (orc_uint8) var40;
+    /* 4: subw */
+    var52.i = var50.i - var51.i;
+    /* 5: loadb */
+    var41 = ptr7[i];
+    /* 6: convubw */
+    var53.i = (orc_uint8) var41;
+    /* 7: subw */
+    var54.i = var50.i - var53.i;
+    /* 9: cmpgtsw */
+    var55.i = (var52.i > var42.i) ? (~0) : 0;
+    /* 10: cmpgtsw */
+    var56.i = (var54.i > var42.i) ? (~0) : 0;
+    /* 11: andw */
+    var57.i = var55.i & var56.i;
+    /* 13: cmpgtsw */
+    var58.i = (var43.i > var52.i) ? (~0) : 0;
+    /* 14: cmpgtsw */
+    var59.i = (var43.i > var54.i) ? (~0) : 0;
+    /* 15: andw */
+    var60.i = var58.i & var59.i;
+    /* 16: orw */
+    var61.i = var57.i | var60.i;
+    /* 17: addw */
+    var62.i = var51.i + var53.i;
+    /* 19: mullw */
+    var63.i = (var62.i * var44.i) & 0xffff;
+    /* 20: shlw */
+    var64.i = ((orc_uint16) var50.i) << 2;
+    /* 21: loadb */
+    var45 = ptr4[i];
+    /* 22: convubw */
+    var65.i = (orc_uint8) var45;
+    /* 23: addw */
+    var66.i = var64.i + var65.i;
+    /* 24: loadb */
+    var46 = ptr8[i];
+    /* 25: convubw */
+    var67.i = (orc_uint8) var46;
+    /* 26: addw */
+    var68.i = var66.i + var67.i;
+    /* 27: subw */
+    var69.i = var68.i - var63.i;
+    /* 28: absw */
+    var70.i = ORC_ABS (var69.i);
+    /* 30: cmpgtsw */
+    var71.i = (var70.i > var47.i) ? (~0) : 0;
+    /* 31: andw */
+    var72.i = var61.i & var71.i;
+    /* 33: andw */
+    var73.i = var72.i & var48.i;
+    /* 34: convsuswb */
+    var49 = ORC_CLAMP_UB (var73.i);
+    /* 35: storeb */
+    ptr0[i] = var49;
+  }
+
+}
+
+void
+fieldanalysis_orc_comb_mask_5_tap_planar_yuv (orc_uint8 * ORC_RESTRICT d1,
+    const orc_uint8 * ORC_RESTRICT s1, const orc_uint8 * ORC_RESTRICT s2,
+    const orc_uint8 * ORC_RESTRICT s3, const orc_uint8 * ORC_RESTRICT s4,
+    const orc_uint8 * ORC_RESTRICT s5, int p1, int p2, int p3, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 44, 102, 105, 101, 108, 100, 97, 110, 97, 108, 121, 115, 105, 115,
+        95, 111, 114, 99, 95, 99, 111, 109, 98, 95, 109, 97, 115, 107, 95, 53,
+        95, 116, 97, 112, 95, 112, 108, 97, 110, 97, 114, 95, 121, 117, 118, 11,
+        1, 1, 12, 1, 1, 12, 1, 1, 12, 1, 1, 12, 1, 1, 12, 1,
+        1, 14, 2, 3, 0, 0, 0, 14, 2, 2, 0, 0, 0, 14, 2, 1,
+        0, 0, 0, 16, 2, 16, 2, 16, 2, 20, 2, 20, 2, 20, 2, 20,
+        2, 20, 2, 20, 2, 20, 2, 150, 32, 6, 150, 33, 5, 98, 34, 32,
+        33, 150, 35, 7, 98, 36, 32, 35, 78, 37, 34, 24, 78, 38, 36, 24,
+        73, 37, 37, 38, 78, 38, 25, 34, 78, 34, 25, 36, 73, 38, 38, 34,
+        92, 37, 37, 38, 70, 33, 33, 35, 89, 33, 33, 16, 93, 32, 32, 17,
+        150, 34, 4, 70, 32, 32, 34, 150, 34, 8, 70, 32, 32, 34, 98, 32,
+        32, 33, 69, 32, 32, 78, 32, 32, 26, 73, 37, 37, 32, 73, 37, 37,
+        18, 160, 0, 37, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p,
+          _backup_fieldanalysis_orc_comb_mask_5_tap_planar_yuv);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "fieldanalysis_orc_comb_mask_5_tap_planar_yuv");
+      orc_program_set_backup_function (p,
+          _backup_fieldanalysis_orc_comb_mask_5_tap_planar_yuv);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_source (p, 1, "s1");
+      orc_program_add_source (p, 1, "s2");
+      orc_program_add_source (p, 1, "s3");
+      orc_program_add_source (p, 1, "s4");
+      orc_program_add_source (p, 1, "s5");
+      orc_program_add_constant (p, 2, 0x00000003, "c1");
+      orc_program_add_constant (p, 2, 0x00000002, "c2");
+      orc_program_add_constant (p, 2, 0x00000001, "c3");
+      orc_program_add_parameter (p, 2, "p1");
+      orc_program_add_parameter (p, 2, "p2");
+      orc_program_add_parameter (p, 2, "p3");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 2, "t3");
+      orc_program_add_temporary (p, 2, "t4");
+      orc_program_add_temporary (p, 2, "t5");
+      orc_program_add_temporary (p, 2, "t6");
+      orc_program_add_temporary (p, 2, "t7");
+
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T1, ORC_VAR_S3, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T2, ORC_VAR_S2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T4, ORC_VAR_S4, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T5, ORC_VAR_T1, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T6, ORC_VAR_T3, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T7, ORC_VAR_P2, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T3, ORC_VAR_P2, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "orw", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shlw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T3, ORC_VAR_S1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T3, ORC_VAR_S5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "absw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_P3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_T1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 0, ORC_VAR_D1, ORC_VAR_T6,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+  ex->arrays[ORC_VAR_S5] = (void *) s5;
+  ex->params[ORC_VAR_P1] = p1;
+  ex->params[ORC_VAR_P2] = p2;
+  ex->params[ORC_VAR_P3] = p3;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* fieldanalysis_orc_select0_packed_yuv */
+#ifdef DISABLE_ORC
+void
+fieldanalysis_orc_select0_packed_yuv (guint8 * ORC_RESTRICT d1,
+    const guint16 * ORC_RESTRICT s1, int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union16 *ORC_RESTRICT ptr4;
+  orc_union16 var32;
+  orc_int8 var33;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr4 = (orc_union16 *) s1;
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var32 = ptr4[i];
+    /* 1: select0wb */
+    {
+      orc_union16 _src;
+      _src.i = var32.i;
+      var33 = _src.x2[0];
+    }
+    /* 2: storeb */
+    ptr0[i] = var33;
+  }
+
+}
+
+#else
+static void
+_backup_fieldanalysis_orc_select0_packed_yuv (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union16 *ORC_RESTRICT ptr4;
+  orc_union16 var32;
+  orc_int8 var33;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr4 = (orc_union16 *) ex->arrays[4];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var32 = ptr4[i];
+    /* 1: select0wb */
+    {
+      orc_union16 _src;
+      _src.i = var32.i;
+      var33 = _src.x2[0];
+    }
+    /* 2: storeb */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+fieldanalysis_orc_select0_packed_yuv (guint8 * ORC_RESTRICT d1,
+    const guint16 * ORC_RESTRICT s1, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 36, 102, 105, 101, 108, 100, 97, 110, 97, 108, 121, 115, 105, 115,
+        95, 111, 114, 99, 95, 115, 101, 108, 101, 99, 116, 48, 95, 112, 97, 99,
+        107, 101, 100, 95, 121, 117, 118, 11, 1, 1, 12, 2, 2, 188, 0, 4,
+        2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p,
+          _backup_fieldanalysis_orc_select0_packed_yuv);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "fieldanalysis_orc_select0_packed_yuv");
+      orc_program_set_backup_function (p,
+          _backup_fieldanalysis_orc_select0_packed_yuv);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_source (p, 2, "s1");
+
+      orc_program_append_2 (p, "select0wb", 0, ORC_VAR_D1, ORC_VAR_S1,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* fieldanalysis_orc_select1_packed_yuv */
+#ifdef DISABLE_ORC
+void
+fieldanalysis_orc_select1_packed_yuv (guint8 * ORC_RESTRICT d1,
+    const guint16 * ORC_RESTRICT s1, int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union16 *ORC_RESTRICT ptr4;
+  orc_union16 var32;
+  orc_int8 var33;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr4 = (orc_union16 *) s1;
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var32 = ptr4[i];
+    /* 1: select1wb */
+    {
+      orc_union16 _src;
+      _src.i = var32.i;
+      var33 = _src.x2[1];
+    }
+    /* 2: storeb */
+    ptr0[i] = var33;
+  }
+
+}
+
+#else
+static void
+_backup_fieldanalysis_orc_select1_packed_yuv (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union16 *ORC_RESTRICT ptr4;
+  orc_union16 var32;
+  orc_int8 var33;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr4 = (orc_union16 *) ex->arrays[4];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var32 = ptr4[i];
+    /* 1: select1wb */
+    {
+      orc_union16 _src;
+      _src.i = var32.i;
+      var33 = _src.x2[1];
+    }
+    /* 2: storeb */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+fieldanalysis_orc_select1_packed_yuv (guint8 * ORC_RESTRICT d1,
+    const guint16 * ORC_RESTRICT s1, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 36, 102, 105, 101, 108, 100, 97, 110, 97, 108, 121, 115, 105, 115,
+        95, 111, 114, 99, 95, 115, 101, 108, 101, 99, 116, 49, 95, 112, 97, 99,
+        107, 101, 100, 95, 121, 117, 118, 11, 1, 1, 12, 2, 2, 189, 0, 4,
+        2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p,
+          _backup_fieldanalysis_orc_select1_packed_yuv);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "fieldanalysis_orc_select1_packed_yuv");
+      orc_program_set_backup_function (p,
+          _backup_fieldanalysis_orc_select1_packed_yuv);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_source (p, 2, "s1");
+
+      orc_program_append_2 (p, "select1wb", 0, ORC_VAR_D1, ORC_VAR_S1,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
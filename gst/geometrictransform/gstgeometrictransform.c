@@ -49,9 +49,32 @@ static GstVideoFilterClass *parent_class = NULL;
 enum
 {
   PROP_0,
-  PROP_OFF_EDGE_PIXELS
+  PROP_OFF_EDGE_PIXELS,
+  PROP_INTERPOLATION,
+  PROP_N_THREADS
 };
 
+/* Bilinear weights are fixed point numbers with this many fractional bits */
+#define GT_WEIGHT_SHIFT 7
+#define GT_WEIGHT_ONE (1 << GT_WEIGHT_SHIFT)
+#define GT_WEIGHT_ROUND (1 << (2 * GT_WEIGHT_SHIFT - 1))
+
+/* Don't bother splitting frames into bands smaller than this */
+#define GT_MIN_BAND_HEIGHT 32
+
+/* Remaps one row of the output from its row of the map */
+typedef void (*GstGeometricTransformRowFunc) (GstGeometricTransform * gt,
+    const gint32 * map, const guint8 * weights, const guint8 * in_data,
+    guint8 * out);
+
+typedef struct
+{
+  GstGeometricTransform *gt;
+  GstGeometricTransformRowFunc row_func;
+  const guint8 *in_data;
+  guint8 *out_data;
+} GeometricTransformRemap;
+
 #define GST_GT_OFF_EDGES_PIXELS_METHOD_TYPE ( \
     gst_geometric_transform_off_edges_pixels_method_get_type())
 static GType
@@ -74,7 +97,99 @@ gst_geometric_transform_off_edges_pixels_method_get_type (void)
   return method_type;
 }
 
+#define GST_GT_INTERPOLATION_METHOD_TYPE ( \
+    gst_geometric_transform_interpolation_method_get_type())
+static GType
+gst_geometric_transform_interpolation_method_get_type (void)
+{
+  static GType method_type = 0;
+
+  static const GEnumValue method_types[] = {
+    {GST_GT_INTERPOLATION_NEAREST, "Nearest neighbour", "nearest"},
+    {GST_GT_INTERPOLATION_BILINEAR, "Bilinear", "bilinear"},
+    {0, NULL, NULL}
+  };
+
+  if (!method_type) {
+    method_type =
+        g_enum_register_static ("GstGeometricTransformInterpolationMethod",
+        method_types);
+  }
+  return method_type;
+}
+
 #define DEFAULT_OFF_EDGE_PIXELS GST_GT_OFF_EDGES_PIXELS_IGNORE
+#define DEFAULT_INTERPOLATION GST_GT_INTERPOLATION_NEAREST
+#define DEFAULT_N_THREADS 0
+
+static void gst_geometric_transform_finalize (GObject * object);
+
+/* Bilinear interpolation needs a neighbour to the right and below */
+static gboolean
+gst_geometric_transform_use_bilinear (GstGeometricTransform * gt)
+{
+  return gt->interpolation == GST_GT_INTERPOLATION_BILINEAR &&
+      gt->width > 1 && gt->height > 1;
+}
+
+/*
+ * Computes the map entry of an output pixel from the input pixel position
+ * returned by the map function: the byte offset of the input pixel in the
+ * frame, or -1 if it is off the edges and the output pixel stays black.
+ *
+ * With @weights, the offset is that of the top left of the four input
+ * pixels to interpolate and @weights are set to the weights of the ones
+ * to the right and below. The neighbours of the last column and row are
+ * not wrapped around, they are taken from the previous column and row.
+ */
+static inline void
+gst_geometric_transform_map_entry (GstGeometricTransform * gt, gdouble in_x,
+    gdouble in_y, gint32 * offset, guint8 * weights)
+{
+  gint trunc_x, trunc_y;
+
+  /* operate on out of edge pixels */
+  switch (gt->off_edge_pixels) {
+    case GST_GT_OFF_EDGES_PIXELS_CLAMP:
+      in_x = CLAMP (in_x, 0, gt->width - 1);
+      in_y = CLAMP (in_y, 0, gt->height - 1);
+      break;
+
+    case GST_GT_OFF_EDGES_PIXELS_WRAP:
+      in_x = gst_gm_mod_float (in_x, gt->width);
+      in_y = gst_gm_mod_float (in_y, gt->height);
+      if (in_x < 0)
+        in_x += gt->width;
+      if (in_y < 0)
+        in_y += gt->height;
+      break;
+
+    default:
+      break;
+  }
+
+  trunc_x = (gint) in_x;
+  trunc_y = (gint) in_y;
+  /* only map the pixel if the values are valid */
+  if (trunc_x < 0 || trunc_x >= gt->width || trunc_y < 0 ||
+      trunc_y >= gt->height) {
+    *offset = -1;
+    if (weights)
+      weights[0] = weights[1] = 0;
+    return;
+  }
+
+  if (weights) {
+    in_x = CLAMP (in_x, 0, gt->width - 1);
+    in_y = CLAMP (in_y, 0, gt->height - 1);
+    trunc_x = MIN ((gint) in_x, gt->width - 2);
+    trunc_y = MIN ((gint) in_y, gt->height - 2);
+    weights[0] = (guint8) ((in_x - trunc_x) * GT_WEIGHT_ONE + 0.5);
+    weights[1] = (guint8) ((in_y - trunc_y) * GT_WEIGHT_ONE + 0.5);
+  }
+
+  *offset = trunc_y * gt->row_stride + trunc_x * gt->pixel_stride;
+}
 
 /* must be called with the object lock */
 static gboolean
@@ -84,13 +199,16 @@ gst_geometric_transform_generate_map (GstGeometricTransform * gt)
   gdouble in_x, in_y;
   gboolean ret = TRUE;
   GstGeometricTransformClass *klass;
-  gdouble *ptr;
+  gint32 *ptr;
+  guint8 *weights = NULL;
 
   GST_INFO_OBJECT (gt, "Generating new transform map");
 
   /* cleanup old map */
   g_free (gt->map);
   gt->map = NULL;
+  g_free (gt->weights);
+  gt->weights = NULL;
 
   klass = GST_GEOMETRIC_TRANSFORM_GET_CLASS (gt);
 
@@ -98,10 +216,14 @@ gst_geometric_transform_generate_map (GstGeometricTransform * gt)
   g_return_val_if_fail (klass->map_func, FALSE);
 
   /*
-   * (x,y) pairs of the inverse mapping
+   * input pixel offsets (and weights) of the inverse mapping
    */
-  gt->map = g_malloc0 (sizeof (gdouble) * gt->width * gt->height * 2);
+  gt->map = g_malloc0 (sizeof (gint32) * gt->width * gt->height);
   ptr = gt->map;
+  if (gst_geometric_transform_use_bilinear (gt)) {
+    gt->weights = g_malloc0 (2 * gt->width * gt->height);
+    weights = gt->weights;
+  }
 
   for (y = 0; y < gt->height; y++) {
     for (x = 0; x < gt->width; x++) {
@@ -111,9 +233,10 @@ gst_geometric_transform_generate_map (GstGeometricTransform * gt)
         goto end;
       }
 
-      ptr[0] = in_x;
-      ptr[1] = in_y;
-      ptr += 2;
+      gst_geometric_transform_map_entry (gt, in_x, in_y, ptr, weights);
+      ptr++;
+      if (weights)
+        weights += 2;
     }
   }
 
@@ -122,6 +245,8 @@ end:
     GST_WARNING_OBJECT (gt, "Generating transform map failed");
     g_free (gt->map);
     gt->map = NULL;
+    g_free (gt->weights);
+    gt->weights = NULL;
   } else
     gt->needs_remap = FALSE;
   return ret;
@@ -135,6 +260,8 @@ gst_geometric_transform_set_info (GstVideoFilter * vfilter, GstCaps * incaps,
   gboolean ret = TRUE;
   gint old_width;
   gint old_height;
+  gint old_row_stride;
+  gint old_pixel_stride;
   GstGeometricTransformClass *klass;
 
   gt = GST_GEOMETRIC_TRANSFORM_CAST (vfilter);
@@ -142,16 +269,30 @@ gst_geometric_transform_set_info (GstVideoFilter * vfilter, GstCaps * incaps,
 
   old_width = gt->width;
   old_height = gt->height;
+  old_row_stride = gt->row_stride;
+  old_pixel_stride = gt->pixel_stride;
 
   gt->width = in_info->width;
   gt->height = in_info->height;
+  gt->format = GST_VIDEO_INFO_FORMAT (in_info);
   gt->row_stride = in_info->stride[0];
   gt->pixel_stride = GST_VIDEO_INFO_COMP_PSTRIDE (in_info, 0);
 
-  /* regenerate the map */
+  /* in AYUV black is not just all zeros:
+   * 0x10 is black for Y,
+   * 0x80 is black for Cr and Cb */
+  if (gt->format == GST_VIDEO_FORMAT_AYUV)
+    GST_WRITE_UINT32_BE (gt->black, 0xff108080);
+  else
+    memset (gt->black, 0, sizeof (gt->black));
+
+  /* regenerate the map, it holds byte offsets so it also depends on the
+   * strides */
   GST_OBJECT_LOCK (gt);
   if (gt->map == NULL || old_width == 0 || old_height == 0
-      || gt->width != old_width || gt->height != old_height) {
+      || gt->width != old_width || gt->height != old_height
+      || gt->row_stride != old_row_stride
+      || gt->pixel_stride != old_pixel_stride) {
     if (klass->prepare_func)
       if (!klass->prepare_func (gt)) {
         GST_OBJECT_UNLOCK (gt);
@@ -164,48 +305,182 @@ gst_geometric_transform_set_info (GstVideoFilter * vfilter, GstCaps * incaps,
   return ret;
 }
 
-static void
-gst_geometric_transform_do_map (GstGeometricTransform * gt, guint8 * in_data,
-    guint8 * out_data, gint x, gint y, gdouble in_x, gdouble in_y)
-{
-  gint in_offset;
-  gint out_offset;
+#define DEFINE_REMAP_ROW_NEAREST(n)                                         \
+static void                                                                 \
+remap_row_nearest_##n (GstGeometricTransform * gt, const gint32 * map,      \
+    const guint8 * weights, const guint8 * in_data, guint8 * out)           \
+{                                                                           \
+  gint x;                                                                   \
+                                                                            \
+  for (x = 0; x < gt->width; x++, out += n) {                               \
+    if (map[x] >= 0)                                                        \
+      memcpy (out, in_data + map[x], n);                                    \
+    else                                                                    \
+      memcpy (out, gt->black, n);                                           \
+  }                                                                         \
+}
 
-  out_offset = y * gt->row_stride + x * gt->pixel_stride;
+DEFINE_REMAP_ROW_NEAREST (1)
+DEFINE_REMAP_ROW_NEAREST (2)
+DEFINE_REMAP_ROW_NEAREST (3)
+DEFINE_REMAP_ROW_NEAREST (4)
+
+/* n 8 bit components per pixel */
+#define DEFINE_REMAP_ROW_BILINEAR(n)                                        \
+static void                                                                 \
+remap_row_bilinear_##n (GstGeometricTransform * gt, const gint32 * map,     \
+    const guint8 * weights, const guint8 * in_data, guint8 * out)           \
+{                                                                           \
+  const gint rs = gt->row_stride;                                           \
+  gint x, c;                                                                \
+                                                                            \
+  for (x = 0; x < gt->width; x++, out += n, weights += 2) {                 \
+    const guint8 *p;                                                        \
+    guint fx, fy;                                                           \
+                                                                            \
+    if (map[x] < 0) {                                                       \
+      memcpy (out, gt->black, n);                                           \
+      continue;                                                             \
+    }                                                                       \
+                                                                            \
+    p = in_data + map[x];                                                   \
+    fx = weights[0];                                                        \
+    fy = weights[1];                                                        \
+    for (c = 0; c < n; c++) {                                               \
+      guint top = p[c] * (GT_WEIGHT_ONE - fx) + p[c + n] * fx;              \
+      guint bottom = p[rs + c] * (GT_WEIGHT_ONE - fx) + p[rs + c + n] * fx; \
+                                                                            \
+      out[c] = (top * (GT_WEIGHT_ONE - fy) + bottom * fy +                  \
+          GT_WEIGHT_ROUND) >> (2 * GT_WEIGHT_SHIFT);                        \
+    }                                                                       \
+  }                                                                         \
+}
 
-  /* operate on out of edge pixels */
-  switch (gt->off_edge_pixels) {
-    case GST_GT_OFF_EDGES_PIXELS_CLAMP:
-      in_x = CLAMP (in_x, 0, gt->width - 1);
-      in_y = CLAMP (in_y, 0, gt->height - 1);
-      break;
+DEFINE_REMAP_ROW_BILINEAR (1)
+DEFINE_REMAP_ROW_BILINEAR (3)
+DEFINE_REMAP_ROW_BILINEAR (4)
+
+#define DEFINE_REMAP_ROW_BILINEAR_16(name, READ, WRITE)                     \
+static void                                                                 \
+remap_row_bilinear_##name (GstGeometricTransform * gt, const gint32 * map,  \
+    const guint8 * weights, const guint8 * in_data, guint8 * out)           \
+{                                                                           \
+  const gint rs = gt->row_stride;                                           \
+  gint x;                                                                   \
+                                                                            \
+  for (x = 0; x < gt->width; x++, out += 2, weights += 2) {                 \
+    const guint8 *p;                                                        \
+    guint fx, fy, top, bottom;                                              \
+                                                                            \
+    if (map[x] < 0) {                                                       \
+      memcpy (out, gt->black, 2);                                           \
+      continue;                                                             \
+    }                                                                       \
+                                                                            \
+    p = in_data + map[x];                                                   \
+    fx = weights[0];                                                        \
+    fy = weights[1];                                                        \
+    top = READ (p) * (GT_WEIGHT_ONE - fx) + READ (p + 2) * fx;              \
+    bottom = READ (p + rs) * (GT_WEIGHT_ONE - fx) + READ (p + rs + 2) * fx; \
+    WRITE (out, (top * (GT_WEIGHT_ONE - fy) + bottom * fy +                 \
+            GT_WEIGHT_ROUND) >> (2 * GT_WEIGHT_SHIFT));                     \
+  }                                                                         \
+}
 
-    case GST_GT_OFF_EDGES_PIXELS_WRAP:
-      in_x = gst_gm_mod_float (in_x, gt->width);
-      in_y = gst_gm_mod_float (in_y, gt->height);
-      if (in_x < 0)
-        in_x += gt->width;
-      if (in_y < 0)
-        in_y += gt->height;
-      break;
+DEFINE_REMAP_ROW_BILINEAR_16 (gray16_le, GST_READ_UINT16_LE,
+    GST_WRITE_UINT16_LE)
+DEFINE_REMAP_ROW_BILINEAR_16 (gray16_be, GST_READ_UINT16_BE,
+    GST_WRITE_UINT16_BE)
 
-    default:
-      break;
+static GstGeometricTransformRowFunc
+gst_geometric_transform_get_row_func (GstGeometricTransform * gt,
+    gboolean bilinear)
+{
+  if (bilinear) {
+    switch (gt->format) {
+      case GST_VIDEO_FORMAT_GRAY16_LE:
+        return remap_row_bilinear_gray16_le;
+      case GST_VIDEO_FORMAT_GRAY16_BE:
+        return remap_row_bilinear_gray16_be;
+      default:
+        break;
+    }
+
+    switch (gt->pixel_stride) {
+      case 1:
+        return remap_row_bilinear_1;
+      case 3:
+        return remap_row_bilinear_3;
+      case 4:
+        return remap_row_bilinear_4;
+      default:
+        break;
+    }
+  } else {
+    switch (gt->pixel_stride) {
+      case 1:
+        return remap_row_nearest_1;
+      case 2:
+        return remap_row_nearest_2;
+      case 3:
+        return remap_row_nearest_3;
+      case 4:
+        return remap_row_nearest_4;
+      default:
+        break;
+    }
   }
 
-  {
-    gint trunc_x = (gint) in_x;
-    gint trunc_y = (gint) in_y;
-    /* only set the values if the values are valid */
-    if (trunc_x >= 0 && trunc_x < gt->width && trunc_y >= 0 &&
-        trunc_y < gt->height) {
-      in_offset = trunc_y * gt->row_stride + trunc_x * gt->pixel_stride;
+  g_return_val_if_reached (NULL);
+}
 
-      memcpy (out_data + out_offset, in_data + in_offset, gt->pixel_stride);
-    }
+/* Remaps the output rows @start to @end, with the padding at their end
+ * set to 0 */
+static void
+gst_geometric_transform_remap_band (guint band, guint start, guint end,
+    const GeometricTransformRemap * remap)
+{
+  GstGeometricTransform *gt = remap->gt;
+  gint row_size = gt->width * gt->pixel_stride;
+  guint y;
+
+  for (y = start; y < end; y++) {
+    guint8 *out = remap->out_data + y * gt->row_stride;
+    const guint8 *weights = NULL;
+
+    if (gt->weights)
+      weights = gt->weights + 2 * y * gt->width;
+
+    remap->row_func (gt, gt->map + y * gt->width, weights, remap->in_data,
+        out);
+    if (gt->row_stride > row_size)
+      memset (out + row_size, 0, gt->row_stride - row_size);
   }
 }
 
+/* Remaps the frame with the precalculated map, in horizontal bands on as
+ * many threads as configured. Must be called with the object lock */
+static void
+gst_geometric_transform_remap_frame (GstGeometricTransform * gt,
+    const guint8 * in_data, guint8 * out_data)
+{
+  GeometricTransformRemap remap;
+  guint n_bands;
+
+  remap.row_func = gst_geometric_transform_get_row_func (gt,
+      gt->weights != NULL);
+  g_return_if_fail (remap.row_func != NULL);
+  remap.gt = gt;
+  remap.in_data = in_data;
+  remap.out_data = out_data;
+
+  n_bands = gst_stripe_runner_run (gt->remap_runner, gt->n_threads,
+      gt->height, GT_MIN_BAND_HEIGHT, 1,
+      (GstStripeRunnerFunc) gst_geometric_transform_remap_band, &remap);
+
+  GST_LOG_OBJECT (gt, "Remapped %u bands", n_bands);
+}
+
 static void
 gst_geometric_transform_before_transform (GstBaseTransform * trans,
     GstBuffer * outbuf)
@@ -229,9 +504,8 @@ gst_geometric_transform_transform_frame (GstVideoFilter * vfilter,
 {
   GstGeometricTransform *gt;
   GstGeometricTransformClass *klass;
-  gint x, y, i;
+  gint x, y;
   GstFlowReturn ret = GST_FLOW_OK;
-  gdouble *ptr;
   guint8 *in_data;
   guint8 *out_data;
 
@@ -241,50 +515,59 @@ gst_geometric_transform_transform_frame (GstVideoFilter * vfilter,
   in_data = GST_VIDEO_FRAME_PLANE_DATA (in_frame, 0);
   out_data = GST_VIDEO_FRAME_PLANE_DATA (out_frame, 0);
 
-  if (GST_VIDEO_FRAME_FORMAT (out_frame) == GST_VIDEO_FORMAT_AYUV) {
-    /* in AYUV black is not just all zeros:
-     * 0x10 is black for Y,
-     * 0x80 is black for Cr and Cb */
-    for (i = 0; i < out_frame->map[0].size; i += 4)
-      GST_WRITE_UINT32_BE (out_data + i, 0xff108080);
-  } else {
-    memset (out_data, 0, out_frame->map[0].size);
-  }
-
   GST_OBJECT_LOCK (gt);
   if (gt->precalc_map) {
     if (gt->needs_remap) {
       if (klass->prepare_func)
         if (!klass->prepare_func (gt)) {
-          ret = FALSE;
+          ret = GST_FLOW_ERROR;
           goto end;
         }
       gst_geometric_transform_generate_map (gt);
     }
-    g_return_val_if_fail (gt->map, GST_FLOW_ERROR);
-    ptr = gt->map;
-    for (y = 0; y < gt->height; y++) {
-      for (x = 0; x < gt->width; x++) {
-        /* do the mapping */
-        gst_geometric_transform_do_map (gt, in_data, out_data, x, y, ptr[0],
-            ptr[1]);
-        ptr += 2;
-      }
+    if (gt->map == NULL) {
+      ret = GST_FLOW_ERROR;
+      goto end;
     }
+    gst_geometric_transform_remap_frame (gt, in_data, out_data);
   } else {
+    /* The map function might not be reentrant, so map one row at a time on
+     * this thread only */
+    gboolean bilinear = gst_geometric_transform_use_bilinear (gt);
+    GstGeometricTransformRowFunc row_func;
+    gint32 *map;
+    guint8 *weights = NULL;
+    gint row_size = gt->width * gt->pixel_stride;
+
+    row_func = gst_geometric_transform_get_row_func (gt, bilinear);
+    if (row_func == NULL) {
+      ret = GST_FLOW_ERROR;
+      goto end;
+    }
+
+    map = g_newa (gint32, gt->width);
+    if (bilinear)
+      weights = g_newa (guint8, 2 * gt->width);
+
     for (y = 0; y < gt->height; y++) {
+      guint8 *out = out_data + y * gt->row_stride;
+
       for (x = 0; x < gt->width; x++) {
         gdouble in_x, in_y;
 
         if (klass->map_func (gt, x, y, &in_x, &in_y)) {
-          gst_geometric_transform_do_map (gt, in_data, out_data, x, y, in_x,
-              in_y);
+          gst_geometric_transform_map_entry (gt, in_x, in_y, &map[x],
+              weights ? &weights[2 * x] : NULL);
         } else {
           GST_WARNING_OBJECT (gt, "Failed to do mapping for %d %d", x, y);
           ret = GST_FLOW_ERROR;
           goto end;
         }
       }
+
+      row_func (gt, map, weights, in_data, out);
+      if (gt->row_stride > row_size)
+        memset (out + row_size, 0, gt->row_stride - row_size);
     }
   }
 end:
@@ -301,9 +584,32 @@ gst_geometric_transform_set_property (GObject * object, guint prop_id,
   gt = GST_GEOMETRIC_TRANSFORM_CAST (object);
 
   switch (prop_id) {
-    case PROP_OFF_EDGE_PIXELS:
+    case PROP_OFF_EDGE_PIXELS:{
+      gint off_edge_pixels = g_value_get_enum (value);
+
+      /* the map already has the edges handled */
+      GST_OBJECT_LOCK (gt);
+      if (off_edge_pixels != gt->off_edge_pixels) {
+        gt->off_edge_pixels = off_edge_pixels;
+        gst_geometric_transform_set_need_remap (gt);
+      }
+      GST_OBJECT_UNLOCK (gt);
+      break;
+    }
+    case PROP_INTERPOLATION:{
+      gint interpolation = g_value_get_enum (value);
+
       GST_OBJECT_LOCK (gt);
-      gt->off_edge_pixels = g_value_get_enum (value);
+      if (interpolation != gt->interpolation) {
+        gt->interpolation = interpolation;
+        gst_geometric_transform_set_need_remap (gt);
+      }
+      GST_OBJECT_UNLOCK (gt);
+      break;
+    }
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (gt);
+      gt->n_threads = g_value_get_uint (value);
       GST_OBJECT_UNLOCK (gt);
       break;
     default:
@@ -324,6 +630,14 @@ gst_geometric_transform_get_property (GObject * object, guint prop_id,
     case PROP_OFF_EDGE_PIXELS:
       g_value_set_enum (value, gt->off_edge_pixels);
       break;
+    case PROP_INTERPOLATION:
+      g_value_set_enum (value, gt->interpolation);
+      break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (gt);
+      g_value_set_uint (value, gt->n_threads);
+      GST_OBJECT_UNLOCK (gt);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -343,10 +657,22 @@ gst_geometric_transform_stop (GstBaseTransform * trans)
 
   g_free (gt->map);
   gt->map = NULL;
+  g_free (gt->weights);
+  gt->weights = NULL;
 
   return TRUE;
 }
 
+static void
+gst_geometric_transform_finalize (GObject * object)
+{
+  GstGeometricTransform *gt = GST_GEOMETRIC_TRANSFORM_CAST (object);
+
+  gst_stripe_runner_free (gt->remap_runner);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
 static void
 gst_geometric_transform_base_init (gpointer g_class)
 {
@@ -373,6 +699,7 @@ gst_geometric_transform_class_init (gpointer klass, gpointer class_data)
 
   obj_class->set_property = gst_geometric_transform_set_property;
   obj_class->get_property = gst_geometric_transform_get_property;
+  obj_class->finalize = gst_geometric_transform_finalize;
 
   trans_class->stop = GST_DEBUG_FUNCPTR (gst_geometric_transform_stop);
   trans_class->before_transform =
@@ -388,6 +715,18 @@ gst_geometric_transform_class_init (gpointer klass, gpointer class_data)
           "What to do with off edge pixels",
           GST_GT_OFF_EDGES_PIXELS_METHOD_TYPE, DEFAULT_OFF_EDGE_PIXELS,
           GST_PARAM_CONTROLLABLE | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (obj_class, PROP_INTERPOLATION,
+      g_param_spec_enum ("interpolation", "Interpolation",
+          "How the output pixels are sampled from the input pixels",
+          GST_GT_INTERPOLATION_METHOD_TYPE, DEFAULT_INTERPOLATION,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (obj_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Number of threads",
+          "Maximum number of threads remapping the rows of the frames "
+          "in parallel (0 = number of processors)", 0, G_MAXUINT,
+          DEFAULT_N_THREADS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -396,8 +735,12 @@ gst_geometric_transform_init (GTypeInstance * instance, gpointer g_class)
   GstGeometricTransform *gt = GST_GEOMETRIC_TRANSFORM_CAST (instance);
 
   gt->off_edge_pixels = DEFAULT_OFF_EDGE_PIXELS;
+  gt->interpolation = DEFAULT_INTERPOLATION;
+  gt->n_threads = DEFAULT_N_THREADS;
   gt->precalc_map = TRUE;
   gt->needs_remap = TRUE;
+
+  gt->remap_runner = gst_stripe_runner_new ();
 }
 
 GType
@@ -22,6 +22,7 @@
 
 #include <gst/video/gstvideofilter.h>
 #include <gst/video/video.h>
+#include <gst/base/gststriperunner.h>
 
 G_BEGIN_DECLS
 
@@ -46,6 +47,12 @@ enum
   GST_GT_OFF_EDGES_PIXELS_WRAP
 };
 
+enum
+{
+  GST_GT_INTERPOLATION_NEAREST = 0,
+  GST_GT_INTERPOLATION_BILINEAR
+};
+
 typedef struct _GstGeometricTransform GstGeometricTransform;
 typedef struct _GstGeometricTransformClass GstGeometricTransformClass;
 
@@ -99,8 +106,21 @@ struct _GstGeometricTransform {
 
   /* properties */
   gint off_edge_pixels;
+  gint interpolation;
+  guint n_threads;
+
+  /* For each output pixel, the byte offset of the input pixel in the first
+   * plane, or -1 if it is off the edges. With bilinear interpolation, this
+   * is the top left one of the 4 input pixels and @weights has the weights
+   * of the pixels to the right and below, in 1/128 */
+  gint32 *map;
+  guint8 *weights;
+
+  /* value of a black pixel */
+  guint8 black[4];
 
-  gdouble *map;
+  /* Remaps horizontal bands of the frames on worker threads */
+  GstStripeRunner *remap_runner;
 };
 
 struct _GstGeometricTransformClass {
@@ -226,7 +226,7 @@ gst_inter_audio_sink_stop (GstBaseSink * sink)
   GST_DEBUG_OBJECT (interaudiosink, "stop");
 
   g_mutex_lock (&interaudiosink->surface->mutex);
-  gst_adapter_clear (interaudiosink->surface->audio_adapter);
+  gst_inter_surface_clear_audio (interaudiosink->surface);
   memset (&interaudiosink->surface->audio_info, 0, sizeof (GstAudioInfo));
   g_mutex_unlock (&interaudiosink->surface->mutex);
 
@@ -250,10 +250,10 @@ gst_inter_audio_sink_set_caps (GstBaseSink * sink, GstCaps * caps)
   }
 
   g_mutex_lock (&interaudiosink->surface->mutex);
+  /* TODO: Ideally we would drain the source here */
+  gst_inter_surface_clear_audio (interaudiosink->surface);
   interaudiosink->surface->audio_info = info;
   interaudiosink->info = info;
-  /* TODO: Ideally we would drain the source here */
-  gst_adapter_clear (interaudiosink->surface->audio_adapter);
   g_mutex_unlock (&interaudiosink->surface->mutex);
 
   return TRUE;
@@ -317,12 +317,13 @@ gst_inter_audio_sink_render (GstBaseSink * sink, GstBuffer * buffer)
       gst_util_uint64_scale (period_time, interaudiosink->info.rate,
       GST_SECOND);
 
+  /* Sources don't consume the samples they read unless there is only one,
+   * so this is what drops audio once it is older than buffer-time */
   n = gst_adapter_available (interaudiosink->surface->audio_adapter) / bpf;
   while (n > buffer_samples) {
     GST_DEBUG_OBJECT (interaudiosink, "flushing %" GST_TIME_FORMAT,
         GST_TIME_ARGS (period_time));
-    gst_adapter_flush (interaudiosink->surface->audio_adapter,
-        period_samples * bpf);
+    gst_inter_surface_flush_audio (interaudiosink->surface, period_samples);
     n -= period_samples;
   }
 
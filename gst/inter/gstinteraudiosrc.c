@@ -22,6 +22,12 @@
  * The interaudiosrc element is an audio source element.  It is used
  * in connection with a interaudiosink element in a different pipeline.
  *
+ * Several interaudiosrc elements can read from the same channel, each one
+ * keeps its own position in the audio stored by the sink. Audio that was
+ * discarded by the sink before a source could read it and silence that a
+ * source inserted because no audio was available are counted in the
+ * #GstInterAudioSrc:stats property.
+ *
  * <refsect2>
  * <title>Example launch line</title>
  * |[
@@ -77,7 +83,8 @@ enum
   PROP_CHANNEL,
   PROP_BUFFER_TIME,
   PROP_LATENCY_TIME,
-  PROP_PERIOD_TIME
+  PROP_PERIOD_TIME,
+  PROP_STATS
 };
 
 #define DEFAULT_CHANNEL ("default")
@@ -148,6 +155,11 @@ gst_inter_audio_src_class_init (GstInterAudioSrcClass * klass)
           "The minimum amount of data to read in each iteration",
           1, G_MAXUINT64, DEFAULT_AUDIO_PERIOD_TIME,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Number of samples dropped and of silence inserted by this source",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -208,6 +220,14 @@ gst_inter_audio_src_get_property (GObject * object, guint property_id,
     case PROP_PERIOD_TIME:
       g_value_set_uint64 (value, interaudiosrc->period_time);
       break;
+    case PROP_STATS:
+      GST_OBJECT_LOCK (interaudiosrc);
+      g_value_take_boxed (value, gst_structure_new ("application/x-inter-stats",
+              "samples-dropped", G_TYPE_UINT64, interaudiosrc->samples_dropped,
+              "samples-silence", G_TYPE_UINT64, interaudiosrc->samples_silence,
+              NULL));
+      GST_OBJECT_UNLOCK (interaudiosrc);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -287,8 +307,15 @@ gst_inter_audio_src_start (GstBaseSrc * src)
   interaudiosrc->surface->audio_buffer_time = interaudiosrc->buffer_time;
   interaudiosrc->surface->audio_latency_time = interaudiosrc->latency_time;
   interaudiosrc->surface->audio_period_time = interaudiosrc->period_time;
+  interaudiosrc->surface->audio_n_sources++;
+  interaudiosrc->read_offset = -1;
   g_mutex_unlock (&interaudiosrc->surface->mutex);
 
+  GST_OBJECT_LOCK (interaudiosrc);
+  interaudiosrc->samples_dropped = 0;
+  interaudiosrc->samples_silence = 0;
+  GST_OBJECT_UNLOCK (interaudiosrc);
+
   return TRUE;
 }
 
@@ -299,6 +326,10 @@ gst_inter_audio_src_stop (GstBaseSrc * src)
 
   GST_DEBUG_OBJECT (interaudiosrc, "stop");
 
+  g_mutex_lock (&interaudiosrc->surface->mutex);
+  interaudiosrc->surface->audio_n_sources--;
+  g_mutex_unlock (&interaudiosrc->surface->mutex);
+
   gst_inter_surface_unref (interaudiosrc->surface);
   interaudiosrc->surface = NULL;
 
@@ -335,11 +366,13 @@ gst_inter_audio_src_create (GstBaseSrc * src, guint64 offset, guint size,
     GstBuffer ** buf)
 {
   GstInterAudioSrc *interaudiosrc = GST_INTER_AUDIO_SRC (src);
+  GstInterSurface *surface = interaudiosrc->surface;
   GstCaps *caps;
   GstBuffer *buffer;
   guint n, bpf;
   guint64 period_time;
   guint64 period_samples;
+  guint64 dropped = 0;
 
   GST_DEBUG_OBJECT (interaudiosrc, "create");
 
@@ -355,6 +388,8 @@ gst_inter_audio_src_create (GstBaseSrc * src, guint64 offset, guint size,
           gst_util_uint64_scale (interaudiosrc->n_samples, GST_SECOND,
           interaudiosrc->info.rate);
       interaudiosrc->n_samples = 0;
+      /* Sample positions of the old format are meaningless now */
+      interaudiosrc->read_offset = -1;
     }
   }
 
@@ -363,16 +398,50 @@ gst_inter_audio_src_create (GstBaseSrc * src, guint64 offset, guint size,
   period_samples =
       gst_util_uint64_scale (period_time, interaudiosrc->info.rate, GST_SECOND);
 
-  if (bpf > 0)
-    n = gst_adapter_available (interaudiosrc->surface->audio_adapter) / bpf;
-  else
+  if (bpf > 0) {
+    guint64 start, end;
+
+    /* The adapter is shared by all sources reading this channel, so unless
+     * this is the only one it is only read from here and the sink drops
+     * old samples */
+    start = surface->audio_offset;
+    end = start + gst_adapter_available (surface->audio_adapter) / bpf;
+
+    if (interaudiosrc->read_offset == -1 || interaudiosrc->read_offset > end) {
+      guint64 latency_samples =
+          gst_util_uint64_scale (surface->audio_latency_time,
+          surface->audio_info.rate, GST_SECOND);
+
+      interaudiosrc->read_offset =
+          end > start + latency_samples ? end - latency_samples : start;
+    } else if (interaudiosrc->read_offset < start) {
+      dropped = start - interaudiosrc->read_offset;
+      GST_DEBUG_OBJECT (interaudiosrc,
+          "dropped %" G_GUINT64_FORMAT " samples", dropped);
+      interaudiosrc->read_offset = start;
+    }
+
+    n = MIN (end - interaudiosrc->read_offset, period_samples);
+  } else {
     n = 0;
+  }
 
-  if (n > period_samples)
-    n = period_samples;
-  if (n > 0) {
-    buffer = gst_adapter_take_buffer (interaudiosrc->surface->audio_adapter,
-        n * bpf);
+  if (n > 0 && surface->audio_n_sources == 1) {
+    /* Nobody else needs the samples, so skip the ones before the read
+     * position and take the rest without copying them */
+    gst_inter_surface_flush_audio (surface,
+        interaudiosrc->read_offset - surface->audio_offset);
+    buffer = gst_inter_surface_take_audio (surface, n);
+    interaudiosrc->read_offset += n;
+  } else if (n > 0) {
+    GstMapInfo map;
+
+    buffer = gst_buffer_new_allocate (NULL, n * bpf, NULL);
+    gst_buffer_map (buffer, &map, GST_MAP_WRITE);
+    gst_adapter_copy (surface->audio_adapter, map.data,
+        (interaudiosrc->read_offset - surface->audio_offset) * bpf, n * bpf);
+    gst_buffer_unmap (buffer, &map);
+    interaudiosrc->read_offset += n;
   } else {
     buffer = gst_buffer_new ();
     GST_BUFFER_FLAG_SET (buffer, GST_BUFFER_FLAG_GAP);
@@ -392,6 +461,11 @@ gst_inter_audio_src_create (GstBaseSrc * src, guint64 offset, guint size,
 
   buffer = gst_buffer_make_writable (buffer);
 
+  GST_OBJECT_LOCK (interaudiosrc);
+  interaudiosrc->samples_dropped += dropped;
+  interaudiosrc->samples_silence += period_samples - n;
+  GST_OBJECT_UNLOCK (interaudiosrc);
+
   bpf = interaudiosrc->info.bpf;
   if (n < period_samples) {
     GstMapInfo map;
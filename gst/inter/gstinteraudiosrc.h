@@ -46,6 +46,15 @@ struct _GstInterAudioSrc
   GstClockTime timestamp_offset;
   GstAudioInfo info;
   guint64 buffer_time, latency_time, period_time;
+
+  /* Sample position of the next sample to read from the surface, or -1 to
+   * start at latency-time behind the newest sample. Protected by the
+   * surface mutex. */
+  guint64 read_offset;
+
+  /* Statistics, protected by the object lock */
+  guint64 samples_dropped;
+  guint64 samples_silence;
 };
 
 struct _GstInterAudioSrcClass
@@ -48,6 +48,8 @@ gst_inter_surface_get (const char *name)
   surface->ref_count = 1;
   surface->name = g_strdup (name);
   g_mutex_init (&surface->mutex);
+  g_cond_init (&surface->video_cond);
+  surface->video_ring_size = DEFAULT_VIDEO_RING_SIZE;
   surface->audio_adapter = gst_adapter_new ();
   surface->audio_buffer_time = DEFAULT_AUDIO_BUFFER_TIME;
   surface->audio_latency_time = DEFAULT_AUDIO_LATENCY_TIME;
@@ -78,7 +80,8 @@ gst_inter_surface_unref (GstInterSurface * surface)
     }
 
     g_mutex_clear (&surface->mutex);
-    gst_buffer_replace (&surface->video_buffer, NULL);
+    g_cond_clear (&surface->video_cond);
+    gst_inter_surface_clear_video_frames (surface);
     gst_buffer_replace (&surface->sub_buffer, NULL);
     gst_object_unref (surface->audio_adapter);
     g_free (surface->name);
@@ -86,3 +89,77 @@ gst_inter_surface_unref (GstInterSurface * surface)
   }
   g_mutex_unlock (&mutex);
 }
+
+/* Stores @buffer as the newest frame, replacing the oldest one if the ring
+ * is full, and wakes up waiting sources */
+void
+gst_inter_surface_push_video_frame (GstInterSurface * surface,
+    GstBuffer * buffer)
+{
+  guint slot = surface->video_frame_count % surface->video_ring_size;
+
+  gst_buffer_replace (&surface->video_frames[slot], buffer);
+  surface->video_frame_count++;
+  g_cond_broadcast (&surface->video_cond);
+}
+
+/* Returns the slot holding frame @n, or NULL if the frame was not written
+ * yet or was already overwritten. The slot itself can be NULL if the sink
+ * was stopped. */
+GstBuffer **
+gst_inter_surface_peek_video_frame (GstInterSurface * surface, guint64 n)
+{
+  if (n >= surface->video_frame_count ||
+      n + surface->video_ring_size < surface->video_frame_count)
+    return NULL;
+
+  return &surface->video_frames[n % surface->video_ring_size];
+}
+
+void
+gst_inter_surface_clear_video_frames (GstInterSurface * surface)
+{
+  guint i;
+
+  for (i = 0; i < GST_INTER_SURFACE_MAX_VIDEO_FRAMES; i++)
+    gst_buffer_replace (&surface->video_frames[i], NULL);
+}
+
+/* Drops the @n_samples oldest samples, sources that did not read them
+ * yet notice from audio_offset */
+void
+gst_inter_surface_flush_audio (GstInterSurface * surface, guint n_samples)
+{
+  gst_adapter_flush (surface->audio_adapter,
+      n_samples * surface->audio_info.bpf);
+  surface->audio_offset += n_samples;
+}
+
+/* Removes the @n_samples oldest samples and returns them in a new buffer
+ * without the metadata of the sink's buffers. The buffer shares the memory
+ * pushed by the sink if the samples are contiguous */
+GstBuffer *
+gst_inter_surface_take_audio (GstInterSurface * surface, guint n_samples)
+{
+  GstBuffer *buffer, *samples;
+
+  samples = gst_adapter_take_buffer (surface->audio_adapter,
+      n_samples * surface->audio_info.bpf);
+  surface->audio_offset += n_samples;
+
+  buffer = gst_buffer_new ();
+  gst_buffer_copy_into (buffer, samples, GST_BUFFER_COPY_MEMORY, 0, -1);
+  gst_buffer_unref (samples);
+
+  return buffer;
+}
+
+void
+gst_inter_surface_clear_audio (GstInterSurface * surface)
+{
+  if (surface->audio_info.bpf > 0)
+    surface->audio_offset +=
+        gst_adapter_available (surface->audio_adapter) /
+        surface->audio_info.bpf;
+  gst_adapter_clear (surface->audio_adapter);
+}
@@ -28,6 +28,8 @@ G_BEGIN_DECLS
 
 typedef struct _GstInterSurface GstInterSurface;
 
+#define GST_INTER_SURFACE_MAX_VIDEO_FRAMES 32
+
 struct _GstInterSurface
 {
   GMutex mutex;
@@ -37,15 +39,29 @@ struct _GstInterSurface
 
   /* video */
   GstVideoInfo video_info;
-  int video_buffer_count;
+  /* The last video_ring_size frames written by the sink. Frame n is
+   * stored in slot n % video_ring_size, each source keeps its own read
+   * position so several sources can consume the same channel. */
+  GstBuffer *video_frames[GST_INTER_SURFACE_MAX_VIDEO_FRAMES];
+  guint video_ring_size;
+  /* Number of frames written since the surface was created, never reset */
+  guint64 video_frame_count;
+  /* Signalled whenever a frame is written */
+  GCond video_cond;
 
   /* audio */
   GstAudioInfo audio_info;
   guint64 audio_buffer_time;
   guint64 audio_latency_time;
   guint64 audio_period_time;
+  /* Sample position of the first sample in audio_adapter. If several
+   * sources read the channel, they read from the adapter without flushing
+   * it, and the sink flushes samples once they are older than
+   * audio_buffer_time. A single source takes the samples it reads. */
+  guint64 audio_offset;
+  /* Number of started sources reading audio_adapter */
+  guint audio_n_sources;
 
-  GstBuffer *video_buffer;
   GstBuffer *sub_buffer;
   GstAdapter *audio_adapter;
 };
@@ -53,11 +69,23 @@ struct _GstInterSurface
 #define DEFAULT_AUDIO_BUFFER_TIME  (GST_SECOND)
 #define DEFAULT_AUDIO_LATENCY_TIME (100 * GST_MSECOND)
 #define DEFAULT_AUDIO_PERIOD_TIME  (25 * GST_MSECOND)
+#define DEFAULT_VIDEO_RING_SIZE    1
 
 
 GstInterSurface * gst_inter_surface_get (const char *name);
 void gst_inter_surface_unref (GstInterSurface *surface);
 
+/* The following must be called with the surface mutex held */
+void gst_inter_surface_push_video_frame (GstInterSurface *surface,
+    GstBuffer *buffer);
+GstBuffer ** gst_inter_surface_peek_video_frame (GstInterSurface *surface,
+    guint64 n);
+void gst_inter_surface_clear_video_frames (GstInterSurface *surface);
+void gst_inter_surface_flush_audio (GstInterSurface *surface, guint n_samples);
+GstBuffer * gst_inter_surface_take_audio (GstInterSurface *surface,
+    guint n_samples);
+void gst_inter_surface_clear_audio (GstInterSurface *surface);
+
 
 G_END_DECLS
 
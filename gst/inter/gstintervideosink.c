@@ -23,6 +23,11 @@
  * in connection with an intervideosrc element in a different pipeline,
  * similar to interaudiosink and interaudiosrc.
  *
+ * Any number of intervideosrc elements can read from the same channel.
+ * By default only the latest frame is kept, with #GstInterVideoSink:ring-size
+ * set higher the sink keeps that many frames, so sources that momentarily
+ * fall behind still get every frame instead of skipping some.
+ *
  * <refsect2>
  * <title>Example launch line</title>
  * |[
@@ -66,7 +71,8 @@ static GstFlowReturn gst_inter_video_sink_show_frame (GstVideoSink * sink,
 enum
 {
   PROP_0,
-  PROP_CHANNEL
+  PROP_CHANNEL,
+  PROP_RING_SIZE
 };
 
 #define DEFAULT_CHANNEL ("default")
@@ -118,12 +124,20 @@ gst_inter_video_sink_class_init (GstInterVideoSinkClass * klass)
       g_param_spec_string ("channel", "Channel",
           "Channel name to match inter src and sink elements",
           DEFAULT_CHANNEL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_RING_SIZE,
+      g_param_spec_uint ("ring-size", "Ring Size",
+          "Number of frames kept for the sources to catch up with, "
+          "1 only keeps the latest frame", 1,
+          GST_INTER_SURFACE_MAX_VIDEO_FRAMES, DEFAULT_VIDEO_RING_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
 gst_inter_video_sink_init (GstInterVideoSink * intervideosink)
 {
   intervideosink->channel = g_strdup (DEFAULT_CHANNEL);
+  intervideosink->ring_size = DEFAULT_VIDEO_RING_SIZE;
 }
 
 void
@@ -137,6 +151,9 @@ gst_inter_video_sink_set_property (GObject * object, guint property_id,
       g_free (intervideosink->channel);
       intervideosink->channel = g_value_dup_string (value);
       break;
+    case PROP_RING_SIZE:
+      intervideosink->ring_size = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -153,6 +170,9 @@ gst_inter_video_sink_get_property (GObject * object, guint property_id,
     case PROP_CHANNEL:
       g_value_set_string (value, intervideosink->channel);
       break;
+    case PROP_RING_SIZE:
+      g_value_set_uint (value, intervideosink->ring_size);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -199,6 +219,9 @@ gst_inter_video_sink_start (GstBaseSink * sink)
   intervideosink->surface = gst_inter_surface_get (intervideosink->channel);
   g_mutex_lock (&intervideosink->surface->mutex);
   memset (&intervideosink->surface->video_info, 0, sizeof (GstVideoInfo));
+  /* Slots are only valid for the ring size they were written with */
+  gst_inter_surface_clear_video_frames (intervideosink->surface);
+  intervideosink->surface->video_ring_size = intervideosink->ring_size;
   g_mutex_unlock (&intervideosink->surface->mutex);
 
   return TRUE;
@@ -210,10 +233,7 @@ gst_inter_video_sink_stop (GstBaseSink * sink)
   GstInterVideoSink *intervideosink = GST_INTER_VIDEO_SINK (sink);
 
   g_mutex_lock (&intervideosink->surface->mutex);
-  if (intervideosink->surface->video_buffer) {
-    gst_buffer_unref (intervideosink->surface->video_buffer);
-  }
-  intervideosink->surface->video_buffer = NULL;
+  gst_inter_surface_clear_video_frames (intervideosink->surface);
   memset (&intervideosink->surface->video_info, 0, sizeof (GstVideoInfo));
   g_mutex_unlock (&intervideosink->surface->mutex);
 
@@ -235,6 +255,10 @@ gst_inter_video_sink_set_caps (GstBaseSink * sink, GstCaps * caps)
   }
 
   g_mutex_lock (&intervideosink->surface->mutex);
+  /* Frames that were not read yet don't match the new caps anymore */
+  if (intervideosink->surface->video_info.finfo &&
+      !gst_video_info_is_equal (&info, &intervideosink->surface->video_info))
+    gst_inter_surface_clear_video_frames (intervideosink->surface);
   intervideosink->surface->video_info = info;
   intervideosink->info = info;
   g_mutex_unlock (&intervideosink->surface->mutex);
@@ -251,11 +275,7 @@ gst_inter_video_sink_show_frame (GstVideoSink * sink, GstBuffer * buffer)
       GST_TIME_ARGS (GST_BUFFER_PTS (buffer)));
 
   g_mutex_lock (&intervideosink->surface->mutex);
-  if (intervideosink->surface->video_buffer) {
-    gst_buffer_unref (intervideosink->surface->video_buffer);
-  }
-  intervideosink->surface->video_buffer = gst_buffer_ref (buffer);
-  intervideosink->surface->video_buffer_count = 0;
+  gst_inter_surface_push_video_frame (intervideosink->surface, buffer);
   g_mutex_unlock (&intervideosink->surface->mutex);
 
   return GST_FLOW_OK;
@@ -23,6 +23,14 @@
  * in connection with a intervideosink element in a different pipeline,
  * similar to interaudiosink and interaudiosrc.
  *
+ * Several intervideosrc elements can read from the same channel, each one
+ * keeps its own position in the frames stored by the sink. Frames that were
+ * overwritten before a source could read them and frames that a source
+ * repeated because no new one arrived in time are counted in the
+ * #GstInterVideoSrc:stats property. With #GstInterVideoSrc:wait-for-frame
+ * the source waits for the next frame from the sink instead of repeating
+ * the previous one.
+ *
  * <refsect2>
  * <title>Example launch line</title>
  * |[
@@ -66,16 +74,21 @@ gst_inter_video_src_get_times (GstBaseSrc * src, GstBuffer * buffer,
 static GstFlowReturn
 gst_inter_video_src_create (GstBaseSrc * src, guint64 offset, guint size,
     GstBuffer ** buf);
+static gboolean gst_inter_video_src_unlock (GstBaseSrc * src);
+static gboolean gst_inter_video_src_unlock_stop (GstBaseSrc * src);
 
 enum
 {
   PROP_0,
   PROP_CHANNEL,
-  PROP_TIMEOUT
+  PROP_TIMEOUT,
+  PROP_WAIT_FOR_FRAME,
+  PROP_STATS
 };
 
 #define DEFAULT_CHANNEL ("default")
 #define DEFAULT_TIMEOUT (GST_SECOND)
+#define DEFAULT_WAIT_FOR_FRAME FALSE
 
 /* pad templates */
 static GstStaticPadTemplate gst_inter_video_src_src_template =
@@ -119,6 +132,9 @@ gst_inter_video_src_class_init (GstInterVideoSrcClass * klass)
   base_src_class->stop = GST_DEBUG_FUNCPTR (gst_inter_video_src_stop);
   base_src_class->get_times = GST_DEBUG_FUNCPTR (gst_inter_video_src_get_times);
   base_src_class->create = GST_DEBUG_FUNCPTR (gst_inter_video_src_create);
+  base_src_class->unlock = GST_DEBUG_FUNCPTR (gst_inter_video_src_unlock);
+  base_src_class->unlock_stop =
+      GST_DEBUG_FUNCPTR (gst_inter_video_src_unlock_stop);
 
   g_object_class_install_property (gobject_class, PROP_CHANNEL,
       g_param_spec_string ("channel", "Channel",
@@ -130,6 +146,17 @@ gst_inter_video_src_class_init (GstInterVideoSrcClass * klass)
           "Timeout after which to start outputting black frames",
           0, G_MAXUINT64, DEFAULT_TIMEOUT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_WAIT_FOR_FRAME,
+      g_param_spec_boolean ("wait-for-frame", "Wait for frame",
+          "Wait for a new frame from the sink, up to the timeout (forever "
+          "if 0), before repeating the last one",
+          DEFAULT_WAIT_FOR_FRAME, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Number of frames dropped and duplicated by this source",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -140,6 +167,7 @@ gst_inter_video_src_init (GstInterVideoSrc * intervideosrc)
 
   intervideosrc->channel = g_strdup (DEFAULT_CHANNEL);
   intervideosrc->timeout = DEFAULT_TIMEOUT;
+  intervideosrc->wait_for_frame = DEFAULT_WAIT_FOR_FRAME;
 }
 
 void
@@ -156,6 +184,9 @@ gst_inter_video_src_set_property (GObject * object, guint property_id,
     case PROP_TIMEOUT:
       intervideosrc->timeout = g_value_get_uint64 (value);
       break;
+    case PROP_WAIT_FOR_FRAME:
+      intervideosrc->wait_for_frame = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -175,6 +206,17 @@ gst_inter_video_src_get_property (GObject * object, guint property_id,
     case PROP_TIMEOUT:
       g_value_set_uint64 (value, intervideosrc->timeout);
       break;
+    case PROP_WAIT_FOR_FRAME:
+      g_value_set_boolean (value, intervideosrc->wait_for_frame);
+      break;
+    case PROP_STATS:
+      GST_OBJECT_LOCK (intervideosrc);
+      g_value_take_boxed (value, gst_structure_new ("application/x-inter-stats",
+              "frames-dropped", G_TYPE_UINT64, intervideosrc->frames_dropped,
+              "frames-duplicated", G_TYPE_UINT64,
+              intervideosrc->frames_duplicated, NULL));
+      GST_OBJECT_UNLOCK (intervideosrc);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -261,6 +303,9 @@ gst_inter_video_src_set_caps (GstBaseSrc * base, GstCaps * caps)
   gst_video_frame_unmap (&src_frame);
   gst_video_frame_unmap (&dest_frame);
   gst_buffer_unref (src);
+  /* Shared by all black output frames, nobody may write into it */
+  GST_MINI_OBJECT_FLAG_SET (gst_buffer_peek_memory (dest, 0),
+      GST_MEMORY_FLAG_READONLY);
   intervideosrc->black_frame = dest;
 
   return TRUE;
@@ -277,6 +322,20 @@ gst_inter_video_src_start (GstBaseSrc * src)
   intervideosrc->timestamp_offset = 0;
   intervideosrc->n_frames = 0;
 
+  g_mutex_lock (&intervideosrc->surface->mutex);
+  /* Start with the latest frame, like a single-slot surface would */
+  intervideosrc->read_frame = intervideosrc->surface->video_frame_count;
+  if (intervideosrc->read_frame > 0)
+    intervideosrc->read_frame--;
+  intervideosrc->repeat_count = 0;
+  intervideosrc->wait_timed_out = FALSE;
+  g_mutex_unlock (&intervideosrc->surface->mutex);
+
+  GST_OBJECT_LOCK (intervideosrc);
+  intervideosrc->frames_dropped = 0;
+  intervideosrc->frames_duplicated = 0;
+  GST_OBJECT_UNLOCK (intervideosrc);
+
   return TRUE;
 }
 
@@ -290,6 +349,7 @@ gst_inter_video_src_stop (GstBaseSrc * src)
   gst_inter_surface_unref (intervideosrc->surface);
   intervideosrc->surface = NULL;
   gst_buffer_replace (&intervideosrc->black_frame, NULL);
+  gst_buffer_replace (&intervideosrc->last_frame, NULL);
 
   return TRUE;
 }
@@ -319,14 +379,93 @@ gst_inter_video_src_get_times (GstBaseSrc * src, GstBuffer * buffer,
   }
 }
 
+static gboolean
+gst_inter_video_src_unlock (GstBaseSrc * src)
+{
+  GstInterVideoSrc *intervideosrc = GST_INTER_VIDEO_SRC (src);
+
+  GST_DEBUG_OBJECT (intervideosrc, "unlock");
+
+  if (intervideosrc->surface) {
+    g_mutex_lock (&intervideosrc->surface->mutex);
+    intervideosrc->flushing = TRUE;
+    g_cond_broadcast (&intervideosrc->surface->video_cond);
+    g_mutex_unlock (&intervideosrc->surface->mutex);
+  }
+
+  return TRUE;
+}
+
+static gboolean
+gst_inter_video_src_unlock_stop (GstBaseSrc * src)
+{
+  GstInterVideoSrc *intervideosrc = GST_INTER_VIDEO_SRC (src);
+
+  GST_DEBUG_OBJECT (intervideosrc, "unlock_stop");
+
+  if (intervideosrc->surface) {
+    g_mutex_lock (&intervideosrc->surface->mutex);
+    intervideosrc->flushing = FALSE;
+    g_mutex_unlock (&intervideosrc->surface->mutex);
+  }
+
+  return TRUE;
+}
+
+/* Waits until the sink wrote a frame this source did not read yet. Returns
+ * FALSE if the source is flushing. Called with the surface mutex held. */
+static gboolean
+gst_inter_video_src_wait_for_frame (GstInterVideoSrc * intervideosrc)
+{
+  GstInterSurface *surface = intervideosrc->surface;
+  gint64 end_time = -1;
+
+  /* Once the sink failed to deliver within the timeout, stop waiting until
+   * it delivers again, otherwise every repeated frame would take that long */
+  if (intervideosrc->wait_timed_out)
+    return !intervideosrc->flushing;
+
+  if (intervideosrc->timeout > 0)
+    end_time = g_get_monotonic_time () + intervideosrc->timeout / GST_USECOND;
+
+  while (!intervideosrc->flushing &&
+      intervideosrc->read_frame >= surface->video_frame_count) {
+    if (end_time == -1) {
+      g_cond_wait (&surface->video_cond, &surface->mutex);
+    } else if (!g_cond_wait_until (&surface->video_cond, &surface->mutex,
+            end_time)) {
+      GST_DEBUG_OBJECT (intervideosrc, "Timed out waiting for a frame");
+      intervideosrc->wait_timed_out = TRUE;
+      break;
+    }
+  }
+
+  return !intervideosrc->flushing;
+}
+
+static gboolean
+gst_inter_video_src_buffer_is_shareable (GstBuffer * buffer)
+{
+  guint i, n = gst_buffer_n_memory (buffer);
+
+  for (i = 0; i < n; i++) {
+    if (GST_MEMORY_IS_NO_SHARE (gst_buffer_peek_memory (buffer, i)))
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
 static GstFlowReturn
 gst_inter_video_src_create (GstBaseSrc * src, guint64 offset, guint size,
     GstBuffer ** buf)
 {
   GstInterVideoSrc *intervideosrc = GST_INTER_VIDEO_SRC (src);
+  GstInterSurface *surface = intervideosrc->surface;
   GstCaps *caps;
   GstBuffer *buffer;
   guint64 frames;
+  guint64 dropped = 0, duplicated = 0;
   gboolean is_gap = FALSE;
 
   GST_DEBUG_OBJECT (intervideosrc, "create");
@@ -338,7 +477,13 @@ gst_inter_video_src_create (GstBaseSrc * src, guint64 offset, guint size,
       GST_VIDEO_INFO_FPS_N (&intervideosrc->info),
       GST_VIDEO_INFO_FPS_D (&intervideosrc->info) * GST_SECOND);
 
-  g_mutex_lock (&intervideosrc->surface->mutex);
+  g_mutex_lock (&surface->mutex);
+  if (intervideosrc->wait_for_frame &&
+      !gst_inter_video_src_wait_for_frame (intervideosrc)) {
+    g_mutex_unlock (&surface->mutex);
+    return GST_FLOW_FLUSHING;
+  }
+
   if (intervideosrc->surface->video_info.finfo) {
     GstVideoInfo tmp_info = intervideosrc->surface->video_info;
 
@@ -360,25 +505,71 @@ gst_inter_video_src_create (GstBaseSrc * src, guint64 offset, guint size,
     }
   }
 
-  if (intervideosrc->surface->video_buffer) {
+  if (intervideosrc->read_frame < surface->video_frame_count) {
+    GstBuffer **slot;
+    guint64 first_frame = 0;
+
+    if (surface->video_frame_count > surface->video_ring_size)
+      first_frame = surface->video_frame_count - surface->video_ring_size;
+
+    if (intervideosrc->read_frame < first_frame) {
+      GST_LOG_OBJECT (intervideosrc, "Dropped %" G_GUINT64_FORMAT " frames",
+          first_frame - intervideosrc->read_frame);
+      dropped = first_frame - intervideosrc->read_frame;
+      intervideosrc->read_frame = first_frame;
+    }
+
+    slot = gst_inter_surface_peek_video_frame (surface,
+        intervideosrc->read_frame);
+    if (slot && *slot) {
+      /* Output buffers share the memory of the stored buffer, but memory
+       * that can't be shared would be copied again for every repeat and
+       * every source. Replace the stored buffer with a copy that can be
+       * shared instead, once. */
+      if (!gst_inter_video_src_buffer_is_shareable (*slot)) {
+        GstBuffer *copy = gst_buffer_copy_deep (*slot);
+
+        GST_LOG_OBJECT (intervideosrc, "Copying unshareable frame");
+        gst_buffer_unref (*slot);
+        *slot = copy;
+      }
+
+      gst_buffer_replace (&intervideosrc->last_frame, *slot);
+      intervideosrc->repeat_count = 0;
+      intervideosrc->wait_timed_out = FALSE;
+      intervideosrc->read_frame++;
+    } else {
+      /* The sink was stopped, its frames are gone */
+      intervideosrc->read_frame = surface->video_frame_count;
+    }
+  }
+
+  if (intervideosrc->last_frame) {
     /* We have a buffer to push */
-    buffer = gst_buffer_ref (intervideosrc->surface->video_buffer);
+    buffer = gst_buffer_ref (intervideosrc->last_frame);
+    if (intervideosrc->repeat_count != 0)
+      duplicated = 1;
 
     /* Can only be true if timeout > 0 */
-    if (intervideosrc->surface->video_buffer_count == frames) {
-      gst_buffer_unref (intervideosrc->surface->video_buffer);
-      intervideosrc->surface->video_buffer = NULL;
-    }
+    if (intervideosrc->repeat_count == frames)
+      gst_buffer_replace (&intervideosrc->last_frame, NULL);
   }
 
-  if (intervideosrc->surface->video_buffer_count != 0 &&
-      intervideosrc->surface->video_buffer_count != (frames + 1)) {
+  if (intervideosrc->repeat_count != 0 &&
+      intervideosrc->repeat_count != (frames + 1)) {
     /* This is a repeat of the stored buffer or of a black frame */
     is_gap = TRUE;
   }
 
-  intervideosrc->surface->video_buffer_count++;
-  g_mutex_unlock (&intervideosrc->surface->mutex);
+  intervideosrc->repeat_count++;
+  g_mutex_unlock (&surface->mutex);
+
+  if (dropped || duplicated) {
+    GST_OBJECT_LOCK (intervideosrc);
+    intervideosrc->frames_dropped += dropped;
+    intervideosrc->frames_duplicated += duplicated;
+    GST_OBJECT_UNLOCK (intervideosrc);
+  }
 
   if (caps) {
     gboolean ret;
@@ -443,9 +634,11 @@ gst_inter_video_src_create (GstBaseSrc * src, guint64 offset, guint size,
 
   if (buffer == NULL) {
     GST_DEBUG_OBJECT (intervideosrc, "Creating black frame");
-    buffer = gst_buffer_copy (intervideosrc->black_frame);
+    buffer = gst_buffer_ref (intervideosrc->black_frame);
   }
 
+  /* Only copies the metadata, the memory stays shared with the stored or
+   * black frame */
   buffer = gst_buffer_make_writable (buffer);
 
   if (is_gap)
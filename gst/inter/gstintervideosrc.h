@@ -43,11 +43,23 @@ struct _GstInterVideoSrc
 
   char *channel;
   guint64 timeout;
+  gboolean wait_for_frame;
 
   GstVideoInfo info;
   GstBuffer *black_frame;
   int n_frames;
   GstClockTime timestamp_offset;
+
+  /* Protected by the surface mutex */
+  guint64 read_frame;
+  GstBuffer *last_frame;
+  guint64 repeat_count;
+  gboolean wait_timed_out;
+  gboolean flushing;
+
+  /* Statistics, protected by the object lock */
+  guint64 frames_dropped;
+  guint64 frames_duplicated;
 };
 
 struct _GstInterVideoSrcClass
@@ -37,6 +37,10 @@
  * stream is inversed telecine'd back to 24 fps, yielding approximately
  * the original videotestsrc content.
  * </refsect2>
+ *
+ * Setting #GstIvtc:benchmark makes the element measure the time it spends
+ * comparing fields and reconstructing frames. The totals are logged when
+ * the element stops and are available in the #GstIvtc:stats property.
  */
 
 #ifdef HAVE_CONFIG_H
@@ -47,6 +51,7 @@
 #include <gst/base/gstbasetransform.h>
 #include <gst/video/video.h>
 #include "gstivtc.h"
+#include "gstivtcorc.h"
 #include <string.h>
 #include <math.h>
 
@@ -59,6 +64,12 @@ GST_DEBUG_CATEGORY_STATIC (gst_ivtc_debug_category);
 /* prototypes */
 
 
+static void gst_ivtc_set_property (GObject * object, guint property_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_ivtc_get_property (GObject * object, guint property_id,
+    GValue * value, GParamSpec * pspec);
+static gboolean gst_ivtc_start (GstBaseTransform * trans);
+static gboolean gst_ivtc_stop (GstBaseTransform * trans);
 static GstCaps *gst_ivtc_transform_caps (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, GstCaps * filter);
 static GstCaps *gst_ivtc_fixate_caps (GstBaseTransform * trans,
@@ -73,13 +84,18 @@ static void gst_ivtc_flush (GstIvtc * ivtc);
 static void gst_ivtc_retire_fields (GstIvtc * ivtc, int n_fields);
 static void gst_ivtc_construct_frame (GstIvtc * itvc, GstBuffer * outbuf);
 
-static int get_comb_score (GstVideoFrame * top, GstVideoFrame * bottom);
+static int get_comb_score (GstIvtcField * top, GstIvtcField * bottom,
+    int max_score);
 
 enum
 {
-  PROP_0
+  PROP_0,
+  PROP_BENCHMARK,
+  PROP_STATS
 };
 
+#define DEFAULT_BENCHMARK FALSE
+
 /* pad templates */
 
 #define MAX_WIDTH 2048
@@ -114,6 +130,7 @@ G_DEFINE_TYPE_WITH_CODE (GstIvtc, gst_ivtc, GST_TYPE_BASE_TRANSFORM,
 static void
 gst_ivtc_class_init (GstIvtcClass * klass)
 {
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
   GstBaseTransformClass *base_transform_class =
       GST_BASE_TRANSFORM_CLASS (klass);
 
@@ -128,17 +145,134 @@ gst_ivtc_class_init (GstIvtcClass * klass)
       "Inverse Telecine", "Video/Filter", "Inverse Telecine Filter",
       "David Schleef <ds@schleef.org>");
 
+  gobject_class->set_property = gst_ivtc_set_property;
+  gobject_class->get_property = gst_ivtc_get_property;
+  base_transform_class->start = GST_DEBUG_FUNCPTR (gst_ivtc_start);
+  base_transform_class->stop = GST_DEBUG_FUNCPTR (gst_ivtc_stop);
   base_transform_class->transform_caps =
       GST_DEBUG_FUNCPTR (gst_ivtc_transform_caps);
   base_transform_class->fixate_caps = GST_DEBUG_FUNCPTR (gst_ivtc_fixate_caps);
   base_transform_class->set_caps = GST_DEBUG_FUNCPTR (gst_ivtc_set_caps);
   base_transform_class->sink_event = GST_DEBUG_FUNCPTR (gst_ivtc_sink_event);
   base_transform_class->transform = GST_DEBUG_FUNCPTR (gst_ivtc_transform);
+
+  /**
+   * GstIvtc:benchmark:
+   *
+   * Measure the time spent comparing fields and reconstructing frames.
+   *
+   * Since: 1.12
+   */
+  g_object_class_install_property (gobject_class, PROP_BENCHMARK,
+      g_param_spec_boolean ("benchmark", "Benchmark",
+          "Measure the time spent comparing fields and reconstructing frames",
+          DEFAULT_BENCHMARK, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstIvtc:stats:
+   *
+   * Statistics of the inverse telecine: the number of output frames and
+   * compared field pairs, and, if #GstIvtc:benchmark is enabled, the total
+   * time spent comparing fields and reconstructing frames (in nanoseconds).
+   *
+   * Since: 1.12
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Number of output frames and compared field pairs, and time spent "
+          "comparing fields and reconstructing frames", GST_TYPE_STRUCTURE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
 gst_ivtc_init (GstIvtc * ivtc)
 {
+  ivtc->benchmark = DEFAULT_BENCHMARK;
+}
+
+static void
+gst_ivtc_set_property (GObject * object, guint property_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstIvtc *ivtc = GST_IVTC (object);
+
+  switch (property_id) {
+    case PROP_BENCHMARK:
+      GST_OBJECT_LOCK (ivtc);
+      ivtc->benchmark = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (ivtc);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_ivtc_get_property (GObject * object, guint property_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstIvtc *ivtc = GST_IVTC (object);
+
+  switch (property_id) {
+    case PROP_BENCHMARK:
+      GST_OBJECT_LOCK (ivtc);
+      g_value_set_boolean (value, ivtc->benchmark);
+      GST_OBJECT_UNLOCK (ivtc);
+      break;
+    case PROP_STATS:
+      GST_OBJECT_LOCK (ivtc);
+      g_value_take_boxed (value,
+          gst_structure_new ("application/x-ivtc-stats",
+              "frames", G_TYPE_UINT64, ivtc->n_frames,
+              "scored", G_TYPE_UINT64, ivtc->n_scored,
+              "similarity-time", G_TYPE_UINT64, ivtc->similarity_time,
+              "reconstruct-time", G_TYPE_UINT64, ivtc->reconstruct_time,
+              NULL));
+      GST_OBJECT_UNLOCK (ivtc);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static gboolean
+gst_ivtc_start (GstBaseTransform * trans)
+{
+  GstIvtc *ivtc = GST_IVTC (trans);
+
+  GST_OBJECT_LOCK (ivtc);
+  ivtc->n_frames = 0;
+  ivtc->n_scored = 0;
+  ivtc->similarity_time = 0;
+  ivtc->reconstruct_time = 0;
+  GST_OBJECT_UNLOCK (ivtc);
+
+  return TRUE;
+}
+
+static gboolean
+gst_ivtc_stop (GstBaseTransform * trans)
+{
+  GstIvtc *ivtc = GST_IVTC (trans);
+
+  gst_ivtc_retire_fields (ivtc, ivtc->n_fields);
+
+  GST_OBJECT_LOCK (ivtc);
+  if (ivtc->benchmark && ivtc->n_frames > 0) {
+    GST_INFO_OBJECT (ivtc, "%" G_GUINT64_FORMAT " frames, %" G_GUINT64_FORMAT
+        " field pairs compared in %" GST_TIME_FORMAT " (%" G_GUINT64_FORMAT
+        " ns per frame), reconstructed in %" GST_TIME_FORMAT " (%"
+        G_GUINT64_FORMAT " ns per frame)", ivtc->n_frames, ivtc->n_scored,
+        GST_TIME_ARGS (ivtc->similarity_time),
+        ivtc->similarity_time / ivtc->n_frames,
+        GST_TIME_ARGS (ivtc->reconstruct_time),
+        ivtc->reconstruct_time / ivtc->n_frames);
+  }
+  GST_OBJECT_UNLOCK (ivtc);
+
+  return TRUE;
 }
 
 static GstCaps *
@@ -299,6 +433,8 @@ add_field (GstIvtc * ivtc, GstBuffer * buffer, int parity, int index)
   field->buffer = gst_buffer_ref (buffer);
   field->parity = parity;
   field->ts = ts;
+  field->envelope[TOP_FIELD] = NULL;
+  field->envelope[BOTTOM_FIELD] = NULL;
 
   gst_video_frame_map (&ivtc->fields[i].frame, &ivtc->sink_video_info,
       buffer, GST_MAP_READ);
@@ -306,8 +442,10 @@ add_field (GstIvtc * ivtc, GstBuffer * buffer, int parity, int index)
   ivtc->n_fields++;
 }
 
+/* scores above max_score are not computed exactly, only known to be at
+ * least max_score */
 static int
-similarity (GstIvtc * ivtc, int i1, int i2)
+similarity (GstIvtc * ivtc, int i1, int i2, int max_score)
 {
   GstIvtcField *f1, *f2;
   int score;
@@ -319,9 +457,9 @@ similarity (GstIvtc * ivtc, int i1, int i2)
   f2 = &ivtc->fields[i2];
 
   if (f1->parity == TOP_FIELD) {
-    score = get_comb_score (&f1->frame, &f2->frame);
+    score = get_comb_score (f1, f2, max_score);
   } else {
-    score = get_comb_score (&f2->frame, &f1->frame);
+    score = get_comb_score (f2, f1, max_score);
   }
 
   GST_DEBUG ("score %d", score);
@@ -366,24 +504,6 @@ reconstruct (GstIvtc * ivtc, GstVideoFrame * dest_frame, int i1, int i2)
 
 }
 
-static int
-reconstruct_line (guint8 * line1, guint8 * line2, int i, int a, int b, int c,
-    int d)
-{
-  int x;
-
-  x = line1[i - 3] * a;
-  x += line1[i - 2] * b;
-  x += line1[i - 1] * c;
-  x += line1[i - 0] * d;
-  x += line2[i + 0] * d;
-  x += line2[i + 1] * c;
-  x += line2[i + 2] * b;
-  x += line2[i + 3] * a;
-  return (x + 16) >> 5;
-}
-
-
 static void
 reconstruct_single (GstIvtc * ivtc, GstVideoFrame * dest_frame, int i1)
 {
@@ -392,6 +512,9 @@ reconstruct_single (GstIvtc * ivtc, GstVideoFrame * dest_frame, int i1)
   int height;
   int width;
   GstIvtcField *field = &ivtc->fields[i1];
+  guint8 classes[MAX_WIDTH];
+  guint16 sums[MAX_WIDTH];
+  guint16 sums2[MAX_WIDTH];
 
   for (k = 0; k < 1; k++) {
     height = GST_VIDEO_FRAME_COMP_HEIGHT (dest_frame, k);
@@ -408,56 +531,32 @@ reconstruct_single (GstIvtc * ivtc, GstVideoFrame * dest_frame, int i1)
           guint8 *dest = GET_LINE (dest_frame, k, j);
           guint8 *line1 = GET_LINE (&field->frame, k, j - 1);
           guint8 *line2 = GET_LINE (&field->frame, k, j + 1);
-          int i;
 
+          /* interpolate along the edge found between the lines, with filters
+           * of up to 8 taps, except in the margins where the taps would go
+           * beyond the line */
 #define MARGIN 3
-          for (i = MARGIN; i < width - MARGIN; i++) {
-            int dx, dy;
-
-            dx = -line1[i - 1] - line2[i - 1] + line1[i + 1] + line2[i + 1];
-            dx *= 2;
-
-            dy = -line1[i - 1] - 2 * line1[i] - line1[i + 1]
-                + line2[i - 1] + 2 * line2[i] + line2[i + 1];
-            if (dy < 0) {
-              dy = -dy;
-              dx = -dx;
-            }
-
-            if (dx == 0 && dy == 0) {
-              dest[i] = (line1[i] + line2[i] + 1) >> 1;
-            } else if (dx < 0) {
-              if (dx < -2 * dy) {
-                dest[i] = reconstruct_line (line1, line2, i, 0, 0, 0, 16);
-              } else if (dx < -dy) {
-                dest[i] = reconstruct_line (line1, line2, i, 0, 0, 8, 8);
-              } else if (2 * dx < -dy) {
-                dest[i] = reconstruct_line (line1, line2, i, 0, 4, 8, 4);
-              } else if (3 * dx < -dy) {
-                dest[i] = reconstruct_line (line1, line2, i, 1, 7, 7, 1);
-              } else {
-                dest[i] = reconstruct_line (line1, line2, i, 4, 8, 4, 0);
-              }
-            } else {
-              if (dx > 2 * dy) {
-                dest[i] = reconstruct_line (line2, line1, i, 0, 0, 0, 16);
-              } else if (dx > dy) {
-                dest[i] = reconstruct_line (line2, line1, i, 0, 0, 8, 8);
-              } else if (2 * dx > dy) {
-                dest[i] = reconstruct_line (line2, line1, i, 0, 4, 8, 4);
-              } else if (3 * dx > dy) {
-                dest[i] = reconstruct_line (line2, line1, i, 1, 7, 7, 1);
-              } else {
-                dest[i] = reconstruct_line (line2, line1, i, 4, 8, 4, 0);
-              }
-            }
-          }
-
-          for (i = 0; i < MARGIN; i++) {
-            dest[i] = (line1[i] + line2[i] + 1) >> 1;
-          }
-          for (i = width - MARGIN; i < width; i++) {
-            dest[i] = (line1[i] + line2[i] + 1) >> 1;
+          if (width > 2 * MARGIN) {
+            const int n = width - 2 * MARGIN;
+
+            /* classes and accumulated weighted sums of the samples */
+            ivtc_orc_reconstruct_classify (classes, sums,
+                line1 + MARGIN - 1, line1 + MARGIN, line1 + MARGIN + 1,
+                line2 + MARGIN - 1, line2 + MARGIN, line2 + MARGIN + 1, n);
+            /* edges leaning left */
+            ivtc_orc_reconstruct_taps (sums2, line1, line1 + 1, line1 + 2,
+                line2 + 2 * MARGIN - 2, line2 + 2 * MARGIN - 1,
+                line2 + 2 * MARGIN, classes, sums, 0, n);
+            /* edges leaning right */
+            ivtc_orc_reconstruct_taps_final (dest + MARGIN, line2, line2 + 1,
+                line2 + 2, line1 + 2 * MARGIN - 2, line1 + 2 * MARGIN - 1,
+                line1 + 2 * MARGIN, classes, sums2, 4, n);
+
+            ivtc_orc_average_lines (dest, line1, line2, MARGIN);
+            ivtc_orc_average_lines (dest + width - MARGIN,
+                line1 + width - MARGIN, line2 + width - MARGIN, MARGIN);
+          } else {
+            ivtc_orc_average_lines (dest, line1, line2, width);
           }
         }
       }
@@ -478,10 +577,8 @@ reconstruct_single (GstIvtc * ivtc, GstVideoFrame * dest_frame, int i1)
           guint8 *dest = GET_LINE (dest_frame, k, j);
           guint8 *line1 = GET_LINE (&field->frame, k, j - 1);
           guint8 *line2 = GET_LINE (&field->frame, k, j + 1);
-          int i;
-          for (i = 0; i < width; i++) {
-            dest[i] = (line1[i] + line2[i] + 1) >> 1;
-          }
+
+          ivtc_orc_average_lines (dest, line1, line2, width);
         }
       }
     }
@@ -499,6 +596,8 @@ gst_ivtc_retire_fields (GstIvtc * ivtc, int n_fields)
   for (i = 0; i < n_fields; i++) {
     gst_video_frame_unmap (&ivtc->fields[i].frame);
     gst_buffer_unref (ivtc->fields[i].buffer);
+    g_free (ivtc->fields[i].envelope[TOP_FIELD]);
+    g_free (ivtc->fields[i].envelope[BOTTOM_FIELD]);
   }
 
   memmove (ivtc->fields, ivtc->fields + n_fields,
@@ -568,6 +667,8 @@ gst_ivtc_construct_frame (GstIvtc * ivtc, GstBuffer * outbuf)
   GstVideoFrame dest_frame;
   int n_retire;
   gboolean forward_ok;
+  gboolean benchmark;
+  GstClockTime start = 0, scored = 0;
 
   anchor_index = 1;
   if (ivtc->fields[anchor_index].ts < ivtc->current_ts) {
@@ -576,13 +677,26 @@ gst_ivtc_construct_frame (GstIvtc * ivtc, GstBuffer * outbuf)
     forward_ok = FALSE;
   }
 
-  prev_score = similarity (ivtc, anchor_index - 1, anchor_index);
-  next_score = similarity (ivtc, anchor_index, anchor_index + 1);
+  GST_OBJECT_LOCK (ivtc);
+  benchmark = ivtc->benchmark;
+  GST_OBJECT_UNLOCK (ivtc);
+  if (benchmark)
+    start = gst_util_get_timestamp ();
+
+  /* the decisions below don't depend on the exact value of scores from
+   * twice the threshold on */
+#define THRESHOLD 100
+  prev_score = similarity (ivtc, anchor_index - 1, anchor_index,
+      THRESHOLD * 2);
+  next_score = similarity (ivtc, anchor_index, anchor_index + 1,
+      THRESHOLD * 2);
+
+  if (benchmark)
+    scored = gst_util_get_timestamp ();
 
   gst_video_frame_map (&dest_frame, &ivtc->src_video_info, outbuf,
       GST_MAP_WRITE);
 
-#define THRESHOLD 100
   if (prev_score < THRESHOLD) {
     if (forward_ok && next_score < prev_score) {
       reconstruct (ivtc, &dest_frame, anchor_index, anchor_index + 1);
@@ -612,11 +726,25 @@ gst_ivtc_construct_frame (GstIvtc * ivtc, GstBuffer * outbuf)
     n_retire = anchor_index + 1;
   }
 
+  gst_video_frame_unmap (&dest_frame);
+
+  GST_OBJECT_LOCK (ivtc);
+  ivtc->n_frames++;
+  ivtc->n_scored += 2;
+  if (benchmark) {
+    GstClockTime done = gst_util_get_timestamp ();
+
+    GST_LOG_OBJECT (ivtc, "compared fields in %" GST_TIME_FORMAT
+        ", reconstructed frame in %" GST_TIME_FORMAT,
+        GST_TIME_ARGS (scored - start), GST_TIME_ARGS (done - scored));
+    ivtc->similarity_time += scored - start;
+    ivtc->reconstruct_time += done - scored;
+  }
+  GST_OBJECT_UNLOCK (ivtc);
+
   GST_DEBUG ("retiring %d", n_retire);
   gst_ivtc_retire_fields (ivtc, n_retire);
 
-  gst_video_frame_unmap (&dest_frame);
-
   GST_BUFFER_PTS (outbuf) = ivtc->current_ts;
   GST_BUFFER_DTS (outbuf) = ivtc->current_ts;
   /* FIXME this is not how to produce durations */
@@ -629,33 +757,90 @@ gst_ivtc_construct_frame (GstIvtc * ivtc, GstBuffer * outbuf)
 
 }
 
+/* Returns the bounds of the luma values a sample of the other field can
+ * take without looking combed, at the lines of the other field between lines
+ * 2 and height - 3. Rows of the envelope hold the lower bounds followed by
+ * the upper bounds of one line. The envelope is computed the first time it is
+ * needed, so every field is analysed once even though it is compared to both
+ * the previous and the next field. */
+static const guint8 *
+get_comb_envelope (GstIvtcField * field, int role)
+{
+  int j;
+  int height;
+  int width;
+  int k = 0;
+
+  if (field->envelope[role])
+    return field->envelope[role];
+
+  height = GST_VIDEO_FRAME_COMP_HEIGHT (&field->frame, 0);
+  width = GST_VIDEO_FRAME_COMP_WIDTH (&field->frame, 0);
+
+  field->envelope[role] = g_malloc (((height >> 1) + 1) * 2 * width);
+
+  for (j = (role == TOP_FIELD) ? 3 : 2; j < height - 2; j += 2) {
+    guint8 *lo = field->envelope[role] + (j >> 1) * 2 * width;
+
+    ivtc_orc_comb_envelope (lo, lo + width, GET_LINE (&field->frame, 0, j - 1),
+        GET_LINE (&field->frame, 0, j + 1), width);
+  }
+
+  return field->envelope[role];
+}
+
 static int
-get_comb_score (GstVideoFrame * top, GstVideoFrame * bottom)
+get_comb_score (GstIvtcField * top, GstIvtcField * bottom, int max_score)
 {
   int j;
   int thisline[MAX_WIDTH];
+  guint8 comb[MAX_WIDTH];
+  gboolean thisline_is_zero;
+  const guint8 *top_envelope, *bottom_envelope;
   int score = 0;
   int height;
   int width;
   int k;
 
-  height = GST_VIDEO_FRAME_COMP_HEIGHT (top, 0);
-  width = GST_VIDEO_FRAME_COMP_WIDTH (top, 0);
+  height = GST_VIDEO_FRAME_COMP_HEIGHT (&top->frame, 0);
+  width = GST_VIDEO_FRAME_COMP_WIDTH (&top->frame, 0);
 
-  memset (thisline, 0, sizeof (thisline));
+  top_envelope = get_comb_envelope (top, TOP_FIELD);
+  bottom_envelope = get_comb_envelope (bottom, BOTTOM_FIELD);
+
+  memset (thisline, 0, width * sizeof (int));
+  thisline_is_zero = TRUE;
 
   k = 0;
   /* remove a few lines from top and bottom, as they sometimes contain
    * artifacts */
   for (j = 2; j < height - 2; j++) {
-    guint8 *src1 = GET_LINE_IL (top, bottom, 0, j - 1);
-    guint8 *src2 = GET_LINE_IL (top, bottom, 0, j);
-    guint8 *src3 = GET_LINE_IL (top, bottom, 0, j + 1);
+    const guint8 *envelope;
+    guint8 *src;
     int i;
 
+    if (j & 1) {
+      src = GET_LINE (&bottom->frame, 0, j);
+      envelope = top_envelope + (j >> 1) * 2 * width;
+    } else {
+      src = GET_LINE (&top->frame, 0, j);
+      envelope = bottom_envelope + (j >> 1) * 2 * width;
+    }
+
+    ivtc_orc_comb_mask (comb, src, envelope, envelope + width, width);
+
+    /* most lines of a matching pair of fields have no combed sample at all */
+    if (memchr (comb, 1, width) == NULL) {
+      if (!thisline_is_zero) {
+        memset (thisline, 0, width * sizeof (int));
+        thisline_is_zero = TRUE;
+      }
+      continue;
+    }
+    thisline_is_zero = FALSE;
+
     for (i = 0; i < width; i++) {
-      if (src2[i] < MIN (src1[i], src3[i]) - 5 ||
-          src2[i] > MAX (src1[i], src3[i]) + 5) {
+      if (comb[i]) {
         if (i > 0) {
           thisline[i] += thisline[i - 1];
         }
@@ -669,6 +854,9 @@ get_comb_score (GstVideoFrame * top, GstVideoFrame * bottom)
         score++;
       }
     }
+
+    if (score >= max_score)
+      break;
   }
 
   GST_DEBUG ("score %d", score);
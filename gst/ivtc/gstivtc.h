@@ -41,6 +41,11 @@ struct _GstIvtcField
   int parity;
   GstVideoFrame frame;
   GstClockTime ts;
+
+  /* bounds of the luma values between the lines of this field, when it is
+   * used as top (0) or bottom (1) field of a frame, or NULL if not computed
+   * yet */
+  guint8 *envelope[2];
 };
 
 #define GST_IVTC_MAX_FIELDS 10
@@ -58,6 +63,15 @@ struct _GstIvtc
 
   int n_fields;
   GstIvtcField fields[GST_IVTC_MAX_FIELDS];
+
+  /* properties */
+  gboolean benchmark;
+
+  /* benchmark statistics, protected by the object lock */
+  guint64 n_frames;
+  guint64 n_scored;
+  GstClockTime similarity_time;
+  GstClockTime reconstruct_time;
 };
 
 struct _GstIvtcClass
@@ -0,0 +1,2626 @@
+
+/* autogenerated from gstivtcorc.orc */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <glib.h>
+
+#ifndef _ORC_INTEGER_TYPEDEFS_
+#define _ORC_INTEGER_TYPEDEFS_
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
+#include <stdint.h>
+typedef int8_t orc_int8;
+typedef int16_t orc_int16;
+typedef int32_t orc_int32;
+typedef int64_t orc_int64;
+typedef uint8_t orc_uint8;
+typedef uint16_t orc_uint16;
+typedef uint32_t orc_uint32;
+typedef uint64_t orc_uint64;
+#define ORC_UINT64_C(x) UINT64_C(x)
+#elif defined(_MSC_VER)
+typedef signed __int8 orc_int8;
+typedef signed __int16 orc_int16;
+typedef signed __int32 orc_int32;
+typedef signed __int64 orc_int64;
+typedef unsigned __int8 orc_uint8;
+typedef unsigned __int16 orc_uint16;
+typedef unsigned __int32 orc_uint32;
+typedef unsigned __int64 orc_uint64;
+#define ORC_UINT64_C(x) (x##Ui64)
+#define inline __inline
+#else
+#include <limits.h>
+typedef signed char orc_int8;
+typedef short orc_int16;
+typedef int orc_int32;
+typedef unsigned char orc_uint8;
+typedef unsigned short orc_uint16;
+typedef unsigned int orc_uint32;
+#if INT_MAX == LONG_MAX
+typedef long long orc_int64;
+typedef unsigned long long orc_uint64;
+#define ORC_UINT64_C(x) (x##ULL)
+#else
+typedef long orc_int64;
+typedef unsigned long orc_uint64;
+#define ORC_UINT64_C(x) (x##UL)
+#endif
+#endif
+typedef union
+{
+  orc_int16 i;
+  orc_int8 x2[2];
+} orc_union16;
+typedef union
+{
+  orc_int32 i;
+  float f;
+  orc_int16 x2[2];
+  orc_int8 x4[4];
+} orc_union32;
+typedef union
+{
+  orc_int64 i;
+  double f;
+  orc_int32 x2[2];
+  float x2f[2];
+  orc_int16 x4[4];
+} orc_union64;
+#endif
+#ifndef ORC_RESTRICT
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
+#define ORC_RESTRICT restrict
+#elif defined(__GNUC__) && __GNUC__ >= 4
+#define ORC_RESTRICT __restrict__
+#else
+#define ORC_RESTRICT
+#endif
+#endif
+
+#ifndef ORC_INTERNAL
+#if defined(__SUNPRO_C) && (__SUNPRO_C >= 0x590)
+#define ORC_INTERNAL __attribute__((visibility("hidden")))
+#elif defined(__SUNPRO_C) && (__SUNPRO_C >= 0x550)
+#define ORC_INTERNAL __hidden
+#elif defined (__GNUC__)
+#define ORC_INTERNAL __attribute__((visibility("hidden")))
+#else
+#define ORC_INTERNAL
+#endif
+#endif
+
+
+#ifndef DISABLE_ORC
+#include <orc/orc.h>
+#endif
+void ivtc_orc_comb_envelope (guint8 * ORC_RESTRICT d1, guint8 * ORC_RESTRICT d2,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n);
+void ivtc_orc_comb_mask (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, int n);
+void ivtc_orc_reconstruct_classify (guint8 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, const guint8 * ORC_RESTRICT s1,
+    const guint8 * ORC_RESTRICT s2, const guint8 * ORC_RESTRICT s3,
+    const guint8 * ORC_RESTRICT s4, const guint8 * ORC_RESTRICT s5,
+    const guint8 * ORC_RESTRICT s6, int n);
+void ivtc_orc_reconstruct_taps (guint16 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4,
+    const guint8 * ORC_RESTRICT s5, const guint8 * ORC_RESTRICT s6,
+    const guint8 * ORC_RESTRICT s7, const guint16 * ORC_RESTRICT s8, int p1,
+    int n);
+void ivtc_orc_reconstruct_taps_final (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4,
+    const guint8 * ORC_RESTRICT s5, const guint8 * ORC_RESTRICT s6,
+    const guint8 * ORC_RESTRICT s7, const guint16 * ORC_RESTRICT s8, int p1,
+    int n);
+void ivtc_orc_average_lines (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n);
+
+
+/* begin Orc C target preamble */
+#define ORC_CLAMP(x,a,b) ((x)<(a) ? (a) : ((x)>(b) ? (b) : (x)))
+#define ORC_ABS(a) ((a)<0 ? -(a) : (a))
+#define ORC_MIN(a,b) ((a)<(b) ? (a) : (b))
+#define ORC_MAX(a,b) ((a)>(b) ? (a) : (b))
+#define ORC_SB_MAX 127
+#define ORC_SB_MIN (-1-ORC_SB_MAX)
+#define ORC_UB_MAX 255
+#define ORC_UB_MIN 0
+#define ORC_SW_MAX 32767
+#define ORC_SW_MIN (-1-ORC_SW_MAX)
+#define ORC_UW_MAX 65535
+#define ORC_UW_MIN 0
+#define ORC_SL_MAX 2147483647
+#define ORC_SL_MIN (-1-ORC_SL_MAX)
+#define ORC_UL_MAX 4294967295U
+#define ORC_UL_MIN 0
+#define ORC_CLAMP_SB(x) ORC_CLAMP(x,ORC_SB_MIN,ORC_SB_MAX)
+#define ORC_CLAMP_UB(x) ORC_CLAMP(x,ORC_UB_MIN,ORC_UB_MAX)
+#define ORC_CLAMP_SW(x) ORC_CLAMP(x,ORC_SW_MIN,ORC_SW_MAX)
+#define ORC_CLAMP_UW(x) ORC_CLAMP(x,ORC_UW_MIN,ORC_UW_MAX)
+#define ORC_CLAMP_SL(x) ORC_CLAMP(x,ORC_SL_MIN,ORC_SL_MAX)
+#define ORC_CLAMP_UL(x) ORC_CLAMP(x,ORC_UL_MIN,ORC_UL_MAX)
+#define ORC_SWAP_W(x) ((((x)&0xffU)<<8) | (((x)&0xff00U)>>8))
+#define ORC_SWAP_L(x) ((((x)&0xffU)<<24) | (((x)&0xff00U)<<8) | (((x)&0xff0000U)>>8) | (((x)&0xff000000U)>>24))
+#define ORC_SWAP_Q(x) ((((x)&ORC_UINT64_C(0xff))<<56) | (((x)&ORC_UINT64_C(0xff00))<<40) | (((x)&ORC_UINT64_C(0xff0000))<<24) | (((x)&ORC_UINT64_C(0xff000000))<<8) | (((x)&ORC_UINT64_C(0xff00000000))>>8) | (((x)&ORC_UINT64_C(0xff0000000000))>>24) | (((x)&ORC_UINT64_C(0xff000000000000))>>40) | (((x)&ORC_UINT64_C(0xff00000000000000))>>56))
+#define ORC_PTR_OFFSET(ptr,offset) ((void *)(((unsigned char *)(ptr)) + (offset)))
+#define ORC_DENORMAL(x) ((x) & ((((x)&0x7f800000) == 0) ? 0xff800000 : 0xffffffff))
+#define ORC_ISNAN(x) ((((x)&0x7f800000) == 0x7f800000) && (((x)&0x007fffff) != 0))
+#define ORC_DENORMAL_DOUBLE(x) ((x) & ((((x)&ORC_UINT64_C(0x7ff0000000000000)) == 0) ? ORC_UINT64_C(0xfff0000000000000) : ORC_UINT64_C(0xffffffffffffffff)))
+#define ORC_ISNAN_DOUBLE(x) ((((x)&ORC_UINT64_C(0x7ff0000000000000)) == ORC_UINT64_C(0x7ff0000000000000)) && (((x)&ORC_UINT64_C(0x000fffffffffffff)) != 0))
+#ifndef ORC_RESTRICT
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
+#define ORC_RESTRICT restrict
+#elif defined(__GNUC__) && __GNUC__ >= 4
+#define ORC_RESTRICT __restrict__
+#else
+#define ORC_RESTRICT
+#endif
+#endif
+/* end Orc C target preamble */
+
+
+
+/* ivtc_orc_comb_envelope */
+#ifdef DISABLE_ORC
+void
+ivtc_orc_comb_envelope (guint8 * ORC_RESTRICT d1, guint8 * ORC_RESTRICT d2,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  orc_int8 *ORC_RESTRICT ptr1;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  orc_int8 var36;
+  orc_int8 var37;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var38;
+#else
+  orc_union16 var38;
+#endif
+  orc_int8 var39;
+  orc_int8 var40;
+  orc_union16 var41;
+  orc_union16 var42;
+  orc_union16 var43;
+  orc_union16 var44;
+  orc_union16 var45;
+  orc_union16 var46;
+  orc_union16 var47;
+  orc_union16 var48;
+  orc_union16 var49;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr1 = (orc_int8 *) d2;
+  ptr4 = (orc_int8 *) s1;
+  ptr5 = (orc_int8 *) s2;
+
+  /* 9: loadpw */
+  var38.i = (int) 0x00000005;   /* 5 or 2.47033e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var36 = ptr4[i];
+    /* 1: convubw */
+    var41.i = (orc_uint8) var36;
+    /* 2: loadb */
+    var37 = ptr5[i];
+    /* 3: convubw */
+    var42.i = (orc_uint8) var37;
+    /* 4: subw */
+    var43.i = var41.i - var42.i;
+    /* 5: cmpgtsw */
+    var44.i = (var41.i > var42.i) ? (~0) : 0;
+    /* 6: andw */
+    var45.i = var43.i & var44.i;
+    /* 7: subw */
+    var46.i = var41.i - var45.i;
+    /* 8: addw */
+    var47.i = var42.i + var45.i;
+    /* 10: subw */
+    var48.i = var46.i - var38.i;
+    /* 11: convsuswb */
+    var39 = ORC_CLAMP_UB (var48.i);
+    /* 12: storeb */
+    ptr0[i] = var39;
+    /* 13: addw */
+    var49.i = var47.i + var38.i;
+    /* 14: convsuswb */
+    var40 = ORC_CLAMP_UB (var49.i);
+    /* 15: storeb */
+    ptr1[i] = var40;
+  }
+
+}
+
+#else
+static void
+_backup_ivtc_orc_comb_envelope (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  orc_int8 *ORC_RESTRICT ptr1;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  orc_int8 var36;
+  orc_int8 var37;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var38;
+#else
+  orc_union16 var38;
+#endif
+  orc_int8 var39;
+  orc_int8 var40;
+  orc_union16 var41;
+  orc_union16 var42;
+  orc_union16 var43;
+  orc_union16 var44;
+  orc_union16 var45;
+  orc_union16 var46;
+  orc_union16 var47;
+  orc_union16 var48;
+  orc_union16 var49;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr1 = (orc_int8 *) ex->arrays[1];
+  ptr4 = (orc_int8 *) ex->arrays[4];
+  ptr5 = (orc_int8 *) ex->arrays[5];
+
+  /* 9: loadpw */
+  var38.i = (int) 0x00000005;   /* 5 or 2.47033e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var36 = ptr4[i];
+    /* 1: convubw */
+    var41.i = (orc_uint8) var36;
+    /* 2: loadb */
+    var37 = ptr5[i];
+    /* 3: convubw */
+    var42.i = (orc_uint8) var37;
+    /* 4: subw */
+    var43.i = var41.i - var42.i;
+    /* 5: cmpgtsw */
+    var44.i = (var41.i > var42.i) ? (~0) : 0;
+    /* 6: andw */
+    var45.i = var43.i & var44.i;
+    /* 7: subw */
+    var46.i = var41.i - var45.i;
+    /* 8: addw */
+    var47.i = var42.i + var45.i;
+    /* 10: subw */
+    var48.i = var46.i - var38.i;
+    /* 11: convsuswb */
+    var39 = ORC_CLAMP_UB (var48.i);
+    /* 12: storeb */
+    ptr0[i] = var39;
+    /* 13: addw */
+    var49.i = var47.i + var38.i;
+    /* 14: convsuswb */
+    var40 = ORC_CLAMP_UB (var49.i);
+    /* 15: storeb */
+    ptr1[i] = var40;
+  }
+
+}
+
+void
+ivtc_orc_comb_envelope (guint8 * ORC_RESTRICT d1, guint8 * ORC_RESTRICT d2,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 22, 105, 118, 116, 99, 95, 111, 114, 99, 95, 99, 111, 109, 98,
+        95, 101, 110, 118, 101, 108, 111, 112, 101, 11, 1, 1, 11, 1, 1, 12,
+        1, 1, 12, 1, 1, 14, 2, 5, 0, 0, 0, 20, 2, 20, 2, 20,
+        2, 20, 2, 150, 32, 4, 150, 33, 5, 98, 34, 32, 33, 78, 35, 32,
+        33, 73, 34, 34, 35, 98, 32, 32, 34, 70, 33, 33, 34, 98, 32, 32,
+        16, 160, 0, 32, 70, 33, 33, 16, 160, 1, 33, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_ivtc_orc_comb_envelope);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "ivtc_orc_comb_envelope");
+      orc_program_set_backup_function (p, _backup_ivtc_orc_comb_envelope);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_destination (p, 1, "d2");
+      orc_program_add_source (p, 1, "s1");
+      orc_program_add_source (p, 1, "s2");
+      orc_program_add_constant (p, 2, 0x00000005, "c1");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 2, "t3");
+      orc_program_add_temporary (p, 2, "t4");
+
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T2, ORC_VAR_S2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T4, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 0, ORC_VAR_D1, ORC_VAR_T1,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 0, ORC_VAR_D2, ORC_VAR_T2,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_D2] = d2;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* ivtc_orc_comb_mask */
+#ifdef DISABLE_ORC
+void
+ivtc_orc_comb_mask (guint8 * ORC_RESTRICT d1, const guint8 * ORC_RESTRICT s1,
+    const guint8 * ORC_RESTRICT s2, const guint8 * ORC_RESTRICT s3, int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  orc_int8 var35;
+  orc_int8 var36;
+  orc_int8 var37;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var38;
+#else
+  orc_union16 var38;
+#endif
+  orc_int8 var39;
+  orc_union16 var40;
+  orc_union16 var41;
+  orc_union16 var42;
+  orc_union16 var43;
+  orc_union16 var44;
+  orc_union16 var45;
+  orc_union16 var46;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr4 = (orc_int8 *) s1;
+  ptr5 = (orc_int8 *) s2;
+  ptr6 = (orc_int8 *) s3;
+
+  /* 9: loadpw */
+  var38.i = (int) 0x00000001;   /* 1 or 4.94066e-324f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var35 = ptr4[i];
+    /* 1: convubw */
+    var40.i = (orc_uint8) var35;
+    /* 2: loadb */
+    var36 = ptr5[i];
+    /* 3: convubw */
+    var41.i = (orc_uint8) var36;
+    /* 4: cmpgtsw */
+    var42.i = (var41.i > var40.i) ? (~0) : 0;
+    /* 5: loadb */
+    var37 = ptr6[i];
+    /* 6: convubw */
+    var43.i = (orc_uint8) var37;
+    /* 7: cmpgtsw */
+    var44.i = (var40.i > var43.i) ? (~0) : 0;
+    /* 8: orw */
+    var45.i = var42.i | var44.i;
+    /* 10: andw */
+    var46.i = var45.i & var38.i;
+    /* 11: convsuswb */
+    var39 = ORC_CLAMP_UB (var46.i);
+    /* 12: storeb */
+    ptr0[i] = var39;
+  }
+
+}
+
+#else
+static void
+_backup_ivtc_orc_comb_mask (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  orc_int8 var35;
+  orc_int8 var36;
+  orc_int8 var37;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var38;
+#else
+  orc_union16 var38;
+#endif
+  orc_int8 var39;
+  orc_union16 var40;
+  orc_union16 var41;
+  orc_union16 var42;
+  orc_union16 var43;
+  orc_union16 var44;
+  orc_union16 var45;
+  orc_union16 var46;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr4 = (orc_int8 *) ex->arrays[4];
+  ptr5 = (orc_int8 *) ex->arrays[5];
+  ptr6 = (orc_int8 *) ex->arrays[6];
+
+  /* 9: loadpw */
+  var38.i = (int) 0x00000001;   /* 1 or 4.94066e-324f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var35 = ptr4[i];
+    /* 1: convubw */
+    var40.i = (orc_uint8) var35;
+    /* 2: loadb */
+    var36 = ptr5[i];
+    /* 3: convubw */
+    var41.i = (orc_uint8) var36;
+    /* 4: cmpgtsw */
+    var42.i = (var41.i > var40.i) ? (~0) : 0;
+    /* 5: loadb */
+    var37 = ptr6[i];
+    /* 6: convubw */
+    var43.i = (orc_uint8) var37;
+    /* 7: cmpgtsw */
+    var44.i = (var40.i > var43.i) ? (~0) : 0;
+    /* 8: orw */
+    var45.i = var42.i | var44.i;
+    /* 10: andw */
+    var46.i = var45.i & var38.i;
+    /* 11: convsuswb */
+    var39 = ORC_CLAMP_UB (var46.i);
+    /* 12: storeb */
+    ptr0[i] = var39;
+  }
+
+}
+
+void
+ivtc_orc_comb_mask (guint8 * ORC_RESTRICT d1, const guint8 * ORC_RESTRICT s1,
+    const guint8 * ORC_RESTRICT s2, const guint8 * ORC_RESTRICT s3, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 18, 105, 118, 116, 99, 95, 111, 114, 99, 95, 99, 111, 109, 98,
+        95, 109, 97, 115, 107, 11, 1, 1, 12, 1, 1, 12, 1, 1, 12, 1,
+        1, 14, 2, 1, 0, 0, 0, 20, 2, 20, 2, 20, 2, 150, 32, 4,
+        150, 33, 5, 78, 33, 33, 32, 150, 34, 6, 78, 34, 32, 34, 92, 33,
+        33, 34, 73, 33, 33, 16, 160, 0, 33, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_ivtc_orc_comb_mask);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "ivtc_orc_comb_mask");
+      orc_program_set_backup_function (p, _backup_ivtc_orc_comb_mask);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_source (p, 1, "s1");
+      orc_program_add_source (p, 1, "s2");
+      orc_program_add_source (p, 1, "s3");
+      orc_program_add_constant (p, 2, 0x00000001, "c1");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 2, "t3");
+
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T2, ORC_VAR_S2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_T1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T3, ORC_VAR_S3, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "orw", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 0, ORC_VAR_D1, ORC_VAR_T2,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* ivtc_orc_reconstruct_classify */
+#ifdef DISABLE_ORC
+void
+ivtc_orc_reconstruct_classify (guint8 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, const guint8 * ORC_RESTRICT s1,
+    const guint8 * ORC_RESTRICT s2, const guint8 * ORC_RESTRICT s3,
+    const guint8 * ORC_RESTRICT s4, const guint8 * ORC_RESTRICT s5,
+    const guint8 * ORC_RESTRICT s6, int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  orc_union16 *ORC_RESTRICT ptr1;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  const orc_int8 *ORC_RESTRICT ptr7;
+  const orc_int8 *ORC_RESTRICT ptr8;
+  const orc_int8 *ORC_RESTRICT ptr9;
+  orc_int8 var45;
+  orc_int8 var46;
+  orc_int8 var47;
+  orc_int8 var48;
+  orc_int8 var49;
+  orc_int8 var50;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var51;
+#else
+  orc_union16 var51;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var52;
+#else
+  orc_union16 var52;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var53;
+#else
+  orc_union16 var53;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var54;
+#else
+  orc_union16 var54;
+#endif
+  orc_union16 var55;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var56;
+#else
+  orc_union16 var56;
+#endif
+  orc_int8 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+  orc_union16 var63;
+  orc_union16 var64;
+  orc_union16 var65;
+  orc_union16 var66;
+  orc_union16 var67;
+  orc_union16 var68;
+  orc_union16 var69;
+  orc_union16 var70;
+  orc_union16 var71;
+  orc_union16 var72;
+  orc_union16 var73;
+  orc_union16 var74;
+  orc_union16 var75;
+  orc_union16 var76;
+  orc_union16 var77;
+  orc_union16 var78;
+  orc_union16 var79;
+  orc_union16 var80;
+  orc_union16 var81;
+  orc_union16 var82;
+  orc_union16 var83;
+  orc_union16 var84;
+  orc_union16 var85;
+  orc_union16 var86;
+  orc_union16 var87;
+  orc_union16 var88;
+  orc_union16 var89;
+  orc_union16 var90;
+  orc_union16 var91;
+  orc_union16 var92;
+  orc_union16 var93;
+  orc_union16 var94;
+  orc_union16 var95;
+  orc_union16 var96;
+  orc_union16 var97;
+  orc_union16 var98;
+  orc_union16 var99;
+  orc_union16 var100;
+  orc_union16 var101;
+  orc_union16 var102;
+  orc_union16 var103;
+  orc_union16 var104;
+  orc_union16 var105;
+  orc_union16 var106;
+  orc_union16 var107;
+  orc_union16 var108;
+  orc_union16 var109;
+  orc_union16 var110;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr1 = (orc_union16 *) d2;
+  ptr4 = (orc_int8 *) s1;
+  ptr5 = (orc_int8 *) s2;
+  ptr6 = (orc_int8 *) s3;
+  ptr7 = (orc_int8 *) s4;
+  ptr8 = (orc_int8 *) s5;
+  ptr9 = (orc_int8 *) s6;
+
+  /* 23: loadpw */
+  var51.i = (int) 0x00000000;   /* 0 or 0f */
+  /* 25: loadpw */
+  var52.i = (int) 0x00000001;   /* 1 or 4.94066e-324f */
+  /* 36: loadpw */
+  var53.i = (int) 0x00000003;   /* 3 or 1.4822e-323f */
+  /* 52: loadpw */
+  var54.i = (int) 0x00000010;   /* 16 or 7.90505e-323f */
+  /* 58: loadpw */
+  var56.i = (int) 0x00000008;   /* 8 or 3.95253e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var45 = ptr4[i];
+    /* 1: convubw */
+    var58.i = (orc_uint8) var45;
+    /* 2: loadb */
+    var46 = ptr5[i];
+    /* 3: convubw */
+    var59.i = (orc_uint8) var46;
+    /* 4: loadb */
+    var47 = ptr6[i];
+    /* 5: convubw */
+    var60.i = (orc_uint8) var47;
+    /* 6: loadb */
+    var48 = ptr7[i];
+    /* 7: convubw */
+    var61.i = (orc_uint8) var48;
+    /* 8: loadb */
+    var49 = ptr8[i];
+    /* 9: convubw */
+    var62.i = (orc_uint8) var49;
+    /* 10: loadb */
+    var50 = ptr9[i];
+    /* 11: convubw */
+    var63.i = (orc_uint8) var50;
+    /* 12: addw */
+    var64.i = var60.i + var63.i;
+    /* 13: addw */
+    var65.i = var58.i + var61.i;
+    /* 14: subw */
+    var66.i = var64.i - var65.i;
+    /* 15: shlw */
+    var67.i = ((orc_uint16) var66.i) << 1;
+    /* 16: addw */
+    var68.i = var61.i + var63.i;
+    /* 17: shlw */
+    var69.i = ((orc_uint16) var62.i) << 1;
+    /* 18: addw */
+    var70.i = var68.i + var69.i;
+    /* 19: addw */
+    var71.i = var58.i + var60.i;
+    /* 20: subw */
+    var72.i = var70.i - var71.i;
+    /* 21: shlw */
+    var73.i = ((orc_uint16) var59.i) << 1;
+    /* 22: subw */
+    var74.i = var72.i - var73.i;
+    /* 24: cmpgtsw */
+    var75.i = (var51.i > var74.i) ? (~0) : 0;
+    /* 26: orw */
+    var76.i = var75.i | var52.i;
+    /* 27: mullw */
+    var77.i = (var67.i * var76.i) & 0xffff;
+    /* 28: absw */
+    var78.i = ORC_ABS (var74.i);
+    /* 29: cmpgtsw */
+    var79.i = (var51.i > var77.i) ? (~0) : 0;
+    /* 30: absw */
+    var80.i = ORC_ABS (var77.i);
+    /* 31: shlw */
+    var81.i = ((orc_uint16) var78.i) << 1;
+    /* 32: cmpgtsw */
+    var82.i = (var80.i > var81.i) ? (~0) : 0;
+    /* 33: cmpgtsw */
+    var83.i = (var80.i > var78.i) ? (~0) : 0;
+    /* 34: shlw */
+    var84.i = ((orc_uint16) var80.i) << 1;
+    /* 35: cmpgtsw */
+    var85.i = (var84.i > var78.i) ? (~0) : 0;
+    /* 37: mullw */
+    var86.i = (var80.i * var53.i) & 0xffff;
+    /* 38: cmpgtsw */
+    var87.i = (var86.i > var78.i) ? (~0) : 0;
+    /* 39: addw */
+    var88.i = var80.i + var78.i;
+    /* 40: cmpgtsw */
+    var89.i = (var52.i > var88.i) ? (~0) : 0;
+    /* 41: shlw */
+    var90.i = ((orc_uint16) var82.i) << 3;
+    /* 42: shlw */
+    var91.i = ((orc_uint16) var83.i) << 2;
+    /* 43: addw */
+    var92.i = var90.i + var91.i;
+    /* 44: mullw */
+    var93.i = (var85.i * var53.i) & 0xffff;
+    /* 45: addw */
+    var94.i = var92.i + var93.i;
+    /* 46: addw */
+    var95.i = var94.i + var87.i;
+    /* 47: shlw */
+    var96.i = ((orc_uint16) var89.i) << 4;
+    /* 48: addw */
+    var97.i = var95.i + var96.i;
+    /* 49: subw */
+    var98.i = var51.i - var97.i;
+    /* 50: addw */
+    var99.i = var59.i + var62.i;
+    /* 51: mullw */
+    var100.i = (var99.i * var98.i) & 0xffff;
+    /* 53: addw */
+    var55.i = var100.i + var54.i;
+    /* 54: storew */
+    ptr1[i] = var55;
+    /* 55: addw */
+    var101.i = var82.i + var83.i;
+    /* 56: addw */
+    var102.i = var101.i + var85.i;
+    /* 57: addw */
+    var103.i = var102.i + var87.i;
+    /* 59: addw */
+    var104.i = var103.i + var56.i;
+    /* 60: shlw */
+    var105.i = ((orc_uint16) var79.i) << 2;
+    /* 61: addw */
+    var106.i = var104.i + var105.i;
+    /* 62: addw */
+    var107.i = var82.i + var52.i;
+    /* 63: mullw */
+    var108.i = (var106.i * var107.i) & 0xffff;
+    /* 64: addw */
+    var109.i = var89.i + var52.i;
+    /* 65: mullw */
+    var110.i = (var108.i * var109.i) & 0xffff;
+    /* 66: convsuswb */
+    var57 = ORC_CLAMP_UB (var110.i);
+    /* 67: storeb */
+    ptr0[i] = var57;
+  }
+
+}
+
+#else
+static void
+_backup_ivtc_orc_reconstruct_classify (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  orc_union16 *ORC_RESTRICT ptr1;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  const orc_int8 *ORC_RESTRICT ptr7;
+  const orc_int8 *ORC_RESTRICT ptr8;
+  const orc_int8 *ORC_RESTRICT ptr9;
+  orc_int8 var45;
+  orc_int8 var46;
+  orc_int8 var47;
+  orc_int8 var48;
+  orc_int8 var49;
+  orc_int8 var50;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var51;
+#else
+  orc_union16 var51;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var52;
+#else
+  orc_union16 var52;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var53;
+#else
+  orc_union16 var53;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var54;
+#else
+  orc_union16 var54;
+#endif
+  orc_union16 var55;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var56;
+#else
+  orc_union16 var56;
+#endif
+  orc_int8 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+  orc_union16 var63;
+  orc_union16 var64;
+  orc_union16 var65;
+  orc_union16 var66;
+  orc_union16 var67;
+  orc_union16 var68;
+  orc_union16 var69;
+  orc_union16 var70;
+  orc_union16 var71;
+  orc_union16 var72;
+  orc_union16 var73;
+  orc_union16 var74;
+  orc_union16 var75;
+  orc_union16 var76;
+  orc_union16 var77;
+  orc_union16 var78;
+  orc_union16 var79;
+  orc_union16 var80;
+  orc_union16 var81;
+  orc_union16 var82;
+  orc_union16 var83;
+  orc_union16 var84;
+  orc_union16 var85;
+  orc_union16 var86;
+  orc_union16 var87;
+  orc_union16 var88;
+  orc_union16 var89;
+  orc_union16 var90;
+  orc_union16 var91;
+  orc_union16 var92;
+  orc_union16 var93;
+  orc_union16 var94;
+  orc_union16 var95;
+  orc_union16 var96;
+  orc_union16 var97;
+  orc_union16 var98;
+  orc_union16 var99;
+  orc_union16 var100;
+  orc_union16 var101;
+  orc_union16 var102;
+  orc_union16 var103;
+  orc_union16 var104;
+  orc_union16 var105;
+  orc_union16 var106;
+  orc_union16 var107;
+  orc_union16 var108;
+  orc_union16 var109;
+  orc_union16 var110;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr1 = (orc_union16 *) ex->arrays[1];
+  ptr4 = (orc_int8 *) ex->arrays[4];
+  ptr5 = (orc_int8 *) ex->arrays[5];
+  ptr6 = (orc_int8 *) ex->arrays[6];
+  ptr7 = (orc_int8 *) ex->arrays[7];
+  ptr8 = (orc_int8 *) ex->arrays[8];
+  ptr9 = (orc_int8 *) ex->arrays[9];
+
+  /* 23: loadpw */
+  var51.i = (int) 0x00000000;   /* 0 or 0f */
+  /* 25: loadpw */
+  var52.i = (int) 0x00000001;   /* 1 or 4.94066e-324f */
+  /* 36: loadpw */
+  var53.i = (int) 0x00000003;   /* 3 or 1.4822e-323f */
+  /* 52: loadpw */
+  var54.i = (int) 0x00000010;   /* 16 or 7.90505e-323f */
+  /* 58: loadpw */
+  var56.i = (int) 0x00000008;   /* 8 or 3.95253e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var45 = ptr4[i];
+    /* 1: convubw */
+    var58.i = (orc_uint8) var45;
+    /* 2: loadb */
+    var46 = ptr5[i];
+    /* 3: convubw */
+    var59.i = (orc_uint8) var46;
+    /* 4: loadb */
+    var47 = ptr6[i];
+    /* 5: convubw */
+    var60.i = (orc_uint8) var47;
+    /* 6: loadb */
+    var48 = ptr7[i];
+    /* 7: convubw */
+    var61.i = (orc_uint8) var48;
+    /* 8: loadb */
+    var49 = ptr8[i];
+    /* 9: convubw */
+    var62.i = (orc_uint8) var49;
+    /* 10: loadb */
+    var50 = ptr9[i];
+    /* 11: convubw */
+    var63.i = (orc_uint8) var50;
+    /* 12: addw */
+    var64.i = var60.i + var63.i;
+    /* 13: addw */
+    var65.i = var58.i + var61.i;
+    /* 14: subw */
+    var66.i = var64.i - var65.i;
+    /* 15: shlw */
+    var67.i = ((orc_uint16) var66.i) << 1;
+    /* 16: addw */
+    var68.i = var61.i + var63.i;
+    /* 17: shlw */
+    var69.i = ((orc_uint16) var62.i) << 1;
+    /* 18: addw */
+    var70.i = var68.i + var69.i;
+    /* 19: addw */
+    var71.i = var58.i + var60.i;
+    /* 20: subw */
+    var72.i = var70.i - var71.i;
+    /* 21: shlw */
+    var73.i = ((orc_uint16) var59.i) << 1;
+    /* 22: subw */
+    var74.i = var72.i - var73.i;
+    /* 24: cmpgtsw */
+    var75.i = (var51.i > var74.i) ? (~0) : 0;
+    /* 26: orw */
+    var76.i = var75.i | var52.i;
+    /* 27: mullw */
+    var77.i = (var67.i * var76.i) & 0xffff;
+    /* 28: absw */
+    var78.i = ORC_ABS (var74.i);
+    /* 29: cmpgtsw */
+    var79.i = (var51.i > var77.i) ? (~0) : 0;
+    /* 30: absw */
+    var80.i = ORC_ABS (var77.i);
+    /* 31: shlw */
+    var81.i = ((orc_uint16) var78.i) << 1;
+    /* 32: cmpgtsw */
+    var82.i = (var80.i > var81.i) ? (~0) : 0;
+    /* 33: cmpgtsw */
+    var83.i = (var80.i > var78.i) ? (~0) : 0;
+    /* 34: shlw */
+    var84.i = ((orc_uint16) var80.i) << 1;
+    /* 35: cmpgtsw */
+    var85.i = (var84.i > var78.i) ? (~0) : 0;
+    /* 37: mullw */
+    var86.i = (var80.i * var53.i) & 0xffff;
+    /* 38: cmpgtsw */
+    var87.i = (var86.i > var78.i) ? (~0) : 0;
+    /* 39: addw */
+    var88.i = var80.i + var78.i;
+    /* 40: cmpgtsw */
+    var89.i = (var52.i > var88.i) ? (~0) : 0;
+    /* 41: shlw */
+    var90.i = ((orc_uint16) var82.i) << 3;
+    /* 42: shlw */
+    var91.i = ((orc_uint16) var83.i) << 2;
+    /* 43: addw */
+    var92.i = var90.i + var91.i;
+    /* 44: mullw */
+    var93.i = (var85.i * var53.i) & 0xffff;
+    /* 45: addw */
+    var94.i = var92.i + var93.i;
+    /* 46: addw */
+    var95.i = var94.i + var87.i;
+    /* 47: shlw */
+    var96.i = ((orc_uint16) var89.i) << 4;
+    /* 48: addw */
+    var97.i = var95.i + var96.i;
+    /* 49: subw */
+    var98.i = var51.i - var97.i;
+    /* 50: addw */
+    var99.i = var59.i + var62.i;
+    /* 51: mullw */
+    var100.i = (var99.i * var98.i) & 0xffff;
+    /* 53: addw */
+    var55.i = var100.i + var54.i;
+    /* 54: storew */
+    ptr1[i] = var55;
+    /* 55: addw */
+    var101.i = var82.i + var83.i;
+    /* 56: addw */
+    var102.i = var101.i + var85.i;
+    /* 57: addw */
+    var103.i = var102.i + var87.i;
+    /* 59: addw */
+    var104.i = var103.i + var56.i;
+    /* 60: shlw */
+    var105.i = ((orc_uint16) var79.i) << 2;
+    /* 61: addw */
+    var106.i = var104.i + var105.i;
+    /* 62: addw */
+    var107.i = var82.i + var52.i;
+    /* 63: mullw */
+    var108.i = (var106.i * var107.i) & 0xffff;
+    /* 64: addw */
+    var109.i = var89.i + var52.i;
+    /* 65: mullw */
+    var110.i = (var108.i * var109.i) & 0xffff;
+    /* 66: convsuswb */
+    var57 = ORC_CLAMP_UB (var110.i);
+    /* 67: storeb */
+    ptr0[i] = var57;
+  }
+
+}
+
+void
+ivtc_orc_reconstruct_classify (guint8 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, const guint8 * ORC_RESTRICT s1,
+    const guint8 * ORC_RESTRICT s2, const guint8 * ORC_RESTRICT s3,
+    const guint8 * ORC_RESTRICT s4, const guint8 * ORC_RESTRICT s5,
+    const guint8 * ORC_RESTRICT s6, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 29, 105, 118, 116, 99, 95, 111, 114, 99, 95, 114, 101, 99, 111,
+        110, 115, 116, 114, 117, 99, 116, 95, 99, 108, 97, 115, 115, 105, 102,
+            121,
+        11, 1, 1, 11, 2, 2, 12, 1, 1, 12, 1, 1, 12, 1, 1, 12,
+        1, 1, 12, 1, 1, 12, 1, 1, 14, 2, 1, 0, 0, 0, 14, 2,
+        0, 0, 0, 0, 14, 2, 3, 0, 0, 0, 14, 2, 2, 0, 0, 0,
+        14, 2, 4, 0, 0, 0, 14, 2, 16, 0, 0, 0, 14, 2, 8, 0,
+        0, 0, 20, 2, 20, 2, 20, 2, 20, 2, 20, 2, 20, 2, 20, 2,
+        20, 2, 20, 2, 20, 2, 20, 2, 20, 2, 20, 2, 150, 32, 4, 150,
+        33, 5, 150, 34, 6, 150, 35, 7, 150, 36, 8, 150, 37, 9, 70, 38,
+        34, 37, 70, 39, 32, 35, 98, 38, 38, 39, 93, 38, 38, 16, 70, 39,
+        35, 37, 93, 40, 36, 16, 70, 39, 39, 40, 70, 40, 32, 34, 98, 39,
+        39, 40, 93, 40, 33, 16, 98, 39, 39, 40, 78, 40, 17, 39, 92, 40,
+        40, 16, 89, 38, 38, 40, 69, 39, 39, 78, 40, 17, 38, 69, 38, 38,
+        93, 41, 39, 16, 78, 41, 38, 41, 78, 42, 38, 39, 93, 43, 38, 16,
+        78, 43, 43, 39, 89, 44, 38, 18, 78, 44, 44, 39, 70, 39, 38, 39,
+        78, 39, 16, 39, 93, 38, 41, 18, 93, 32, 42, 19, 70, 38, 38, 32,
+        89, 32, 43, 18, 70, 38, 38, 32, 70, 38, 38, 44, 93, 32, 39, 20,
+        70, 38, 38, 32, 98, 38, 17, 38, 70, 32, 33, 36, 89, 32, 32, 38,
+        70, 1, 32, 21, 70, 32, 41, 42, 70, 32, 32, 43, 70, 32, 32, 44,
+        70, 32, 32, 22, 93, 40, 40, 19, 70, 32, 32, 40, 70, 41, 41, 16,
+        89, 32, 32, 41, 70, 39, 39, 16, 89, 32, 32, 39, 160, 0, 32, 2,
+        0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p,
+          _backup_ivtc_orc_reconstruct_classify);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "ivtc_orc_reconstruct_classify");
+      orc_program_set_backup_function (p,
+          _backup_ivtc_orc_reconstruct_classify);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_destination (p, 2, "d2");
+      orc_program_add_source (p, 1, "s1");
+      orc_program_add_source (p, 1, "s2");
+      orc_program_add_source (p, 1, "s3");
+      orc_program_add_source (p, 1, "s4");
+      orc_program_add_source (p, 1, "s5");
+      orc_program_add_source (p, 1, "s6");
+      orc_program_add_constant (p, 2, 0x00000001, "c1");
+      orc_program_add_constant (p, 2, 0x00000000, "c2");
+      orc_program_add_constant (p, 2, 0x00000003, "c3");
+      orc_program_add_constant (p, 2, 0x00000002, "c4");
+      orc_program_add_constant (p, 2, 0x00000004, "c5");
+      orc_program_add_constant (p, 2, 0x00000010, "c6");
+      orc_program_add_constant (p, 2, 0x00000008, "c7");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 2, "t3");
+      orc_program_add_temporary (p, 2, "t4");
+      orc_program_add_temporary (p, 2, "t5");
+      orc_program_add_temporary (p, 2, "t6");
+      orc_program_add_temporary (p, 2, "t7");
+      orc_program_add_temporary (p, 2, "t8");
+      orc_program_add_temporary (p, 2, "t9");
+      orc_program_add_temporary (p, 2, "t10");
+      orc_program_add_temporary (p, 2, "t11");
+      orc_program_add_temporary (p, 2, "t12");
+      orc_program_add_temporary (p, 2, "t13");
+
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T2, ORC_VAR_S2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T3, ORC_VAR_S3, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T4, ORC_VAR_S4, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T5, ORC_VAR_S5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T6, ORC_VAR_S6, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T7, ORC_VAR_T3, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T8, ORC_VAR_T1, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shlw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T8, ORC_VAR_T4, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shlw", 0, ORC_VAR_T9, ORC_VAR_T5, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T9,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T9, ORC_VAR_T1, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T9,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shlw", 0, ORC_VAR_T9, ORC_VAR_T2, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T9,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T9, ORC_VAR_C2, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "orw", 0, ORC_VAR_T9, ORC_VAR_T9, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T9,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "absw", 0, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T9, ORC_VAR_C2, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "absw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shlw", 0, ORC_VAR_T10, ORC_VAR_T8, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T10, ORC_VAR_T7,
+          ORC_VAR_T10, ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T11, ORC_VAR_T7,
+          ORC_VAR_T8, ORC_VAR_D1);
+      orc_program_append_2 (p, "shlw", 0, ORC_VAR_T12, ORC_VAR_T7, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T12, ORC_VAR_T12,
+          ORC_VAR_T8, ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T13, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T13, ORC_VAR_T13,
+          ORC_VAR_T8, ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T8, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T8, ORC_VAR_C1, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shlw", 0, ORC_VAR_T7, ORC_VAR_T10, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shlw", 0, ORC_VAR_T1, ORC_VAR_T11, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T1, ORC_VAR_T12, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T13,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shlw", 0, ORC_VAR_T1, ORC_VAR_T8, ORC_VAR_C5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T7, ORC_VAR_C2, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T1, ORC_VAR_T2, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_D2, ORC_VAR_T1, ORC_VAR_C6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T1, ORC_VAR_T10, ORC_VAR_T11,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T12,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T13,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_C7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shlw", 0, ORC_VAR_T9, ORC_VAR_T9, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T9,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T10, ORC_VAR_T10, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T10,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 0, ORC_VAR_D1, ORC_VAR_T1,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_D2] = d2;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+  ex->arrays[ORC_VAR_S5] = (void *) s5;
+  ex->arrays[ORC_VAR_S6] = (void *) s6;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* ivtc_orc_reconstruct_taps */
+#ifdef DISABLE_ORC
+void
+ivtc_orc_reconstruct_taps (guint16 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4,
+    const guint8 * ORC_RESTRICT s5, const guint8 * ORC_RESTRICT s6,
+    const guint8 * ORC_RESTRICT s7, const guint16 * ORC_RESTRICT s8, int p1,
+    int n)
+{
+  int i;
+  orc_union16 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  const orc_int8 *ORC_RESTRICT ptr7;
+  const orc_int8 *ORC_RESTRICT ptr8;
+  const orc_int8 *ORC_RESTRICT ptr9;
+  const orc_int8 *ORC_RESTRICT ptr10;
+  const orc_union16 *ORC_RESTRICT ptr11;
+  orc_int8 var40;
+  orc_union16 var41;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var42;
+#else
+  orc_union16 var42;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var43;
+#else
+  orc_union16 var43;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var44;
+#else
+  orc_union16 var44;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var45;
+#else
+  orc_union16 var45;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var46;
+#else
+  orc_union16 var46;
+#endif
+  orc_int8 var47;
+  orc_int8 var48;
+  orc_int8 var49;
+  orc_int8 var50;
+  orc_int8 var51;
+  orc_int8 var52;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var53;
+#else
+  orc_union16 var53;
+#endif
+  orc_union16 var54;
+  orc_union16 var55;
+  orc_union16 var56;
+  orc_union16 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+  orc_union16 var63;
+  orc_union16 var64;
+  orc_union16 var65;
+  orc_union16 var66;
+  orc_union16 var67;
+  orc_union16 var68;
+  orc_union16 var69;
+  orc_union16 var70;
+  orc_union16 var71;
+  orc_union16 var72;
+  orc_union16 var73;
+  orc_union16 var74;
+  orc_union16 var75;
+  orc_union16 var76;
+  orc_union16 var77;
+  orc_union16 var78;
+  orc_union16 var79;
+  orc_union16 var80;
+  orc_union16 var81;
+  orc_union16 var82;
+  orc_union16 var83;
+  orc_union16 var84;
+  orc_union16 var85;
+  orc_union16 var86;
+  orc_union16 var87;
+  orc_union16 var88;
+
+  ptr0 = (orc_union16 *) d1;
+  ptr4 = (orc_int8 *) s1;
+  ptr5 = (orc_int8 *) s2;
+  ptr6 = (orc_int8 *) s3;
+  ptr7 = (orc_int8 *) s4;
+  ptr8 = (orc_int8 *) s5;
+  ptr9 = (orc_int8 *) s6;
+  ptr10 = (orc_int8 *) s7;
+  ptr11 = (orc_union16 *) s8;
+
+  /* 2: loadpw */
+  var41.i = p1;
+  /* 4: loadpw */
+  var42.i = (int) 0x00000000;   /* 0 or 0f */
+  /* 6: loadpw */
+  var43.i = (int) 0x00000005;   /* 5 or 2.47033e-323f */
+  /* 9: loadpw */
+  var44.i = (int) 0x00000001;   /* 1 or 4.94066e-324f */
+  /* 11: loadpw */
+  var45.i = (int) 0x00000002;   /* 2 or 9.88131e-324f */
+  /* 13: loadpw */
+  var46.i = (int) 0x00000003;   /* 3 or 1.4822e-323f */
+  /* 41: loadpw */
+  var53.i = (int) 0x00000008;   /* 8 or 3.95253e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var40 = ptr10[i];
+    /* 1: convubw */
+    var56.i = (orc_uint8) var40;
+    /* 3: subw */
+    var57.i = var56.i - var41.i;
+    /* 5: cmpgtsw */
+    var58.i = (var57.i > var42.i) ? (~0) : 0;
+    /* 7: cmpgtsw */
+    var59.i = (var43.i > var57.i) ? (~0) : 0;
+    /* 8: andw */
+    var60.i = var58.i & var59.i;
+    /* 10: cmpgtsw */
+    var61.i = (var57.i > var44.i) ? (~0) : 0;
+    /* 12: cmpgtsw */
+    var62.i = (var57.i > var45.i) ? (~0) : 0;
+    /* 14: cmpgtsw */
+    var63.i = (var57.i > var46.i) ? (~0) : 0;
+    /* 15: loadb */
+    var47 = ptr4[i];
+    /* 16: convubw */
+    var64.i = (orc_uint8) var47;
+    /* 17: loadb */
+    var48 = ptr9[i];
+    /* 18: convubw */
+    var65.i = (orc_uint8) var48;
+    /* 19: addw */
+    var66.i = var64.i + var65.i;
+    /* 20: mullw */
+    var67.i = (var63.i * var46.i) & 0xffff;
+    /* 21: addw */
+    var68.i = var67.i + var62.i;
+    /* 22: mullw */
+    var69.i = (var66.i * var68.i) & 0xffff;
+    /* 23: loadb */
+    var49 = ptr5[i];
+    /* 24: convubw */
+    var70.i = (orc_uint8) var49;
+    /* 25: loadb */
+    var50 = ptr8[i];
+    /* 26: convubw */
+    var71.i = (orc_uint8) var50;
+    /* 27: addw */
+    var72.i = var70.i + var71.i;
+    /* 28: shlw */
+    var73.i = ((orc_uint16) var61.i) << 2;
+    /* 29: addw */
+    var74.i = var73.i + var63.i;
+    /* 30: mullw */
+    var75.i = (var62.i * var46.i) & 0xffff;
+    /* 31: addw */
+    var76.i = var74.i + var75.i;
+    /* 32: mullw */
+    var77.i = (var72.i * var76.i) & 0xffff;
+    /* 33: addw */
+    var78.i = var69.i + var77.i;
+    /* 34: loadb */
+    var51 = ptr6[i];
+    /* 35: convubw */
+    var79.i = (orc_uint8) var51;
+    /* 36: loadb */
+    var52 = ptr7[i];
+    /* 37: convubw */
+    var80.i = (orc_uint8) var52;
+    /* 38: addw */
+    var81.i = var79.i + var80.i;
+    /* 39: mullw */
+    var82.i = (var63.i * var46.i) & 0xffff;
+    /* 40: addw */
+    var83.i = var82.i + var62.i;
+    /* 42: addw */
+    var84.i = var83.i + var53.i;
+    /* 43: mullw */
+    var85.i = (var81.i * var84.i) & 0xffff;
+    /* 44: subw */
+    var86.i = var78.i - var85.i;
+    /* 45: subw */
+    var87.i = var42.i - var86.i;
+    /* 46: andw */
+    var88.i = var87.i & var60.i;
+    /* 47: loadw */
+    var54 = ptr11[i];
+    /* 48: addw */
+    var55.i = var54.i + var88.i;
+    /* 49: storew */
+    ptr0[i] = var55;
+  }
+
+}
+
+#else
+static void
+_backup_ivtc_orc_reconstruct_taps (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union16 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  const orc_int8 *ORC_RESTRICT ptr7;
+  const orc_int8 *ORC_RESTRICT ptr8;
+  const orc_int8 *ORC_RESTRICT ptr9;
+  const orc_int8 *ORC_RESTRICT ptr10;
+  const orc_union16 *ORC_RESTRICT ptr11;
+  orc_int8 var40;
+  orc_union16 var41;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var42;
+#else
+  orc_union16 var42;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var43;
+#else
+  orc_union16 var43;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var44;
+#else
+  orc_union16 var44;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var45;
+#else
+  orc_union16 var45;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var46;
+#else
+  orc_union16 var46;
+#endif
+  orc_int8 var47;
+  orc_int8 var48;
+  orc_int8 var49;
+  orc_int8 var50;
+  orc_int8 var51;
+  orc_int8 var52;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var53;
+#else
+  orc_union16 var53;
+#endif
+  orc_union16 var54;
+  orc_union16 var55;
+  orc_union16 var56;
+  orc_union16 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+  orc_union16 var63;
+  orc_union16 var64;
+  orc_union16 var65;
+  orc_union16 var66;
+  orc_union16 var67;
+  orc_union16 var68;
+  orc_union16 var69;
+  orc_union16 var70;
+  orc_union16 var71;
+  orc_union16 var72;
+  orc_union16 var73;
+  orc_union16 var74;
+  orc_union16 var75;
+  orc_union16 var76;
+  orc_union16 var77;
+  orc_union16 var78;
+  orc_union16 var79;
+  orc_union16 var80;
+  orc_union16 var81;
+  orc_union16 var82;
+  orc_union16 var83;
+  orc_union16 var84;
+  orc_union16 var85;
+  orc_union16 var86;
+  orc_union16 var87;
+  orc_union16 var88;
+
+  ptr0 = (orc_union16 *) ex->arrays[0];
+  ptr4 = (orc_int8 *) ex->arrays[4];
+  ptr5 = (orc_int8 *) ex->arrays[5];
+  ptr6 = (orc_int8 *) ex->arrays[6];
+  ptr7 = (orc_int8 *) ex->arrays[7];
+  ptr8 = (orc_int8 *) ex->arrays[8];
+  ptr9 = (orc_int8 *) ex->arrays[9];
+  ptr10 = (orc_int8 *) ex->arrays[10];
+  ptr11 = (orc_union16 *) ex->arrays[11];
+
+  /* 2: loadpw */
+  var41.i = ex->params[24];
+  /* 4: loadpw */
+  var42.i = (int) 0x00000000;   /* 0 or 0f */
+  /* 6: loadpw */
+  var43.i = (int) 0x00000005;   /* 5 or 2.47033e-323f */
+  /* 9: loadpw */
+  var44.i = (int) 0x00000001;   /* 1 or 4.94066e-324f */
+  /* 11: loadpw */
+  var45.i = (int) 0x00000002;   /* 2 or 9.88131e-324f */
+  /* 13: loadpw */
+  var46.i = (int) 0x00000003;   /* 3 or 1.4822e-323f */
+  /* 41: loadpw */
+  var53.i = (int) 0x00000008;   /* 8 or 3.95253e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var40 = ptr10[i];
+    /* 1: convubw */
+    var56.i = (orc_uint8) var40;
+    /* 3: subw */
+    var57.i = var56.i - var41.i;
+    /* 5: cmpgtsw */
+    var58.i = (var57.i > var42.i) ? (~0) : 0;
+    /* 7: cmpgtsw */
+    var59.i = (var43.i > var57.i) ? (~0) : 0;
+    /* 8: andw */
+    var60.i = var58.i & var59.i;
+    /* 10: cmpgtsw */
+    var61.i = (var57.i > var44.i) ? (~0) : 0;
+    /* 12: cmpgtsw */
+    var62.i = (var57.i > var45.i) ? (~0) : 0;
+    /* 14: cmpgtsw */
+    var63.i = (var57.i > var46.i) ? (~0) : 0;
+    /* 15: loadb */
+    var47 = ptr4[i];
+    /* 16: convubw */
+    var64.i = (orc_uint8) var47;
+    /* 17: loadb */
+    var48 = ptr9[i];
+    /* 18: convubw */
+    var65.i = (orc_uint8) var48;
+    /* 19: addw */
+    var66.i = var64.i + var65.i;
+    /* 20: mullw */
+    var67.i = (var63.i * var46.i) & 0xffff;
+    /* 21: addw */
+    var68.i = var67.i + var62.i;
+    /* 22: mullw */
+    var69.i = (var66.i * var68.i) & 0xffff;
+    /* 23: loadb */
+    var49 = ptr5[i];
+    /* 24: convubw */
+    var70.i = (orc_uint8) var49;
+    /* 25: loadb */
+    var50 = ptr8[i];
+    /* 26: convubw */
+    var71.i = (orc_uint8) var50;
+    /* 27: addw */
+    var72.i = var70.i + var71.i;
+    /* 28: shlw */
+    var73.i = ((orc_uint16) var61.i) << 2;
+    /* 29: addw */
+    var74.i = var73.i + var63.i;
+    /* 30: mullw */
+    var75.i = (var62.i * var46.i) & 0xffff;
+    /* 31: addw */
+    var76.i = var74.i + var75.i;
+    /* 32: mullw */
+    var77.i = (var72.i * var76.i) & 0xffff;
+    /* 33: addw */
+    var78.i = var69.i + var77.i;
+    /* 34: loadb */
+    var51 = ptr6[i];
+    /* 35: convubw */
+    var79.i = (orc_uint8) var51;
+    /* 36: loadb */
+    var52 = ptr7[i];
+    /* 37: convubw */
+    var80.i = (orc_uint8) var52;
+    /* 38: addw */
+    var81.i = var79.i + var80.i;
+    /* 39: mullw */
+    var82.i = (var63.i * var46.i) & 0xffff;
+    /* 40: addw */
+    var83.i = var82.i + var62.i;
+    /* 42: addw */
+    var84.i = var83.i + var53.i;
+    /* 43: mullw */
+    var85.i = (var81.i * var84.i) & 0xffff;
+    /* 44: subw */
+    var86.i = var78.i - var85.i;
+    /* 45: subw */
+    var87.i = var42.i - var86.i;
+    /* 46: andw */
+    var88.i = var87.i & var60.i;
+    /* 47: loadw */
+    var54 = ptr11[i];
+    /* 48: addw */
+    var55.i = var54.i + var88.i;
+    /* 49: storew */
+    ptr0[i] = var55;
+  }
+
+}
+
+void
+ivtc_orc_reconstruct_taps (guint16 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4,
+    const guint8 * ORC_RESTRICT s5, const guint8 * ORC_RESTRICT s6,
+    const guint8 * ORC_RESTRICT s7, const guint16 * ORC_RESTRICT s8, int p1,
+    int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 25, 105, 118, 116, 99, 95, 111, 114, 99, 95, 114, 101, 99, 111,
+        110, 115, 116, 114, 117, 99, 116, 95, 116, 97, 112, 115, 11, 2, 2, 12,
+        1, 1, 12, 1, 1, 12, 1, 1, 12, 1, 1, 12, 1, 1, 12, 1,
+        1, 12, 1, 1, 12, 2, 2, 14, 2, 0, 0, 0, 0, 14, 2, 5,
+        0, 0, 0, 14, 2, 1, 0, 0, 0, 14, 2, 2, 0, 0, 0, 14,
+        2, 3, 0, 0, 0, 14, 2, 8, 0, 0, 0, 16, 2, 20, 2, 20,
+        2, 20, 2, 20, 2, 20, 2, 20, 2, 20, 2, 20, 2, 150, 32, 10,
+        98, 32, 32, 24, 78, 33, 32, 16, 78, 34, 17, 32, 73, 33, 33, 34,
+        78, 34, 32, 18, 78, 35, 32, 19, 78, 36, 32, 20, 150, 37, 4, 150,
+        38, 9, 70, 37, 37, 38, 89, 38, 36, 20, 70, 38, 38, 35, 89, 37,
+        37, 38, 150, 38, 5, 150, 39, 8, 70, 38, 38, 39, 93, 39, 34, 19,
+        70, 39, 39, 36, 89, 32, 35, 20, 70, 39, 39, 32, 89, 38, 38, 39,
+        70, 37, 37, 38, 150, 38, 6, 150, 39, 7, 70, 38, 38, 39, 89, 39,
+        36, 20, 70, 39, 39, 35, 70, 39, 39, 21, 89, 38, 38, 39, 98, 37,
+        37, 38, 98, 37, 16, 37, 73, 37, 37, 33, 70, 0, 11, 37, 2, 0,
+
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_ivtc_orc_reconstruct_taps);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "ivtc_orc_reconstruct_taps");
+      orc_program_set_backup_function (p, _backup_ivtc_orc_reconstruct_taps);
+      orc_program_add_destination (p, 2, "d1");
+      orc_program_add_source (p, 1, "s1");
+      orc_program_add_source (p, 1, "s2");
+      orc_program_add_source (p, 1, "s3");
+      orc_program_add_source (p, 1, "s4");
+      orc_program_add_source (p, 1, "s5");
+      orc_program_add_source (p, 1, "s6");
+      orc_program_add_source (p, 1, "s7");
+      orc_program_add_source (p, 2, "s8");
+      orc_program_add_constant (p, 2, 0x00000000, "c1");
+      orc_program_add_constant (p, 2, 0x00000005, "c2");
+      orc_program_add_constant (p, 2, 0x00000001, "c3");
+      orc_program_add_constant (p, 2, 0x00000002, "c4");
+      orc_program_add_constant (p, 2, 0x00000003, "c5");
+      orc_program_add_constant (p, 2, 0x00000008, "c6");
+      orc_program_add_parameter (p, 2, "p1");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 2, "t3");
+      orc_program_add_temporary (p, 2, "t4");
+      orc_program_add_temporary (p, 2, "t5");
+      orc_program_add_temporary (p, 2, "t6");
+      orc_program_add_temporary (p, 2, "t7");
+      orc_program_add_temporary (p, 2, "t8");
+
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T1, ORC_VAR_S7, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T3, ORC_VAR_C2, ORC_VAR_T1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T4, ORC_VAR_T1, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T5, ORC_VAR_T1, ORC_VAR_C5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T6, ORC_VAR_S1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T7, ORC_VAR_S6, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_C5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T7, ORC_VAR_S2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T8, ORC_VAR_S5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shlw", 0, ORC_VAR_T8, ORC_VAR_T3, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T1, ORC_VAR_T4, ORC_VAR_C5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T7, ORC_VAR_S3, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T8, ORC_VAR_S4, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T8, ORC_VAR_T5, ORC_VAR_C5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T6, ORC_VAR_C1, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_D1, ORC_VAR_S8, ORC_VAR_T6,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+  ex->arrays[ORC_VAR_S5] = (void *) s5;
+  ex->arrays[ORC_VAR_S6] = (void *) s6;
+  ex->arrays[ORC_VAR_S7] = (void *) s7;
+  ex->arrays[ORC_VAR_S8] = (void *) s8;
+  ex->params[ORC_VAR_P1] = p1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* ivtc_orc_reconstruct_taps_final */
+#ifdef DISABLE_ORC
+void
+ivtc_orc_reconstruct_taps_final (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4,
+    const guint8 * ORC_RESTRICT s5, const guint8 * ORC_RESTRICT s6,
+    const guint8 * ORC_RESTRICT s7, const guint16 * ORC_RESTRICT s8, int p1,
+    int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  const orc_int8 *ORC_RESTRICT ptr7;
+  const orc_int8 *ORC_RESTRICT ptr8;
+  const orc_int8 *ORC_RESTRICT ptr9;
+  const orc_int8 *ORC_RESTRICT ptr10;
+  const orc_union16 *ORC_RESTRICT ptr11;
+  orc_int8 var40;
+  orc_union16 var41;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var42;
+#else
+  orc_union16 var42;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var43;
+#else
+  orc_union16 var43;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var44;
+#else
+  orc_union16 var44;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var45;
+#else
+  orc_union16 var45;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var46;
+#else
+  orc_union16 var46;
+#endif
+  orc_int8 var47;
+  orc_int8 var48;
+  orc_int8 var49;
+  orc_int8 var50;
+  orc_int8 var51;
+  orc_int8 var52;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var53;
+#else
+  orc_union16 var53;
+#endif
+  orc_union16 var54;
+  orc_int8 var55;
+  orc_union16 var56;
+  orc_union16 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+  orc_union16 var63;
+  orc_union16 var64;
+  orc_union16 var65;
+  orc_union16 var66;
+  orc_union16 var67;
+  orc_union16 var68;
+  orc_union16 var69;
+  orc_union16 var70;
+  orc_union16 var71;
+  orc_union16 var72;
+  orc_union16 var73;
+  orc_union16 var74;
+  orc_union16 var75;
+  orc_union16 var76;
+  orc_union16 var77;
+  orc_union16 var78;
+  orc_union16 var79;
+  orc_union16 var80;
+  orc_union16 var81;
+  orc_union16 var82;
+  orc_union16 var83;
+  orc_union16 var84;
+  orc_union16 var85;
+  orc_union16 var86;
+  orc_union16 var87;
+  orc_union16 var88;
+  orc_union16 var89;
+  orc_union16 var90;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr4 = (orc_int8 *) s1;
+  ptr5 = (orc_int8 *) s2;
+  ptr6 = (orc_int8 *) s3;
+  ptr7 = (orc_int8 *) s4;
+  ptr8 = (orc_int8 *) s5;
+  ptr9 = (orc_int8 *) s6;
+  ptr10 = (orc_int8 *) s7;
+  ptr11 = (orc_union16 *) s8;
+
+  /* 2: loadpw */
+  var41.i = p1;
+  /* 4: loadpw */
+  var42.i = (int) 0x00000000;   /* 0 or 0f */
+  /* 6: loadpw */
+  var43.i = (int) 0x00000005;   /* 5 or 2.47033e-323f */
+  /* 9: loadpw */
+  var44.i = (int) 0x00000001;   /* 1 or 4.94066e-324f */
+  /* 11: loadpw */
+  var45.i = (int) 0x00000002;   /* 2 or 9.88131e-324f */
+  /* 13: loadpw */
+  var46.i = (int) 0x00000003;   /* 3 or 1.4822e-323f */
+  /* 41: loadpw */
+  var53.i = (int) 0x00000008;   /* 8 or 3.95253e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var40 = ptr10[i];
+    /* 1: convubw */
+    var56.i = (orc_uint8) var40;
+    /* 3: subw */
+    var57.i = var56.i - var41.i;
+    /* 5: cmpgtsw */
+    var58.i = (var57.i > var42.i) ? (~0) : 0;
+    /* 7: cmpgtsw */
+    var59.i = (var43.i > var57.i) ? (~0) : 0;
+    /* 8: andw */
+    var60.i = var58.i & var59.i;
+    /* 10: cmpgtsw */
+    var61.i = (var57.i > var44.i) ? (~0) : 0;
+    /* 12: cmpgtsw */
+    var62.i = (var57.i > var45.i) ? (~0) : 0;
+    /* 14: cmpgtsw */
+    var63.i = (var57.i > var46.i) ? (~0) : 0;
+    /* 15: loadb */
+    var47 = ptr4[i];
+    /* 16: convubw */
+    var64.i = (orc_uint8) var47;
+    /* 17: loadb */
+    var48 = ptr9[i];
+    /* 18: convubw */
+    var65.i = (orc_uint8) var48;
+    /* 19: addw */
+    var66.i = var64.i + var65.i;
+    /* 20: mullw */
+    var67.i = (var63.i * var46.i) & 0xffff;
+    /* 21: addw */
+    var68.i = var67.i + var62.i;
+    /* 22: mullw */
+    var69.i = (var66.i * var68.i) & 0xffff;
+    /* 23: loadb */
+    var49 = ptr5[i];
+    /* 24: convubw */
+    var70.i = (orc_uint8) var49;
+    /* 25: loadb */
+    var50 = ptr8[i];
+    /* 26: convubw */
+    var71.i = (orc_uint8) var50;
+    /* 27: addw */
+    var72.i = var70.i + var71.i;
+    /* 28: shlw */
+    var73.i = ((orc_uint16) var61.i) << 2;
+    /* 29: addw */
+    var74.i = var73.i + var63.i;
+    /* 30: mullw */
+    var75.i = (var62.i * var46.i) & 0xffff;
+    /* 31: addw */
+    var76.i = var74.i + var75.i;
+    /* 32: mullw */
+    var77.i = (var72.i * var76.i) & 0xffff;
+    /* 33: addw */
+    var78.i = var69.i + var77.i;
+    /* 34: loadb */
+    var51 = ptr6[i];
+    /* 35: convubw */
+    var79.i = (orc_uint8) var51;
+    /* 36: loadb */
+    var52 = ptr7[i];
+    /* 37: convubw */
+    var80.i = (orc_uint8) var52;
+    /* 38: addw */
+    var81.i = var79.i + var80.i;
+    /* 39: mullw */
+    var82.i = (var63.i * var46.i) & 0xffff;
+    /* 40: addw */
+    var83.i = var82.i + var62.i;
+    /* 42: addw */
+    var84.i = var83.i + var53.i;
+    /* 43: mullw */
+    var85.i = (var81.i * var84.i) & 0xffff;
+    /* 44: subw */
+    var86.i = var78.i - var85.i;
+    /* 45: subw */
+    var87.i = var42.i - var86.i;
+    /* 46: andw */
+    var88.i = var87.i & var60.i;
+    /* 47: loadw */
+    var54 = ptr11[i];
+    /* 48: addw */
+    var89.i = var54.i + var88.i;
+    /* 49: shrsw */
+    var90.i = var89.i >> 5;
+    /* 50: convsuswb */
+    var55 = ORC_CLAMP_UB (var90.i);
+    /* 51: storeb */
+    ptr0[i] = var55;
+  }
+
+}
+
+#else
+static void
+_backup_ivtc_orc_reconstruct_taps_final (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  const orc_int8 *ORC_RESTRICT ptr7;
+  const orc_int8 *ORC_RESTRICT ptr8;
+  const orc_int8 *ORC_RESTRICT ptr9;
+  const orc_int8 *ORC_RESTRICT ptr10;
+  const orc_union16 *ORC_RESTRICT ptr11;
+  orc_int8 var40;
+  orc_union16 var41;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var42;
+#else
+  orc_union16 var42;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var43;
+#else
+  orc_union16 var43;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var44;
+#else
+  orc_union16 var44;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var45;
+#else
+  orc_union16 var45;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var46;
+#else
+  orc_union16 var46;
+#endif
+  orc_int8 var47;
+  orc_int8 var48;
+  orc_int8 var49;
+  orc_int8 var50;
+  orc_int8 var51;
+  orc_int8 var52;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var53;
+#else
+  orc_union16 var53;
+#endif
+  orc_union16 var54;
+  orc_int8 var55;
+  orc_union16 var56;
+  orc_union16 var57;
+  orc_union16 var58;
+  orc_union16 var59;
+  orc_union16 var60;
+  orc_union16 var61;
+  orc_union16 var62;
+  orc_union16 var63;
+  orc_union16 var64;
+  orc_union16 var65;
+  orc_union16 var66;
+  orc_union16 var67;
+  orc_union16 var68;
+  orc_union16 var69;
+  orc_union16 var70;
+  orc_union16 var71;
+  orc_union16 var72;
+  orc_union16 var73;
+  orc_union16 var74;
+  orc_union16 var75;
+  orc_union16 var76;
+  orc_union16 var77;
+  orc_union16 var78;
+  orc_union16 var79;
+  orc_union16 var80;
+  orc_union16 var81;
+  orc_union16 var82;
+  orc_union16 var83;
+  orc_union16 var84;
+  orc_union16 var85;
+  orc_union16 var86;
+  orc_union16 var87;
+  orc_union16 var88;
+  orc_union16 var89;
+  orc_union16 var90;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr4 = (orc_int8 *) ex->arrays[4];
+  ptr5 = (orc_int8 *) ex->arrays[5];
+  ptr6 = (orc_int8 *) ex->arrays[6];
+  ptr7 = (orc_int8 *) ex->arrays[7];
+  ptr8 = (orc_int8 *) ex->arrays[8];
+  ptr9 = (orc_int8 *) ex->arrays[9];
+  ptr10 = (orc_int8 *) ex->arrays[10];
+  ptr11 = (orc_union16 *) ex->arrays[11];
+
+  /* 2: loadpw */
+  var41.i = ex->params[24];
+  /* 4: loadpw */
+  var42.i = (int) 0x00000000;   /* 0 or 0f */
+  /* 6: loadpw */
+  var43.i = (int) 0x00000005;   /* 5 or 2.47033e-323f */
+  /* 9: loadpw */
+  var44.i = (int) 0x00000001;   /* 1 or 4.94066e-324f */
+  /* 11: loadpw */
+  var45.i = (int) 0x00000002;   /* 2 or 9.88131e-324f */
+  /* 13: loadpw */
+  var46.i = (int) 0x00000003;   /* 3 or 1.4822e-323f */
+  /* 41: loadpw */
+  var53.i = (int) 0x00000008;   /* 8 or 3.95253e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var40 = ptr10[i];
+    /* 1: convubw */
+    var56.i = (orc_uint8) var40;
+    /* 3: subw */
+    var57.i = var56.i - var41.i;
+    /* 5: cmpgtsw */
+    var58.i = (var57.i > var42.i) ? (~0) : 0;
+    /* 7: cmpgtsw */
+    var59.i = (var43.i > var57.i) ? (~0) : 0;
+    /* 8: andw */
+    var60.i = var58.i & var59.i;
+    /* 10: cmpgtsw */
+    var61.i = (var57.i > var44.i) ? (~0) : 0;
+    /* 12: cmpgtsw */
+    var62.i = (var57.i > var45.i) ? (~0) : 0;
+    /* 14: cmpgtsw */
+    var63.i = (var57.i > var46.i) ? (~0) : 0;
+    /* 15: loadb */
+    var47 = ptr4[i];
+    /* 16: convubw */
+    var64.i = (orc_uint8) var47;
+    /* 17: loadb */
+    var48 = ptr9[i];
+    /* 18: convubw */
+    var65.i = (orc_uint8) var48;
+    /* 19: addw */
+    var66.i = var64.i + var65.i;
+    /* 20: mullw */
+    var67.i = (var63.i * var46.i) & 0xffff;
+    /* 21: addw */
+    var68.i = var67.i + var62.i;
+    /* 22: mullw */
+    var69.i = (var66.i * var68.i) & 0xffff;
+    /* 23: loadb */
+    var49 = ptr5[i];
+    /* 24: convubw */
+    var70.i = (orc_uint8) var49;
+    /* 25: loadb */
+    var50 = ptr8[i];
+    /* 26: convubw */
+    var71.i = (orc_uint8) var50;
+    /* 27: addw */
+    var72.i = var70.i + var71.i;
+    /* 28: shlw */
+    var73.i = ((orc_uint16) var61.i) << 2;
+    /* 29: addw */
+    var74.i = var73.i + var63.i;
+    /* 30: mullw */
+    var75.i = (var62.i * var46.i) & 0xffff;
+    /* 31: addw */
+    var76.i = var74.i + var75.i;
+    /* 32: mullw */
+    var77.i = (var72.i * var76.i) & 0xffff;
+    /* 33: addw */
+    var78.i = var69.i + var77.i;
+    /* 34: loadb */
+    var51 = ptr6[i];
+    /* 35: convubw */
+    var79.i = (orc_uint8) var51;
+    /* 36: loadb */
+    var52 = ptr7[i];
+    /* 37: convubw */
+    var80.i = (orc_uint8) var52;
+    /* 38: addw */
+    var81.i = var79.i + var80.i;
+    /* 39: mullw */
+    var82.i = (var63.i * var46.i) & 0xffff;
+    /* 40: addw */
+    var83.i = var82.i + var62.i;
+    /* 42: addw */
+    var84.i = var83.i + var53.i;
+    /* 43: mullw */
+    var85.i = (var81.i * var84.i) & 0xffff;
+    /* 44: subw */
+    var86.i = var78.i - var85.i;
+    /* 45: subw */
+    var87.i = var42.i - var86.i;
+    /* 46: andw */
+    var88.i = var87.i & var60.i;
+    /* 47: loadw */
+    var54 = ptr11[i];
+    /* 48: addw */
+    var89.i = var54.i + var88.i;
+    /* 49: shrsw */
+    var90.i = var89.i >> 5;
+    /* 50: convsuswb */
+    var55 = ORC_CLAMP_UB (var90.i);
+    /* 51: storeb */
+    ptr0[i] = var55;
+  }
+
+}
+
+void
+ivtc_orc_reconstruct_taps_final (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4,
+    const guint8 * ORC_RESTRICT s5, const guint8 * ORC_RESTRICT s6,
+    const guint8 * ORC_RESTRICT s7, const guint16 * ORC_RESTRICT s8, int p1,
+    int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 31, 105, 118, 116, 99, 95, 111, 114, 99, 95, 114, 101, 99, 111,
+        110, 115, 116, 114, 117, 99, 116, 95, 116, 97, 112, 115, 95, 102, 105,
+            110,
+        97, 108, 11, 1, 1, 12, 1, 1, 12, 1, 1, 12, 1, 1, 12, 1,
+        1, 12, 1, 1, 12, 1, 1, 12, 1, 1, 12, 2, 2, 14, 2, 0,
+        0, 0, 0, 14, 2, 5, 0, 0, 0, 14, 2, 1, 0, 0, 0, 14,
+        2, 2, 0, 0, 0, 14, 2, 3, 0, 0, 0, 14, 2, 8, 0, 0,
+        0, 16, 2, 20, 2, 20, 2, 20, 2, 20, 2, 20, 2, 20, 2, 20,
+        2, 20, 2, 150, 32, 10, 98, 32, 32, 24, 78, 33, 32, 16, 78, 34,
+        17, 32, 73, 33, 33, 34, 78, 34, 32, 18, 78, 35, 32, 19, 78, 36,
+        32, 20, 150, 37, 4, 150, 38, 9, 70, 37, 37, 38, 89, 38, 36, 20,
+        70, 38, 38, 35, 89, 37, 37, 38, 150, 38, 5, 150, 39, 8, 70, 38,
+        38, 39, 93, 39, 34, 19, 70, 39, 39, 36, 89, 32, 35, 20, 70, 39,
+        39, 32, 89, 38, 38, 39, 70, 37, 37, 38, 150, 38, 6, 150, 39, 7,
+        70, 38, 38, 39, 89, 39, 36, 20, 70, 39, 39, 35, 70, 39, 39, 21,
+        89, 38, 38, 39, 98, 37, 37, 38, 98, 37, 16, 37, 73, 37, 37, 33,
+        70, 37, 11, 37, 94, 37, 37, 17, 160, 0, 37, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p,
+          _backup_ivtc_orc_reconstruct_taps_final);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "ivtc_orc_reconstruct_taps_final");
+      orc_program_set_backup_function (p,
+          _backup_ivtc_orc_reconstruct_taps_final);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_source (p, 1, "s1");
+      orc_program_add_source (p, 1, "s2");
+      orc_program_add_source (p, 1, "s3");
+      orc_program_add_source (p, 1, "s4");
+      orc_program_add_source (p, 1, "s5");
+      orc_program_add_source (p, 1, "s6");
+      orc_program_add_source (p, 1, "s7");
+      orc_program_add_source (p, 2, "s8");
+      orc_program_add_constant (p, 2, 0x00000000, "c1");
+      orc_program_add_constant (p, 2, 0x00000005, "c2");
+      orc_program_add_constant (p, 2, 0x00000001, "c3");
+      orc_program_add_constant (p, 2, 0x00000002, "c4");
+      orc_program_add_constant (p, 2, 0x00000003, "c5");
+      orc_program_add_constant (p, 2, 0x00000008, "c6");
+      orc_program_add_parameter (p, 2, "p1");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 2, "t3");
+      orc_program_add_temporary (p, 2, "t4");
+      orc_program_add_temporary (p, 2, "t5");
+      orc_program_add_temporary (p, 2, "t6");
+      orc_program_add_temporary (p, 2, "t7");
+      orc_program_add_temporary (p, 2, "t8");
+
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T1, ORC_VAR_S7, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T3, ORC_VAR_C2, ORC_VAR_T1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T4, ORC_VAR_T1, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "cmpgtsw", 0, ORC_VAR_T5, ORC_VAR_T1, ORC_VAR_C5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T6, ORC_VAR_S1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T7, ORC_VAR_S6, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_C5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T7, ORC_VAR_S2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T8, ORC_VAR_S5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shlw", 0, ORC_VAR_T8, ORC_VAR_T3, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T1, ORC_VAR_T4, ORC_VAR_C5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T7, ORC_VAR_S3, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T8, ORC_VAR_S4, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T8, ORC_VAR_T5, ORC_VAR_C5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 0, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_T7,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subw", 0, ORC_VAR_T6, ORC_VAR_C1, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andw", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 0, ORC_VAR_T6, ORC_VAR_S8, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsw", 0, ORC_VAR_T6, ORC_VAR_T6, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 0, ORC_VAR_D1, ORC_VAR_T6,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+  ex->arrays[ORC_VAR_S5] = (void *) s5;
+  ex->arrays[ORC_VAR_S6] = (void *) s6;
+  ex->arrays[ORC_VAR_S7] = (void *) s7;
+  ex->arrays[ORC_VAR_S8] = (void *) s8;
+  ex->params[ORC_VAR_P1] = p1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* ivtc_orc_average_lines */
+#ifdef DISABLE_ORC
+void
+ivtc_orc_average_lines (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  orc_int8 var32;
+  orc_int8 var33;
+  orc_int8 var34;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr4 = (orc_int8 *) s1;
+  ptr5 = (orc_int8 *) s2;
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var32 = ptr4[i];
+    /* 1: loadb */
+    var33 = ptr5[i];
+    /* 2: avgub */
+    var34 = ((orc_uint8) var32 + (orc_uint8) var33 + 1) >> 1;
+    /* 3: storeb */
+    ptr0[i] = var34;
+  }
+
+}
+
+#else
+static void
+_backup_ivtc_orc_average_lines (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  orc_int8 var32;
+  orc_int8 var33;
+  orc_int8 var34;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr4 = (orc_int8 *) ex->arrays[4];
+  ptr5 = (orc_int8 *) ex->arrays[5];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var32 = ptr4[i];
+    /* 1: loadb */
+    var33 = ptr5[i];
+    /* 2: avgub */
+    var34 = ((orc_uint8) var32 + (orc_uint8) var33 + 1) >> 1;
+    /* 3: storeb */
+    ptr0[i] = var34;
+  }
+
+}
+
+void
+ivtc_orc_average_lines (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 22, 105, 118, 116, 99, 95, 111, 114, 99, 95, 97, 118, 101, 114,
+        97, 103, 101, 95, 108, 105, 110, 101, 115, 11, 1, 1, 12, 1, 1, 12,
+        1, 1, 39, 0, 4, 5, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_ivtc_orc_average_lines);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "ivtc_orc_average_lines");
+      orc_program_set_backup_function (p, _backup_ivtc_orc_average_lines);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_source (p, 1, "s1");
+      orc_program_add_source (p, 1, "s2");
+
+      orc_program_append_2 (p, "avgub", 0, ORC_VAR_D1, ORC_VAR_S1, ORC_VAR_S2,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
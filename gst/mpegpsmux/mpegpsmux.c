@@ -44,6 +44,7 @@
 #include "config.h"
 #endif
 #include <string.h>
+#include <gst/mpegts/mpegts.h>
 
 #include "mpegpsmux.h"
 #include "mpegpsmux_aac.h"
@@ -774,6 +775,7 @@ mpegpsmux_change_state (GstElement * element, GstStateChange transition)
 static gboolean
 plugin_init (GstPlugin * plugin)
 {
+  gst_mpegts_initialize ();
   if (!gst_element_register (plugin, "mpegpsmux", GST_RANK_PRIMARY,
           mpegpsmux_get_type ()))
     return FALSE;
@@ -1451,6 +1451,7 @@ mpegts_base_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 static GstFlowReturn
 mpegts_base_scan (MpegTSBase * base)
 {
+  MpegTSBaseClass *klass = GST_MPEGTS_BASE_GET_CLASS (base);
   GstFlowReturn ret = GST_FLOW_OK;
   GstBuffer *buf = NULL;
   guint i;
@@ -1511,6 +1512,11 @@ mpegts_base_scan (MpegTSBase * base)
     goto beach;
   upstream_size = tmpval;
 
+  if (klass->load_index && klass->load_index (base, upstream_size)) {
+    GST_DEBUG ("Index covers the end of the stream, not scanning it");
+    goto beach;
+  }
+
   /* The scanning takes place on the last 2048kB. Considering PCR should
    * be present at least every 100ms, this should cope with streams
    * up to 160Mbit/s */
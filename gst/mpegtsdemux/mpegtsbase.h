@@ -194,6 +194,11 @@ struct _MpegTSBaseClass {
   /* seek is called to wait for seeking */
   GstFlowReturn (*seek) (MpegTSBase * base, GstEvent * event);
 
+  /* load_index is called in pull mode once the initial PCRs were found, to
+   * feed PCR observations from a seek index to the packetizer. Returns TRUE
+   * if they reach the end of the stream, which then doesn't need scanning */
+  gboolean (*load_index) (MpegTSBase * base, guint64 upstream_size);
+
   /* Drain all currently pending data */
   GstFlowReturn (*drain) (MpegTSBase * base);
 
@@ -0,0 +1,382 @@
+/*
+ * mpegtsindex.c : Seek index sidecar files for MPEG-TS
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include <gst/base/base.h>
+
+#include "mpegtsindex.h"
+
+GST_DEBUG_CATEGORY_STATIC (mpegts_index_debug);
+#define GST_CAT_DEFAULT mpegts_index_debug
+
+/* File layout (all values little-endian):
+ *
+ *   magic            8 bytes "GSTTSIDX"
+ *   version          uint32
+ *   packet_size      uint32
+ *   file_size        uint64
+ *   file_mtime       int64
+ *   pcr_pid          uint32
+ *   n_groups         uint32
+ *   n_groups times:
+ *     flags          uint32
+ *     n_values       uint32
+ *     first_pcr      uint64
+ *     first_offset   uint64
+ *     pcr_offset     uint64
+ *     n_values times:
+ *       pcr          uint64
+ *       offset       uint64
+ *   keyframe_pid     uint32
+ *   n_keyframes      uint32
+ *   n_keyframes times:
+ *     ts             uint64
+ *     offset         uint64
+ */
+#define INDEX_MAGIC "GSTTSIDX"
+#define INDEX_MAGIC_SIZE 8
+#define INDEX_VERSION 1
+
+MpegTSIndex *
+mpegts_index_new (guint64 file_size, gint64 file_mtime)
+{
+  MpegTSIndex *index = g_slice_new0 (MpegTSIndex);
+
+  index->file_size = file_size;
+  index->file_mtime = file_mtime;
+  index->pcr_pid = 0x1fff;
+  index->keyframe_pid = 0x1fff;
+  index->keyframes = g_array_new (FALSE, FALSE, sizeof (MpegTSIndexEntry));
+
+  return index;
+}
+
+void
+mpegts_index_free (MpegTSIndex * index)
+{
+  mpegts_packetizer_free_pcr_groups (index->groups);
+  g_array_free (index->keyframes, TRUE);
+  g_slice_free (MpegTSIndex, index);
+}
+
+static PCROffsetGroup *
+read_group (GstByteReader * br, guint64 file_size)
+{
+  PCROffsetGroup *group;
+  guint32 flags, n_values, i;
+  guint64 first_pcr, first_offset, pcr_offset;
+
+  if (!gst_byte_reader_get_uint32_le (br, &flags) ||
+      !gst_byte_reader_get_uint32_le (br, &n_values) ||
+      !gst_byte_reader_get_uint64_le (br, &first_pcr) ||
+      !gst_byte_reader_get_uint64_le (br, &first_offset) ||
+      !gst_byte_reader_get_uint64_le (br, &pcr_offset))
+    return NULL;
+
+  /* The first value is the reference (0/0) of the group */
+  if (n_values == 0 || first_offset >= file_size ||
+      gst_byte_reader_get_remaining (br) / 16 < n_values)
+    return NULL;
+
+  group = g_slice_new0 (PCROffsetGroup);
+  group->flags = flags;
+  group->first_pcr = first_pcr;
+  group->first_offset = first_offset;
+  group->pcr_offset = pcr_offset;
+  group->values = g_new (PCROffset, n_values);
+  group->nb_allocated = n_values;
+  group->last_value = n_values - 1;
+
+  for (i = 0; i < n_values; i++) {
+    gst_byte_reader_get_uint64_le (br, &group->values[i].pcr);
+    gst_byte_reader_get_uint64_le (br, &group->values[i].offset);
+  }
+
+  if (group->values[0].pcr != 0 || group->values[0].offset != 0 ||
+      group->first_offset + group->values[group->last_value].offset >=
+      file_size) {
+    g_free (group->values);
+    g_slice_free (PCROffsetGroup, group);
+    return NULL;
+  }
+
+  return group;
+}
+
+/* Loads the index stored in @location. Returns NULL if it doesn't exist,
+ * is invalid, or was made for a file of a different size or modification
+ * time */
+MpegTSIndex *
+mpegts_index_load (const gchar * location, guint64 file_size,
+    gint64 file_mtime)
+{
+  MpegTSIndex *index = NULL;
+  GstByteReader br;
+  GError *error = NULL;
+  gchar *contents;
+  gsize size;
+  const guint8 *magic;
+  guint32 version, packet_size, pcr_pid, n_groups, keyframe_pid, n_keyframes;
+  guint64 indexed_size;
+  gint64 indexed_mtime;
+  guint64 last_offset = 0;
+  guint i;
+
+  if (!g_file_get_contents (location, &contents, &size, &error)) {
+    GST_DEBUG ("No index in %s: %s", location, error->message);
+    g_clear_error (&error);
+    return NULL;
+  }
+
+  gst_byte_reader_init (&br, (const guint8 *) contents, size);
+
+  if (!gst_byte_reader_get_data (&br, INDEX_MAGIC_SIZE, &magic) ||
+      memcmp (magic, INDEX_MAGIC, INDEX_MAGIC_SIZE) != 0 ||
+      !gst_byte_reader_get_uint32_le (&br, &version) ||
+      version != INDEX_VERSION)
+    goto invalid;
+
+  if (!gst_byte_reader_get_uint32_le (&br, &packet_size) ||
+      !gst_byte_reader_get_uint64_le (&br, &indexed_size) ||
+      !gst_byte_reader_get_int64_le (&br, &indexed_mtime))
+    goto invalid;
+
+  if (indexed_size != file_size || indexed_mtime != file_mtime) {
+    GST_INFO ("Index %s is outdated (size %" G_GUINT64_FORMAT " mtime %"
+        G_GINT64_FORMAT ", file has size %" G_GUINT64_FORMAT " mtime %"
+        G_GINT64_FORMAT ")", location, indexed_size, indexed_mtime, file_size,
+        file_mtime);
+    g_free (contents);
+    return NULL;
+  }
+
+  if (!gst_byte_reader_get_uint32_le (&br, &pcr_pid) || pcr_pid > 0x1fff ||
+      !gst_byte_reader_get_uint32_le (&br, &n_groups))
+    goto invalid;
+
+  index = mpegts_index_new (file_size, file_mtime);
+  index->packet_size = packet_size;
+  index->pcr_pid = pcr_pid;
+
+  for (i = 0; i < n_groups; i++) {
+    PCROffsetGroup *group = read_group (&br, file_size);
+
+    if (group == NULL)
+      goto invalid;
+    /* Groups must be sorted and must not overlap */
+    if (i > 0 && group->first_offset <= last_offset) {
+      mpegts_packetizer_free_pcr_groups (g_list_prepend (NULL, group));
+      goto invalid;
+    }
+    last_offset = group->first_offset + group->values[group->last_value].offset;
+    index->groups = g_list_prepend (index->groups, group);
+  }
+  index->groups = g_list_reverse (index->groups);
+
+  if (!gst_byte_reader_get_uint32_le (&br, &keyframe_pid) ||
+      keyframe_pid > 0x1fff ||
+      !gst_byte_reader_get_uint32_le (&br, &n_keyframes) ||
+      gst_byte_reader_get_remaining (&br) / 16 < n_keyframes)
+    goto invalid;
+
+  index->keyframe_pid = keyframe_pid;
+  g_array_set_size (index->keyframes, n_keyframes);
+  for (i = 0; i < n_keyframes; i++) {
+    MpegTSIndexEntry *entry =
+        &g_array_index (index->keyframes, MpegTSIndexEntry, i);
+
+    gst_byte_reader_get_uint64_le (&br, &entry->ts);
+    gst_byte_reader_get_uint64_le (&br, &entry->offset);
+    if (entry->offset >= file_size || (i > 0 && entry->offset <= entry[-1].offset))
+      goto invalid;
+  }
+
+  GST_DEBUG ("Loaded index %s with %u PCR groups and %u keyframes", location,
+      n_groups, n_keyframes);
+
+  g_free (contents);
+  return index;
+
+invalid:
+  GST_WARNING ("Ignoring invalid index %s", location);
+  if (index)
+    mpegts_index_free (index);
+  g_free (contents);
+  return NULL;
+}
+
+gboolean
+mpegts_index_save (MpegTSIndex * index, const gchar * location)
+{
+  GstByteWriter bw;
+  GError *error = NULL;
+  GList *tmp;
+  guint8 *data;
+  gsize size;
+  gboolean res;
+  guint i;
+
+  gst_byte_writer_init_with_size (&bw,
+      64 + index->keyframes->len * sizeof (MpegTSIndexEntry), FALSE);
+
+  gst_byte_writer_put_data (&bw, (const guint8 *) INDEX_MAGIC,
+      INDEX_MAGIC_SIZE);
+  gst_byte_writer_put_uint32_le (&bw, INDEX_VERSION);
+  gst_byte_writer_put_uint32_le (&bw, index->packet_size);
+  gst_byte_writer_put_uint64_le (&bw, index->file_size);
+  gst_byte_writer_put_int64_le (&bw, index->file_mtime);
+
+  gst_byte_writer_put_uint32_le (&bw, index->pcr_pid);
+  gst_byte_writer_put_uint32_le (&bw, g_list_length (index->groups));
+  for (tmp = index->groups; tmp; tmp = tmp->next) {
+    PCROffsetGroup *group = (PCROffsetGroup *) tmp->data;
+
+    gst_byte_writer_put_uint32_le (&bw, group->flags);
+    gst_byte_writer_put_uint32_le (&bw, group->last_value + 1);
+    gst_byte_writer_put_uint64_le (&bw, group->first_pcr);
+    gst_byte_writer_put_uint64_le (&bw, group->first_offset);
+    gst_byte_writer_put_uint64_le (&bw, group->pcr_offset);
+    for (i = 0; i <= group->last_value; i++) {
+      gst_byte_writer_put_uint64_le (&bw, group->values[i].pcr);
+      gst_byte_writer_put_uint64_le (&bw, group->values[i].offset);
+    }
+  }
+
+  gst_byte_writer_put_uint32_le (&bw, index->keyframe_pid);
+  gst_byte_writer_put_uint32_le (&bw, index->keyframes->len);
+  for (i = 0; i < index->keyframes->len; i++) {
+    MpegTSIndexEntry *entry =
+        &g_array_index (index->keyframes, MpegTSIndexEntry, i);
+
+    gst_byte_writer_put_uint64_le (&bw, entry->ts);
+    gst_byte_writer_put_uint64_le (&bw, entry->offset);
+  }
+
+  size = gst_byte_writer_get_size (&bw);
+  data = gst_byte_writer_reset_and_get_data (&bw);
+
+  /* Written to a temporary file first, so concurrent readers either see
+   * the old or the new index */
+  res = g_file_set_contents (location, (const gchar *) data, size, &error);
+  if (res) {
+    GST_DEBUG ("Saved index %s (%" G_GSIZE_FORMAT " bytes, %u keyframes)",
+        location, size, index->keyframes->len);
+  } else {
+    GST_WARNING ("Could not save index %s: %s", location, error->message);
+    g_clear_error (&error);
+  }
+
+  g_free (data);
+  return res;
+}
+
+/* Returns the position of the first keyframe at or after @offset */
+static guint
+find_keyframe_position (MpegTSIndex * index, guint64 offset)
+{
+  guint lo = 0, hi = index->keyframes->len;
+
+  while (lo < hi) {
+    guint mid = lo + (hi - lo) / 2;
+
+    if (g_array_index (index->keyframes, MpegTSIndexEntry, mid).offset <
+        offset)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return lo;
+}
+
+/* Returns TRUE if the keyframe wasn't known yet */
+gboolean
+mpegts_index_add_keyframe (MpegTSIndex * index, GstClockTime ts,
+    guint64 offset)
+{
+  MpegTSIndexEntry entry;
+  guint pos;
+
+  /* Keyframes are mostly added in order while playing */
+  if (index->keyframes->len == 0 ||
+      g_array_index (index->keyframes, MpegTSIndexEntry,
+          index->keyframes->len - 1).offset < offset) {
+    pos = index->keyframes->len;
+  } else {
+    pos = find_keyframe_position (index, offset);
+    if (g_array_index (index->keyframes, MpegTSIndexEntry, pos).offset ==
+        offset)
+      return FALSE;
+  }
+
+  GST_LOG ("Adding keyframe %" GST_TIME_FORMAT " at offset %"
+      G_GUINT64_FORMAT, GST_TIME_ARGS (ts), offset);
+
+  entry.ts = ts;
+  entry.offset = offset;
+  g_array_insert_val (index->keyframes, pos, entry);
+
+  return TRUE;
+}
+
+/* Returns the last keyframe at or before @ts, or NULL if there is none */
+const MpegTSIndexEntry *
+mpegts_index_find_keyframe (MpegTSIndex * index, GstClockTime ts)
+{
+  guint lo = 0, hi = index->keyframes->len;
+
+  /* Stream times increase with the offset */
+  while (lo < hi) {
+    guint mid = lo + (hi - lo) / 2;
+
+    if (g_array_index (index->keyframes, MpegTSIndexEntry, mid).ts <= ts)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  if (lo == 0)
+    return NULL;
+
+  return &g_array_index (index->keyframes, MpegTSIndexEntry, lo - 1);
+}
+
+/* Returns the last keyframe before @offset, or NULL if there is none */
+const MpegTSIndexEntry *
+mpegts_index_find_keyframe_before_offset (MpegTSIndex * index, guint64 offset)
+{
+  guint pos = find_keyframe_position (index, offset);
+
+  if (pos == 0)
+    return NULL;
+
+  return &g_array_index (index->keyframes, MpegTSIndexEntry, pos - 1);
+}
+
+void
+init_mpegts_index (void)
+{
+  GST_DEBUG_CATEGORY_INIT (mpegts_index_debug, "mpegtsindex", 0,
+      "MPEG transport stream seek index");
+}
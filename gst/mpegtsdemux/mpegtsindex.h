@@ -0,0 +1,84 @@
+/*
+ * mpegtsindex.h : Seek index sidecar files for MPEG-TS
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __MPEGTS_INDEX_H__
+#define __MPEGTS_INDEX_H__
+
+#include <gst/gst.h>
+#include "mpegtspacketizer.h"
+
+G_BEGIN_DECLS
+
+typedef struct _MpegTSIndex MpegTSIndex;
+typedef struct _MpegTSIndexEntry MpegTSIndexEntry;
+
+/* A keyframe position */
+struct _MpegTSIndexEntry
+{
+  /* Stream time of the keyframe (same as the outgoing PTS) */
+  GstClockTime ts;
+  /* Offset of the TS packet starting the keyframe PES */
+  guint64 offset;
+};
+
+/* The seek index of one file.
+ *
+ * The PCR/offset groups are the observations of the packetizer for
+ * @pcr_pid, as they were when the index was saved. Keyframes of
+ * @keyframe_pid are sorted by offset (and therefore by stream time). */
+struct _MpegTSIndex
+{
+  /* Size (in bytes) and modification time (in seconds since the epoch)
+   * of the indexed file. The index is discarded if they changed. */
+  guint64 file_size;
+  gint64 file_mtime;
+
+  guint16 packet_size;
+
+  guint16 pcr_pid;
+  /* PCROffsetGroup, sorted by offset */
+  GList *groups;
+
+  guint16 keyframe_pid;
+  /* MpegTSIndexEntry, sorted by offset */
+  GArray *keyframes;
+};
+
+G_GNUC_INTERNAL MpegTSIndex *mpegts_index_new (guint64 file_size,
+    gint64 file_mtime);
+G_GNUC_INTERNAL void mpegts_index_free (MpegTSIndex * index);
+
+G_GNUC_INTERNAL MpegTSIndex *mpegts_index_load (const gchar * location,
+    guint64 file_size, gint64 file_mtime);
+G_GNUC_INTERNAL gboolean mpegts_index_save (MpegTSIndex * index,
+    const gchar * location);
+
+G_GNUC_INTERNAL gboolean mpegts_index_add_keyframe (MpegTSIndex * index,
+    GstClockTime ts, guint64 offset);
+G_GNUC_INTERNAL const MpegTSIndexEntry *mpegts_index_find_keyframe (MpegTSIndex *
+    index, GstClockTime ts);
+G_GNUC_INTERNAL const MpegTSIndexEntry
+    *mpegts_index_find_keyframe_before_offset (MpegTSIndex * index,
+    guint64 offset);
+
+G_GNUC_INTERNAL void init_mpegts_index (void);
+
+G_END_DECLS
+
+#endif /* __MPEGTS_INDEX_H__ */
@@ -135,20 +135,13 @@ mpegts_packetizer_get_current_time (MpegTSPacketizer2 * packetizer,
 }
 
 static inline MpegTSPacketizerStreamSubtable *
-find_subtable (GSList * subtables, guint8 table_id, guint16 subtable_extension)
+find_subtable (GHashTable * subtables, guint8 table_id,
+    guint16 subtable_extension)
 {
-  GSList *tmp;
-
-  /* FIXME: Make this an array ! */
-  for (tmp = subtables; tmp; tmp = tmp->next) {
-    MpegTSPacketizerStreamSubtable *sub =
-        (MpegTSPacketizerStreamSubtable *) tmp->data;
-    if (sub->table_id == table_id
-        && sub->subtable_extension == subtable_extension)
-      return sub;
-  }
-
-  return NULL;
+  /* PIDs like the EIT one carry thousands of subtables (one per table_id and
+   * service), a lookup has to stay cheap as it's done for every section */
+  return g_hash_table_lookup (subtables,
+      SUBTABLE_KEY (table_id, subtable_extension));
 }
 
 static gboolean
@@ -192,6 +185,13 @@ mpegts_packetizer_stream_subtable_new (guint8 table_id,
   return subtable;
 }
 
+static void
+mpegts_packetizer_stream_subtable_free (MpegTSPacketizerStreamSubtable *
+    subtable)
+{
+  g_free (subtable);
+}
+
 static MpegTSPacketizerStream *
 mpegts_packetizer_stream_new (guint16 pid)
 {
@@ -199,7 +199,8 @@ mpegts_packetizer_stream_new (guint16 pid)
 
   stream = (MpegTSPacketizerStream *) g_new0 (MpegTSPacketizerStream, 1);
   stream->continuity_counter = CONTINUITY_UNSET;
-  stream->subtables = NULL;
+  stream->subtables = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+      NULL, (GDestroyNotify) mpegts_packetizer_stream_subtable_free);
   stream->table_id = TABLE_ID_UNSET;
   stream->pid = pid;
   return stream;
@@ -216,20 +217,11 @@ mpegts_packetizer_clear_section (MpegTSPacketizerStream * stream)
   stream->section_data = NULL;
 }
 
-static void
-mpegts_packetizer_stream_subtable_free (MpegTSPacketizerStreamSubtable *
-    subtable)
-{
-  g_free (subtable);
-}
-
 static void
 mpegts_packetizer_stream_free (MpegTSPacketizerStream * stream)
 {
   mpegts_packetizer_clear_section (stream);
-  g_slist_foreach (stream->subtables,
-      (GFunc) mpegts_packetizer_stream_subtable_free, NULL);
-  g_slist_free (stream->subtables);
+  g_hash_table_destroy (stream->subtables);
   g_free (stream);
 }
 
@@ -516,7 +508,8 @@ mpegts_packetizer_parse_section_header (MpegTSPacketizer2 * packetizer,
         stream->subtable_extension, stream->last_section_number);
     subtable->version_number = stream->version_number;
 
-    stream->subtables = g_slist_prepend (stream->subtables, subtable);
+    g_hash_table_insert (stream->subtables,
+        SUBTABLE_KEY (stream->table_id, stream->subtable_extension), subtable);
   }
 
   GST_MEMDUMP ("Full section data", stream->section_data,
@@ -695,7 +688,7 @@ mpegts_packetizer_flush_bytes (MpegTSPacketizer2 * packetizer, gsize size)
 static gboolean
 mpegts_packetizer_map (MpegTSPacketizer2 * packetizer, gsize size)
 {
-  gsize available;
+  gsize available, available_fast;
 
   if (packetizer->map_size - packetizer->map_offset >= size)
     return TRUE;
@@ -706,24 +699,70 @@ mpegts_packetizer_map (MpegTSPacketizer2 * packetizer, gsize size)
   if (available < size)
     return FALSE;
 
-  packetizer->map_data =
-      (guint8 *) gst_adapter_map (packetizer->adapter, available);
-  if (!packetizer->map_data)
-    return FALSE;
+  /* Mapping more than the first buffer in the adapter would merge all
+   * queued buffers, which copies the whole data. So only map the first
+   * buffer if it holds enough data. */
+  available_fast = gst_adapter_available_fast (packetizer->adapter);
+
+  if (available_fast >= size) {
+    packetizer->map_data =
+        (guint8 *) gst_adapter_map (packetizer->adapter, available_fast);
+    if (!packetizer->map_data)
+      return FALSE;
+    packetizer->map_size = available_fast;
+  } else if (size <= MPEGTS_MAX_PACKETSIZE) {
+    /* The packet straddles a buffer boundary. Copy just this one packet. */
+    gst_adapter_unmap (packetizer->adapter);
+    gst_adapter_copy (packetizer->adapter, packetizer->bounce_buffer, 0, size);
+    packetizer->map_data = packetizer->bounce_buffer;
+    packetizer->map_size = size;
+    GST_LOG ("copied straddling packet of %" G_GSIZE_FORMAT " bytes", size);
+  } else {
+    /* Only happens while searching for sync bytes, which requires a
+     * contiguous block of several packets */
+    packetizer->map_data =
+        (guint8 *) gst_adapter_map (packetizer->adapter, available);
+    if (!packetizer->map_data)
+      return FALSE;
+    packetizer->map_size = available;
+  }
 
-  packetizer->map_size = available;
   packetizer->map_offset = 0;
 
-  GST_LOG ("mapped %" G_GSIZE_FORMAT " bytes from adapter", available);
+  GST_LOG ("mapped %" G_GSIZE_FORMAT " bytes from adapter",
+      packetizer->map_size);
 
   return TRUE;
 }
 
+/* Number of packets that are checked at most when measuring the length of
+ * a run of packets that are in sync */
+#define MAX_SYNC_RUN_LENGTH 32
+
+/* Returns the number of consecutive packets with a sync byte at their start,
+ * where the first packet starts at data[0] */
+static guint
+mpegts_packetizer_sync_run_length (const guint8 * data, gsize size,
+    guint packet_size)
+{
+  guint run_length = 0;
+  gsize pos = 0;
+
+  while (run_length < MAX_SYNC_RUN_LENGTH && pos < size
+      && data[pos] == PACKET_SYNC_BYTE) {
+    run_length++;
+    pos += packet_size;
+  }
+
+  return run_length;
+}
+
 static gboolean
 mpegts_try_discover_packet_size (MpegTSPacketizer2 * packetizer)
 {
-  guint8 *data;
-  gsize size, i, j;
+  guint8 *data, *sync;
+  gsize size, i, j, end;
+  guint best_run_length = 0;
 
   static const guint psizes[] = {
     MPEGTS_NORMAL_PACKETSIZE,
@@ -737,23 +776,47 @@ mpegts_try_discover_packet_size (MpegTSPacketizer2 * packetizer)
 
   size = packetizer->map_size - packetizer->map_offset;
   data = packetizer->map_data + packetizer->map_offset;
+  end = size - 3 * MPEGTS_MAX_PACKETSIZE;
+
+  for (i = 0; i < end; i++) {
+    guint candidates;
 
-  for (i = 0; i + 3 * MPEGTS_MAX_PACKETSIZE < size; i++) {
-    /* find a sync byte */
-    if (data[i] != PACKET_SYNC_BYTE)
+    /* find a sync byte; memchr() is vectorized in all common C libraries
+     * and skips over non-sync bytes much faster than a bytewise loop */
+    sync = memchr (data + i, PACKET_SYNC_BYTE, end - i);
+    if (sync == NULL) {
+      i = end;
+      break;
+    }
+    i = sync - data;
+
+    /* check the next sync byte for all possible packet sizes at once */
+    candidates = (data[i + MPEGTS_NORMAL_PACKETSIZE] == PACKET_SYNC_BYTE)
+        | ((data[i + MPEGTS_M2TS_PACKETSIZE] == PACKET_SYNC_BYTE) << 1)
+        | ((data[i + MPEGTS_DVB_ASI_PACKETSIZE] == PACKET_SYNC_BYTE) << 2)
+        | ((data[i + MPEGTS_ATSC_PACKETSIZE] == PACKET_SYNC_BYTE) << 3);
+    if (G_LIKELY (candidates == 0))
       continue;
 
-    /* check for 4 consecutive sync bytes with each possible packet size */
+    /* At least 4 consecutive sync bytes are required. If several packet
+     * sizes qualify (because of sync bytes inside the payload), pick the
+     * one with the longest run of packets in sync. */
     for (j = 0; j < G_N_ELEMENTS (psizes); j++) {
-      guint packet_size = psizes[j];
+      guint run_length;
 
-      if (data[i + packet_size] == PACKET_SYNC_BYTE &&
-          data[i + 2 * packet_size] == PACKET_SYNC_BYTE &&
-          data[i + 3 * packet_size] == PACKET_SYNC_BYTE) {
-        packetizer->packet_size = packet_size;
-        goto out;
+      if (!(candidates & (1 << j)))
+        continue;
+
+      run_length =
+          mpegts_packetizer_sync_run_length (data + i, size - i, psizes[j]);
+      if (run_length >= 4 && run_length > best_run_length) {
+        best_run_length = run_length;
+        packetizer->packet_size = psizes[j];
       }
     }
+
+    if (best_run_length > 0)
+      goto out;
   }
 
 out:
@@ -766,7 +829,8 @@ out:
     return FALSE;
   }
 
-  GST_INFO ("have packetsize detected: %u bytes", packetizer->packet_size);
+  GST_INFO ("have packetsize detected: %u bytes (%u packets in sync)",
+      packetizer->packet_size, best_run_length);
 
   if (packetizer->packet_size == MPEGTS_M2TS_PACKETSIZE &&
       packetizer->map_offset >= 4)
@@ -779,9 +843,9 @@ static gboolean
 mpegts_packetizer_sync (MpegTSPacketizer2 * packetizer)
 {
   gboolean found = FALSE;
-  guint8 *data;
+  guint8 *data, *sync;
   guint packet_size;
-  gsize size, sync_offset, i;
+  gsize size, sync_offset, i, end;
 
   packet_size = packetizer->packet_size;
 
@@ -790,21 +854,34 @@ mpegts_packetizer_sync (MpegTSPacketizer2 * packetizer)
 
   size = packetizer->map_size - packetizer->map_offset;
   data = packetizer->map_data + packetizer->map_offset;
+  end = size - 2 * packet_size;
 
   if (packet_size == MPEGTS_M2TS_PACKETSIZE)
     sync_offset = 4;
   else
     sync_offset = 0;
 
-  for (i = sync_offset; i + 2 * packet_size < size; i++) {
-    if (data[i] == PACKET_SYNC_BYTE &&
-        data[i + packet_size] == PACKET_SYNC_BYTE &&
+  for (i = sync_offset; i < end; i++) {
+    sync = memchr (data + i, PACKET_SYNC_BYTE, end - i);
+    if (sync == NULL) {
+      i = end;
+      break;
+    }
+    i = sync - data;
+
+    if (data[i + packet_size] == PACKET_SYNC_BYTE &&
         data[i + 2 * packet_size] == PACKET_SYNC_BYTE) {
       found = TRUE;
       break;
     }
   }
 
+  if (found) {
+    GST_DEBUG ("resynced after skipping %" G_GSIZE_FORMAT " bytes (%u packets "
+        "in sync)", i - sync_offset,
+        mpegts_packetizer_sync_run_length (data + i, size - i, packet_size));
+  }
+
   packetizer->map_offset += i - sync_offset;
 
   if (!found)
@@ -2539,3 +2616,113 @@ mpegts_packetizer_set_current_pcr_offset (MpegTSPacketizer2 * packetizer,
   }
   PACKETIZER_GROUP_UNLOCK (packetizer);
 }
+
+/* Returns a copy of the PCR/offset groups observed so far for @pcr_pid,
+ * including the values still pending in the current window. Free with
+ * mpegts_packetizer_free_pcr_groups() */
+GList *
+mpegts_packetizer_dup_pcr_groups (MpegTSPacketizer2 * packetizer,
+    guint16 pcr_pid)
+{
+  MpegTSPCR *pcrtable;
+  PCROffsetCurrent *current;
+  GList *tmp, *res = NULL;
+
+  PACKETIZER_GROUP_LOCK (packetizer);
+  pcrtable = get_pcr_table (packetizer, pcr_pid);
+  current = pcrtable->current;
+
+  for (tmp = pcrtable->groups; tmp; tmp = tmp->next) {
+    PCROffsetGroup *group = (PCROffsetGroup *) tmp->data;
+    PCROffsetGroup *copy;
+
+    if (G_UNLIKELY (group->flags & PCR_GROUP_FLAG_ESTIMATED))
+      _reevaluate_group_pcr_offset (pcrtable, group);
+
+    copy = g_slice_dup (PCROffsetGroup, group);
+    copy->nb_allocated = group->last_value + 1;
+    copy->values = g_memdup (group->values,
+        copy->nb_allocated * sizeof (PCROffset));
+    if (current->group == group)
+      _append_group_values (copy, current->pending[current->last]);
+
+    res = g_list_prepend (res, copy);
+  }
+  PACKETIZER_GROUP_UNLOCK (packetizer);
+
+  return g_list_reverse (res);
+}
+
+/* Adds PCR/offset groups observed previously (for example by an earlier run
+ * over the same file) to the observations for @pcr_pid. @groups must be
+ * sorted and must not overlap. Existing groups entirely covered by one of
+ * them are replaced, the ones they only partially overlap with are kept.
+ * Takes ownership of @groups */
+void
+mpegts_packetizer_add_pcr_groups (MpegTSPacketizer2 * packetizer,
+    guint16 pcr_pid, GList * groups)
+{
+  MpegTSPCR *pcrtable;
+  GList *tmp;
+
+  PACKETIZER_GROUP_LOCK (packetizer);
+  pcrtable = get_pcr_table (packetizer, pcr_pid);
+
+  /* The current window might belong to a group which is about to be
+   * replaced. The next observation will find the group to fill again */
+  _close_current_group (pcrtable);
+
+  for (tmp = groups; tmp; tmp = tmp->next) {
+    PCROffsetGroup *group = (PCROffsetGroup *) tmp->data;
+    PCROffsetGroup *prev = NULL;
+    guint64 start = group->first_offset;
+    guint64 end = start + group->values[group->last_value].offset;
+    gboolean overlaps = FALSE;
+    GList *walk, *next;
+
+    for (walk = pcrtable->groups; walk; walk = next) {
+      PCROffsetGroup *cur = (PCROffsetGroup *) walk->data;
+      guint64 cur_start = cur->first_offset;
+      guint64 cur_end = cur_start + cur->values[cur->last_value].offset;
+
+      next = walk->next;
+      if (cur_end < start) {
+        prev = cur;
+        continue;
+      }
+      if (cur_start > end)
+        break;
+      if (cur_start >= start && cur_end <= end) {
+        pcrtable->groups = g_list_delete_link (pcrtable->groups, walk);
+        pcr_offset_group_free (cur);
+        continue;
+      }
+      overlaps = TRUE;
+      break;
+    }
+
+    if (overlaps) {
+      GST_DEBUG ("Group at offset %" G_GUINT64_FORMAT " overlaps with "
+          "existing observations, ignoring it", start);
+      pcr_offset_group_free (group);
+      continue;
+    }
+
+    GST_DEBUG ("Adding group PCR %" GST_TIME_FORMAT " (offset %"
+        G_GUINT64_FORMAT " pcr_offset %" GST_TIME_FORMAT ") with %u values",
+        GST_TIME_ARGS (PCRTIME_TO_GSTTIME (group->first_pcr)),
+        group->first_offset,
+        GST_TIME_ARGS (PCRTIME_TO_GSTTIME (group->pcr_offset)),
+        group->last_value + 1);
+    _insert_group_after (pcrtable, group, prev);
+  }
+  g_list_free (groups);
+
+  PACKETIZER_GROUP_UNLOCK (packetizer);
+}
+
+void
+mpegts_packetizer_free_pcr_groups (GList * groups)
+{
+  g_list_free_full (groups, (GDestroyNotify) pcr_offset_group_free);
+}
@@ -85,7 +85,8 @@ typedef struct
   guint8  section_number;
   guint8  last_section_number;
 
-  GSList *subtables;
+  /* MpegTSPacketizerStreamSubtable, keyed by SUBTABLE_KEY() */
+  GHashTable *subtables;
 
   /* Upstream offset of the data contained in the section */
   guint64 offset;
@@ -269,6 +270,10 @@ struct _MpegTSPacketizer2 {
   gsize map_size;
   gboolean need_sync;
 
+  /* Holds a copy of a packet that straddles two input buffers. Packets
+   * that lie within one buffer are read straight from its memory. */
+  guint8 bounce_buffer[MPEGTS_MAX_PACKETSIZE];
+
   /* Reference offset */
   guint64 refoffset;
 
@@ -325,6 +330,10 @@ typedef struct
   guint8   seen_section[32];
 } MpegTSPacketizerStreamSubtable;
 
+/* Key of a subtable in MpegTSPacketizerStream::subtables */
+#define SUBTABLE_KEY(table_id, subtable_extension) \
+  GUINT_TO_POINTER (((guint) (table_id) << 16) | (subtable_extension))
+
 #define MPEGTS_BIT_SET(field, offs)    ((field)[(offs) >> 3] |=  (1 << ((offs) & 0x7)))
 #define MPEGTS_BIT_UNSET(field, offs)  ((field)[(offs) >> 3] &= ~(1 << ((offs) & 0x7)))
 #define MPEGTS_BIT_IS_SET(field, offs) ((field)[(offs) >> 3] &   (1 << ((offs) & 0x7)))
@@ -378,6 +387,16 @@ mpegts_packetizer_set_reference_offset (MpegTSPacketizer2 * packetizer,
 G_GNUC_INTERNAL void
 mpegts_packetizer_set_pcr_discont_threshold (MpegTSPacketizer2 * packetizer,
 					GstClockTime threshold);
+
+/* Seek index support */
+G_GNUC_INTERNAL GList *
+mpegts_packetizer_dup_pcr_groups (MpegTSPacketizer2 * packetizer,
+				  guint16 pcr_pid);
+G_GNUC_INTERNAL void
+mpegts_packetizer_add_pcr_groups (MpegTSPacketizer2 * packetizer,
+				  guint16 pcr_pid, GList * groups);
+G_GNUC_INTERNAL void
+mpegts_packetizer_free_pcr_groups (GList * groups);
 G_END_DECLS
 
 #endif /* GST_MPEGTS_PACKETIZER_H */
@@ -35,6 +35,7 @@
 #include <string.h>
 
 #include <glib.h>
+#include <glib/gstdio.h>
 #include <gst/tag/tag.h>
 #include <gst/pbutils/pbutils.h>
 #include <gst/base/base.h>
@@ -74,6 +75,28 @@
 /* latency in nsecs */
 #define TS_LATENCY (700 * GST_MSECOND)
 
+/* Initial size of PES buffers when the PES packet length is unknown */
+#define PES_BUFFER_MIN_SIZE 8192
+/* PES buffer pools grow in multiples of this (must be a power of two) */
+#define PES_POOL_SIZE_GRANULARITY 4096
+/* Initial size of the PES buffer pools. Only unbounded video PES packets,
+ * which are often as large as a frame, are reconstructed in pool buffers.
+ * Pools double their size whenever a packet does not fit. */
+#define PES_POOL_INITIAL_SIZE (512 * 1024)
+
+#define DEFAULT_USE_BUFFER_POOL TRUE
+#define DEFAULT_USE_INDEX FALSE
+#define DEFAULT_INDEX_LOCATION NULL
+
+/* Suffix of the index file if no index-location is set */
+#define INDEX_SUFFIX ".tsidx"
+/* If the index has PCRs within that many bytes of the end of the file, the
+ * end of the file is not scanned (same amount mpegtsbase scans at once) */
+#define INDEX_END_MARGIN 56400
+/* Indexed keyframes further away than this from the seek position are not
+ * used, as the part of the file in between might never have been indexed */
+#define INDEX_MAX_KEYFRAME_DISTANCE (10 * GST_SECOND)
+
 GST_DEBUG_CATEGORY_STATIC (ts_demux_debug);
 #define GST_CAT_DEFAULT ts_demux_debug
 
@@ -145,14 +168,25 @@ struct _TSDemuxStream
   /* Whether this is a sparse stream (subtitles or metadata) */
   gboolean sparse;
 
+  /* Whether this is a video stream */
+  gboolean is_video;
+
   /* TRUE if we are waiting for a valid timestamp */
   gboolean pending_ts;
 
   /* Output data */
   PendingPacketState state;
 
-  /* Data being reconstructed (allocated) */
+  /* Data being reconstructed (mapped from ->data_buffer) */
   guint8 *data;
+  GstBuffer *data_buffer;
+  GstMapInfo data_map;
+
+  /* Pool unbounded video PES buffers are recycled from. Its buffers are
+   * ->pool_size bytes large, and the size doubles if a PES packet does not
+   * fit */
+  GstBufferPool *pool;
+  guint pool_size;
 
   /* Size of data being reconstructed (if known, else 0) */
   guint expected_size;
@@ -200,6 +234,12 @@ struct _TSDemuxStream
 
   GstTsDemuxKeyFrameScanFunction scan_function;
   TSDemuxH264ParsingInfos h264infos;
+
+  /* Offset of the TS packet starting the current PES packet, and whether
+   * that packet signalled a random access point (or the keyframe scan
+   * found one) */
+  guint64 pes_offset;
+  gboolean random_access;
 };
 
 #define VIDEO_CAPS \
@@ -273,6 +313,9 @@ enum
   PROP_0,
   PROP_PROGRAM_NUMBER,
   PROP_EMIT_STATS,
+  PROP_USE_BUFFER_POOL,
+  PROP_USE_INDEX,
+  PROP_INDEX_LOCATION,
   /* FILL ME */
 };
 
@@ -301,6 +344,9 @@ gst_ts_demux_stream_added (MpegTSBase * base, MpegTSBaseStream * stream,
 static void
 gst_ts_demux_stream_removed (MpegTSBase * base, MpegTSBaseStream * stream);
 static GstFlowReturn gst_ts_demux_do_seek (MpegTSBase * base, GstEvent * event);
+static gboolean gst_ts_demux_load_index (MpegTSBase * base,
+    guint64 upstream_size);
+static void gst_ts_demux_save_index (GstTSDemux * demux);
 static void gst_ts_demux_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
 static void gst_ts_demux_get_property (GObject * object, guint prop_id,
@@ -342,6 +388,16 @@ gst_ts_demux_dispose (GObject * object)
   GST_CALL_PARENT (G_OBJECT_CLASS, dispose, (object));
 }
 
+static void
+gst_ts_demux_finalize (GObject * object)
+{
+  GstTSDemux *demux = GST_TS_DEMUX_CAST (object);
+
+  g_free (demux->index_location);
+
+  GST_CALL_PARENT (G_OBJECT_CLASS, finalize, (object));
+}
+
 static void
 gst_ts_demux_class_init (GstTSDemuxClass * klass)
 {
@@ -353,6 +409,7 @@ gst_ts_demux_class_init (GstTSDemuxClass * klass)
   gobject_class->set_property = gst_ts_demux_set_property;
   gobject_class->get_property = gst_ts_demux_get_property;
   gobject_class->dispose = gst_ts_demux_dispose;
+  gobject_class->finalize = gst_ts_demux_finalize;
 
   g_object_class_install_property (gobject_class, PROP_PROGRAM_NUMBER,
       g_param_spec_int ("program-number", "Program number",
@@ -364,6 +421,40 @@ gst_ts_demux_class_init (GstTSDemuxClass * klass)
           "Emit messages for every pcr/opcr/pts/dts", FALSE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_USE_BUFFER_POOL,
+      g_param_spec_boolean ("use-buffer-pool", "Use buffer pool",
+          "Reconstruct unbounded video PES packets in buffers recycled from "
+          "a per-stream pool",
+          DEFAULT_USE_BUFFER_POOL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTSDemux:use-index:
+   *
+   * When reading a local file in pull mode, load a seek index of PCR and
+   * keyframe positions from a sidecar file, extend it while playing and
+   * save it again. The index is only used if the size and modification
+   * time of the file did not change since it was saved.
+   *
+   * Since: 1.12
+   */
+  g_object_class_install_property (gobject_class, PROP_USE_INDEX,
+      g_param_spec_boolean ("use-index", "Use index",
+          "Load, extend and save a seek index for local files in pull mode",
+          DEFAULT_USE_INDEX, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTSDemux:index-location:
+   *
+   * Location of the seek index file. If not set, the location of the file
+   * being read with a ".tsidx" suffix is used.
+   *
+   * Since: 1.12
+   */
+  g_object_class_install_property (gobject_class, PROP_INDEX_LOCATION,
+      g_param_spec_string ("index-location", "Index location",
+          "Location of the seek index file (NULL = next to the input file)",
+          DEFAULT_INDEX_LOCATION, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   element_class = GST_ELEMENT_CLASS (klass);
   gst_element_class_add_pad_template (element_class,
       gst_static_pad_template_get (&video_template));
@@ -392,6 +483,7 @@ gst_ts_demux_class_init (GstTSDemuxClass * klass)
   ts_class->stream_added = gst_ts_demux_stream_added;
   ts_class->stream_removed = gst_ts_demux_stream_removed;
   ts_class->seek = GST_DEBUG_FUNCPTR (gst_ts_demux_do_seek);
+  ts_class->load_index = GST_DEBUG_FUNCPTR (gst_ts_demux_load_index);
   ts_class->flush = GST_DEBUG_FUNCPTR (gst_ts_demux_flush);
   ts_class->drain = GST_DEBUG_FUNCPTR (gst_ts_demux_drain);
 }
@@ -423,6 +515,15 @@ gst_ts_demux_reset (MpegTSBase * base)
 
   demux->last_seek_offset = -1;
   demux->program_generation = 0;
+
+  if (demux->index) {
+    gst_ts_demux_save_index (demux);
+    mpegts_index_free (demux->index);
+    demux->index = NULL;
+  }
+  g_free (demux->index_file);
+  demux->index_file = NULL;
+  demux->index_size = 0;
 }
 
 static void
@@ -438,6 +539,9 @@ gst_ts_demux_init (GstTSDemux * demux)
   demux->flowcombiner = gst_flow_combiner_new ();
   demux->requested_program_number = -1;
   demux->program_number = -1;
+  demux->use_buffer_pool = DEFAULT_USE_BUFFER_POOL;
+  demux->use_index = DEFAULT_USE_INDEX;
+  demux->index_location = DEFAULT_INDEX_LOCATION;
   gst_ts_demux_reset (base);
 }
 
@@ -457,6 +561,20 @@ gst_ts_demux_set_property (GObject * object, guint prop_id,
     case PROP_EMIT_STATS:
       demux->emit_statistics = g_value_get_boolean (value);
       break;
+    case PROP_USE_BUFFER_POOL:
+      demux->use_buffer_pool = g_value_get_boolean (value);
+      break;
+    case PROP_USE_INDEX:
+      GST_OBJECT_LOCK (demux);
+      demux->use_index = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (demux);
+      break;
+    case PROP_INDEX_LOCATION:
+      GST_OBJECT_LOCK (demux);
+      g_free (demux->index_location);
+      demux->index_location = g_value_dup_string (value);
+      GST_OBJECT_UNLOCK (demux);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -475,6 +593,19 @@ gst_ts_demux_get_property (GObject * object, guint prop_id,
     case PROP_EMIT_STATS:
       g_value_set_boolean (value, demux->emit_statistics);
       break;
+    case PROP_USE_BUFFER_POOL:
+      g_value_set_boolean (value, demux->use_buffer_pool);
+      break;
+    case PROP_USE_INDEX:
+      GST_OBJECT_LOCK (demux);
+      g_value_set_boolean (value, demux->use_index);
+      GST_OBJECT_UNLOCK (demux);
+      break;
+    case PROP_INDEX_LOCATION:
+      GST_OBJECT_LOCK (demux);
+      g_value_set_string (value, demux->index_location);
+      GST_OBJECT_UNLOCK (demux);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
   }
@@ -604,6 +735,142 @@ gst_ts_demux_srcpad_query (GstPad * pad, GstObject * parent, GstQuery * query)
 
 }
 
+static void
+gst_ts_demux_stream_clear_data (TSDemuxStream * stream)
+{
+  if (stream->data_buffer) {
+    gst_buffer_unmap (stream->data_buffer, &stream->data_map);
+    gst_buffer_unref (stream->data_buffer);
+    stream->data_buffer = NULL;
+  }
+  stream->data = NULL;
+  stream->allocated_size = 0;
+}
+
+static void
+gst_ts_demux_stream_set_data_buffer (TSDemuxStream * stream,
+    GstBuffer * buffer)
+{
+  gst_ts_demux_stream_clear_data (stream);
+
+  gst_buffer_map (buffer, &stream->data_map, GST_MAP_READWRITE);
+  stream->data_buffer = buffer;
+  stream->data = stream->data_map.data;
+  stream->allocated_size = stream->data_map.size;
+}
+
+/* Replaces the data being reconstructed with @data (ownership is taken) */
+static void
+gst_ts_demux_stream_replace_data (TSDemuxStream * stream, guint8 * data,
+    gsize size)
+{
+  gst_ts_demux_stream_set_data_buffer (stream,
+      gst_buffer_new_wrapped (data, size));
+  stream->current_size = size;
+}
+
+/* Hands the reconstructed data over as a buffer of ->current_size bytes */
+static GstBuffer *
+gst_ts_demux_stream_take_data (TSDemuxStream * stream)
+{
+  GstBuffer *buffer = stream->data_buffer;
+
+  gst_buffer_unmap (buffer, &stream->data_map);
+  gst_buffer_resize (buffer, 0, stream->current_size);
+  stream->data_buffer = NULL;
+  stream->data = NULL;
+  stream->allocated_size = 0;
+
+  return buffer;
+}
+
+/* (Re)configures the pool of @stream for buffers of ->pool_size bytes.
+ * The existing pool is reused unless buffers of it are still in use
+ * downstream, in which case it is replaced; these buffers then get freed
+ * once they come back. */
+static gboolean
+gst_ts_demux_stream_configure_pool (TSDemuxStream * stream)
+{
+  GstStructure *config;
+
+  if (stream->pool) {
+    gst_buffer_pool_set_active (stream->pool, FALSE);
+    config = gst_buffer_pool_get_config (stream->pool);
+    gst_buffer_pool_config_set_params (config, NULL, stream->pool_size, 0, 0);
+    if (gst_buffer_pool_set_config (stream->pool, config)
+        && gst_buffer_pool_set_active (stream->pool, TRUE))
+      return TRUE;
+
+    GST_DEBUG ("pid 0x%04x: PES buffer pool busy, replacing it",
+        stream->stream.pid);
+    gst_object_unref (stream->pool);
+  }
+
+  stream->pool = gst_buffer_pool_new ();
+  config = gst_buffer_pool_get_config (stream->pool);
+  gst_buffer_pool_config_set_params (config, NULL, stream->pool_size, 0, 0);
+  if (gst_buffer_pool_set_config (stream->pool, config)
+      && gst_buffer_pool_set_active (stream->pool, TRUE))
+    return TRUE;
+
+  gst_object_unref (stream->pool);
+  stream->pool = NULL;
+  return FALSE;
+}
+
+static GstBuffer *
+gst_ts_demux_stream_acquire_buffer (GstTSDemux * demux,
+    TSDemuxStream * stream, gsize size)
+{
+  GstBuffer *buffer = NULL;
+
+  /* Bounded PES packets get a buffer of exactly their size, and only video
+   * streams have unbounded packets large enough to be worth recycling */
+  if (!demux->use_buffer_pool || stream->expected_size || !stream->is_video)
+    return gst_buffer_new_allocate (NULL, size, NULL);
+
+  if (G_UNLIKELY (stream->pool == NULL || size > stream->pool_size)) {
+    guint pool_size = stream->pool_size;
+
+    if (pool_size == 0)
+      pool_size = PES_POOL_INITIAL_SIZE;
+    while (pool_size < size)
+      pool_size *= 2;
+    stream->pool_size = GST_ROUND_UP_N (pool_size, PES_POOL_SIZE_GRANULARITY);
+
+    GST_DEBUG ("pid 0x%04x: PES buffer pool with %u byte buffers",
+        stream->stream.pid, stream->pool_size);
+
+    if (!gst_ts_demux_stream_configure_pool (stream)) {
+      GST_WARNING ("pid 0x%04x: failed to set up PES buffer pool",
+          stream->stream.pid);
+      stream->pool_size = 0;
+      return gst_buffer_new_allocate (NULL, size, NULL);
+    }
+  }
+
+  if (gst_buffer_pool_acquire_buffer (stream->pool, &buffer,
+          NULL) != GST_FLOW_OK)
+    return gst_buffer_new_allocate (NULL, size, NULL);
+
+  return buffer;
+}
+
+/* Makes ->data hold at least @size bytes, keeping the ->current_size bytes
+ * already reconstructed */
+static void
+gst_ts_demux_stream_alloc_data (GstTSDemux * demux, TSDemuxStream * stream,
+    gsize size)
+{
+  GstBuffer *buffer;
+
+  buffer = gst_ts_demux_stream_acquire_buffer (demux, stream, size);
+  if (stream->data) {
+    gst_buffer_fill (buffer, 0, stream->data, stream->current_size);
+  }
+  gst_ts_demux_stream_set_data_buffer (stream, buffer);
+}
+
 static void
 clear_simple_buffer (SimpleBuffer * sbuf)
 {
@@ -756,9 +1023,9 @@ scan_keyframe_h264 (TSDemuxStream * stream, const guint8 * data,
       clear_simple_buffer (&h264infos->framedata);
     }
 
-    g_free (stream->data);
-    stream->current_size = gst_byte_writer_get_size (h264infos->sps);
-    stream->data = gst_byte_writer_reset_and_get_data (h264infos->sps);
+    tmpsize = gst_byte_writer_get_size (h264infos->sps);
+    gst_ts_demux_stream_replace_data (stream,
+        gst_byte_writer_reset_and_get_data (h264infos->sps), tmpsize);
     gst_byte_writer_init (h264infos->sps);
     gst_byte_writer_init (h264infos->pps);
     gst_byte_writer_init (h264infos->sei);
@@ -806,6 +1073,149 @@ gst_ts_demux_adjust_seek_offset_for_keyframe (TSDemuxStream * stream,
   return TRUE;
 }
 
+static gboolean
+gst_ts_demux_load_index (MpegTSBase * base, guint64 upstream_size)
+{
+  GstTSDemux *demux = GST_TS_DEMUX_CAST (base);
+  MpegTSIndex *index;
+  GstQuery *query;
+  GStatBuf st;
+  gchar *uri = NULL, *filename = NULL, *location;
+  gboolean use_index, covers_end = FALSE;
+
+  GST_OBJECT_LOCK (demux);
+  use_index = demux->use_index;
+  location = g_strdup (demux->index_location);
+  GST_OBJECT_UNLOCK (demux);
+
+  if (!use_index || demux->index)
+    goto done;
+
+  /* The index can only be verified against a local file */
+  query = gst_query_new_uri ();
+  if (gst_pad_peer_query (base->sinkpad, query))
+    gst_query_parse_uri (query, &uri);
+  gst_query_unref (query);
+
+  if (uri)
+    filename = g_filename_from_uri (uri, NULL, NULL);
+  if (filename == NULL) {
+    GST_DEBUG_OBJECT (demux, "Upstream is not a local file, not using an "
+        "index");
+    goto done;
+  }
+
+  if (g_stat (filename, &st) != 0 || (guint64) st.st_size != upstream_size) {
+    GST_DEBUG_OBJECT (demux, "Could not check %s, not using an index",
+        filename);
+    goto done;
+  }
+
+  if (location == NULL)
+    location = g_strconcat (filename, INDEX_SUFFIX, NULL);
+
+  index = mpegts_index_load (location, st.st_size, st.st_mtime);
+  if (index && index->packet_size != base->packetsize) {
+    GST_WARNING_OBJECT (demux, "Index %s has a different packet size",
+        location);
+    mpegts_index_free (index);
+    index = NULL;
+  }
+
+  if (index) {
+    GList *tmp, *last = g_list_last (index->groups);
+
+    GST_INFO_OBJECT (demux, "Using index %s", location);
+    if (last) {
+      PCROffsetGroup *group = (PCROffsetGroup *) last->data;
+
+      covers_end = group->first_offset +
+          group->values[group->last_value].offset + INDEX_END_MARGIN >=
+          upstream_size;
+    }
+    demux->index_size = index->keyframes->len;
+    for (tmp = index->groups; tmp; tmp = tmp->next)
+      demux->index_size += ((PCROffsetGroup *) tmp->data)->last_value + 1;
+
+    /* The packetizer takes over the PCR observations, they are retrieved
+     * from it again when saving */
+    mpegts_packetizer_add_pcr_groups (base->packetizer, index->pcr_pid,
+        index->groups);
+    index->groups = NULL;
+  } else {
+    GST_INFO_OBJECT (demux, "Creating index %s", location);
+    index = mpegts_index_new (st.st_size, st.st_mtime);
+    index->packet_size = base->packetsize;
+  }
+
+  demux->index = index;
+  demux->index_file = location;
+  location = NULL;
+
+done:
+  g_free (location);
+  g_free (filename);
+  g_free (uri);
+
+  return covers_end;
+}
+
+static void
+gst_ts_demux_save_index (GstTSDemux * demux)
+{
+  MpegTSBase *base = (MpegTSBase *) demux;
+  MpegTSIndex *index = demux->index;
+  GList *groups, *tmp;
+  guint size;
+
+  if (index->pcr_pid == 0x1fff)
+    return;
+
+  groups = mpegts_packetizer_dup_pcr_groups (base->packetizer, index->pcr_pid);
+
+  /* Observations and keyframes are only ever added, so the total number
+   * of entries tells if anything was learned since the last save */
+  size = index->keyframes->len;
+  for (tmp = groups; tmp; tmp = tmp->next)
+    size += ((PCROffsetGroup *) tmp->data)->last_value + 1;
+
+  if (size == demux->index_size) {
+    GST_DEBUG_OBJECT (demux, "Index unchanged, not saving it");
+    mpegts_packetizer_free_pcr_groups (groups);
+    return;
+  }
+
+  index->groups = groups;
+  if (mpegts_index_save (index, demux->index_file))
+    demux->index_size = size;
+  mpegts_packetizer_free_pcr_groups (index->groups);
+  index->groups = NULL;
+}
+
+/* Called for PES packets starting with a random access point */
+static void
+gst_ts_demux_index_keyframe (GstTSDemux * demux, TSDemuxStream * stream)
+{
+  MpegTSBaseStream *bs = (MpegTSBaseStream *) stream;
+  MpegTSIndex *index = demux->index;
+
+  if (!GST_CLOCK_TIME_IS_VALID (stream->pts))
+    return;
+
+  /* Keyframes of the first video stream are indexed */
+  if (index->keyframe_pid == 0x1fff) {
+    if (stream->pad == NULL
+        || !g_str_has_prefix (GST_PAD_NAME (stream->pad), "video_"))
+      return;
+    GST_DEBUG_OBJECT (stream->pad, "Indexing keyframes of PID 0x%04x",
+        bs->pid);
+    index->keyframe_pid = bs->pid;
+  } else if (index->keyframe_pid != bs->pid)
+    return;
+
+  mpegts_index_add_keyframe (index, stream->pts, stream->pes_offset);
+}
+
 static GstFlowReturn
 gst_ts_demux_do_seek (MpegTSBase * base, GstEvent * event)
 {
@@ -841,9 +1251,26 @@ gst_ts_demux_do_seek (MpegTSBase * base, GstEvent * event)
   GST_DEBUG_OBJECT (demux, "configuring seek");
 
   if (start_type != GST_SEEK_TYPE_NONE) {
-    start_offset =
-        mpegts_packetizer_ts_to_offset (base->packetizer, MAX (0,
-            start - SEEK_TIMESTAMP_OFFSET), demux->program->pcr_pid);
+    const MpegTSIndexEntry *entry = NULL;
+
+    /* Start at the last indexed keyframe before the seek position. This
+     * avoids going back and forth to find it */
+    if (demux->index && start >= 0) {
+      entry = mpegts_index_find_keyframe (demux->index, start);
+      if (entry && start - entry->ts > INDEX_MAX_KEYFRAME_DISTANCE)
+        entry = NULL;
+    }
+
+    if (entry) {
+      GST_DEBUG_OBJECT (demux, "Using indexed keyframe %" GST_TIME_FORMAT
+          " at offset %" G_GUINT64_FORMAT, GST_TIME_ARGS (entry->ts),
+          entry->offset);
+      start_offset = entry->offset;
+    } else {
+      start_offset =
+          mpegts_packetizer_ts_to_offset (base->packetizer, MAX (0,
+              start - SEEK_TIMESTAMP_OFFSET), demux->program->pcr_pid);
+    }
 
     if (G_UNLIKELY (start_offset == -1)) {
       GST_WARNING ("Couldn't convert start position to an offset");
@@ -983,6 +1410,10 @@ push_event (MpegTSBase * base, GstEvent * event)
     }
   }
 
+  /* Save what was learned while playing, without waiting for the stop */
+  if (GST_EVENT_TYPE (event) == GST_EVENT_EOS && demux->index)
+    gst_ts_demux_save_index (demux);
+
   gst_event_unref (event);
 
   return TRUE;
@@ -1618,6 +2049,7 @@ done:
           GST_STREAM_FLAG_SPARSE);
     }
     stream->sparse = sparse;
+    stream->is_video = is_video;
     gst_stream_set_caps (bstream->stream_object, caps);
     if (!stream->taglist)
       stream->taglist = gst_tag_list_new_empty ();
@@ -1731,6 +2163,13 @@ gst_ts_demux_stream_removed (MpegTSBase * base, MpegTSBaseStream * bstream)
 
   gst_ts_demux_stream_flush (stream, GST_TS_DEMUX_CAST (base), TRUE);
 
+  if (stream->pool) {
+    gst_buffer_pool_set_active (stream->pool, FALSE);
+    gst_object_unref (stream->pool);
+    stream->pool = NULL;
+    stream->pool_size = 0;
+  }
+
   if (stream->taglist != NULL) {
     gst_tag_list_unref (stream->taglist);
     stream->taglist = NULL;
@@ -1762,11 +2201,9 @@ gst_ts_demux_stream_flush (TSDemuxStream * stream, GstTSDemux * tsdemux,
 {
   GST_DEBUG ("flushing stream %p", stream);
 
-  g_free (stream->data);
-  stream->data = NULL;
+  gst_ts_demux_stream_clear_data (stream);
   stream->state = PENDING_PACKET_EMPTY;
   stream->expected_size = 0;
-  stream->allocated_size = 0;
   stream->current_size = 0;
   stream->discont = TRUE;
   stream->pts = GST_CLOCK_TIME_NONE;
@@ -1873,6 +2310,9 @@ gst_ts_demux_program_started (MpegTSBase * base, MpegTSBaseProgram * program)
     demux->program_number = program->program_number;
     demux->program = program;
 
+    if (demux->index)
+      demux->index->pcr_pid = program->pcr_pid;
+
     /* Increment the program_generation counter */
     demux->program_generation = (demux->program_generation + 1) & 0xf;
 
@@ -2208,14 +2648,17 @@ gst_ts_demux_parse_pes_header (GstTSDemux * demux, TSDemuxStream * stream,
   data += header.header_size;
   length -= header.header_size;
 
-  /* Create the output buffer */
+  /* Create the output buffer. If the PES packet length is known, the payload
+   * goes straight into a buffer of exactly the packet size. Otherwise, video
+   * packets use a pool buffer, which is large enough for most frames
+   * already. */
+  g_assert (stream->data == NULL);
   if (stream->expected_size)
-    stream->allocated_size = MAX (stream->expected_size, length);
+    gst_ts_demux_stream_alloc_data (demux, stream,
+        MAX (stream->expected_size, length));
   else
-    stream->allocated_size = MAX (8192, length);
-
-  g_assert (stream->data == NULL);
-  stream->data = g_malloc (stream->allocated_size);
+    gst_ts_demux_stream_alloc_data (demux, stream,
+        MAX (PES_BUFFER_MIN_SIZE, length));
   memcpy (stream->data, data, length);
   stream->current_size = length;
 
@@ -2281,11 +2724,13 @@ gst_ts_demux_queue_data (GstTSDemux * demux, TSDemuxStream * stream,
     {
       GST_LOG ("BUFFER: appending data");
       if (G_UNLIKELY (stream->current_size + size > stream->allocated_size)) {
+        gsize new_size = stream->allocated_size;
+
         GST_LOG ("resizing buffer");
         do {
-          stream->allocated_size *= 2;
-        } while (stream->current_size + size > stream->allocated_size);
-        stream->data = g_realloc (stream->data, stream->allocated_size);
+          new_size *= 2;
+        } while (stream->current_size + size > new_size);
+        gst_ts_demux_stream_alloc_data (demux, stream, new_size);
       }
       memcpy (stream->data + stream->current_size, data, size);
       stream->current_size += size;
@@ -2294,10 +2739,8 @@ gst_ts_demux_queue_data (GstTSDemux * demux, TSDemuxStream * stream,
     case PENDING_PACKET_DISCONT:
     {
       GST_LOG ("DISCONT: not storing/pushing");
-      if (G_UNLIKELY (stream->data)) {
-        g_free (stream->data);
-        stream->data = NULL;
-      }
+      if (G_UNLIKELY (stream->data))
+        gst_ts_demux_stream_clear_data (stream);
       stream->continuity_counter = CONTINUITY_UNSET;
       break;
     }
@@ -2541,8 +2984,7 @@ parse_opus_access_unit (TSDemuxStream * stream)
     gst_buffer_list_add (buffer_list, buffer);
   } while (gst_byte_reader_get_remaining (&reader) > 0);
 
-  g_free (stream->data);
-  stream->data = NULL;
+  gst_ts_demux_stream_clear_data (stream);
   stream->current_size = 0;
 
   return buffer_list;
@@ -2550,8 +2992,7 @@ parse_opus_access_unit (TSDemuxStream * stream)
 error:
   {
     GST_ERROR ("Failed to parse Opus access unit");
-    g_free (stream->data);
-    stream->data = NULL;
+    gst_ts_demux_stream_clear_data (stream);
     stream->current_size = 0;
     gst_buffer_list_unref (buffer_list);
     return NULL;
@@ -2589,19 +3030,23 @@ gst_ts_demux_push_pending_data (GstTSDemux * demux, TSDemuxStream * stream,
 
   if (G_UNLIKELY (demux->program == NULL)) {
     GST_LOG_OBJECT (demux, "No program");
-    g_free (stream->data);
     goto beach;
   }
 
   if (stream->needs_keyframe) {
     MpegTSBase *base = (MpegTSBase *) demux;
+    gboolean keyframe;
 
-    if ((gst_ts_demux_adjust_seek_offset_for_keyframe (stream, stream->data,
-                stream->current_size)) || demux->last_seek_offset == 0) {
+    keyframe = gst_ts_demux_adjust_seek_offset_for_keyframe (stream,
+        stream->data, stream->current_size);
+    if (keyframe || demux->last_seek_offset == 0) {
       GST_DEBUG_OBJECT (stream->pad,
           "Got Keyframe, ready to go at %" GST_TIME_FORMAT,
           GST_TIME_ARGS (stream->pts));
 
+      if (keyframe && stream->scan_function)
+        stream->random_access = TRUE;
+
       if (bs->stream_type == GST_MPEGTS_STREAM_TYPE_PRIVATE_PES_PACKETS &&
           bs->registration_id == DRF_ID_OPUS) {
         buffer_list = parse_opus_access_unit (stream);
@@ -2616,23 +3061,33 @@ gst_ts_demux_push_pending_data (GstTSDemux * demux, TSDemuxStream * stream,
           buffer_list = NULL;
         }
       } else {
-        buffer = gst_buffer_new_wrapped (stream->data, stream->current_size);
+        buffer = gst_ts_demux_stream_take_data (stream);
       }
 
       stream->seeked_pts = stream->pts;
       stream->seeked_dts = stream->dts;
       stream->needs_keyframe = FALSE;
     } else {
-      base->seek_offset = demux->last_seek_offset - 200 * base->packetsize;
-      if (demux->last_seek_offset < 200 * base->packetsize)
+      const MpegTSIndexEntry *entry = NULL;
+
+      /* Go back to the previous indexed keyframe, or by a fixed amount
+       * if there is none */
+      if (demux->index && demux->index->keyframe_pid == bs->pid)
+        entry = mpegts_index_find_keyframe_before_offset (demux->index,
+            demux->last_seek_offset);
+
+      if (entry)
+        base->seek_offset = entry->offset;
+      else if (demux->last_seek_offset < 200 * base->packetsize)
         base->seek_offset = 0;
+      else
+        base->seek_offset = demux->last_seek_offset - 200 * base->packetsize;
       demux->last_seek_offset = base->seek_offset;
       mpegts_packetizer_flush (base->packetizer, FALSE);
       base->mode = BASE_MODE_SEEKING;
 
       stream->continuity_counter = CONTINUITY_UNSET;
       res = GST_FLOW_REWINDING;
-      g_free (stream->data);
       goto beach;
     }
   } else {
@@ -2650,7 +3105,7 @@ gst_ts_demux_push_pending_data (GstTSDemux * demux, TSDemuxStream * stream,
         buffer_list = NULL;
       }
     } else {
-      buffer = gst_buffer_new_wrapped (stream->data, stream->current_size);
+      buffer = gst_ts_demux_stream_take_data (stream);
     }
 
     if (G_UNLIKELY (stream->pending_ts && !check_pending_buffers (demux))) {
@@ -2680,6 +3135,9 @@ gst_ts_demux_push_pending_data (GstTSDemux * demux, TSDemuxStream * stream,
     }
   }
 
+  if (demux->index && stream->random_access)
+    gst_ts_demux_index_keyframe (demux, stream);
+
   if (G_UNLIKELY (stream->need_newsegment))
     calculate_and_push_newsegment (demux, stream, target_program);
 
@@ -2795,7 +3253,7 @@ beach:
   /* Reset everything */
   GST_LOG ("Resetting to EMPTY, returning %s", gst_flow_get_name (res));
   stream->state = PENDING_PACKET_EMPTY;
-  stream->data = NULL;
+  gst_ts_demux_stream_clear_data (stream);
   stream->expected_size = 0;
   stream->current_size = 0;
 
@@ -2813,10 +3271,15 @@ gst_ts_demux_handle_packet (GstTSDemux * demux, TSDemuxStream * stream,
       FLAGS_CONTINUITY_COUNTER (packet->scram_afc_cc), packet->payload);
 
   if (G_UNLIKELY (packet->payload_unit_start_indicator) &&
-      FLAGS_HAS_PAYLOAD (packet->scram_afc_cc))
+      FLAGS_HAS_PAYLOAD (packet->scram_afc_cc)) {
     /* Flush previous data */
     res = gst_ts_demux_push_pending_data (demux, stream, NULL);
 
+    stream->pes_offset = packet->offset;
+    stream->random_access =
+        (packet->afc_flags & MPEGTS_AFC_RANDOM_ACCES_FLAGS) != 0;
+  }
+
   if (packet->payload && (res == GST_FLOW_OK || res == GST_FLOW_NOT_LINKED)
       && stream->pad) {
     gst_ts_demux_queue_data (demux, stream, packet);
@@ -2906,6 +3369,7 @@ gst_ts_demux_plugin_init (GstPlugin * plugin)
   GST_DEBUG_CATEGORY_INIT (ts_demux_debug, "tsdemux", 0,
       "MPEG transport stream demuxer");
   init_pes_parser ();
+  init_mpegts_index ();
 
   return gst_element_register (plugin, "tsdemux",
       GST_RANK_PRIMARY, GST_TYPE_TS_DEMUX);
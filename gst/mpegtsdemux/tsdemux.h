@@ -32,6 +32,7 @@
 #include <gst/base/gstflowcombiner.h>
 #include "mpegtsbase.h"
 #include "mpegtspacketizer.h"
+#include "mpegtsindex.h"
 
 G_BEGIN_DECLS
 #define GST_TYPE_TS_DEMUX \
@@ -62,6 +63,9 @@ struct _GstTSDemux
   gint requested_program_number; /* Required program number (ignore:-1) */
   guint program_number;
   gboolean emit_statistics;
+  gboolean use_buffer_pool;	/* Recycle unbounded video PES buffers */
+  gboolean use_index;		/* Load/save a seek index for local files */
+  gchar *index_location;	/* Location of the index (NULL: next to file) */
 
   /*< private >*/
   gint program_generation; /* Incremented each time we switch program 0..15 */
@@ -87,6 +91,12 @@ struct _GstTSDemux
 
   /* Used when seeking for a keyframe to go backward in the stream */
   guint64 last_seek_offset;
+
+  /* Seek index (pull mode only), the file it is saved to, and its number
+   * of entries when it was loaded or last saved */
+  MpegTSIndex *index;
+  gchar *index_file;
+  guint index_size;
 };
 
 struct _GstTSDemuxClass
@@ -110,11 +110,15 @@ enum
   PROP_PAT_INTERVAL,
   PROP_PMT_INTERVAL,
   PROP_ALIGNMENT,
-  PROP_SI_INTERVAL
+  PROP_SI_INTERVAL,
+  PROP_BITRATE
 };
 
 #define MPEGTSMUX_DEFAULT_ALIGNMENT    -1
+/* Packets per output buffer if there is no alignment (about 64 kB) */
+#define MPEGTSMUX_UNALIGNED_SLAB_PACKETS 348
 #define MPEGTSMUX_DEFAULT_M2TS         FALSE
+#define MPEGTSMUX_DEFAULT_BITRATE      0
 
 static GstStaticPadTemplate mpegtsmux_sink_factory =
     GST_STATIC_PAD_TEMPLATE ("sink_%d",
@@ -173,6 +177,7 @@ static void release_buffer_cb (guint8 * data, void *user_data);
 static GstFlowReturn mpegtsmux_collect_packet (MpegTsMux * mux,
     GstBuffer * buf);
 static GstFlowReturn mpegtsmux_push_packets (MpegTsMux * mux, gboolean force);
+static void mpegtsmux_clear_output (MpegTsMux * mux);
 static gboolean new_packet_m2ts (MpegTsMux * mux, GstBuffer * buf,
     gint64 new_pcr);
 
@@ -298,6 +303,14 @@ mpegtsmux_class_init (MpegTsMuxClass * klass)
           "Set the interval (in ticks of the 90kHz clock) for writing out the Service"
           "Information tables", 1, G_MAXUINT, TSMUX_DEFAULT_SI_INTERVAL,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_BITRATE,
+      g_param_spec_uint64 ("bitrate", "Bitrate (in bits per second)",
+          "Produce a constant bitrate multiplex of this many bits per second "
+          "by inserting null packets, with PCR and PAT/PMT/SI repetition "
+          "derived from the output position (0 = variable bitrate)",
+          0, G_MAXUINT64, MPEGTSMUX_DEFAULT_BITRATE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -322,7 +335,6 @@ mpegtsmux_init (MpegTsMux * mux)
       GST_DEBUG_FUNCPTR (mpegtsmux_clip_inc_running_time), mux);
 
   mux->adapter = gst_adapter_new ();
-  mux->out_adapter = gst_adapter_new ();
 
   /* properties */
   mux->m2ts_mode = MPEGTSMUX_DEFAULT_M2TS;
@@ -331,6 +343,7 @@ mpegtsmux_init (MpegTsMux * mux)
   mux->si_interval = TSMUX_DEFAULT_SI_INTERVAL;
   mux->prog_map = NULL;
   mux->alignment = MPEGTSMUX_DEFAULT_ALIGNMENT;
+  mux->bitrate = MPEGTSMUX_DEFAULT_BITRATE;
 
   /* initial state */
   mpegtsmux_reset (mux, TRUE);
@@ -391,8 +404,7 @@ mpegtsmux_reset (MpegTsMux * mux, gboolean alloc)
 #endif
   if (mux->adapter)
     gst_adapter_clear (mux->adapter);
-  if (mux->out_adapter)
-    gst_adapter_clear (mux->out_adapter);
+  mpegtsmux_clear_output (mux);
 
   if (mux->tsmux) {
     tsmux_free (mux->tsmux);
@@ -408,7 +420,6 @@ mpegtsmux_reset (MpegTsMux * mux, gboolean alloc)
     gst_buffer_unref (buf);
 
   gst_event_replace (&mux->force_key_unit_event, NULL);
-  gst_buffer_replace (&mux->out_buffer, NULL);
 
   if (mux->collect) {
     GST_COLLECT_PADS_STREAM_LOCK (mux->collect);
@@ -421,6 +432,7 @@ mpegtsmux_reset (MpegTsMux * mux, gboolean alloc)
     mux->tsmux = tsmux_new ();
     tsmux_set_write_func (mux->tsmux, new_packet_cb, mux);
     tsmux_set_alloc_func (mux->tsmux, alloc_packet_cb, mux);
+    tsmux_set_bitrate (mux->tsmux, mux->bitrate);
   }
 }
 
@@ -435,10 +447,6 @@ mpegtsmux_dispose (GObject * object)
     g_object_unref (mux->adapter);
     mux->adapter = NULL;
   }
-  if (mux->out_adapter) {
-    g_object_unref (mux->out_adapter);
-    mux->out_adapter = NULL;
-  }
   if (mux->collect) {
     gst_object_unref (mux->collect);
     mux->collect = NULL;
@@ -501,6 +509,11 @@ gst_mpegtsmux_set_property (GObject * object, guint prop_id,
       mux->si_interval = g_value_get_uint (value);
       tsmux_set_si_interval (mux->tsmux, mux->si_interval);
       break;
+    case PROP_BITRATE:
+      mux->bitrate = g_value_get_uint64 (value);
+      if (mux->tsmux)
+        tsmux_set_bitrate (mux->tsmux, mux->bitrate);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -532,6 +545,9 @@ gst_mpegtsmux_get_property (GObject * object, guint prop_id,
     case PROP_SI_INTERVAL:
       g_value_set_uint (value, mux->si_interval);
       break;
+    case PROP_BITRATE:
+      g_value_set_uint64 (value, mux->bitrate);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1456,7 +1472,8 @@ new_packet_common_init (MpegTsMux * mux, GstBuffer * buf, guint8 * data,
         hbuf = gst_buffer_new_and_alloc (len);
         gst_buffer_fill (hbuf, 0, data, len);
       } else {
-        hbuf = gst_buffer_copy (buf);
+        /* don't share memory with the recycled packet buffer */
+        hbuf = gst_buffer_copy_deep (buf);
       }
       GST_LOG_OBJECT (mux,
           "Collecting packet with pid 0x%04x into streamheaders", pid);
@@ -1483,81 +1500,160 @@ new_packet_common_init (MpegTsMux * mux, GstBuffer * buf, guint8 * data,
   }
 }
 
-static GstFlowReturn
-mpegtsmux_push_packets (MpegTsMux * mux, gboolean force)
+/* Returns the number of packets per output buffer, 0 if unaligned */
+static gint
+mpegtsmux_get_alignment (MpegTsMux * mux, gint * packet_size)
 {
-  GstBufferList *buffer_list;
   gint align = mux->alignment;
-  gint av, packet_size;
 
   if (mux->m2ts_mode) {
-    packet_size = M2TS_PACKET_LENGTH;
+    *packet_size = M2TS_PACKET_LENGTH;
     if (align < 0)
       align = 32;
   } else {
-    packet_size = NORMAL_TS_PACKET_LENGTH;
+    *packet_size = NORMAL_TS_PACKET_LENGTH;
     if (align < 0)
       align = 0;
   }
 
-  av = gst_adapter_available (mux->out_adapter);
-  GST_LOG_OBJECT (mux, "align %d, av %d", align, av);
+  return align;
+}
 
-  if (av == 0)
-    return GST_FLOW_OK;
+static GstBufferPool *
+mpegtsmux_new_pool (MpegTsMux * mux, guint size)
+{
+  GstBufferPool *pool;
+  GstStructure *config;
+
+  pool = gst_buffer_pool_new ();
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, NULL, size, 0, 0);
+  if (!gst_buffer_pool_set_config (pool, config) ||
+      !gst_buffer_pool_set_active (pool, TRUE)) {
+    GST_WARNING_OBJECT (mux, "failed to set up pool of %u byte buffers", size);
+    gst_object_unref (pool);
+    return NULL;
+  }
 
-  /* no alignment, just push all available data */
-  if (align == 0) {
-    buffer_list = gst_adapter_take_buffer_list (mux->out_adapter, av);
-    return gst_pad_push_list (mux->srcpad, buffer_list);
+  return pool;
+}
+
+static void
+mpegtsmux_free_pool (GstBufferPool ** pool)
+{
+  if (*pool) {
+    /* buffers still used downstream are freed once they are released */
+    gst_buffer_pool_set_active (*pool, FALSE);
+    gst_object_unref (*pool);
+    *pool = NULL;
   }
+}
 
-  align *= packet_size;
+static GstBuffer *
+mpegtsmux_acquire_buffer (GstBufferPool * pool, guint size)
+{
+  GstBuffer *buf = NULL;
 
-  if (!force && align > av)
-    return GST_FLOW_OK;
+  if (pool == NULL
+      || gst_buffer_pool_acquire_buffer (pool, &buf, NULL) != GST_FLOW_OK)
+    buf = gst_buffer_new_and_alloc (size);
 
-  buffer_list = gst_buffer_list_new_sized ((av / align) + 1);
+  return buf;
+}
 
-  GST_LOG_OBJECT (mux, "aligning to %d bytes", align);
-  while (align <= av) {
-    GstBuffer *buf;
-    GstClockTime pts;
+/* Queues the current output slab for pushing */
+static void
+mpegtsmux_finish_out_buffer (MpegTsMux * mux)
+{
+  if (mux->out_buffer == NULL)
+    return;
+
+  gst_buffer_unmap (mux->out_buffer, &mux->out_map);
+  gst_buffer_resize (mux->out_buffer, 0, mux->out_offset);
 
-    pts = gst_adapter_prev_pts (mux->out_adapter, NULL);
-    buf = gst_adapter_take_buffer (mux->out_adapter, align);
+  if (mux->out_list == NULL)
+    mux->out_list = gst_buffer_list_new ();
+  gst_buffer_list_add (mux->out_list, mux->out_buffer);
 
-    GST_BUFFER_PTS (buf) = pts;
+  mux->out_buffer = NULL;
+  mux->out_offset = 0;
+}
 
-    gst_buffer_list_add (buffer_list, buf);
-    av -= align;
+/* Starts a new output slab, which takes timestamp and flags from @packet,
+ * the first packet written into it */
+static void
+mpegtsmux_start_out_buffer (MpegTsMux * mux, GstBuffer * packet)
+{
+  gint packet_size, align;
+  guint slab_size;
+
+  align = mpegtsmux_get_alignment (mux, &packet_size);
+  if (align == 0)
+    align = MPEGTSMUX_UNALIGNED_SLAB_PACKETS;
+  slab_size = align * packet_size;
+
+  if (mux->out_pool == NULL || mux->out_pool_size != slab_size) {
+    mpegtsmux_free_pool (&mux->out_pool);
+    mux->out_pool = mpegtsmux_new_pool (mux, slab_size);
+    mux->out_pool_size = slab_size;
   }
 
-  if (av > 0 && force) {
-    GstBuffer *buf;
-    GstClockTime pts;
-    guint8 *data;
-    guint32 header;
-    gint dummy;
-    GstMapInfo map;
+  mux->out_buffer = mpegtsmux_acquire_buffer (mux->out_pool, slab_size);
+  mux->out_offset = 0;
+  gst_buffer_map (mux->out_buffer, &mux->out_map, GST_MAP_WRITE);
+
+  GST_BUFFER_PTS (mux->out_buffer) = GST_BUFFER_PTS (packet);
+  GST_BUFFER_FLAGS (mux->out_buffer) |= GST_BUFFER_FLAGS (packet) &
+      (GST_BUFFER_FLAG_HEADER | GST_BUFFER_FLAG_DELTA_UNIT);
+}
+
+static void
+mpegtsmux_clear_output (MpegTsMux * mux)
+{
+  if (mux->out_buffer) {
+    gst_buffer_unmap (mux->out_buffer, &mux->out_map);
+    gst_buffer_unref (mux->out_buffer);
+    mux->out_buffer = NULL;
+  }
+  mux->out_offset = 0;
+
+  if (mux->out_list) {
+    gst_buffer_list_unref (mux->out_list);
+    mux->out_list = NULL;
+  }
 
-    GST_LOG_OBJECT (mux, "handling %d leftover bytes", av);
+  mpegtsmux_free_pool (&mux->out_pool);
+  mux->out_pool_size = 0;
+  mpegtsmux_free_pool (&mux->packet_pool);
+}
 
-    pts = gst_adapter_prev_pts (mux->out_adapter, NULL);
-    buf = gst_buffer_new_and_alloc (align);
+static GstFlowReturn
+mpegtsmux_push_packets (MpegTsMux * mux, gboolean force)
+{
+  GstBufferList *buffer_list;
+  gint align, packet_size;
 
-    GST_BUFFER_PTS (buf) = pts;
+  align = mpegtsmux_get_alignment (mux, &packet_size);
 
-    gst_buffer_map (buf, &map, GST_MAP_READ);
-    data = map.data;
+  GST_LOG_OBJECT (mux, "align %d, pending %" G_GSIZE_FORMAT " bytes", align,
+      mux->out_offset);
 
-    gst_adapter_copy (mux->out_adapter, data, 0, av);
-    gst_adapter_clear (mux->out_adapter);
+  /* no alignment, just push all available data */
+  if (align == 0)
+    mpegtsmux_finish_out_buffer (mux);
 
-    data += av;
+  if (mux->out_buffer && force) {
+    guint8 *data;
+    guint32 header;
+    gint dummy;
+
+    GST_LOG_OBJECT (mux, "handling %" G_GSIZE_FORMAT " leftover bytes",
+        mux->out_offset);
+
+    data = mux->out_map.data + mux->out_offset;
     header = GST_READ_UINT32_BE (data - packet_size);
 
-    dummy = (map.size - av) / packet_size;
+    dummy = (mux->out_map.size - mux->out_offset) / packet_size;
     GST_LOG_OBJECT (mux, "adding %d null packets", dummy);
 
     for (; dummy > 0; dummy--) {
@@ -1579,21 +1675,51 @@ mpegtsmux_push_packets (MpegTsMux * mux, gboolean force)
       /* payload */
       memset (data + offset + 4, 0, NORMAL_TS_PACKET_LENGTH - 4);
       data += packet_size;
+      mux->out_offset += packet_size;
     }
 
-    gst_buffer_unmap (buf, &map);
-    gst_buffer_list_add (buffer_list, buf);
+    mpegtsmux_finish_out_buffer (mux);
   }
 
+  if (mux->out_list == NULL)
+    return GST_FLOW_OK;
+
+  buffer_list = mux->out_list;
+  mux->out_list = NULL;
+
+  GST_LOG_OBJECT (mux, "pushing %u buffers",
+      gst_buffer_list_length (buffer_list));
+
   return gst_pad_push_list (mux->srcpad, buffer_list);
 }
 
 static GstFlowReturn
 mpegtsmux_collect_packet (MpegTsMux * mux, GstBuffer * buf)
 {
-  GST_LOG_OBJECT (mux, "collecting packet size %" G_GSIZE_FORMAT,
-      gst_buffer_get_size (buf));
-  gst_adapter_push (mux->out_adapter, buf);
+  gsize size = gst_buffer_get_size (buf);
+  gint packet_size;
+
+  GST_LOG_OBJECT (mux, "collecting packet size %" G_GSIZE_FORMAT, size);
+
+  /* Without alignment, key units start a new output buffer so that their
+   * flags still reach downstream */
+  if (mux->out_buffer
+      && !GST_BUFFER_FLAG_IS_SET (buf, GST_BUFFER_FLAG_DELTA_UNIT)
+      && mpegtsmux_get_alignment (mux, &packet_size) == 0)
+    mpegtsmux_finish_out_buffer (mux);
+
+  if (mux->out_buffer && mux->out_offset + size > mux->out_map.size)
+    mpegtsmux_finish_out_buffer (mux);
+
+  if (mux->out_buffer == NULL)
+    mpegtsmux_start_out_buffer (mux, buf);
+
+  gst_buffer_extract (buf, 0, mux->out_map.data + mux->out_offset, size);
+  mux->out_offset += size;
+  gst_buffer_unref (buf);
+
+  if (mux->out_offset == mux->out_map.size)
+    mpegtsmux_finish_out_buffer (mux);
 
   return GST_FLOW_OK;
 }
@@ -1762,7 +1888,12 @@ alloc_packet_cb (GstBuffer ** _buf, void *user_data)
   if (mux->m2ts_mode == TRUE)
     offset = 4;
 
-  buf = gst_buffer_new_and_alloc (NORMAL_TS_PACKET_LENGTH + offset);
+  /* Packets are copied into the output slabs, so recycle them */
+  if (G_UNLIKELY (mux->packet_pool == NULL))
+    mux->packet_pool = mpegtsmux_new_pool (mux, M2TS_PACKET_LENGTH);
+
+  buf = mpegtsmux_acquire_buffer (mux->packet_pool,
+      NORMAL_TS_PACKET_LENGTH + offset);
   gst_buffer_set_size (buf, NORMAL_TS_PACKET_LENGTH);
 
   *_buf = buf;
@@ -139,6 +139,7 @@ struct MpegTsMux {
   guint pmt_interval;
   gint alignment;
   guint si_interval;
+  guint64 bitrate;
 
   /* state */
   gboolean first;
@@ -160,9 +161,16 @@ struct MpegTsMux {
   gint64 pcr_rate_den;
   GstAdapter *adapter;
 
-  /* output buffer aggregation */
-  GstAdapter *out_adapter;
+  /* output buffer aggregation: packets are copied into ->out_buffer, a
+   * slab from ->out_pool, and full slabs are queued in ->out_list until
+   * they get pushed. Packets themselves are recycled via ->packet_pool */
+  GstBufferPool *packet_pool;
+  GstBufferPool *out_pool;
+  guint out_pool_size;
   GstBuffer *out_buffer;
+  GstMapInfo out_map;
+  gsize out_offset;
+  GstBufferList *out_list;
 
 #if 0
   /* SPN/PTS index handling */
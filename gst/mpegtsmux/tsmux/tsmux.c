@@ -109,6 +109,12 @@
 /* Times per second to write PCR */
 #define TSMUX_DEFAULT_PCR_FREQ (25)
 
+/* Offset of the byte carrying the last bit of program_clock_reference_base
+ * within a TS packet, which is the byte the PCR value refers to */
+#define TSMUX_PCR_BYTE_OFFSET 10
+
+#define TSMUX_NULL_PACKET_PID 0x1FFF
+
 /* Base for all written PCR and DTS/PTS,
  * so we have some slack to go backwards */
 #define CLOCK_BASE (TSMUX_CLOCK_FREQ * 10 * 360)
@@ -150,6 +156,8 @@ tsmux_new (void)
   mux->last_si_ts = G_MININT64;
   mux->si_interval = TSMUX_DEFAULT_SI_INTERVAL;
 
+  mux->first_pcr_ts = G_MININT64;
+
   mux->si_sections = g_hash_table_new_full (g_direct_hash, g_direct_equal,
       NULL, (GDestroyNotify) tsmux_section_free);
 
@@ -212,6 +220,40 @@ tsmux_set_pat_interval (TsMux * mux, guint freq)
   mux->pat_interval = freq;
 }
 
+/**
+ * tsmux_set_bitrate:
+ * @mux: a #TsMux
+ * @bitrate: the output bitrate in bits per second, or 0
+ *
+ * Set the bitrate of the output for constant bitrate muxing. Null packets
+ * are inserted whenever the streams don't fill up @bitrate, and PCR values
+ * as well as PAT, PMT and SI repetition are derived from the output position.
+ * A @bitrate of 0 produces a variable bitrate stream.
+ */
+void
+tsmux_set_bitrate (TsMux * mux, guint64 bitrate)
+{
+  g_return_if_fail (mux != NULL);
+
+  mux->bitrate = bitrate;
+}
+
+/**
+ * tsmux_get_bitrate:
+ * @mux: a #TsMux
+ *
+ * Get the configured output bitrate. See also tsmux_set_bitrate().
+ *
+ * Returns: the configured bitrate in bits per second
+ */
+guint64
+tsmux_get_bitrate (TsMux * mux)
+{
+  g_return_val_if_fail (mux != NULL, 0);
+
+  return mux->bitrate;
+}
+
 /**
  * tsmux_get_pat_interval:
  * @mux: a #TsMux
@@ -585,6 +627,9 @@ tsmux_get_buffer (TsMux * mux, GstBuffer ** buf)
 static gboolean
 tsmux_packet_out (TsMux * mux, GstBuffer * buf, gint64 pcr)
 {
+  if (mux->bitrate)
+    mux->n_bytes += TSMUX_PACKET_LENGTH;
+
   if (G_UNLIKELY (mux->write_func == NULL)) {
     if (buf)
       gst_buffer_unref (buf);
@@ -976,12 +1021,221 @@ tsmux_write_si (TsMux * mux)
 
 }
 
+/* Writes the PAT, PMT and SI tables which are due at @cur_ts */
+static gboolean
+tsmux_write_tables (TsMux * mux, gint64 cur_ts)
+{
+  gboolean write_pat;
+  gboolean write_si;
+  GList *cur;
+
+  /* check if we need to rewrite pat */
+  if (mux->last_pat_ts == G_MININT64 || mux->pat_changed)
+    write_pat = TRUE;
+  else if (cur_ts >= mux->last_pat_ts + mux->pat_interval)
+    write_pat = TRUE;
+  else
+    write_pat = FALSE;
+
+  if (write_pat) {
+    mux->last_pat_ts = cur_ts;
+    if (!tsmux_write_pat (mux))
+      return FALSE;
+  }
+
+  /* check if we need to rewrite sit */
+  if (mux->last_si_ts == G_MININT64 || mux->si_changed)
+    write_si = TRUE;
+  else if (cur_ts >= mux->last_si_ts + mux->si_interval)
+    write_si = TRUE;
+  else
+    write_si = FALSE;
+
+  if (write_si) {
+    mux->last_si_ts = cur_ts;
+    if (!tsmux_write_si (mux))
+      return FALSE;
+  }
+
+  /* check if we need to rewrite any of the current pmts */
+  for (cur = mux->programs; cur; cur = cur->next) {
+    TsMuxProgram *program = (TsMuxProgram *) cur->data;
+    gboolean write_pmt;
+
+    if (program->last_pmt_ts == G_MININT64 || program->pmt_changed)
+      write_pmt = TRUE;
+    else if (cur_ts >= program->last_pmt_ts + program->pmt_interval)
+      write_pmt = TRUE;
+    else
+      write_pmt = FALSE;
+
+    if (write_pmt) {
+      program->last_pmt_ts = cur_ts;
+      if (!tsmux_write_pmt (mux, program))
+        return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/* Constant bitrate helpers: the output position in bytes is the clock, so
+ * a byte is output at first_pcr_ts + n_bytes * 8 / bitrate */
+
+/* PCR at which byte @offset of the next packet is output */
+static gint64
+tsmux_get_cbr_pcr (TsMux * mux, guint offset)
+{
+  return (mux->first_pcr_ts + CLOCK_BASE) *
+      (TSMUX_SYS_CLOCK_FREQ / TSMUX_CLOCK_FREQ) +
+      gst_util_uint64_scale ((mux->n_bytes + offset) * 8,
+      TSMUX_SYS_CLOCK_FREQ, mux->bitrate);
+}
+
+/* The stream time which is due when the next packet is output, in the same
+ * MPEG PTS clock time as the stream timestamps */
+static gint64
+tsmux_get_cbr_ts (TsMux * mux)
+{
+  return mux->first_pcr_ts + TSMUX_PCR_OFFSET +
+      gst_util_uint64_scale (mux->n_bytes * 8, TSMUX_CLOCK_FREQ,
+      mux->bitrate);
+}
+
+static gboolean
+tsmux_write_null_packet (TsMux * mux)
+{
+  GstBuffer *buf = NULL;
+  GstMapInfo map;
+  guint8 *tmp;
+
+  if (!tsmux_get_buffer (mux, &buf))
+    return FALSE;
+
+  gst_buffer_map (buf, &map, GST_MAP_WRITE);
+  map.data[0] = TSMUX_SYNC_BYTE;
+  tmp = map.data + 1;
+  tsmux_put16 (&tmp, TSMUX_NULL_PACKET_PID);
+  /* payload only, continuity counter is undefined for null packets */
+  map.data[3] = 0x10;
+  memset (map.data + TSMUX_HEADER_LENGTH, 0xff, TSMUX_PAYLOAD_LENGTH);
+  gst_buffer_unmap (buf, &map);
+
+  return tsmux_packet_out (mux, buf, -1);
+}
+
+/* Writes an adaptation field only packet carrying a PCR for every program
+ * whose PCR is due. Such packets don't advance the continuity counter. */
+static gboolean
+tsmux_write_pcr_packets (TsMux * mux)
+{
+  GList *cur;
+
+  for (cur = mux->programs; cur; cur = cur->next) {
+    TsMuxProgram *program = (TsMuxProgram *) cur->data;
+    TsMuxStream *stream = program->pcr_stream;
+    TsMuxPacketInfo pi;
+    GstBuffer *buf = NULL;
+    GstMapInfo map;
+    guint payload_len, payload_offs;
+    gint64 cur_pcr;
+
+    if (stream == NULL)
+      continue;
+
+    cur_pcr = tsmux_get_cbr_pcr (mux, TSMUX_PCR_BYTE_OFFSET);
+    if (stream->last_pcr != -1 &&
+        cur_pcr - stream->last_pcr <=
+        (TSMUX_SYS_CLOCK_FREQ / TSMUX_DEFAULT_PCR_FREQ))
+      continue;
+
+    pi.pid = stream->pi.pid;
+    pi.flags = TSMUX_PACKET_FLAG_ADAPTATION | TSMUX_PACKET_FLAG_WRITE_PCR;
+    pi.packet_start_unit_indicator = FALSE;
+    /* repeat the continuity counter of the last packet with payload */
+    pi.packet_count = stream->pi.packet_count - 1;
+    pi.stream_avail = 0;
+    pi.pcr = cur_pcr;
+    pi.private_data_len = 0;
+
+    if (!tsmux_get_buffer (mux, &buf))
+      return FALSE;
+
+    gst_buffer_map (buf, &map, GST_MAP_WRITE);
+    if (!tsmux_write_ts_header (map.data, &pi, &payload_len, &payload_offs)) {
+      gst_buffer_unmap (buf, &map);
+      gst_buffer_unref (buf);
+      return FALSE;
+    }
+    gst_buffer_unmap (buf, &map);
+
+    stream->last_pcr = cur_pcr;
+    if (!tsmux_packet_out (mux, buf, cur_pcr))
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/* In constant bitrate mode, output null packets until the output position
+ * caught up with the time @stream's next packet is due. PCR, PAT, PMT and
+ * SI packets are inserted in between as they become due. */
+static gboolean
+tsmux_pad_stream (TsMux * mux, TsMuxStream * stream)
+{
+  gint64 ts = tsmux_stream_get_dts (stream);
+  gint64 target_pcr;
+  guint n_null = 0;
+
+  if (ts == G_MININT64)
+    return TRUE;
+
+  if (G_UNLIKELY (mux->first_pcr_ts == G_MININT64)) {
+    mux->first_pcr_ts = ts - TSMUX_PCR_OFFSET;
+    TS_DEBUG ("First output byte at %" G_GINT64_FORMAT, mux->first_pcr_ts);
+  }
+
+  /* the same PCR as a variable bitrate mux would assign to this packet */
+  target_pcr = (ts + CLOCK_BASE - TSMUX_PCR_OFFSET) *
+      (TSMUX_SYS_CLOCK_FREQ / TSMUX_CLOCK_FREQ);
+
+  while (tsmux_get_cbr_pcr (mux, 0) < target_pcr) {
+    if (!tsmux_write_tables (mux, tsmux_get_cbr_ts (mux)))
+      return FALSE;
+    if (!tsmux_write_pcr_packets (mux))
+      return FALSE;
+    if (tsmux_get_cbr_pcr (mux, 0) >= target_pcr)
+      break;
+    if (!tsmux_write_null_packet (mux))
+      return FALSE;
+    n_null++;
+  }
+
+  if (n_null)
+    TS_DEBUG ("Wrote %u null packets", n_null);
+
+  /* Once the output falls behind by the full PCR offset, packets arrive
+   * after their decoding time */
+  if (tsmux_get_cbr_pcr (mux, 0) - target_pcr >
+      TSMUX_PCR_OFFSET * (TSMUX_SYS_CLOCK_FREQ / TSMUX_CLOCK_FREQ)) {
+    if (!mux->cbr_overflow)
+      GST_WARNING ("Streams exceed the configured bitrate of %"
+          G_GUINT64_FORMAT " bits per second", mux->bitrate);
+    mux->cbr_overflow = TRUE;
+  } else {
+    mux->cbr_overflow = FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
  * tsmux_write_stream_packet:
  * @mux: a #TsMux
  * @stream: a #TsMuxStream
  *
- * Write a packet of @stream.
+ * Write a packet of @stream. In constant bitrate mode, null packets are
+ * written first if the output is ahead of @stream.
  *
  * Returns: TRUE if the packet could be written.
  */
@@ -998,20 +1252,27 @@ tsmux_write_stream_packet (TsMux * mux, TsMuxStream * stream)
   g_return_val_if_fail (mux != NULL, FALSE);
   g_return_val_if_fail (stream != NULL, FALSE);
 
+  if (mux->bitrate && !tsmux_pad_stream (mux, stream))
+    return FALSE;
+
   if (tsmux_stream_is_pcr (stream)) {
     gint64 cur_pts = tsmux_stream_get_pts (stream);
-    gboolean write_pat;
-    gboolean write_si;
-    GList *cur;
+    gboolean cbr = mux->bitrate && mux->first_pcr_ts != G_MININT64;
+
+    if (!tsmux_write_tables (mux, cbr ? tsmux_get_cbr_ts (mux) : cur_pts))
+      return FALSE;
 
     cur_pcr = 0;
     if (cur_pts != G_MININT64) {
       TS_DEBUG ("TS for PCR stream is %" G_GINT64_FORMAT, cur_pts);
     }
 
-    /* FIXME: The current PCR needs more careful calculation than just
-     * writing a fixed offset */
-    if (cur_pts != G_MININT64) {
+    if (cbr) {
+      /* The PCR is exactly the time the packet is output at */
+      cur_pcr = tsmux_get_cbr_pcr (mux, TSMUX_PCR_BYTE_OFFSET);
+    } else if (cur_pts != G_MININT64) {
+      /* FIXME: The current PCR needs more careful calculation than just
+       * writing a fixed offset */
       /* CLOCK_BASE >= TSMUX_PCR_OFFSET */
       cur_pts += CLOCK_BASE;
       cur_pcr = (cur_pts - TSMUX_PCR_OFFSET) *
@@ -1030,53 +1291,6 @@ tsmux_write_stream_packet (TsMux * mux, TsMuxStream * stream)
     } else {
       cur_pcr = -1;
     }
-
-    /* check if we need to rewrite pat */
-    if (mux->last_pat_ts == G_MININT64 || mux->pat_changed)
-      write_pat = TRUE;
-    else if (cur_pts >= mux->last_pat_ts + mux->pat_interval)
-      write_pat = TRUE;
-    else
-      write_pat = FALSE;
-
-    if (write_pat) {
-      mux->last_pat_ts = cur_pts;
-      if (!tsmux_write_pat (mux))
-        return FALSE;
-    }
-
-    /* check if we need to rewrite sit */
-    if (mux->last_si_ts == G_MININT64 || mux->si_changed)
-      write_si = TRUE;
-    else if (cur_pts >= mux->last_si_ts + mux->si_interval)
-      write_si = TRUE;
-    else
-      write_si = FALSE;
-
-    if (write_si) {
-      mux->last_si_ts = cur_pts;
-      if (!tsmux_write_si (mux))
-        return FALSE;
-    }
-
-    /* check if we need to rewrite any of the current pmts */
-    for (cur = mux->programs; cur; cur = cur->next) {
-      TsMuxProgram *program = (TsMuxProgram *) cur->data;
-      gboolean write_pmt;
-
-      if (program->last_pmt_ts == G_MININT64 || program->pmt_changed)
-        write_pmt = TRUE;
-      else if (cur_pts >= program->last_pmt_ts + program->pmt_interval)
-        write_pmt = TRUE;
-      else
-        write_pmt = FALSE;
-
-      if (write_pmt) {
-        program->last_pmt_ts = cur_pts;
-        if (!tsmux_write_pmt (mux, program))
-          return FALSE;
-      }
-    }
   }
 
   pi->packet_start_unit_indicator = tsmux_stream_at_pes_start (stream);
@@ -169,6 +169,17 @@ struct TsMux {
   /* last time SIT written in MPEG PTS clock time */
   gint64   last_si_ts;
 
+  /* output bitrate in bits per second for constant bitrate muxing,
+   * or 0 for variable bitrate */
+  guint64  bitrate;
+  /* number of bytes written so far (constant bitrate only) */
+  guint64  n_bytes;
+  /* MPEG PTS clock time at which the first byte is output, which
+   * anchors all PCR values (constant bitrate only) */
+  gint64   first_pcr_ts;
+  /* TRUE while the streams need more than the configured bitrate */
+  gboolean cbr_overflow;
+
   /* callback to write finished packet */
   TsMuxWriteFunc write_func;
   void *write_func_data;
@@ -190,6 +201,8 @@ void 		tsmux_set_alloc_func 		(TsMux *mux, TsMuxAllocFunc func, void *user_data)
 void 		tsmux_set_pat_interval          (TsMux *mux, guint interval);
 guint 		tsmux_get_pat_interval          (TsMux *mux);
 guint16		tsmux_get_new_pid 		(TsMux *mux);
+void 		tsmux_set_bitrate 		(TsMux *mux, guint64 bitrate);
+guint64 	tsmux_get_bitrate 		(TsMux *mux);
 
 /* pid/program management */
 TsMuxProgram *	tsmux_program_new 		(TsMux *mux, gint prog_id);
@@ -710,8 +710,10 @@ tsmux_stream_add_data (TsMuxStream * stream, guint8 * data, guint len,
   packet->pts = pts;
   packet->dts = dts;
 
-  if (stream->bytes_avail == 0)
+  if (stream->bytes_avail == 0) {
     stream->last_pts = pts;
+    stream->last_dts = dts;
+  }
 
   stream->bytes_avail += len;
   stream->buffers = g_list_append (stream->buffers, packet);
@@ -1015,3 +1017,24 @@ tsmux_stream_get_pts (TsMuxStream * stream)
 
   return stream->last_pts;
 }
+
+/**
+ * tsmux_stream_get_dts:
+ * @stream: a #TsMuxStream
+ *
+ * Return the DTS of the last buffer that has had bytes written and
+ * which _had_ a DTS or PTS in @stream. The PTS is used if there is no DTS.
+ *
+ * Returns: the DTS of the last buffer in @stream, or G_MININT64 if no
+ * buffer with a DTS or PTS was written yet.
+ */
+gint64
+tsmux_stream_get_dts (TsMuxStream * stream)
+{
+  g_return_val_if_fail (stream != NULL, GST_CLOCK_STIME_NONE);
+
+  if (GST_CLOCK_STIME_IS_VALID (stream->last_dts))
+    return stream->last_dts;
+
+  return stream->last_pts;
+}
@@ -178,6 +178,8 @@ gst_raw_audio_parse_update_channel_reordering_flag (GstRawAudioParseConfig *
     config);
 static void gst_raw_audio_parse_update_config_bpf (GstRawAudioParseConfig *
     config);
+static void gst_raw_audio_parse_update_reorder_func (GstRawAudioParseConfig *
+    config);
 static gboolean gst_raw_audio_parse_caps_to_config (GstRawAudioParse *
     raw_audio_parse, GstCaps * caps, GstRawAudioParseConfig * config);
 static gboolean gst_raw_audio_parse_config_to_caps (GstRawAudioParse *
@@ -706,6 +708,135 @@ gst_raw_audio_parse_get_alignment (GstRawBaseParse * raw_base_parse,
   return width;
 }
 
+/* Channel reordering kernels. The sample width is a compile time constant in
+ * each of them, so the memcpy() calls turn into single (unaligned) loads and
+ * stores, and the stereo variants, which only swap the two channels, can be
+ * vectorized by the compiler. Reordering happens while copying the samples
+ * out of the input buffer, so the data is touched only once.
+ *
+ * The 5.1 and 7.1 layouts are the common ones that need reordering (for
+ * example, when the channels are in Vorbis or AAC order). Their kernels
+ * invert the reorder map once per buffer, and then assemble each output
+ * frame with a fully unrolled sequence of loads from fixed offsets in the
+ * input frame. The output is written sequentially, and no inner loop over
+ * the channels is left. */
+
+#define REORDER_SAMPLE(width, c) \
+  memcpy (dest + (c) * (width), src + src_offsets[c], (width))
+
+#define DEFINE_REORDER_FUNCS(width) \
+static void \
+gst_raw_audio_parse_reorder_##width (guint8 * dest, guint8 const *src, \
+    gsize num_frames, guint num_channels, gint const *reorder_map) \
+{ \
+  gsize i; \
+  guint c; \
+  \
+  for (i = 0; i < num_frames; ++i) { \
+    for (c = 0; c < num_channels; ++c) \
+      memcpy (dest + reorder_map[c] * (width), src + c * (width), (width)); \
+    src += num_channels * (width); \
+    dest += num_channels * (width); \
+  } \
+} \
+\
+static void \
+gst_raw_audio_parse_reorder_stereo_##width (guint8 * dest, \
+    guint8 const *src, gsize num_frames, G_GNUC_UNUSED guint num_channels, \
+    G_GNUC_UNUSED gint const *reorder_map) \
+{ \
+  gsize i; \
+  \
+  for (i = 0; i < num_frames; ++i) { \
+    memcpy (dest, src + (width), (width)); \
+    memcpy (dest + (width), src, (width)); \
+    src += 2 * (width); \
+    dest += 2 * (width); \
+  } \
+} \
+\
+static void \
+gst_raw_audio_parse_reorder_5_1_##width (guint8 * dest, \
+    guint8 const *src, gsize num_frames, G_GNUC_UNUSED guint num_channels, \
+    gint const *reorder_map) \
+{ \
+  guint src_offsets[6]; \
+  gsize i; \
+  guint c; \
+  \
+  for (c = 0; c < 6; ++c) \
+    src_offsets[reorder_map[c]] = c * (width); \
+  \
+  for (i = 0; i < num_frames; ++i) { \
+    REORDER_SAMPLE (width, 0); \
+    REORDER_SAMPLE (width, 1); \
+    REORDER_SAMPLE (width, 2); \
+    REORDER_SAMPLE (width, 3); \
+    REORDER_SAMPLE (width, 4); \
+    REORDER_SAMPLE (width, 5); \
+    src += 6 * (width); \
+    dest += 6 * (width); \
+  } \
+} \
+\
+static void \
+gst_raw_audio_parse_reorder_7_1_##width (guint8 * dest, \
+    guint8 const *src, gsize num_frames, G_GNUC_UNUSED guint num_channels, \
+    gint const *reorder_map) \
+{ \
+  guint src_offsets[8]; \
+  gsize i; \
+  guint c; \
+  \
+  for (c = 0; c < 8; ++c) \
+    src_offsets[reorder_map[c]] = c * (width); \
+  \
+  for (i = 0; i < num_frames; ++i) { \
+    REORDER_SAMPLE (width, 0); \
+    REORDER_SAMPLE (width, 1); \
+    REORDER_SAMPLE (width, 2); \
+    REORDER_SAMPLE (width, 3); \
+    REORDER_SAMPLE (width, 4); \
+    REORDER_SAMPLE (width, 5); \
+    REORDER_SAMPLE (width, 6); \
+    REORDER_SAMPLE (width, 7); \
+    src += 8 * (width); \
+    dest += 8 * (width); \
+  } \
+}
+
+DEFINE_REORDER_FUNCS (1);
+DEFINE_REORDER_FUNCS (2);
+DEFINE_REORDER_FUNCS (3);
+DEFINE_REORDER_FUNCS (4);
+DEFINE_REORDER_FUNCS (8);
+
+#undef DEFINE_REORDER_FUNCS
+#undef REORDER_SAMPLE
+
+#define REORDER_FUNCS(width) \
+  {width, gst_raw_audio_parse_reorder_##width, \
+      gst_raw_audio_parse_reorder_stereo_##width, \
+      gst_raw_audio_parse_reorder_5_1_##width, \
+      gst_raw_audio_parse_reorder_7_1_##width}
+
+static const struct
+{
+  guint width;
+  GstRawAudioParseReorderFunc generic_func;
+  GstRawAudioParseReorderFunc stereo_func;
+  GstRawAudioParseReorderFunc surround_5_1_func;
+  GstRawAudioParseReorderFunc surround_7_1_func;
+} reorder_funcs[] = {
+  REORDER_FUNCS (1),
+  REORDER_FUNCS (2),
+  REORDER_FUNCS (3),
+  REORDER_FUNCS (4),
+  REORDER_FUNCS (8)
+};
+
+#undef REORDER_FUNCS
+
 static gboolean
 gst_raw_audio_parse_process (GstRawBaseParse * raw_base_parse,
     GstRawBaseParseConfig config, GstBuffer * in_data, gsize total_num_in_bytes,
@@ -727,15 +858,39 @@ gst_raw_audio_parse_process (GstRawBaseParse * raw_base_parse,
         " bytes from the input buffer with reordering", num_valid_in_bytes,
         total_num_in_bytes);
 
-    outbuf =
-        gst_buffer_copy_region (in_data,
-        GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS |
-        GST_BUFFER_COPY_META | GST_BUFFER_COPY_MEMORY, 0, num_valid_in_bytes);
-
-    gst_audio_buffer_reorder_channels (outbuf,
-        config_ptr->pcm_format,
-        config_ptr->num_channels,
-        config_ptr->channel_positions, config_ptr->reordered_channel_positions);
+    if (config_ptr->reorder_func != NULL && config_ptr->interleaved) {
+      GstMapInfo in_map, out_map;
+      GstAllocationParams params = { 0, 0, 0, 0, };
+
+      /* Allocate the output buffer with the alignment the base class
+       * expects, otherwise it would be copied once more */
+      params.align =
+          gst_raw_audio_parse_get_alignment (raw_base_parse, config) - 1;
+      outbuf = gst_buffer_new_allocate (NULL, num_valid_in_bytes, &params);
+      gst_buffer_copy_into (outbuf, in_data,
+          GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS |
+          GST_BUFFER_COPY_META, 0, num_valid_in_bytes);
+
+      gst_buffer_map (in_data, &in_map, GST_MAP_READ);
+      gst_buffer_map (outbuf, &out_map, GST_MAP_WRITE);
+      config_ptr->reorder_func (out_map.data, in_map.data,
+          num_valid_in_bytes / config_ptr->bpf, config_ptr->num_channels,
+          config_ptr->reorder_map);
+      gst_buffer_unmap (outbuf, &out_map);
+      gst_buffer_unmap (in_data, &in_map);
+    } else {
+      outbuf =
+          gst_buffer_copy_region (in_data,
+          GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS |
+          GST_BUFFER_COPY_META | GST_BUFFER_COPY_MEMORY, 0,
+          num_valid_in_bytes);
+
+      gst_audio_buffer_reorder_channels (outbuf,
+          config_ptr->pcm_format,
+          config_ptr->num_channels,
+          config_ptr->channel_positions,
+          config_ptr->reordered_channel_positions);
+    }
 
     *processed_data = outbuf;
   } else {
@@ -834,6 +989,7 @@ gst_raw_audio_parse_init_config (GstRawAudioParseConfig * config)
   config->num_channels = DEFAULT_NUM_CHANNELS;
   config->interleaved = DEFAULT_INTERLEAVED;
   config->needs_channel_reordering = FALSE;
+  config->reorder_func = NULL;
 
   gst_raw_audio_parse_set_config_channels (config, config->num_channels, 0,
       TRUE);
@@ -889,9 +1045,14 @@ gst_raw_audio_parse_update_channel_reordering_flag (GstRawAudioParseConfig *
     config->needs_channel_reordering = TRUE;
     memcpy (config->reordered_channel_positions, config->channel_positions,
         sizeof (GstAudioChannelPosition) * config->num_channels);
-    return
-        gst_audio_channel_positions_to_valid_order
-        (config->reordered_channel_positions, config->num_channels);
+    if (!gst_audio_channel_positions_to_valid_order
+        (config->reordered_channel_positions, config->num_channels))
+      return FALSE;
+
+    /* Precompute the reorder map for the reordering kernels */
+    return gst_audio_get_channel_reorder_map (config->num_channels,
+        config->channel_positions, config->reordered_channel_positions,
+        config->reorder_map);
   }
 }
 
@@ -921,6 +1082,44 @@ gst_raw_audio_parse_update_config_bpf (GstRawAudioParseConfig * config)
     default:
       g_assert_not_reached ();
   }
+
+  gst_raw_audio_parse_update_reorder_func (config);
+}
+
+
+static void
+gst_raw_audio_parse_update_reorder_func (GstRawAudioParseConfig * config)
+{
+  guint i, width;
+
+  config->reorder_func = NULL;
+
+  if (config->bpf == 0 || config->num_channels == 0)
+    return;
+
+  /* A-law and mu-law samples are 1 byte wide, so the sample width can
+   * be derived from the bpf value for all formats */
+  width = config->bpf / config->num_channels;
+
+  for (i = 0; i < G_N_ELEMENTS (reorder_funcs); ++i) {
+    if (reorder_funcs[i].width == width) {
+      switch (config->num_channels) {
+        case 2:
+          config->reorder_func = reorder_funcs[i].stereo_func;
+          break;
+        case 6:
+          config->reorder_func = reorder_funcs[i].surround_5_1_func;
+          break;
+        case 8:
+          config->reorder_func = reorder_funcs[i].surround_7_1_func;
+          break;
+        default:
+          config->reorder_func = reorder_funcs[i].generic_func;
+          break;
+      }
+      break;
+    }
+  }
 }
 
 
@@ -1025,6 +1224,8 @@ gst_raw_audio_parse_caps_to_config (GstRawAudioParse * raw_audio_parse,
     goto done;
   }
 
+  gst_raw_audio_parse_update_reorder_func (config);
+
   ret = TRUE;
 
 done:
@@ -46,6 +46,13 @@ typedef struct _GstRawAudioParseConfig GstRawAudioParseConfig;
 typedef struct _GstRawAudioParse GstRawAudioParse;
 typedef struct _GstRawAudioParseClass GstRawAudioParseClass;
 
+/* Copies num_frames interleaved frames from src to dest, writing the sample
+ * of input channel c to output channel reorder_map[c]. src and dest must not
+ * overlap. */
+typedef void (*GstRawAudioParseReorderFunc) (guint8 * dest,
+    guint8 const *src, gsize num_frames, guint num_channels,
+    gint const *reorder_map);
+
 
 enum _GstRawAudioParseFormat
 {
@@ -92,6 +99,16 @@ struct _GstRawAudioParseConfig
   /* TRUE if channel reordering is necessary, FALSE otherwise. See above
    * for details. */
   gboolean needs_channel_reordering;
+
+  /* Maps input channel indices to output channel indices. Only valid if
+   * needs_channel_reordering is TRUE. */
+  gint reorder_map[64];
+
+  /* Reordering kernel that is specialized for the sample width and channel
+   * count of this configuration. It is picked whenever the bpf value is
+   * updated. NULL if no specialized kernel exists; the generic
+   * gst_audio_buffer_reorder_channels() function is used then. */
+  GstRawAudioParseReorderFunc reorder_func;
 };
 
 
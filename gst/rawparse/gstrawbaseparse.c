@@ -100,6 +100,25 @@
  *       timestamps will incorrectly include the overhead bytes.
  *     </para></listitem>
  * </listitem>
+ *
+ * The zero-copy property enables a mode in which output buffers are slices
+ * of the upstream memory whenever possible. Each input block is then split
+ * into output buffers at frame boundaries without copying the frame data.
+ * Copies only happen if the data does not meet the alignment returned by
+ * the @get_alignment vfunc, which in this mode must be the minimum the data
+ * format strictly needs. Subclasses check the zero_copy field of the
+ * #GstRawBaseParse instance to find out if the mode is enabled.
+ *
+ * If the use-mmap property is enabled, and upstream operates in pull mode and
+ * is a local file (as reported by an URI query), then the whole file is
+ * memory-mapped. The pulls done by #GstBaseParse are then answered by a pad
+ * probe with read-only slices of the mapping instead of being forwarded to
+ * upstream, so the data is never read into separate memory. Since frames are
+ * located at byte offsets that are computed out of the frame size, the mapped
+ * data starts at exact frame boundaries, and seeking is reduced to the offset
+ * arithmetic that is done in the convert vfunc. If the device, inode, size or
+ * modification time of the file change, the mapping is dropped, and the pulls
+ * go to upstream again.
  */
 
 #ifdef HAVE_CONFIG_H
@@ -107,6 +126,7 @@
 #endif
 
 #include <string.h>
+#include <glib/gstdio.h>
 #include "gstrawbaseparse.h"
 
 
@@ -117,11 +137,15 @@ GST_DEBUG_CATEGORY_STATIC (raw_base_parse_debug);
 enum
 {
   PROP_0,
-  PROP_USE_SINK_CAPS
+  PROP_USE_SINK_CAPS,
+  PROP_ZERO_COPY,
+  PROP_USE_MMAP
 };
 
 
 #define DEFAULT_USE_SINK_CAPS  FALSE
+#define DEFAULT_ZERO_COPY      FALSE
+#define DEFAULT_USE_MMAP       FALSE
 #define INITIAL_PARSER_CONFIG \
   ((DEFAULT_USE_SINK_CAPS) ? GST_RAW_BASE_PARSE_CONFIG_SINKCAPS : \
    GST_RAW_BASE_PARSE_CONFIG_PROPERTIES)
@@ -151,6 +175,12 @@ static gboolean gst_raw_base_parse_is_using_sink_caps (GstRawBaseParse *
     raw_base_parse);
 static gboolean gst_raw_base_parse_is_gstformat_supported (GstRawBaseParse *
     raw_base_parse, GstFormat format);
+static void gst_raw_base_parse_setup_mmap (GstRawBaseParse * raw_base_parse);
+static void gst_raw_base_parse_clear_mmap (GstRawBaseParse * raw_base_parse);
+static gboolean gst_raw_base_parse_is_mapped_file_unchanged (GstRawBaseParse *
+    raw_base_parse);
+static GstPadProbeReturn gst_raw_base_parse_mmap_pull_probe (GstPad * pad,
+    GstPadProbeInfo * info, gpointer user_data);
 
 
 
@@ -194,6 +224,34 @@ gst_raw_base_parse_class_init (GstRawBaseParseClass * klass)
           "Use the sink caps for defining the output format",
           DEFAULT_USE_SINK_CAPS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)
       );
+  /**
+   * GstRawBaseParse::zero-copy:
+   *
+   * Output slices of the input memory instead of copying frames.
+   * Frame data is only copied if its alignment is insufficient for
+   * the data format.
+   */
+  g_object_class_install_property (object_class,
+      PROP_ZERO_COPY,
+      g_param_spec_boolean ("zero-copy",
+          "Zero copy",
+          "Share the input memory with output buffers instead of copying frames",
+          DEFAULT_ZERO_COPY, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)
+      );
+  /**
+   * GstRawBaseParse::use-mmap:
+   *
+   * Memory-map the upstream file if upstream is a local file that operates
+   * in pull mode, and output read-only slices of the mapping. The file must
+   * not be truncated while it is mapped.
+   */
+  g_object_class_install_property (object_class,
+      PROP_USE_MMAP,
+      g_param_spec_boolean ("use-mmap",
+          "Use mmap",
+          "Memory-map local files in pull mode and output slices of the mapping",
+          DEFAULT_USE_MMAP, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)
+      );
 }
 
 
@@ -201,6 +259,12 @@ static void
 gst_raw_base_parse_init (GstRawBaseParse * raw_base_parse)
 {
   raw_base_parse->src_caps_set = FALSE;
+  raw_base_parse->zero_copy = DEFAULT_ZERO_COPY;
+  raw_base_parse->use_mmap = DEFAULT_USE_MMAP;
+  raw_base_parse->mapped_file = NULL;
+  raw_base_parse->mapped_filename = NULL;
+  raw_base_parse->mmap_checked = FALSE;
+  raw_base_parse->mmap_probe_id = 0;
   g_mutex_init (&(raw_base_parse->config_mutex));
 }
 
@@ -210,6 +274,7 @@ gst_raw_base_parse_finalize (GObject * object)
 {
   GstRawBaseParse *raw_base_parse = GST_RAW_BASE_PARSE (object);
 
+  gst_raw_base_parse_clear_mmap (raw_base_parse);
   g_mutex_clear (&(raw_base_parse->config_mutex));
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
@@ -285,6 +350,18 @@ gst_raw_base_parse_set_property (GObject * object, guint prop_id,
       break;
     }
 
+    case PROP_ZERO_COPY:
+      GST_RAW_BASE_PARSE_CONFIG_MUTEX_LOCK (object);
+      raw_base_parse->zero_copy = g_value_get_boolean (value);
+      GST_RAW_BASE_PARSE_CONFIG_MUTEX_UNLOCK (object);
+      break;
+
+    case PROP_USE_MMAP:
+      GST_RAW_BASE_PARSE_CONFIG_MUTEX_LOCK (object);
+      raw_base_parse->use_mmap = g_value_get_boolean (value);
+      GST_RAW_BASE_PARSE_CONFIG_MUTEX_UNLOCK (object);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -306,6 +383,18 @@ gst_raw_base_parse_get_property (GObject * object, guint prop_id,
       GST_RAW_BASE_PARSE_CONFIG_MUTEX_UNLOCK (object);
       break;
 
+    case PROP_ZERO_COPY:
+      GST_RAW_BASE_PARSE_CONFIG_MUTEX_LOCK (object);
+      g_value_set_boolean (value, raw_base_parse->zero_copy);
+      GST_RAW_BASE_PARSE_CONFIG_MUTEX_UNLOCK (object);
+      break;
+
+    case PROP_USE_MMAP:
+      GST_RAW_BASE_PARSE_CONFIG_MUTEX_LOCK (object);
+      g_value_set_boolean (value, raw_base_parse->use_mmap);
+      GST_RAW_BASE_PARSE_CONFIG_MUTEX_UNLOCK (object);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -319,6 +408,7 @@ gst_raw_base_parse_start (GstBaseParse * parse)
   GstBaseParse *base_parse = GST_BASE_PARSE (parse);
   GstRawBaseParse *raw_base_parse = GST_RAW_BASE_PARSE (parse);
   GstRawBaseParseClass *klass = GST_RAW_BASE_PARSE_GET_CLASS (parse);
+  gboolean use_mmap;
 
   g_assert (klass->set_current_config);
 
@@ -333,8 +423,19 @@ gst_raw_base_parse_start (GstBaseParse * parse)
     gst_base_parse_set_min_frame_size (base_parse, frame_size);
   }
 
+  use_mmap = raw_base_parse->use_mmap;
+
   GST_RAW_BASE_PARSE_CONFIG_MUTEX_UNLOCK (raw_base_parse);
 
+  /* The probe only sees pulls; in push mode, it is never called. It is
+   * called before GstBaseParse pulls data from upstream, and can answer
+   * the pull with a slice of the mapping instead. */
+  if (use_mmap)
+    raw_base_parse->mmap_probe_id =
+        gst_pad_add_probe (GST_BASE_PARSE_SINK_PAD (raw_base_parse),
+        GST_PAD_PROBE_TYPE_PULL | GST_PAD_PROBE_TYPE_BLOCK,
+        gst_raw_base_parse_mmap_pull_probe, raw_base_parse, NULL);
+
   return TRUE;
 }
 
@@ -344,8 +445,15 @@ gst_raw_base_parse_stop (GstBaseParse * parse)
 {
   GstRawBaseParse *raw_base_parse = GST_RAW_BASE_PARSE (parse);
 
+  if (raw_base_parse->mmap_probe_id != 0) {
+    gst_pad_remove_probe (GST_BASE_PARSE_SINK_PAD (raw_base_parse),
+        raw_base_parse->mmap_probe_id);
+    raw_base_parse->mmap_probe_id = 0;
+  }
+
   GST_RAW_BASE_PARSE_CONFIG_MUTEX_LOCK (raw_base_parse);
   raw_base_parse->src_caps_set = FALSE;
+  gst_raw_base_parse_clear_mmap (raw_base_parse);
   GST_RAW_BASE_PARSE_CONFIG_MUTEX_UNLOCK (raw_base_parse);
 
   return TRUE;
@@ -430,42 +538,61 @@ done:
   return ret;
 }
 
-static GstBuffer *
-gst_raw_base_parse_align_buffer (GstRawBaseParse * raw_base_parse,
-    gsize alignment, GstBuffer * buffer, gsize out_size)
+static gboolean
+gst_raw_base_parse_is_buffer_aligned (GstBuffer * buffer, gsize alignment)
 {
+  GstMemory *mem;
   GstMapInfo map;
+  gboolean aligned;
 
-  gst_buffer_map (buffer, &map, GST_MAP_READ);
+  /* Mapping a buffer that consists of multiple memories merges them, which
+   * means that all of its data is copied. Downstream would have to do the
+   * same when mapping the buffer, so treat such buffers as unaligned; this
+   * way, the data is copied only once, into an aligned buffer. */
+  if (gst_buffer_n_memory (buffer) != 1)
+    return FALSE;
 
-  if (map.size < sizeof (guintptr)) {
-    gst_buffer_unmap (buffer, &map);
-    return NULL;
-  }
+  /* Only map the single memory block itself. This never copies. */
+  mem = gst_buffer_peek_memory (buffer, 0);
+  if (!gst_memory_map (mem, &map, GST_MAP_READ))
+    return FALSE;
 
-  if (((guintptr) map.data) & (alignment - 1)) {
-    GstBuffer *new_buffer;
-    GstAllocationParams params = { 0, alignment - 1, 0, 0, };
+  aligned = (((guintptr) map.data) & (alignment - 1)) == 0;
 
-    new_buffer = gst_buffer_new_allocate (NULL, out_size, &params);
+  gst_memory_unmap (mem, &map);
 
-    /* Copy data "by hand", so ensure alignment is kept: */
-    gst_buffer_fill (new_buffer, 0, map.data, out_size);
+  return aligned;
+}
 
-    gst_buffer_copy_into (new_buffer, buffer, GST_BUFFER_COPY_METADATA, 0,
-        out_size);
-    GST_DEBUG_OBJECT (raw_base_parse,
-        "We want output aligned on %" G_GSIZE_FORMAT ", reallocated",
-        alignment);
+static GstBuffer *
+gst_raw_base_parse_align_buffer (GstRawBaseParse * raw_base_parse,
+    gsize alignment, GstBuffer * buffer, gsize out_size)
+{
+  GstBuffer *new_buffer;
+  GstMapInfo map;
+  GstAllocationParams params = { 0, alignment - 1, 0, 0, };
+
+  if (gst_buffer_get_size (buffer) < sizeof (guintptr))
+    return NULL;
 
-    gst_buffer_unmap (buffer, &map);
+  if (gst_raw_base_parse_is_buffer_aligned (buffer, alignment))
+    return NULL;
 
-    return new_buffer;
-  }
+  new_buffer = gst_buffer_new_allocate (NULL, out_size, &params);
 
-  gst_buffer_unmap (buffer, &map);
+  /* Copy data "by hand", so ensure alignment is kept. Extract the bytes
+   * straight out of the individual memories, which avoids an intermediate
+   * merged copy of the source buffer. */
+  gst_buffer_map (new_buffer, &map, GST_MAP_WRITE);
+  gst_buffer_extract (buffer, 0, map.data, out_size);
+  gst_buffer_unmap (new_buffer, &map);
 
-  return NULL;
+  gst_buffer_copy_into (new_buffer, buffer, GST_BUFFER_COPY_METADATA, 0,
+      out_size);
+  GST_DEBUG_OBJECT (raw_base_parse,
+      "We want output aligned on %" G_GSIZE_FORMAT ", reallocated", alignment);
+
+  return new_buffer;
 }
 
 static GstFlowReturn
@@ -574,6 +701,22 @@ gst_raw_base_parse_handle_frame (GstBaseParse * parse,
   if (klass->get_max_frames_per_buffer) {
     guint max_num_out_frames = klass->get_max_frames_per_buffer (raw_base_parse,
         GST_RAW_BASE_PARSE_CONFIG_CURRENT);
+
+    /* If the subclass wants several frames per buffer, wait until enough
+     * data for all of them is available, unless the stream is draining.
+     * Returning without finishing the frame makes GstBaseParse call this
+     * function again once more data came in. */
+    if (num_out_frames < max_num_out_frames && !GST_BASE_PARSE_DRAINING (parse)) {
+      GST_LOG_OBJECT (raw_base_parse, "%u of %u frames available; waiting "
+          "for more data", num_out_frames, max_num_out_frames);
+      if (new_caps_event != NULL) {
+        gst_event_unref (new_caps_event);
+        raw_base_parse->src_caps_set = FALSE;
+      }
+      GST_RAW_BASE_PARSE_CONFIG_MUTEX_UNLOCK (raw_base_parse);
+      return GST_FLOW_OK;
+    }
+
     num_out_frames = MIN (num_out_frames, max_num_out_frames);
   }
 
@@ -583,10 +726,12 @@ gst_raw_base_parse_handle_frame (GstBaseParse * parse,
   out_size = num_out_frames * frame_size;
 
   /* Set the overhead size to ensure that timestamping excludes these
-   * extra overhead bytes. */
+   * extra overhead bytes. The vfunc returns the overhead of one frame. */
   frame->overhead =
       klass->get_overhead_size ? klass->get_overhead_size (raw_base_parse,
       GST_RAW_BASE_PARSE_CONFIG_CURRENT) : 0;
+  if (frame->overhead > 0)
+    frame->overhead *= num_out_frames;
 
   g_assert (out_size >= (guint) (frame->overhead));
   out_size -= frame->overhead;
@@ -622,10 +767,17 @@ gst_raw_base_parse_handle_frame (GstBaseParse * parse,
           klass->get_alignment (raw_base_parse,
               GST_RAW_BASE_PARSE_CONFIG_CURRENT)) != 1) {
     GstBuffer *aligned_buffer;
+    gsize aligned_size;
+
+    /* If there is no output buffer, GstBaseParse pushes the consumed bytes
+     * including the overhead, so these all have to be kept in the copy */
+    aligned_size =
+        frame->out_buffer ? gst_buffer_get_size (frame->out_buffer) : out_size +
+        frame->overhead;
 
     aligned_buffer =
         gst_raw_base_parse_align_buffer (raw_base_parse, alignment,
-        frame->out_buffer ? frame->out_buffer : frame->buffer, out_size);
+        frame->out_buffer ? frame->out_buffer : frame->buffer, aligned_size);
 
     if (aligned_buffer) {
       if (frame->out_buffer)
@@ -790,7 +942,159 @@ gst_raw_base_parse_is_gstformat_supported (GstRawBaseParse * raw_base_parse,
 }
 
 
+static void
+gst_raw_base_parse_setup_mmap (GstRawBaseParse * raw_base_parse)
+{
+  /* must be called with lock */
+  GstPad *sinkpad = GST_BASE_PARSE_SINK_PAD (raw_base_parse);
+  GstQuery *query;
+  gchar *uri = NULL, *filename;
+  GStatBuf stat_buf;
+  GError *error = NULL;
+
+  raw_base_parse->mmap_checked = TRUE;
+
+  query = gst_query_new_uri ();
+  if (gst_pad_peer_query (sinkpad, query))
+    gst_query_parse_uri (query, &uri);
+  gst_query_unref (query);
+
+  if (uri == NULL) {
+    GST_DEBUG_OBJECT (raw_base_parse, "upstream did not report an URI");
+    return;
+  }
+
+  filename = g_filename_from_uri (uri, NULL, NULL);
+  g_free (uri);
+  if (filename == NULL) {
+    GST_DEBUG_OBJECT (raw_base_parse, "upstream is not a local file");
+    return;
+  }
+
+  /* Remember which file was mapped, to be able to tell later on if it was
+   * replaced or modified. The stat is done before mapping, so a modification
+   * in between shows up as a changed mtime at the next check. */
+  if (g_stat (filename, &stat_buf) != 0 || stat_buf.st_size == 0) {
+    GST_DEBUG_OBJECT (raw_base_parse, "cannot map file %s", filename);
+    g_free (filename);
+    return;
+  }
+
+  raw_base_parse->mapped_file = g_mapped_file_new (filename, FALSE, &error);
+  if (raw_base_parse->mapped_file == NULL) {
+    GST_WARNING_OBJECT (raw_base_parse, "could not map file %s: %s", filename,
+        error->message);
+    g_clear_error (&error);
+    g_free (filename);
+    return;
+  }
+
+  raw_base_parse->mapped_filename = filename;
+  raw_base_parse->mapped_file_dev = stat_buf.st_dev;
+  raw_base_parse->mapped_file_inode = stat_buf.st_ino;
+  raw_base_parse->mapped_file_size = stat_buf.st_size;
+  raw_base_parse->mapped_file_mtime = stat_buf.st_mtime;
+
+  GST_DEBUG_OBJECT (raw_base_parse, "mapped file %s with %" G_GSIZE_FORMAT
+      " bytes", filename, g_mapped_file_get_length (raw_base_parse->mapped_file));
+}
+
+
+static void
+gst_raw_base_parse_clear_mmap (GstRawBaseParse * raw_base_parse)
+{
+  if (raw_base_parse->mapped_file != NULL) {
+    g_mapped_file_unref (raw_base_parse->mapped_file);
+    raw_base_parse->mapped_file = NULL;
+  }
+  g_free (raw_base_parse->mapped_filename);
+  raw_base_parse->mapped_filename = NULL;
+  raw_base_parse->mmap_checked = FALSE;
+}
+
+
+static gboolean
+gst_raw_base_parse_is_mapped_file_unchanged (GstRawBaseParse * raw_base_parse)
+{
+  /* must be called with lock */
+  GStatBuf stat_buf;
+
+  if (g_stat (raw_base_parse->mapped_filename, &stat_buf) != 0)
+    return FALSE;
 
+  return stat_buf.st_dev == raw_base_parse->mapped_file_dev
+      && stat_buf.st_ino == raw_base_parse->mapped_file_inode
+      && stat_buf.st_size == raw_base_parse->mapped_file_size
+      && stat_buf.st_mtime == raw_base_parse->mapped_file_mtime
+      && (gsize) stat_buf.st_size ==
+      g_mapped_file_get_length (raw_base_parse->mapped_file);
+}
+
+
+static GstPadProbeReturn
+gst_raw_base_parse_mmap_pull_probe (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  GstRawBaseParse *raw_base_parse = GST_RAW_BASE_PARSE (user_data);
+  GMappedFile *mapped_file;
+  GstBuffer *buffer = NULL;
+  guint64 offset = info->offset;
+  gsize file_size, size;
+
+  /* The caller wants its own buffer filled; leave this to upstream */
+  if (GST_PAD_PROBE_INFO_DATA (info) != NULL)
+    return GST_PAD_PROBE_PASS;
+
+  GST_RAW_BASE_PARSE_CONFIG_MUTEX_LOCK (raw_base_parse);
+
+  if (G_UNLIKELY (!raw_base_parse->mmap_checked))
+    gst_raw_base_parse_setup_mmap (raw_base_parse);
+
+  if (raw_base_parse->mapped_file != NULL
+      && !gst_raw_base_parse_is_mapped_file_unchanged (raw_base_parse)) {
+    GST_DEBUG_OBJECT (raw_base_parse, "file %s changed after mapping it; "
+        "not using the mapping anymore", raw_base_parse->mapped_filename);
+    g_mapped_file_unref (raw_base_parse->mapped_file);
+    raw_base_parse->mapped_file = NULL;
+  }
+
+  mapped_file = raw_base_parse->mapped_file;
+
+  /* Pulls at or past the end of the file are left to upstream, which then
+   * reports EOS. Pulls that cross the end get the remaining bytes, just like
+   * a read from the file would. */
+  if (mapped_file != NULL) {
+    file_size = g_mapped_file_get_length (mapped_file);
+
+    if (offset < file_size) {
+      size = MIN (info->size, file_size - offset);
+
+      /* Wrap the entire mapping, and let the buffer only expose the pulled
+       * range. Each buffer holds a reference to the mapping to keep it
+       * alive. GstBaseParse creates the frames as subbuffers of this one,
+       * so downstream gets the mapped memory without any copy. */
+      buffer = gst_buffer_new_wrapped_full (GST_MEMORY_FLAG_READONLY,
+          g_mapped_file_get_contents (mapped_file), file_size, offset, size,
+          g_mapped_file_ref (mapped_file),
+          (GDestroyNotify) g_mapped_file_unref);
+      GST_BUFFER_OFFSET (buffer) = offset;
+      GST_BUFFER_OFFSET_END (buffer) = offset + size;
+    }
+  }
+
+  GST_RAW_BASE_PARSE_CONFIG_MUTEX_UNLOCK (raw_base_parse);
+
+  if (buffer == NULL)
+    return GST_PAD_PROBE_PASS;
+
+  /* Dropping the pull with a buffer in the probe info makes the pull return
+   * that buffer, without calling the getrange function of upstream */
+  GST_LOG_OBJECT (raw_base_parse, "answering pull of %u bytes at offset %"
+      G_GUINT64_FORMAT " from the mapping", info->size, offset);
+  GST_PAD_PROBE_INFO_DATA (info) = buffer;
+
+  return GST_PAD_PROBE_DROP;
+}
 
 
 /**
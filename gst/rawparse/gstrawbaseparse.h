@@ -82,6 +82,27 @@ struct _GstRawBaseParse
 
   /* Mutex which protects access to and modifications on the configs. */
   GMutex config_mutex;
+
+  /* TRUE if output buffers should share the input memory whenever possible.
+   * Subclasses read this (with the config lock held) to decide if they can
+   * relax their alignment requirements and avoid copying frames. */
+  gboolean zero_copy;
+
+  /* TRUE if a local upstream file may be memory-mapped in pull mode. */
+  gboolean use_mmap;
+  /* Memory mapping of the upstream file, or NULL if none exists. Output
+   * buffers hold references to it, so it outlives the parser if needed. */
+  GMappedFile *mapped_file;
+  /* TRUE if upstream was already checked for a file that can be mapped. */
+  gboolean mmap_checked;
+  /* Name and identity of the mapped file, used for detecting changes. */
+  gchar *mapped_filename;
+  guint64 mapped_file_dev;
+  guint64 mapped_file_inode;
+  gint64 mapped_file_size;
+  gint64 mapped_file_mtime;
+  /* ID of the sink pad probe that answers pulls from the mapping. */
+  gulong mmap_probe_id;
 };
 
 
@@ -114,6 +135,9 @@ struct _GstRawBaseParse
  *                             several complete frames. If this vfunc is not set, then there
  *                             is no maximum number of frames per buffer - the parser reads
  *                             as many complete frames as possible from the input buffer.
+ *                             If it is set, the parser waits until this many frames are
+ *                             available before producing an output buffer (except when
+ *                             draining at the end of the stream).
  * @is_config_ready:           Returns TRUE if the specified configuration is ready, FALSE
  *                             otherwise.
  * @process:                   Optional.
@@ -148,7 +172,15 @@ struct _GstRawBaseParse
  *                             Returns the number of bytes that make up the portion of a frame
  *                             that isn't payload. Examples are padding bytes, headers, and
  *                             other kinds of metadata. If this vfunc isn't defined, then an
- *                             overhead size of 0 bytes is assumed.
+ *                             overhead size of 0 bytes is assumed. The value refers to one
+ *                             frame; if an output buffer contains several frames, the base
+ *                             class multiplies it by the number of frames.
+ * @get_alignment:             Optional.
+ *                             Returns the alignment (in bytes, must be a power of two) the
+ *                             start of output buffers must have. If the data is not aligned
+ *                             accordingly, the base class copies it into a newly allocated,
+ *                             aligned buffer. In zero-copy mode, subclasses should return
+ *                             the smallest alignment the data format strictly requires.
  *
  * Subclasses are required to override all vfuncs except for @process, which is optional.
  * The raw base parser lock is held during all vfunc calls.
@@ -53,6 +53,20 @@
  * than the actual frame size (in fact, its default value is 0); if it is smaller,
  * then no trailing data will be skipped.
  *
+ * If the zero-copy property is enabled, output buffers share the memory of the
+ * input buffers. Frames are then only copied if their start is not aligned to
+ * the natural word size of the video format (for example, 2 bytes for 16-bit
+ * formats, or 4 bytes for v210). Also, the extra bytes defined by the frame
+ * stride are not cut off, so output buffers may be larger than the frame size
+ * given by the video metadata.
+ *
+ * Using the frames-per-buffer property, several frames can be put into one output
+ * buffer. This reduces the per-buffer overhead with high frame rate streams that
+ * have small frames. Such a buffer contains one #GstVideoMeta per frame; the ID
+ * of each meta is the index of its frame within the buffer, so individual frames
+ * can be accessed with gst_buffer_get_video_meta_id(). The buffer duration covers
+ * all of its frames. Frame stride padding is kept in the buffer in this case.
+ *
  * If a framerate of 0 Hz is set (for example, 0/1), then output buffers will have
  * no duration set. The first output buffer will have a PTS 0, all subsequent ones
  * an unset PTS.
@@ -103,7 +117,8 @@ enum
   PROP_TOP_FIELD_FIRST,
   PROP_PLANE_STRIDES,
   PROP_PLANE_OFFSETS,
-  PROP_FRAME_STRIDE
+  PROP_FRAME_STRIDE,
+  PROP_FRAMES_PER_BUFFER
 };
 
 
@@ -117,6 +132,7 @@ enum
 #define DEFAULT_INTERLACED            FALSE
 #define DEFAULT_TOP_FIELD_FIRST       FALSE
 #define DEFAULT_FRAME_STRIDE          0
+#define DEFAULT_FRAMES_PER_BUFFER     1
 
 
 #define GST_RAW_VIDEO_PARSE_CAPS \
@@ -330,6 +346,14 @@ gst_raw_video_parse_class_init (GstRawVideoParseClass * klass)
           0, G_MAXUINT,
           DEFAULT_FRAME_STRIDE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)
       );
+  g_object_class_install_property (object_class,
+      PROP_FRAMES_PER_BUFFER,
+      g_param_spec_uint ("frames-per-buffer",
+          "Frames per buffer",
+          "Number of frames to put into each output buffer",
+          1, G_MAXUINT,
+          DEFAULT_FRAMES_PER_BUFFER, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)
+      );
 
   gst_element_class_set_static_metadata (element_class,
       "rawvideoparse",
@@ -354,6 +378,8 @@ gst_raw_video_parse_init (GstRawVideoParse * raw_video_parse)
   raw_video_parse->properties_config.ready = TRUE;
   raw_video_parse->properties_config.top_field_first = DEFAULT_TOP_FIELD_FIRST;
   raw_video_parse->properties_config.frame_stride = DEFAULT_FRAME_STRIDE;
+
+  raw_video_parse->frames_per_buffer = DEFAULT_FRAMES_PER_BUFFER;
 }
 
 
@@ -647,6 +673,17 @@ gst_raw_video_parse_set_property (GObject * object, guint prop_id,
       break;
     }
 
+    case PROP_FRAMES_PER_BUFFER:
+    {
+      /* The number of frames per buffer applies to both configurations,
+       * and does not affect the size of one frame */
+
+      GST_RAW_BASE_PARSE_CONFIG_MUTEX_LOCK (object);
+      raw_video_parse->frames_per_buffer = g_value_get_uint (value);
+      GST_RAW_BASE_PARSE_CONFIG_MUTEX_UNLOCK (object);
+      break;
+    }
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -767,6 +804,12 @@ gst_raw_video_parse_get_property (GObject * object, guint prop_id,
       GST_RAW_BASE_PARSE_CONFIG_MUTEX_UNLOCK (object);
       break;
 
+    case PROP_FRAMES_PER_BUFFER:
+      GST_RAW_BASE_PARSE_CONFIG_MUTEX_LOCK (object);
+      g_value_set_uint (value, raw_video_parse->frames_per_buffer);
+      GST_RAW_BASE_PARSE_CONFIG_MUTEX_UNLOCK (object);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -916,11 +959,11 @@ gst_raw_video_parse_get_config_frame_size (GstRawBaseParse * raw_base_parse,
 
 
 static guint
-gst_raw_video_parse_get_max_frames_per_buffer (G_GNUC_UNUSED GstRawBaseParse *
+gst_raw_video_parse_get_max_frames_per_buffer (GstRawBaseParse *
     raw_base_parse, G_GNUC_UNUSED GstRawBaseParseConfig config)
 {
-  /* We want exactly one frame per buffer */
-  return 1;
+  /* We want exactly frames_per_buffer frames per buffer (by default 1) */
+  return GST_RAW_VIDEO_PARSE (raw_base_parse)->frames_per_buffer;
 }
 
 
@@ -936,14 +979,37 @@ static gint
 gst_raw_video_parse_get_alignment (GstRawBaseParse * raw_base_parse,
     GstRawBaseParseConfig config)
 {
-  return 32;
+  GstRawVideoParse *raw_video_parse = GST_RAW_VIDEO_PARSE (raw_base_parse);
+  GstRawVideoParseConfig *config_ptr;
+  GstVideoFormatInfo const *finfo;
+  guint bits;
+
+  if (!raw_base_parse->zero_copy)
+    return 32;
+
+  /* In zero-copy mode, only demand the alignment that is necessary to access
+   * the pixel data words. Complex formats like v210 are unpacked from
+   * 32-bit words, all others are read in units of their component bits. */
+  config_ptr = gst_raw_video_parse_get_config_ptr (raw_video_parse, config);
+  finfo = config_ptr->info.finfo;
+
+  if (GST_VIDEO_FORMAT_INFO_IS_COMPLEX (finfo))
+    return 4;
+
+  bits = GST_VIDEO_FORMAT_INFO_BITS (finfo);
+  if (bits > 16)
+    return 4;
+  else if (bits > 8)
+    return 2;
+  else
+    return 1;
 }
 
 static gboolean
 gst_raw_video_parse_process (GstRawBaseParse * raw_base_parse,
     GstRawBaseParseConfig config, GstBuffer * in_data,
     G_GNUC_UNUSED gsize total_num_in_bytes,
-    G_GNUC_UNUSED gsize num_valid_in_bytes, GstBuffer ** processed_data)
+    gsize num_valid_in_bytes, GstBuffer ** processed_data)
 {
   GstRawVideoParse *raw_video_parse = GST_RAW_VIDEO_PARSE (raw_base_parse);
   GstRawVideoParseConfig *config_ptr =
@@ -952,10 +1018,22 @@ gst_raw_video_parse_process (GstRawBaseParse * raw_base_parse,
   GstVideoInfo *video_info = &(config_ptr->info);
   GstVideoMeta *videometa;
   GstBuffer *out_data;
+  gsize frame_size = GST_VIDEO_INFO_SIZE (video_info);
+  gsize frame_stride;
+  guint num_frames, i, n_planes;
 
   /* In case of extra padding bytes, get a subbuffer without the padding bytes.
-   * Otherwise, just add the video meta. */
-  if (GST_VIDEO_INFO_SIZE (video_info) < config_ptr->frame_stride) {
+   * Otherwise, just add the video meta. The subbuffer shares the memory of
+   * the input, so this does not copy the frame, in zero-copy mode or not.
+   * If the buffer contains several frames, the padding bytes between them
+   * are kept, and the video metas describe where each frame is.
+   * (num_valid_in_bytes excludes the padding of all frames.) */
+  num_frames = (frame_size > 0) ? (num_valid_in_bytes / frame_size) : 1;
+  num_frames = MAX (num_frames, 1);
+  frame_stride = MAX (frame_size, (gsize) (config_ptr->frame_stride));
+
+  if (num_frames == 1 && GST_VIDEO_INFO_SIZE (video_info) <
+      config_ptr->frame_stride) {
     *processed_data = out_data =
         gst_buffer_copy_region (in_data,
         GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS |
@@ -983,14 +1061,23 @@ gst_raw_video_parse_process (GstRawBaseParse * raw_base_parse,
     gst_buffer_remove_meta (out_data, (GstMeta *) videometa);
   }
 
-  gst_buffer_add_video_meta_full (out_data,
-      frame_flags,
-      config_ptr->format,
-      config_ptr->width,
-      config_ptr->height,
-      GST_VIDEO_INFO_N_PLANES (video_info),
-      config_ptr->plane_offsets, config_ptr->plane_strides);
-
+  /* Add one videometa per frame. Frames after the first one are
+   * located at multiples of the frame stride. */
+  n_planes = GST_VIDEO_INFO_N_PLANES (video_info);
+  for (i = 0; i < num_frames; ++i) {
+    gsize plane_offsets[GST_VIDEO_MAX_PLANES];
+    guint plane;
+
+    for (plane = 0; plane < n_planes; ++plane)
+      plane_offsets[plane] = config_ptr->plane_offsets[plane] + i * frame_stride;
+
+    videometa = gst_buffer_add_video_meta_full (out_data,
+        frame_flags,
+        config_ptr->format,
+        config_ptr->width,
+        config_ptr->height, n_planes, plane_offsets, config_ptr->plane_strides);
+    videometa->id = i;
+  }
 
   return TRUE;
 }
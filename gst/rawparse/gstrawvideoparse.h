@@ -101,6 +101,9 @@ struct _GstRawVideoParse
   /* Currently active configuration. Points either to properties_config
    * or to sink_caps_config. This is never NULL. */
   GstRawVideoParseConfig *current_config;
+  /* How many frames are put into one output buffer. Each frame in the
+   * buffer gets its own GstVideoMeta, with the frame index as meta ID. */
+  guint frames_per_buffer;
 };
 
 
@@ -36,6 +36,14 @@ typedef struct _GstSceneChangeClass GstSceneChangeClass;
 
 #define SC_N_DIFFS 5
 
+/* The values are the distance between the pixels and rows that are scored */
+typedef enum
+{
+  GST_SCENE_CHANGE_SUBSAMPLING_NONE = 1,
+  GST_SCENE_CHANGE_SUBSAMPLING_2X2 = 2,
+  GST_SCENE_CHANGE_SUBSAMPLING_4X4 = 4
+} GstSceneChangeSubsampling;
+
 struct _GstSceneChange
 {
   GstVideoFilter base_scenechange;
@@ -45,6 +53,14 @@ struct _GstSceneChange
   GstBuffer *oldbuf;
   GstVideoInfo oldinfo;
   int count;
+
+  GstSceneChangeSubsampling subsampling;
+
+  /* Statistics, protected by the object lock */
+  guint64 n_scored;
+  double last_score;
+  GstClockTime last_score_time;
+  GstClockTime total_score_time;
 };
 
 struct _GstSceneChangeClass
@@ -91,6 +91,8 @@ static void gst_shm_sink_get_property (GObject * object, guint prop_id,
 static gboolean gst_shm_sink_start (GstBaseSink * bsink);
 static gboolean gst_shm_sink_stop (GstBaseSink * bsink);
 static GstFlowReturn gst_shm_sink_render (GstBaseSink * bsink, GstBuffer * buf);
+static GstFlowReturn gst_shm_sink_render_list (GstBaseSink * bsink,
+    GstBufferList * list);
 
 static gboolean gst_shm_sink_event (GstBaseSink * bsink, GstEvent * event);
 static gboolean gst_shm_sink_unlock (GstBaseSink * bsink);
@@ -371,6 +373,8 @@ gst_shm_sink_class_init (GstShmSinkClass * klass)
   gstbasesink_class->start = GST_DEBUG_FUNCPTR (gst_shm_sink_start);
   gstbasesink_class->stop = GST_DEBUG_FUNCPTR (gst_shm_sink_stop);
   gstbasesink_class->render = GST_DEBUG_FUNCPTR (gst_shm_sink_render);
+  gstbasesink_class->render_list =
+      GST_DEBUG_FUNCPTR (gst_shm_sink_render_list);
   gstbasesink_class->event = GST_DEBUG_FUNCPTR (gst_shm_sink_event);
   gstbasesink_class->unlock = GST_DEBUG_FUNCPTR (gst_shm_sink_unlock);
   gstbasesink_class->unlock_stop = GST_DEBUG_FUNCPTR (gst_shm_sink_unlock_stop);
@@ -652,6 +656,15 @@ gst_shm_sink_can_render (GstShmSink * self, GstClockTime time)
   return TRUE;
 }
 
+/* Must be called with the object lock held. Notifications queued in a batch
+ * are sent first, as the clients can't release buffers they don't know of */
+static void
+gst_shm_sink_wait_locked (GstShmSink * self)
+{
+  sp_writer_flush_batch (self->pipe);
+  g_cond_wait (&self->cond, GST_OBJECT_GET_LOCK (self));
+}
+
 static GstFlowReturn
 gst_shm_sink_render (GstBaseSink * bsink, GstBuffer * buf)
 {
@@ -665,13 +678,13 @@ gst_shm_sink_render (GstBaseSink * bsink, GstBuffer * buf)
 
   GST_OBJECT_LOCK (self);
   while (self->wait_for_connection && !self->clients) {
-    g_cond_wait (&self->cond, GST_OBJECT_GET_LOCK (self));
+    gst_shm_sink_wait_locked (self);
     if (self->unlock)
       goto flushing;
   }
 
   while (!gst_shm_sink_can_render (self, GST_BUFFER_TIMESTAMP (buf))) {
-    g_cond_wait (&self->cond, GST_OBJECT_GET_LOCK (self));
+    gst_shm_sink_wait_locked (self);
     if (self->unlock)
       goto flushing;
   }
@@ -706,13 +719,13 @@ gst_shm_sink_render (GstBaseSink * bsink, GstBuffer * buf)
     while ((memory =
             gst_shm_sink_allocator_alloc_locked (self->allocator,
                 gst_buffer_get_size (buf), &self->params)) == NULL) {
-      g_cond_wait (&self->cond, GST_OBJECT_GET_LOCK (self));
+      gst_shm_sink_wait_locked (self);
       if (self->unlock)
         goto flushing;
     }
 
     while (self->wait_for_connection && !self->clients) {
-      g_cond_wait (&self->cond, GST_OBJECT_GET_LOCK (self));
+      gst_shm_sink_wait_locked (self);
       if (self->unlock) {
         GST_OBJECT_UNLOCK (self);
         gst_memory_unref (memory);
@@ -761,6 +774,34 @@ flushing:
   return GST_FLOW_FLUSHING;
 }
 
+static GstFlowReturn
+gst_shm_sink_render_list (GstBaseSink * bsink, GstBufferList * list)
+{
+  GstShmSink *self = GST_SHM_SINK (bsink);
+  GstFlowReturn ret = GST_FLOW_OK;
+  guint i, len;
+  int failed;
+
+  /* Notify each client of all the buffers of the list with a single call */
+  GST_OBJECT_LOCK (self);
+  sp_writer_begin_batch (self->pipe);
+  GST_OBJECT_UNLOCK (self);
+
+  len = gst_buffer_list_length (list);
+  for (i = 0; i < len && ret == GST_FLOW_OK; i++)
+    ret = gst_shm_sink_render (bsink, gst_buffer_list_get (list, i));
+
+  GST_OBJECT_LOCK (self);
+  failed = sp_writer_end_batch (self->pipe);
+  GST_OBJECT_UNLOCK (self);
+
+  if (failed)
+    GST_WARNING_OBJECT (self, "Could not notify %d client(s) of new buffers",
+        failed);
+
+  return ret;
+}
+
 static void
 free_buffer_locked (GstBuffer * buffer, void *data)
 {
@@ -848,22 +889,28 @@ pollthread_func (gpointer data)
 
       if (gst_poll_fd_can_read (self->poll, &gclient->pollfd)) {
         int rv;
-        gpointer tag = NULL;
+        gboolean pending;
 
-        GST_OBJECT_LOCK (self);
-        rv = sp_writer_recv (self->pipe, gclient->client, &tag);
-        GST_OBJECT_UNLOCK (self);
+        /* Handle all the acks that were read from the socket at once */
+        do {
+          gpointer tag = NULL;
 
-        if (rv < 0) {
-          GST_WARNING_OBJECT (self, "One client has read error,"
-              " closing (retval: %d errno: %d)", rv, errno);
-          goto close_client;
-        }
+          GST_OBJECT_LOCK (self);
+          rv = sp_writer_recv (self->pipe, gclient->client, &tag);
+          pending = sp_writer_client_pending_commands (gclient->client);
+          GST_OBJECT_UNLOCK (self);
+
+          if (rv < 0) {
+            GST_WARNING_OBJECT (self, "One client has read error,"
+                " closing (retval: %d errno: %d)", rv, errno);
+            goto close_client;
+          }
 
-        g_assert (rv == 0 || tag == NULL);
+          g_assert (rv == 0 || tag == NULL);
 
-        if (rv == 0)
-          gst_buffer_unref (tag);
+          if (rv == 0)
+            gst_buffer_unref (tag);
+        } while (pending);
       }
       continue;
     close_client:
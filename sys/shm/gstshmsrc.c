@@ -326,30 +326,41 @@ gst_shm_src_create (GstPushSrc * psrc, GstBuffer ** outbuf)
   struct GstShmBuffer *gsb;
 
   do {
-    if (gst_poll_wait (self->poll, GST_CLOCK_TIME_NONE) < 0) {
-      if (errno == EBUSY)
-        return GST_FLOW_FLUSHING;
-      GST_ELEMENT_ERROR (self, RESOURCE, READ, ("Failed to read from shmsrc"),
-          ("Poll failed on fd: %s", strerror (errno)));
-      return GST_FLOW_ERROR;
+    gboolean pending;
+
+    /* Commands are read from the socket in bursts, the ones that were
+     * already read can be handled without polling */
+    GST_OBJECT_LOCK (self);
+    pending = sp_client_pending_commands (self->pipe->pipe);
+    GST_OBJECT_UNLOCK (self);
+
+    if (!pending) {
+      if (gst_poll_wait (self->poll, GST_CLOCK_TIME_NONE) < 0) {
+        if (errno == EBUSY)
+          return GST_FLOW_FLUSHING;
+        GST_ELEMENT_ERROR (self, RESOURCE, READ,
+            ("Failed to read from shmsrc"),
+            ("Poll failed on fd: %s", strerror (errno)));
+        return GST_FLOW_ERROR;
+      }
     }
 
     if (self->unlocked)
       return GST_FLOW_FLUSHING;
 
-    if (gst_poll_fd_has_closed (self->poll, &self->pollfd)) {
+    if (!pending && gst_poll_fd_has_closed (self->poll, &self->pollfd)) {
       GST_ELEMENT_ERROR (self, RESOURCE, READ, ("Failed to read from shmsrc"),
           ("Control socket has closed"));
       return GST_FLOW_ERROR;
     }
 
-    if (gst_poll_fd_has_error (self->poll, &self->pollfd)) {
+    if (!pending && gst_poll_fd_has_error (self->poll, &self->pollfd)) {
       GST_ELEMENT_ERROR (self, RESOURCE, READ, ("Failed to read from shmsrc"),
           ("Control socket has error"));
       return GST_FLOW_ERROR;
     }
 
-    if (gst_poll_fd_can_read (self->poll, &self->pollfd)) {
+    if (pending || gst_poll_fd_can_read (self->poll, &self->pollfd)) {
       buf = NULL;
       GST_LOG_OBJECT (self, "Reading from pipe");
       GST_OBJECT_LOCK (self);
@@ -39,8 +39,13 @@ struct _ShmAllocSpace
   /* The total size of this space */
   size_t size;
 
-  /* chained list of the blocks contained in this space */
+  /* chained list of the blocks contained in this space, in ring order:
+   * the offsets increase from @blocks to @last_block, wrapping around to
+   * the start of the space at most once. New blocks normally go right
+   * after @last_block and are released in the same order, so neither
+   * allocating nor freeing needs to walk the list */
   ShmAllocBlock *blocks;
+  ShmAllocBlock *last_block;
 };
 
 /* A single block of data */
@@ -56,7 +61,8 @@ struct _ShmAllocBlock
   /* The size of the block */
   unsigned long size;
 
-  /* Pointer to the next block in the chain */
+  /* Pointers to the previous and next blocks in the chain */
+  ShmAllocBlock *prev;
   ShmAllocBlock *next;
 };
 
@@ -80,51 +86,92 @@ shm_alloc_space_free (ShmAllocSpace * self)
   spalloc_free (ShmAllocSpace, self);
 }
 
-
-ShmAllocBlock *
-shm_alloc_space_alloc_block (ShmAllocSpace * self, unsigned long size)
+/* Creates a block and links it after @prev_item (or as the only block
+ * if @prev_item is NULL) */
+static ShmAllocBlock *
+shm_alloc_space_insert_block (ShmAllocSpace * self, ShmAllocBlock * prev_item,
+    unsigned long offset, unsigned long size)
 {
   ShmAllocBlock *block;
-  ShmAllocBlock *item = NULL;
-  ShmAllocBlock *prev_item = NULL;
-  unsigned long prev_end_offset = 0;
-
 
-  for (item = self->blocks; item; item = item->next) {
-    unsigned long max_size = 0;
-
-    max_size = item->offset - prev_end_offset;
-
-    if (max_size >= size)
-      break;
-
-    prev_end_offset = item->offset + item->size;
-    prev_item = item;
-  }
-
-  /* Return NULL if there is no big enough space, otherwise, there is space
-   * at the end */
-  assert (prev_end_offset <= self->size);
-  if (!item && self->size - prev_end_offset < size)
-    return NULL;
+  assert (offset + size <= self->size);
 
   block = spalloc_new (ShmAllocBlock);
   memset (block, 0, sizeof (ShmAllocBlock));
-  block->offset = prev_end_offset;
+  block->offset = offset;
   block->size = size;
   block->use_count = 1;
   block->space = self;
 
-  if (prev_item)
+  block->prev = prev_item;
+  if (prev_item) {
+    block->next = prev_item->next;
     prev_item->next = block;
-  else
+  } else {
+    block->next = self->blocks;
     self->blocks = block;
+  }
 
-  block->next = item;
+  if (block->next)
+    block->next->prev = block;
+  else
+    self->last_block = block;
 
   return block;
 }
 
+ShmAllocBlock *
+shm_alloc_space_alloc_block (ShmAllocSpace * self, unsigned long size)
+{
+  ShmAllocBlock *first = self->blocks;
+  ShmAllocBlock *last = self->last_block;
+  ShmAllocBlock *item = NULL;
+  unsigned long end_offset;
+
+  if (size > self->size)
+    return NULL;
+
+  /* Nothing is in use, start again from the beginning */
+  if (!first)
+    return shm_alloc_space_insert_block (self, NULL, 0, size);
+
+  end_offset = last->offset + last->size;
+
+  if (last->offset >= first->offset) {
+    /* The blocks don't wrap around: there is free space after the last
+     * block and before the first one */
+    if (self->size - end_offset >= size)
+      return shm_alloc_space_insert_block (self, last, end_offset, size);
+    if (first->offset >= size)
+      return shm_alloc_space_insert_block (self, last, 0, size);
+  } else {
+    /* The blocks wrap around: the free space is between the last block
+     * and the first one */
+    if (first->offset - end_offset >= size)
+      return shm_alloc_space_insert_block (self, last, end_offset, size);
+  }
+
+  /* Blocks were released out of order, look for a hole between them */
+  for (item = first; item->next; item = item->next) {
+    ShmAllocBlock *next = item->next;
+
+    end_offset = item->offset + item->size;
+
+    if (next->offset >= end_offset) {
+      if (next->offset - end_offset >= size)
+        return shm_alloc_space_insert_block (self, item, end_offset, size);
+    } else {
+      /* This is where the blocks wrap around */
+      if (self->size - end_offset >= size)
+        return shm_alloc_space_insert_block (self, item, end_offset, size);
+      if (next->offset >= size)
+        return shm_alloc_space_insert_block (self, item, 0, size);
+    }
+  }
+
+  return NULL;
+}
+
 unsigned long
 shm_alloc_space_alloc_block_get_offset (ShmAllocBlock * block)
 {
@@ -134,20 +181,17 @@ shm_alloc_space_alloc_block_get_offset (ShmAllocBlock * block)
 static void
 shm_alloc_space_free_block (ShmAllocBlock * block)
 {
-  ShmAllocBlock *item = NULL;
-  ShmAllocBlock *prev_item = NULL;
   ShmAllocSpace *self = block->space;
 
-  for (item = self->blocks; item; item = item->next) {
-    if (item == block) {
-      if (prev_item)
-        prev_item->next = item->next;
-      else
-        self->blocks = item->next;
-      break;
-    }
-    prev_item = item;
-  }
+  if (block->prev)
+    block->prev->next = block->next;
+  else
+    self->blocks = block->next;
+
+  if (block->next)
+    block->next->prev = block->prev;
+  else
+    self->last_block = block->prev;
 
   spalloc_free (ShmAllocBlock, block);
 }
@@ -155,7 +199,12 @@ shm_alloc_space_free_block (ShmAllocBlock * block)
 ShmAllocBlock *
 shm_alloc_space_block_get (ShmAllocSpace * self, unsigned long offset)
 {
-  ShmAllocBlock *block = NULL;
+  ShmAllocBlock *block = self->last_block;
+
+  /* The block being sent is almost always the one allocated last */
+  if (block && block->offset <= offset &&
+      (block->offset + block->size) > offset)
+    return block;
 
   for (block = self->blocks; block; block = block->next) {
     if (block->offset <= offset && (block->offset + block->size) > offset)
@@ -165,7 +214,6 @@ shm_alloc_space_block_get (ShmAllocSpace * self, unsigned long offset)
   return NULL;
 }
 
-
 void
 shm_alloc_space_block_inc (ShmAllocBlock * block)
 {
@@ -75,6 +75,12 @@
 
 #define LISTEN_BACKLOG 10
 
+/* Maximum number of commands queued per client while batching */
+#define MAX_BATCHED_COMMANDS 32
+
+/* Number of commands read from a socket at once */
+#define RECV_BUFFER_COMMANDS 32
+
 enum
 {
   COMMAND_NEW_SHM_AREA = 1,
@@ -84,6 +90,41 @@ enum
 };
 
 typedef struct _ShmArea ShmArea;
+typedef struct _ShmRecvBuffer ShmRecvBuffer;
+
+struct CommandBuffer
+{
+  unsigned int type;
+  int area_id;
+
+  union
+  {
+    struct
+    {
+      size_t size;
+      unsigned int path_size;
+      /* Followed by path */
+    } new_shm_area;
+    struct
+    {
+      unsigned long offset;
+      unsigned long size;
+    } buffer;
+    struct
+    {
+      unsigned long offset;
+    } ack_buffer;
+  } payload;
+};
+
+/* Commands read from a socket but not handled yet. Everything that is
+ * available is read at once, so a burst of commands costs one recv() */
+struct _ShmRecvBuffer
+{
+  char data[RECV_BUFFER_COMMANDS * sizeof (struct CommandBuffer)];
+  size_t pos;
+  size_t len;
+};
 
 struct _ShmArea
 {
@@ -141,12 +182,24 @@ struct _ShmPipe
   ShmClient *clients;
 
   mode_t perms;
+
+  /* If set, new buffer commands are queued until sp_writer_flush_batch() */
+  int batching;
+
+  /* Reader side */
+  ShmRecvBuffer recvbuf;
 };
 
 struct _ShmClient
 {
   int fd;
 
+  /* Commands queued while batching */
+  struct CommandBuffer batch[MAX_BATCHED_COMMANDS];
+  int batch_len;
+
+  ShmRecvBuffer recvbuf;
+
   ShmClient *next;
 };
 
@@ -157,36 +210,12 @@ struct _ShmBlock
   ShmAllocBlock *ablock;
 };
 
-struct CommandBuffer
-{
-  unsigned int type;
-  int area_id;
-
-  union
-  {
-    struct
-    {
-      size_t size;
-      unsigned int path_size;
-      /* Followed by path */
-    } new_shm_area;
-    struct
-    {
-      unsigned long offset;
-      unsigned long size;
-    } buffer;
-    struct
-    {
-      unsigned long offset;
-    } ack_buffer;
-  } payload;
-};
-
 static ShmArea *sp_open_shm (char *path, int id, mode_t perms, size_t size);
 static void sp_close_shm (ShmArea * area);
 static int sp_shmbuf_dec (ShmPipe * self, ShmBuffer * buf,
     ShmBuffer * prev_buf, ShmClient * client, void **tag);
 static void sp_shm_area_dec (ShmPipe * self, ShmArea * area);
+static int flush_client_batch (ShmClient * client);
 
 
 
@@ -485,6 +514,76 @@ send_command (int fd, struct CommandBuffer *cb, unsigned short int type,
   return 1;
 }
 
+static int
+queue_command (ShmClient * client, struct CommandBuffer *cb,
+    unsigned short int type, int area_id)
+{
+  int ret = 1;
+
+  if (client->batch_len == MAX_BATCHED_COMMANDS)
+    ret = flush_client_batch (client);
+
+  cb->type = type;
+  cb->area_id = area_id;
+  client->batch[client->batch_len++] = *cb;
+
+  return ret;
+}
+
+static int
+flush_client_batch (ShmClient * client)
+{
+  ssize_t len = client->batch_len * sizeof (struct CommandBuffer);
+
+  if (client->batch_len == 0)
+    return 1;
+
+  client->batch_len = 0;
+
+  if (send (client->fd, client->batch, len, MSG_NOSIGNAL) != len)
+    return 0;
+
+  return 1;
+}
+
+/**
+ * sp_writer_begin_batch:
+ *
+ * Until sp_writer_end_batch() is called, the new buffer notifications
+ * are queued and sent to each client with a single call when flushing,
+ * instead of one call per buffer and client.
+ */
+
+void
+sp_writer_begin_batch (ShmPipe * self)
+{
+  self->batching = 1;
+}
+
+/* Returns the number of clients the queued commands could not be sent to */
+
+int
+sp_writer_flush_batch (ShmPipe * self)
+{
+  ShmClient *client;
+  int failed = 0;
+
+  for (client = self->clients; client; client = client->next) {
+    if (!flush_client_batch (client))
+      failed++;
+  }
+
+  return failed;
+}
+
+int
+sp_writer_end_batch (ShmPipe * self)
+{
+  self->batching = 0;
+
+  return sp_writer_flush_batch (self);
+}
+
 int
 sp_writer_resize (ShmPipe * self, size_t size)
 {
@@ -497,6 +596,9 @@ sp_writer_resize (ShmPipe * self, size_t size)
   if (self->shm_area->shm_area_len == size)
     return 0;
 
+  /* The clients must get the buffers of the old area before it is closed */
+  sp_writer_flush_batch (self);
+
   newarea = sp_open_shm (NULL, ++self->next_area_id, self->perms, size);
 
   if (!newarea)
@@ -617,8 +719,12 @@ sp_writer_send_buf (ShmPipe * self, char *buf, size_t size, void *tag)
     struct CommandBuffer cb = { 0 };
     cb.payload.buffer.offset = offset;
     cb.payload.buffer.size = bsize;
-    if (!send_command (client->fd, &cb, COMMAND_NEW_BUFFER, self->shm_area->id))
+    if (self->batching) {
+      queue_command (client, &cb, COMMAND_NEW_BUFFER, self->shm_area->id);
+    } else if (!send_command (client->fd, &cb, COMMAND_NEW_BUFFER,
+            self->shm_area->id)) {
       continue;
+    }
     sb->clients[i++] = client->fd;
     c++;
   }
@@ -640,16 +746,63 @@ sp_writer_send_buf (ShmPipe * self, char *buf, size_t size, void *tag)
 }
 
 static int
-recv_command (int fd, struct CommandBuffer *cb)
+recv_command (int fd, ShmRecvBuffer * rb, struct CommandBuffer *cb)
 {
-  int retval;
+  ssize_t retval;
+
+  if (rb->len - rb->pos < sizeof (struct CommandBuffer)) {
+    /* Keep the start of a partial command and read everything available */
+    memmove (rb->data, rb->data + rb->pos, rb->len - rb->pos);
+    rb->len -= rb->pos;
+    rb->pos = 0;
+
+    retval = recv (fd, rb->data + rb->len, sizeof (rb->data) - rb->len,
+        MSG_DONTWAIT);
+    if (retval > 0)
+      rb->len += retval;
+
+    if (rb->len == 0)
+      return 0;
+
+    /* Commands are always sent whole, the rest is on its way */
+    if (rb->len < sizeof (struct CommandBuffer)) {
+      retval = recv (fd, rb->data + rb->len,
+          sizeof (struct CommandBuffer) - rb->len, MSG_WAITALL);
+      if (retval != (ssize_t) (sizeof (struct CommandBuffer) - rb->len))
+        return 0;
+      rb->len += retval;
+    }
+  }
 
-  retval = recv (fd, cb, sizeof (struct CommandBuffer), MSG_DONTWAIT);
-  if (retval == sizeof (struct CommandBuffer)) {
-    return 1;
-  } else {
+  memcpy (cb, rb->data + rb->pos, sizeof (struct CommandBuffer));
+  rb->pos += sizeof (struct CommandBuffer);
+
+  return 1;
+}
+
+/* Reads data following a command, taking what was already buffered first */
+static int
+recv_data (int fd, ShmRecvBuffer * rb, char *buf, size_t size)
+{
+  size_t avail = rb->len - rb->pos;
+
+  if (avail > size)
+    avail = size;
+
+  memcpy (buf, rb->data + rb->pos, avail);
+  rb->pos += avail;
+
+  if (avail < size && recv (fd, buf + avail, size - avail,
+          MSG_WAITALL) != (ssize_t) (size - avail))
     return 0;
-  }
+
+  return 1;
+}
+
+static int
+has_pending_command (ShmRecvBuffer * rb)
+{
+  return rb->len - rb->pos >= sizeof (struct CommandBuffer);
 }
 
 long int
@@ -659,9 +812,8 @@ sp_client_recv (ShmPipe * self, char **buf)
   ShmArea *newarea;
   ShmArea *area;
   struct CommandBuffer cb;
-  int retval;
 
-  if (!recv_command (self->main_socket, &cb))
+  if (!recv_command (self->main_socket, &self->recvbuf, &cb))
     return -1;
 
   switch (cb.type) {
@@ -670,14 +822,13 @@ sp_client_recv (ShmPipe * self, char **buf)
       assert (cb.payload.new_shm_area.size > 0);
 
       area_name = malloc (cb.payload.new_shm_area.path_size + 1);
-      retval = recv (self->main_socket, area_name,
-          cb.payload.new_shm_area.path_size, 0);
-      if (retval != cb.payload.new_shm_area.path_size) {
+      if (!recv_data (self->main_socket, &self->recvbuf, area_name,
+              cb.payload.new_shm_area.path_size)) {
         free (area_name);
         return -3;
       }
       /* Ensure area_name is NULL terminated */
-      area_name[retval] = 0;
+      area_name[cb.payload.new_shm_area.path_size] = 0;
 
       newarea = sp_open_shm (area_name, cb.area_id, 0,
           cb.payload.new_shm_area.size);
@@ -722,7 +873,7 @@ sp_writer_recv (ShmPipe * self, ShmClient * client, void **tag)
   ShmBuffer *buf = NULL, *prev_buf = NULL;
   struct CommandBuffer cb;
 
-  if (!recv_command (client->fd, &cb))
+  if (!recv_command (client->fd, &client->recvbuf, &cb))
     return -1;
 
   switch (cb.type) {
@@ -835,6 +986,7 @@ sp_writer_accept_client (ShmPipe * self)
   }
 
   client = spalloc_new (ShmClient);
+  memset (client, 0, sizeof (ShmClient));
   client->fd = fd;
 
   /* Prepend ot linked list */
@@ -963,6 +1115,23 @@ sp_writer_pending_writes (ShmPipe * self)
   return (self->buffers != NULL);
 }
 
+/* Returns TRUE if commands from this client were already read from the
+ * socket, sp_writer_recv() must then be called without polling first */
+
+int
+sp_writer_client_pending_commands (ShmClient * client)
+{
+  return has_pending_command (&client->recvbuf);
+}
+
+/* Same as sp_writer_client_pending_commands() for sp_client_recv() */
+
+int
+sp_client_pending_commands (ShmPipe * self)
+{
+  return has_pending_command (&self->recvbuf);
+}
+
 const char *
 sp_writer_get_path (ShmPipe * pipe)
 {
@@ -131,6 +131,191 @@ GST_START_TEST (test_filter_caps)
 
 GST_END_TEST;
 
+static void
+test_convert_handoff_cb (GstElement * sink, GstBuffer * buffer, GstPad * pad,
+    gsize * out_size)
+{
+  *out_size += gst_buffer_get_size (buffer);
+}
+
+/* check that inputs with other caps than the output are converted */
+GST_START_TEST (test_convert)
+{
+  GstElement *pipeline, *src1, *cf1, *src2, *cf2, *audiomixer, *sink;
+  GstCaps *filter_caps, *caps;
+  GstMessage *msg;
+  gsize out_size = 0;
+  GstBus *bus;
+  GstPad *pad;
+
+  filter_caps = gst_caps_new_simple ("audio/x-raw",
+      "format", G_TYPE_STRING, GST_AUDIO_NE (S16),
+      "layout", G_TYPE_STRING, "interleaved",
+      "rate", G_TYPE_INT, 48000, "channels", G_TYPE_INT, 2, NULL);
+
+  /* build pipeline */
+  pipeline = gst_pipeline_new ("pipeline");
+
+  src1 = gst_element_factory_make ("audiotestsrc", NULL);
+  g_object_set (src1, "num-buffers", 10, NULL);
+  cf1 = gst_element_factory_make ("capsfilter", NULL);
+  caps = gst_caps_new_simple ("audio/x-raw",
+      "format", G_TYPE_STRING, GST_AUDIO_NE (F32),
+      "rate", G_TYPE_INT, 44100, "channels", G_TYPE_INT, 1, NULL);
+  g_object_set (cf1, "caps", caps, NULL);
+  gst_caps_unref (caps);
+
+  src2 = gst_element_factory_make ("audiotestsrc", NULL);
+  g_object_set (src2, "num-buffers", 10, NULL);
+  cf2 = gst_element_factory_make ("capsfilter", NULL);
+  g_object_set (cf2, "caps", filter_caps, NULL);
+
+  audiomixer = gst_element_factory_make ("audiomixer", NULL);
+  g_object_set (audiomixer, "caps", filter_caps, NULL);
+  sink = gst_element_factory_make ("fakesink", "sink");
+  g_object_set (sink, "signal-handoffs", TRUE, NULL);
+  g_signal_connect (sink, "handoff", (GCallback) test_convert_handoff_cb,
+      &out_size);
+  gst_bin_add_many (GST_BIN (pipeline), src1, cf1, src2, cf2, audiomixer,
+      sink, NULL);
+
+  fail_unless (gst_element_link_many (src1, cf1, audiomixer, sink, NULL));
+  fail_unless (gst_element_link_many (src2, cf2, audiomixer, NULL));
+
+  fail_unless_equals_int (gst_element_set_state (pipeline, GST_STATE_PLAYING),
+      GST_STATE_CHANGE_ASYNC);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_poll (bus, GST_MESSAGE_EOS | GST_MESSAGE_ERROR, -1);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  /* both inputs are mixed into the requested output format */
+  pad = gst_element_get_static_pad (sink, "sink");
+  caps = gst_pad_get_current_caps (pad);
+  fail_unless (caps != NULL);
+  GST_INFO_OBJECT (pipeline, "received caps: %" GST_PTR_FORMAT, caps);
+  fail_unless (gst_caps_is_equal_fixed (caps, filter_caps));
+  gst_caps_unref (caps);
+  gst_object_unref (pad);
+  fail_unless (out_size > 0);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  gst_caps_unref (filter_caps);
+}
+
+GST_END_TEST;
+
+static GstPadProbeReturn
+test_fast_path_probe_cb (GstPad * pad, GstPadProbeInfo * info,
+    GHashTable * input_memory)
+{
+  GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER (info);
+
+  g_hash_table_add (input_memory, gst_buffer_peek_memory (buffer, 0));
+
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+test_fast_path_handoff_cb (GstElement * sink, GstBuffer * buffer,
+    GstPad * pad, GHashTable * input_memory)
+{
+  guint *n_forwarded = g_object_get_data (G_OBJECT (sink), "n-forwarded");
+  guint *n_gap = g_object_get_data (G_OBJECT (sink), "n-gap");
+
+  if (gst_buffer_n_memory (buffer) == 1
+      && g_hash_table_contains (input_memory, gst_buffer_peek_memory (buffer,
+              0)))
+    (*n_forwarded)++;
+  if (GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_GAP))
+    (*n_gap)++;
+}
+
+/* Mixes two streams of 10ms buffers, the second one muted, and counts the
+ * output buffers that share memory with the first one and that are GAP */
+static void
+run_fast_path_test (gboolean mute_all, guint * n_forwarded, guint * n_gap)
+{
+  GstElement *pipeline, *src1, *src2, *audiomixer, *sink;
+  GHashTable *input_memory;
+  GstPad *srcpad, *sinkpad;
+  GstCaps *caps;
+  GstMessage *msg;
+  GstBus *bus;
+
+  *n_forwarded = *n_gap = 0;
+  input_memory = g_hash_table_new (NULL, NULL);
+
+  pipeline = gst_pipeline_new ("pipeline");
+  src1 = gst_element_factory_make ("audiotestsrc", NULL);
+  g_object_set (src1, "num-buffers", 20, "samplesperbuffer", 441, NULL);
+  src2 = gst_element_factory_make ("audiotestsrc", NULL);
+  g_object_set (src2, "num-buffers", 20, "samplesperbuffer", 441, NULL);
+  audiomixer = gst_element_factory_make ("audiomixer", NULL);
+  sink = gst_element_factory_make ("fakesink", NULL);
+  g_object_set (sink, "signal-handoffs", TRUE, NULL);
+  g_object_set_data (G_OBJECT (sink), "n-forwarded", n_forwarded);
+  g_object_set_data (G_OBJECT (sink), "n-gap", n_gap);
+  g_signal_connect (sink, "handoff", (GCallback) test_fast_path_handoff_cb,
+      input_memory);
+  gst_bin_add_many (GST_BIN (pipeline), src1, src2, audiomixer, sink, NULL);
+
+  caps = gst_caps_new_simple ("audio/x-raw",
+      "format", G_TYPE_STRING, GST_AUDIO_NE (S16),
+      "layout", G_TYPE_STRING, "interleaved",
+      "rate", G_TYPE_INT, 44100, "channels", G_TYPE_INT, 1, NULL);
+  fail_unless (gst_element_link_filtered (src1, audiomixer, caps));
+  fail_unless (gst_element_link_filtered (src2, audiomixer, caps));
+  fail_unless (gst_element_link (audiomixer, sink));
+  gst_caps_unref (caps);
+
+  srcpad = gst_element_get_static_pad (src1, "src");
+  gst_pad_add_probe (srcpad, GST_PAD_PROBE_TYPE_BUFFER,
+      (GstPadProbeCallback) test_fast_path_probe_cb, input_memory, NULL);
+  gst_object_unref (srcpad);
+
+  sinkpad = gst_element_get_static_pad (audiomixer, "sink_0");
+  g_object_set (sinkpad, "mute", mute_all, NULL);
+  gst_object_unref (sinkpad);
+  sinkpad = gst_element_get_static_pad (audiomixer, "sink_1");
+  g_object_set (sinkpad, "mute", TRUE, NULL);
+  gst_object_unref (sinkpad);
+
+  fail_unless_equals_int (gst_element_set_state (pipeline, GST_STATE_PLAYING),
+      GST_STATE_CHANGE_ASYNC);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_poll (bus, GST_MESSAGE_EOS | GST_MESSAGE_ERROR, -1);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+  g_hash_table_unref (input_memory);
+}
+
+/* check that a single audible pad is forwarded without mixing and that
+ * silent output is flagged as GAP */
+GST_START_TEST (test_silence_fast_path)
+{
+  guint n_forwarded, n_gap;
+
+  run_fast_path_test (FALSE, &n_forwarded, &n_gap);
+  fail_unless_equals_int (n_forwarded, 20);
+  fail_unless_equals_int (n_gap, 0);
+
+  run_fast_path_test (TRUE, &n_forwarded, &n_gap);
+  fail_unless_equals_int (n_forwarded, 0);
+  fail_unless_equals_int (n_gap, 20);
+}
+
+GST_END_TEST;
+
 static gboolean
 set_playing (GstElement * element)
 {
@@ -1920,6 +2105,8 @@ audiomixer_suite (void)
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_caps);
   tcase_add_test (tc_chain, test_filter_caps);
+  tcase_add_test (tc_chain, test_convert);
+  tcase_add_test (tc_chain, test_silence_fast_path);
   tcase_add_test (tc_chain, test_event);
   tcase_add_test (tc_chain, test_play_twice);
   tcase_add_test (tc_chain, test_play_twice_then_add_and_play_again);
@@ -0,0 +1,426 @@
+/* GStreamer
+ *
+ * unit test for compare
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+/* The metrics are computed by static functions of the element */
+#include "../../gst/debugutils/gstcompare.c"
+#include "gstdebugutilsbadorc.c"
+
+#define EPSILON 1e-9
+
+enum
+{
+  CONTENT_NOISE,
+  CONTENT_SAME,
+  CONTENT_NOISY_COPY
+};
+
+/* Creates two frames, the second one being unrelated to the first one, the
+ * same, or the same with some noise */
+static void
+create_frames (GstVideoInfo * info, GRand * rand, gint content,
+    GstBuffer ** buf1, GstBuffer ** buf2)
+{
+  GstMapInfo map1, map2;
+  gsize i;
+
+  *buf1 = gst_buffer_new_allocate (NULL, info->size, NULL);
+  *buf2 = gst_buffer_new_allocate (NULL, info->size, NULL);
+
+  gst_buffer_map (*buf1, &map1, GST_MAP_WRITE);
+  gst_buffer_map (*buf2, &map2, GST_MAP_WRITE);
+  for (i = 0; i < info->size; i++) {
+    map1.data[i] = g_rand_int_range (rand, 0, 256);
+    switch (content) {
+      case CONTENT_NOISE:
+        map2.data[i] = g_rand_int_range (rand, 0, 256);
+        break;
+      case CONTENT_SAME:
+        map2.data[i] = map1.data[i];
+        break;
+      case CONTENT_NOISY_COPY:
+      default:
+        map2.data[i] = map1.data[i] + g_rand_int_range (rand, -3, 4);
+        break;
+    }
+  }
+  gst_buffer_unmap (*buf1, &map1);
+  gst_buffer_unmap (*buf2, &map2);
+}
+
+/* SSIM of the window of @width x @height samples at @data1 and @data2,
+ * summing its samples directly */
+static gdouble
+reference_ssim_window (const guint8 * data1, const guint8 * data2,
+    gint width, gint height, gint step, gint stride1, gint stride2)
+{
+  gint64 sum1 = 0, sum2 = 0, ssum1 = 0, ssum2 = 0, acov = 0;
+  gdouble count = width * height;
+  gdouble avg1, avg2, var1, var2, cov;
+  const gdouble c1 = (0.01 * 255.0) * (0.01 * 255.0);
+  const gdouble c2 = (0.03 * 255.0) * (0.03 * 255.0);
+  gint i, j;
+
+  for (i = 0; i < height; i++) {
+    for (j = 0; j < width; j++) {
+      gint a = data1[i * stride1 + j * step];
+      gint b = data2[i * stride2 + j * step];
+
+      sum1 += a;
+      sum2 += b;
+      ssum1 += a * a;
+      ssum2 += b * b;
+      acov += a * b;
+    }
+  }
+
+  avg1 = sum1 / count;
+  avg2 = sum2 / count;
+  var1 = ssum1 / count - avg1 * avg1;
+  var2 = ssum2 / count - avg2 * avg2;
+  cov = acov / count - avg1 * avg2;
+
+  return (2 * avg1 * avg2 + c1) * (2 * cov + c2) /
+      ((avg1 * avg1 + avg2 * avg2 + c1) * (var1 + var2 + c2));
+}
+
+/* SSIM and mean squared error of component @k, with 16x16 windows every 8
+ * samples */
+static void
+reference_component (GstVideoFrame * frame1, GstVideoFrame * frame2, gint k,
+    gdouble * ssim, gdouble * mse)
+{
+  const guint8 *data1 = GST_VIDEO_FRAME_COMP_DATA (frame1, k);
+  const guint8 *data2 = GST_VIDEO_FRAME_COMP_DATA (frame2, k);
+  gint width = GST_VIDEO_FRAME_COMP_WIDTH (frame1, k);
+  gint height = GST_VIDEO_FRAME_COMP_HEIGHT (frame1, k);
+  gint step = GST_VIDEO_FRAME_COMP_PSTRIDE (frame1, k);
+  gint stride1 = GST_VIDEO_FRAME_COMP_STRIDE (frame1, k);
+  gint stride2 = GST_VIDEO_FRAME_COMP_STRIDE (frame2, k);
+  gdouble ssim_sum = 0;
+  gint64 sse = 0;
+  gint count = 0, i, j;
+
+  for (j = 0; j + 8 < height; j += 8) {
+    for (i = 0; i + 8 < width; i += 8) {
+      ssim_sum += reference_ssim_window (data1 + i * step + j * stride1,
+          data2 + i * step + j * stride2, MIN (16, width - i),
+          MIN (16, height - j), step, stride1, stride2);
+      count++;
+    }
+  }
+  *ssim = count ? ssim_sum / count : 1.0;
+
+  for (j = 0; j < height; j++) {
+    for (i = 0; i < width; i++) {
+      gint d = data1[j * stride1 + i * step] - data2[j * stride2 + i * step];
+
+      sse += d * d;
+    }
+  }
+  *mse = (gdouble) sse / ((gdouble) width * height);
+}
+
+static GstCompare *
+create_compare (gint method, guint n_threads)
+{
+  GstCompare *comp = g_object_new (GST_TYPE_COMPARE, NULL);
+
+  comp->method = method;
+  g_object_set (comp, "n-threads", n_threads, NULL);
+
+  return comp;
+}
+
+static void
+check_metrics (GstVideoFormat format, gint width, gint height, gint content)
+{
+  GstCompare *comp;
+  GstCompareMetrics metrics;
+  GstVideoInfo info;
+  GstVideoFrame frame1, frame2;
+  GstBuffer *buf1, *buf2;
+  GstCaps *caps;
+  GRand *rand;
+  gdouble ssim, mse, psnr;
+  gint k;
+
+  gst_video_info_set_format (&info, format, width, height);
+  caps = gst_video_info_to_caps (&info);
+  rand = g_rand_new_with_seed (format * 1000 + width + height + content);
+  create_frames (&info, rand, content, &buf1, &buf2);
+
+  comp = create_compare (GST_COMPARE_METHOD_PSNR, 0);
+  psnr = gst_compare_video (comp, buf1, caps, buf2, caps, &metrics);
+  fail_unless_equals_int (metrics.n_components,
+      GST_VIDEO_INFO_N_COMPONENTS (&info));
+  fail_unless (psnr == metrics.total_psnr);
+
+  fail_unless (gst_video_frame_map (&frame1, &info, buf1, GST_MAP_READ));
+  fail_unless (gst_video_frame_map (&frame2, &info, buf2, GST_MAP_READ));
+  for (k = 0; k < metrics.n_components; k++) {
+    reference_component (&frame1, &frame2, k, &ssim, &mse);
+
+    fail_unless (fabs (metrics.ssim[k] - ssim) < EPSILON,
+        "component %d: ssim %f != %f", k, metrics.ssim[k], ssim);
+    if (mse == 0)
+      fail_unless (isinf (metrics.psnr[k]));
+    else
+      fail_unless (fabs (metrics.psnr[k] - 10 * log10 (255.0 * 255.0 / mse))
+          < EPSILON, "component %d: psnr %f, mse %f", k, metrics.psnr[k], mse);
+  }
+  gst_video_frame_unmap (&frame1);
+  gst_video_frame_unmap (&frame2);
+
+  if (content == CONTENT_SAME) {
+    fail_unless (fabs (metrics.total_ssim - 1.0) < EPSILON);
+    fail_unless (isinf (metrics.total_psnr));
+  }
+
+  comp->method = GST_COMPARE_METHOD_SSIM;
+  ssim = gst_compare_video (comp, buf1, caps, buf2, caps, &metrics);
+  fail_unless (ssim == metrics.total_ssim);
+
+  gst_object_unref (comp);
+  gst_caps_unref (caps);
+  gst_buffer_unref (buf1);
+  gst_buffer_unref (buf2);
+  g_rand_free (rand);
+}
+
+/* Test the SSIM and PSNR of planar and packed formats of various sizes
+ * against a direct evaluation of every window */
+GST_START_TEST (test_ssim_psnr)
+{
+  static const GstVideoFormat formats[] = { GST_VIDEO_FORMAT_GRAY8,
+    GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_YUY2, GST_VIDEO_FORMAT_RGB
+  };
+  static const gint sizes[][2] = { {1, 1}, {7, 9}, {16, 16}, {17, 8},
+  {33, 47}, {160, 120}, {201, 75}
+  };
+  gint f, s, c;
+
+  for (f = 0; f < G_N_ELEMENTS (formats); f++) {
+    for (s = 0; s < G_N_ELEMENTS (sizes); s++) {
+      for (c = CONTENT_NOISE; c <= CONTENT_NOISY_COPY; c++)
+        check_metrics (formats[f], sizes[s][0], sizes[s][1], c);
+    }
+  }
+}
+
+GST_END_TEST;
+
+/* Test that the metrics don't depend on the number of threads */
+GST_START_TEST (test_n_threads)
+{
+  static const guint n_threads[] = { 2, 3, 5, 8, 0 };
+  GstCompareMetrics expected, metrics;
+  GstVideoInfo info;
+  GstBuffer *buf1, *buf2;
+  GstCaps *caps;
+  GstCompare *comp;
+  GRand *rand;
+  gint i, k;
+
+  gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420, 333, 250);
+  caps = gst_video_info_to_caps (&info);
+  rand = g_rand_new_with_seed (0);
+  create_frames (&info, rand, CONTENT_NOISY_COPY, &buf1, &buf2);
+
+  comp = create_compare (GST_COMPARE_METHOD_SSIM, 1);
+  gst_compare_video (comp, buf1, caps, buf2, caps, &expected);
+  gst_object_unref (comp);
+
+  for (i = 0; i < G_N_ELEMENTS (n_threads); i++) {
+    comp = create_compare (GST_COMPARE_METHOD_SSIM, n_threads[i]);
+    gst_compare_video (comp, buf1, caps, buf2, caps, &metrics);
+    gst_object_unref (comp);
+
+    fail_unless_equals_int (metrics.n_components, expected.n_components);
+    for (k = 0; k < metrics.n_components; k++) {
+      fail_unless (metrics.ssim[k] == expected.ssim[k]);
+      fail_unless (metrics.psnr[k] == expected.psnr[k]);
+    }
+    fail_unless (metrics.total_ssim == expected.total_ssim);
+    fail_unless (metrics.total_psnr == expected.total_psnr);
+  }
+
+  gst_caps_unref (caps);
+  gst_buffer_unref (buf1);
+  gst_buffer_unref (buf2);
+  g_rand_free (rand);
+}
+
+GST_END_TEST;
+
+/* Test the "compare" message posted for every frame */
+GST_START_TEST (test_compare_message)
+{
+  GstCompareMetrics metrics;
+  GstVideoInfo info;
+  GstBuffer *buf1, *buf2;
+  GstCaps *caps;
+  GstCompare *comp;
+  GstBus *bus;
+  GstMessage *msg;
+  const GstStructure *s;
+  const GValue *ssim, *psnr;
+  GRand *rand;
+  guint64 timestamp;
+  gdouble value;
+  gint k;
+
+  gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420, 64, 48);
+  caps = gst_video_info_to_caps (&info);
+  rand = g_rand_new_with_seed (0);
+  create_frames (&info, rand, CONTENT_NOISY_COPY, &buf1, &buf2);
+  GST_BUFFER_PTS (buf1) = GST_BUFFER_PTS (buf2) = 3 * GST_SECOND;
+
+  comp = create_compare (GST_COMPARE_METHOD_SSIM, 0);
+  g_object_set (comp, "post-messages", TRUE, NULL);
+  bus = gst_bus_new ();
+  gst_element_set_bus (GST_ELEMENT (comp), bus);
+
+  gst_compare_video (comp, buf1, caps, buf2, caps, &metrics);
+  gst_compare_buffers (comp, buf1, caps, buf2, caps);
+
+  while ((msg = gst_bus_pop_filtered (bus, GST_MESSAGE_ELEMENT))) {
+    if (gst_message_has_name (msg, "compare"))
+      break;
+    gst_message_unref (msg);
+  }
+  fail_unless (msg != NULL);
+  fail_unless (GST_MESSAGE_SRC (msg) == GST_OBJECT (comp));
+
+  s = gst_message_get_structure (msg);
+  fail_unless (gst_structure_get_uint64 (s, "timestamp", &timestamp));
+  fail_unless_equals_uint64 (timestamp, 3 * GST_SECOND);
+  fail_unless (gst_structure_get_double (s, "ssim", &value));
+  fail_unless (value == metrics.total_ssim);
+  fail_unless (gst_structure_get_double (s, "psnr", &value));
+  fail_unless (value == metrics.total_psnr);
+
+  ssim = gst_structure_get_value (s, "component-ssim");
+  psnr = gst_structure_get_value (s, "component-psnr");
+  fail_unless (GST_VALUE_HOLDS_ARRAY (ssim));
+  fail_unless (GST_VALUE_HOLDS_ARRAY (psnr));
+  fail_unless_equals_int (gst_value_array_get_size (ssim), 3);
+  fail_unless_equals_int (gst_value_array_get_size (psnr), 3);
+  for (k = 0; k < 3; k++) {
+    fail_unless (g_value_get_double (gst_value_array_get_value (ssim,
+                k)) == metrics.ssim[k]);
+    fail_unless (g_value_get_double (gst_value_array_get_value (psnr,
+                k)) == metrics.psnr[k]);
+  }
+  gst_message_unref (msg);
+
+  /* nothing is posted when disabled */
+  g_object_set (comp, "post-messages", FALSE, NULL);
+  gst_compare_buffers (comp, buf1, caps, buf2, caps);
+  while ((msg = gst_bus_pop_filtered (bus, GST_MESSAGE_ELEMENT))) {
+    fail_if (gst_message_has_name (msg, "compare"));
+    gst_message_unref (msg);
+  }
+
+  gst_element_set_bus (GST_ELEMENT (comp), NULL);
+  gst_object_unref (bus);
+  gst_object_unref (comp);
+  gst_caps_unref (caps);
+  gst_buffer_unref (buf1);
+  gst_buffer_unref (buf2);
+  g_rand_free (rand);
+}
+
+GST_END_TEST;
+
+/* Test that the means and variances of the windows are not truncated. Two
+ * opposite checkerboards of 0 and 1 have integer means and variances of 0,
+ * which made them look identical. */
+GST_START_TEST (test_ssim_exact_means)
+{
+  GstCompareMetrics metrics;
+  GstVideoInfo info;
+  GstVideoFrame frame1, frame2;
+  GstBuffer *buf1, *buf2;
+  GstCaps *caps;
+  GstCompare *comp;
+  const gdouble c2 = (0.03 * 255.0) * (0.03 * 255.0);
+  gdouble ssim;
+  gint x, y;
+
+  gst_video_info_set_format (&info, GST_VIDEO_FORMAT_GRAY8, 16, 16);
+  caps = gst_video_info_to_caps (&info);
+  buf1 = gst_buffer_new_allocate (NULL, info.size, NULL);
+  buf2 = gst_buffer_new_allocate (NULL, info.size, NULL);
+
+  fail_unless (gst_video_frame_map (&frame1, &info, buf1, GST_MAP_WRITE));
+  fail_unless (gst_video_frame_map (&frame2, &info, buf2, GST_MAP_WRITE));
+  for (y = 0; y < 16; y++) {
+    guint8 *line1 = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA (&frame1, 0) +
+        y * GST_VIDEO_FRAME_PLANE_STRIDE (&frame1, 0);
+    guint8 *line2 = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA (&frame2, 0) +
+        y * GST_VIDEO_FRAME_PLANE_STRIDE (&frame2, 0);
+
+    for (x = 0; x < 16; x++) {
+      line1[x] = (x + y) & 1;
+      line2[x] = !line1[x];
+    }
+  }
+  gst_video_frame_unmap (&frame1);
+  gst_video_frame_unmap (&frame2);
+
+  comp = create_compare (GST_COMPARE_METHOD_SSIM, 0);
+  ssim = gst_compare_video (comp, buf1, caps, buf2, caps, &metrics);
+
+  /* a single window with means of 1/2, variances of 1/4 and a covariance of
+   * -1/4 */
+  fail_unless (fabs (ssim - (c2 - 0.5) / (c2 + 0.5)) < EPSILON,
+      "ssim %f", ssim);
+  fail_unless (ssim < 1.0);
+
+  gst_object_unref (comp);
+  gst_caps_unref (caps);
+  gst_buffer_unref (buf1);
+  gst_buffer_unref (buf2);
+}
+
+GST_END_TEST;
+
+static Suite *
+compare_suite (void)
+{
+  Suite *s = suite_create ("compare");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_ssim_psnr);
+  tcase_add_test (tc_chain, test_n_threads);
+  tcase_add_test (tc_chain, test_compare_message);
+  tcase_add_test (tc_chain, test_ssim_exact_means);
+
+  return s;
+}
+
+GST_CHECK_MAIN (compare);
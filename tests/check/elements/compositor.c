@@ -1827,6 +1827,270 @@ GST_START_TEST (test_ignore_eos)
 
 GST_END_TEST;
 
+/* Mix inputs in several formats, so that each pad needs conversion, at
+ * positions that straddle the bands the output is composited in, and
+ * return the output frames */
+static GList *
+_run_mixed_formats (const gchar * format, guint n_threads)
+{
+  GstElement *bin, *appsink;
+  GstSample *sample;
+  GList *buffers = NULL;
+  gchar *desc;
+
+  desc = g_strdup_printf ("compositor name=mix n-threads=%u "
+      "sink_1::xpos=21 sink_1::ypos=37 sink_1::alpha=0.6 "
+      "sink_2::xpos=200 sink_2::ypos=-13 ! "
+      "video/x-raw,format=%s,width=320,height=240 ! appsink name=sink "
+      "sync=false videotestsrc num-buffers=5 pattern=smpte ! "
+      "video/x-raw,format=I420,width=160,height=120 ! mix. "
+      "videotestsrc num-buffers=5 pattern=ball ! "
+      "video/x-raw,format=RGB,width=80,height=60 ! mix. "
+      "videotestsrc num-buffers=5 pattern=circular ! "
+      "video/x-raw,format=YUY2,width=64,height=64 ! mix.", n_threads,
+      format);
+  bin = gst_parse_launch (desc, NULL);
+  g_free (desc);
+  fail_unless (bin != NULL);
+
+  appsink = gst_bin_get_by_name (GST_BIN (bin), "sink");
+  fail_unless (gst_element_set_state (bin,
+          GST_STATE_PLAYING) != GST_STATE_CHANGE_FAILURE);
+
+  do {
+    g_signal_emit_by_name (appsink, "pull-sample", &sample);
+    if (sample) {
+      buffers = g_list_append (buffers,
+          gst_buffer_ref (gst_sample_get_buffer (sample)));
+      gst_sample_unref (sample);
+    }
+  } while (sample != NULL);
+
+  gst_element_set_state (bin, GST_STATE_NULL);
+  gst_object_unref (appsink);
+  gst_object_unref (bin);
+
+  return buffers;
+}
+
+/* Test that preparing the pad frames and compositing the output in parallel
+ * gives the same output as doing everything on one thread */
+GST_START_TEST (test_parallel_compositing)
+{
+  static const gchar *formats[] = { "AYUV", "I420", "NV12", "YUY2", "RGB",
+    "BGRx"
+  };
+  GList *serial, *parallel, *l1, *l2;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+    GST_INFO ("testing %s", formats[i]);
+
+    serial = _run_mixed_formats (formats[i], 1);
+    parallel = _run_mixed_formats (formats[i], 4);
+
+    fail_unless_equals_int (g_list_length (serial), 5);
+    fail_unless_equals_int (g_list_length (parallel), 5);
+
+    for (l1 = serial, l2 = parallel; l1 && l2; l1 = l1->next, l2 = l2->next) {
+      GstMapInfo map1, map2;
+
+      fail_unless (gst_buffer_map (l1->data, &map1, GST_MAP_READ));
+      fail_unless (gst_buffer_map (l2->data, &map2, GST_MAP_READ));
+      fail_unless_equals_int (map1.size, map2.size);
+      fail_unless (memcmp (map1.data, map2.data, map1.size) == 0);
+      gst_buffer_unmap (l1->data, &map1);
+      gst_buffer_unmap (l2->data, &map2);
+    }
+
+    g_list_free_full (serial, (GDestroyNotify) gst_buffer_unref);
+    g_list_free_full (parallel, (GDestroyNotify) gst_buffer_unref);
+  }
+}
+
+GST_END_TEST;
+
+static GstPadProbeReturn
+_record_memory_probe_cb (GstPad * pad, GstPadProbeInfo * info,
+    GList ** memories)
+{
+  GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER (info);
+
+  *memories = g_list_prepend (*memories,
+      gst_memory_ref (gst_buffer_peek_memory (buffer, 0)));
+
+  return GST_PAD_PROBE_OK;
+}
+
+/* Returns how many of the output buffers share their memory with one of the
+ * input buffers */
+static gint
+_count_passthrough_buffers (const gchar * pad_props)
+{
+  GstElement *bin, *mix;
+  GstPad *sinkpad, *srcpad;
+  GList *in_memories = NULL, *out_memories = NULL, *l;
+  GstBus *bus;
+  GstMessage *msg;
+  gchar *desc;
+  gint count = 0;
+
+  desc = g_strdup_printf ("videotestsrc num-buffers=5 ! "
+      "video/x-raw,format=I420,width=320,height=240 ! "
+      "compositor name=mix %s ! "
+      "video/x-raw,format=I420,width=320,height=240 ! fakesink", pad_props);
+  bin = gst_parse_launch (desc, NULL);
+  g_free (desc);
+  fail_unless (bin != NULL);
+
+  mix = gst_bin_get_by_name (GST_BIN (bin), "mix");
+  sinkpad = gst_element_get_static_pad (mix, "sink_0");
+  srcpad = gst_element_get_static_pad (mix, "src");
+  gst_pad_add_probe (sinkpad, GST_PAD_PROBE_TYPE_BUFFER,
+      (GstPadProbeCallback) _record_memory_probe_cb, &in_memories, NULL);
+  gst_pad_add_probe (srcpad, GST_PAD_PROBE_TYPE_BUFFER,
+      (GstPadProbeCallback) _record_memory_probe_cb, &out_memories, NULL);
+
+  fail_unless (gst_element_set_state (bin,
+          GST_STATE_PLAYING) != GST_STATE_CHANGE_FAILURE);
+  bus = gst_element_get_bus (bin);
+  msg = gst_bus_poll (bus, GST_MESSAGE_EOS | GST_MESSAGE_ERROR, -1);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+  gst_element_set_state (bin, GST_STATE_NULL);
+
+  fail_unless (out_memories != NULL);
+  for (l = out_memories; l; l = l->next) {
+    if (g_list_find (in_memories, l->data))
+      count++;
+  }
+
+  g_list_free_full (in_memories, (GDestroyNotify) gst_memory_unref);
+  g_list_free_full (out_memories, (GDestroyNotify) gst_memory_unref);
+  gst_object_unref (sinkpad);
+  gst_object_unref (srcpad);
+  gst_object_unref (mix);
+  gst_object_unref (bin);
+
+  return count;
+}
+
+/* Test that a single opaque input covering the whole output is passed
+ * through without copying, and only then */
+GST_START_TEST (test_opaque_passthrough)
+{
+  fail_unless_equals_int (_count_passthrough_buffers (""), 5);
+  fail_unless_equals_int (_count_passthrough_buffers ("sink_0::xpos=2"), 0);
+  fail_unless_equals_int (_count_passthrough_buffers ("sink_0::alpha=0.5"),
+      0);
+}
+
+GST_END_TEST;
+
+static void
+_store_last_buffer_cb (GstElement * sink, GstBuffer * buffer, GstPad * pad,
+    GstBuffer ** last_buffer)
+{
+  gst_buffer_replace (last_buffer, buffer);
+}
+
+/* Test that an input whose video meta describes a padded stride is not
+ * passed through, as its caps alone describe the default layout */
+GST_START_TEST (test_padded_stride_not_passed_through)
+{
+  GstElement *pipeline, *compositor, *sink;
+  GstPad *srcpad, *sinkpad;
+  GstSegment segment;
+  GstCaps *caps;
+  GstVideoInfo info;
+  GstVideoFrame frame;
+  GstBuffer *inbuf, *outbuf = NULL;
+  GstMemory *inmem;
+  GstBus *bus;
+  GstMessage *msg;
+  gsize offset[GST_VIDEO_MAX_PLANES] = { 0, };
+  gint stride[GST_VIDEO_MAX_PLANES] = { 48, };
+  guint8 *data;
+  gint x, y;
+
+  caps = gst_caps_from_string ("video/x-raw,format=BGRx,width=8,height=4,"
+      "framerate=25/1");
+  fail_unless (gst_video_info_from_caps (&info, caps));
+  fail_unless_equals_int (GST_VIDEO_INFO_PLANE_STRIDE (&info, 0), 32);
+
+  /* Every visible byte holds its row number, the padding holds 0xff */
+  inbuf = gst_buffer_new_and_alloc (stride[0] * 4);
+  gst_buffer_memset (inbuf, 0, 0xff, stride[0] * 4);
+  for (y = 0; y < 4; y++)
+    gst_buffer_memset (inbuf, y * stride[0], y, 32);
+  gst_buffer_add_video_meta_full (inbuf, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_FORMAT_BGRx, 8, 4, 1, offset, stride);
+  GST_BUFFER_PTS (inbuf) = 0;
+  GST_BUFFER_DURATION (inbuf) = GST_SECOND / 25;
+  inmem = gst_buffer_peek_memory (inbuf, 0);
+
+  pipeline = gst_pipeline_new ("test-pipeline");
+  compositor = gst_element_factory_make ("compositor", NULL);
+  sink = gst_element_factory_make ("fakesink", NULL);
+  g_object_set (sink, "signal-handoffs", TRUE, NULL);
+  g_signal_connect (sink, "handoff", G_CALLBACK (_store_last_buffer_cb),
+      &outbuf);
+  gst_bin_add_many (GST_BIN (pipeline), compositor, sink, NULL);
+  fail_unless (gst_element_link (compositor, sink));
+
+  sinkpad = gst_element_get_request_pad (compositor, "sink_%u");
+  srcpad = gst_pad_new ("src", GST_PAD_SRC);
+  fail_unless (gst_pad_link (srcpad, sinkpad) == GST_PAD_LINK_OK);
+  gst_pad_set_active (srcpad, TRUE);
+
+  fail_if (gst_element_set_state (pipeline,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (srcpad,
+          gst_event_new_stream_start ("test")));
+  fail_unless (gst_pad_push_event (srcpad, gst_event_new_caps (caps)));
+  fail_unless (gst_pad_push_event (srcpad, gst_event_new_segment (&segment)));
+  fail_unless (gst_pad_push (srcpad, gst_buffer_ref (inbuf)) == GST_FLOW_OK);
+  fail_unless (gst_pad_push_event (srcpad, gst_event_new_eos ()));
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_poll (bus, GST_MESSAGE_EOS | GST_MESSAGE_ERROR, -1);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  fail_unless (outbuf != NULL);
+  fail_if (gst_buffer_peek_memory (outbuf, 0) == inmem);
+
+  /* The output must hold the visible pixels only, whatever its layout */
+  fail_unless (gst_video_frame_map (&frame, &info, outbuf, GST_MAP_READ));
+  for (y = 0; y < 4; y++) {
+    data = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA (&frame, 0) +
+        y * GST_VIDEO_FRAME_PLANE_STRIDE (&frame, 0);
+    for (x = 0; x < 32; x++) {
+      /* Skip the x of BGRx, compositor does not have to preserve it */
+      if (x % 4 == 3)
+        continue;
+      fail_unless_equals_int (data[x], y);
+    }
+  }
+  gst_video_frame_unmap (&frame);
+
+  gst_pad_set_active (srcpad, FALSE);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_element_release_request_pad (compositor, sinkpad);
+  gst_object_unref (sinkpad);
+  gst_object_unref (srcpad);
+  gst_object_unref (pipeline);
+  gst_buffer_unref (outbuf);
+  gst_buffer_unref (inbuf);
+  gst_caps_unref (caps);
+}
+
+GST_END_TEST;
+
 /* Test that the GST_ELEMENT(vagg)->sinkpads GList is always sorted by zorder */
 GST_START_TEST (test_pad_z_order)
 {
@@ -2093,6 +2357,9 @@ compositor_suite (void)
   tcase_add_test (tc_chain, test_segment_base_handling);
   tcase_add_test (tc_chain, test_obscured_skipped);
   tcase_add_test (tc_chain, test_ignore_eos);
+  tcase_add_test (tc_chain, test_parallel_compositing);
+  tcase_add_test (tc_chain, test_opaque_passthrough);
+  tcase_add_test (tc_chain, test_padded_stride_not_passed_through);
   tcase_add_test (tc_chain, test_pad_z_order);
   tcase_add_test (tc_chain, test_pad_numbering);
   tcase_add_test (tc_chain, test_start_time_zero_live_drop_0);
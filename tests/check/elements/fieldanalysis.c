@@ -0,0 +1,205 @@
+/* GStreamer
+ *
+ * unit test for fieldanalysis
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+/* The comb masks are computed by static functions of the element */
+#include "../../gst/fieldanalysis/gstfieldanalysis.c"
+#include "gstfieldanalysisorc.c"
+
+#define TEST_WIDTH 70
+#define TEST_HEIGHT 24
+
+/* The per-sample comb detection the Orc kernels replaced */
+static gboolean
+scalar_comb_sample (FieldAnalysisCombMethod method, gint spatial_thresh,
+    const guint8 * fjm2, const guint8 * fjm1, const guint8 * fj,
+    const guint8 * fjp1, const guint8 * fjp2, gint idx)
+{
+  const gint diff1 = fj[idx] - fjm1[idx];
+  const gint diff2 = fj[idx] - fjp1[idx];
+
+  /* change in the same direction */
+  if (!((diff1 > spatial_thresh && diff2 > spatial_thresh)
+          || (diff1 < -spatial_thresh && diff2 < -spatial_thresh)))
+    return FALSE;
+
+  switch (method) {
+    case METHOD_32DETECT:
+      return abs (fj[idx] - fjm2[idx]) < 10 && abs (diff1) > 15;
+    case METHOD_IS_COMBED:
+      return (fjm1[idx] - fj[idx]) * (fjp1[idx] - fj[idx]) >
+          spatial_thresh * spatial_thresh;
+    case METHOD_5_TAP:
+    default:
+      return abs (fjm2[idx] + (fj[idx] << 2) + fjp2[idx] - 3 * (fjm1[idx] +
+              fjp1[idx])) > 6 * spatial_thresh;
+  }
+}
+
+/* Line k of the frame woven from the two fields, addressed independently of
+ * the element's helpers */
+static const guint8 *
+reference_line (FieldAnalysisFields (*history)[2], gint k)
+{
+  GstVideoFrame *frame;
+
+  if (((*history)[0].parity == TOP_FIELD) == (k % 2 == 0))
+    frame = &(*history)[0].frame;
+  else
+    frame = &(*history)[1].frame;
+
+  return (const guint8 *) GST_VIDEO_FRAME_COMP_DATA (frame, 0) +
+      k * GST_VIDEO_FRAME_COMP_STRIDE (frame, 0);
+}
+
+/* Fills the luma with a mix of noise and combing and everything else with a
+ * value the luma never has */
+static GstBuffer *
+create_frame (GstVideoInfo * info, GRand * rand, guint8 offset)
+{
+  GstBuffer *buf = gst_buffer_new_allocate (NULL, info->size, NULL);
+  GstVideoFrame frame;
+  gint x, y;
+
+  gst_buffer_memset (buf, 0, 255, info->size);
+
+  fail_unless (gst_video_frame_map (&frame, info, buf, GST_MAP_WRITE));
+  for (y = 0; y < GST_VIDEO_INFO_HEIGHT (info); y++) {
+    guint8 *line = (guint8 *) GST_VIDEO_FRAME_COMP_DATA (&frame, 0) +
+        y * GST_VIDEO_FRAME_COMP_STRIDE (&frame, 0);
+
+    for (x = 0; x < GST_VIDEO_INFO_WIDTH (info); x++) {
+      guint8 value;
+
+      if (x < GST_VIDEO_INFO_WIDTH (info) / 2)
+        value = g_rand_int_range (rand, 0, 255);
+      else
+        value = offset + (y % 2) * 40 + g_rand_int_range (rand, 0, 12);
+      line[x * GST_VIDEO_FRAME_COMP_PSTRIDE (&frame, 0)] = value;
+    }
+  }
+  gst_video_frame_unmap (&frame);
+
+  return buf;
+}
+
+static void
+check_comb_masks (GstVideoFormat format)
+{
+  static const FieldAnalysisCombMethod methods[] =
+      { METHOD_32DETECT, METHOD_IS_COMBED, METHOD_5_TAP };
+  static const gint spatial_threshs[] = { 0, 9, 30, 254 };
+  GstFieldAnalysis *filter;
+  FieldAnalysisFields history[2];
+  GstVideoInfo info;
+  GstBuffer *bufs[2];
+  GRand *rand;
+  guint8 comb_mask[TEST_WIDTH], luma_cache[COMB_MASK_LINES * TEST_WIDTH];
+  guint64 cached_lines[COMB_MASK_LINES];
+  gint m, t, i, j, k;
+
+  gst_video_info_set_format (&info, format, TEST_WIDTH, TEST_HEIGHT);
+  rand = g_rand_new_with_seed (format);
+  bufs[0] = create_frame (&info, rand, 40);
+  bufs[1] = create_frame (&info, rand, 120);
+  fail_unless (gst_video_frame_map (&history[0].frame, &info, bufs[0],
+          GST_MAP_READ));
+  fail_unless (gst_video_frame_map (&history[1].frame, &info, bufs[1],
+          GST_MAP_READ));
+
+  filter = g_object_new (GST_TYPE_FIELDANALYSIS, NULL);
+
+  for (i = 0; i < 2; i++) {
+    history[0].parity = i ? BOTTOM_FIELD : TOP_FIELD;
+    history[1].parity = i ? TOP_FIELD : BOTTOM_FIELD;
+
+    for (m = 0; m < G_N_ELEMENTS (methods); m++) {
+      for (t = 0; t < G_N_ELEMENTS (spatial_threshs); t++) {
+        filter->comb_method = methods[m];
+        filter->spatial_thresh = spatial_threshs[t];
+
+        for (k = 0; k < COMB_MASK_LINES; k++)
+          cached_lines[k] = G_MAXUINT64;
+
+        for (j = 2; j < TEST_HEIGHT - 2; j++) {
+          const gint pstride = GST_VIDEO_INFO_COMP_PSTRIDE (&info, 0);
+
+          comb_mask_line (filter, comb_mask,
+              luma_line (&history, j - 2, luma_cache, cached_lines,
+                  TEST_WIDTH), luma_line (&history, j - 1, luma_cache,
+                  cached_lines, TEST_WIDTH), luma_line (&history, j,
+                  luma_cache, cached_lines, TEST_WIDTH),
+              luma_line (&history, j + 1, luma_cache, cached_lines,
+                  TEST_WIDTH), luma_line (&history, j + 2, luma_cache,
+                  cached_lines, TEST_WIDTH), TEST_WIDTH);
+
+          for (k = 0; k < TEST_WIDTH; k++) {
+            gboolean expected = scalar_comb_sample (methods[m],
+                spatial_threshs[t], reference_line (&history, j - 2),
+                reference_line (&history, j - 1), reference_line (&history,
+                    j), reference_line (&history, j + 1),
+                reference_line (&history, j + 2), k * pstride);
+
+            fail_unless_equals_int (comb_mask[k], expected);
+          }
+        }
+      }
+    }
+  }
+
+  gst_object_unref (filter);
+  gst_video_frame_unmap (&history[0].frame);
+  gst_video_frame_unmap (&history[1].frame);
+  gst_buffer_unref (bufs[0]);
+  gst_buffer_unref (bufs[1]);
+  g_rand_free (rand);
+}
+
+/* Test that the comb masks of every supported format match the ones of the
+ * scalar code */
+GST_START_TEST (test_comb_masks)
+{
+  check_comb_masks (GST_VIDEO_FORMAT_YUY2);
+  check_comb_masks (GST_VIDEO_FORMAT_UYVY);
+  check_comb_masks (GST_VIDEO_FORMAT_Y42B);
+  check_comb_masks (GST_VIDEO_FORMAT_I420);
+  check_comb_masks (GST_VIDEO_FORMAT_YV12);
+}
+
+GST_END_TEST;
+
+static Suite *
+fieldanalysis_suite (void)
+{
+  Suite *s = suite_create ("fieldanalysis");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_comb_masks);
+
+  return s;
+}
+
+GST_CHECK_MAIN (fieldanalysis);
@@ -0,0 +1,340 @@
+/* GStreamer
+ *
+ * unit test for ivtc
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+/* The comb scores and reconstructed fields are computed by static functions
+ * of the element */
+#include "../../gst/ivtc/gstivtc.c"
+#include "gstivtcorc.c"
+
+#define TEST_HEIGHT 16
+
+enum
+{
+  CONTENT_NOISE,
+  CONTENT_RAMP,
+  CONTENT_BINARY,
+  CONTENT_COMBED,
+  N_CONTENTS
+};
+
+static const gint test_widths[] = { 1, 2, 3, 5, 6, 7, 8, 9, 15, 16, 17, 66,
+  320, 721
+};
+
+static GstBuffer *
+create_frame (GstVideoInfo * info, GRand * rand, gint content)
+{
+  GstBuffer *buf = gst_buffer_new_allocate (NULL, info->size, NULL);
+  GstVideoFrame frame;
+  gint k, x, y;
+
+  fail_unless (gst_video_frame_map (&frame, info, buf, GST_MAP_WRITE));
+  for (k = 0; k < 3; k++) {
+    for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (&frame, k); y++) {
+      guint8 *line = (guint8 *) GST_VIDEO_FRAME_COMP_DATA (&frame, k) +
+          y * GST_VIDEO_FRAME_COMP_STRIDE (&frame, k);
+
+      for (x = 0; x < GST_VIDEO_FRAME_COMP_WIDTH (&frame, k); x++) {
+        switch (content) {
+          case CONTENT_NOISE:
+            line[x] = g_rand_int_range (rand, 0, 256);
+            break;
+          case CONTENT_RAMP:
+            line[x] = x * (y % 5 + 3) + g_rand_int_range (rand, 0, 4);
+            break;
+          case CONTENT_BINARY:
+            line[x] = g_rand_boolean (rand) ? 255 : 0;
+            break;
+          case CONTENT_COMBED:
+          default:
+            line[x] = (y & 1) ? 200 : 10;
+            line[x] += g_rand_int_range (rand, 0, 3);
+            break;
+        }
+      }
+    }
+  }
+  gst_video_frame_unmap (&frame);
+
+  return buf;
+}
+
+static int
+scalar_reconstruct_line (const guint8 * line1, const guint8 * line2, int i,
+    int a, int b, int c, int d)
+{
+  int x;
+
+  x = line1[i - 3] * a;
+  x += line1[i - 2] * b;
+  x += line1[i - 1] * c;
+  x += line1[i - 0] * d;
+  x += line2[i + 0] * d;
+  x += line2[i + 1] * c;
+  x += line2[i + 2] * b;
+  x += line2[i + 3] * a;
+  return (x + 16) >> 5;
+}
+
+/* The per-sample reconstruction the Orc kernels replaced. Lines no wider
+ * than the margins are averaged. */
+static guint8
+scalar_reconstruct_sample (const guint8 * line1, const guint8 * line2,
+    int i, int width)
+{
+  int dx, dy;
+
+  if (i < MARGIN || i >= width - MARGIN)
+    return (line1[i] + line2[i] + 1) >> 1;
+
+  dx = -line1[i - 1] - line2[i - 1] + line1[i + 1] + line2[i + 1];
+  dx *= 2;
+
+  dy = -line1[i - 1] - 2 * line1[i] - line1[i + 1]
+      + line2[i - 1] + 2 * line2[i] + line2[i + 1];
+  if (dy < 0) {
+    dy = -dy;
+    dx = -dx;
+  }
+
+  if (dx == 0 && dy == 0) {
+    return (line1[i] + line2[i] + 1) >> 1;
+  } else if (dx < 0) {
+    if (dx < -2 * dy)
+      return scalar_reconstruct_line (line1, line2, i, 0, 0, 0, 16);
+    else if (dx < -dy)
+      return scalar_reconstruct_line (line1, line2, i, 0, 0, 8, 8);
+    else if (2 * dx < -dy)
+      return scalar_reconstruct_line (line1, line2, i, 0, 4, 8, 4);
+    else if (3 * dx < -dy)
+      return scalar_reconstruct_line (line1, line2, i, 1, 7, 7, 1);
+    else
+      return scalar_reconstruct_line (line1, line2, i, 4, 8, 4, 0);
+  } else {
+    if (dx > 2 * dy)
+      return scalar_reconstruct_line (line2, line1, i, 0, 0, 0, 16);
+    else if (dx > dy)
+      return scalar_reconstruct_line (line2, line1, i, 0, 0, 8, 8);
+    else if (2 * dx > dy)
+      return scalar_reconstruct_line (line2, line1, i, 0, 4, 8, 4);
+    else if (3 * dx > dy)
+      return scalar_reconstruct_line (line2, line1, i, 1, 7, 7, 1);
+    else
+      return scalar_reconstruct_line (line2, line1, i, 4, 8, 4, 0);
+  }
+}
+
+static void
+check_reconstruct_single (gint width, gint content, gint parity)
+{
+  GstIvtc *ivtc;
+  GstVideoInfo info;
+  GstVideoFrame dest_frame;
+  GstBuffer *buf, *dest_buf;
+  GRand *rand;
+  gint i, j, k;
+
+  gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420, width,
+      TEST_HEIGHT);
+  rand = g_rand_new_with_seed (width * N_CONTENTS + content);
+  buf = create_frame (&info, rand, content);
+  dest_buf = gst_buffer_new_allocate (NULL, info.size, NULL);
+
+  ivtc = g_object_new (GST_TYPE_IVTC, NULL);
+  ivtc->fields[0].parity = parity;
+  fail_unless (gst_video_frame_map (&ivtc->fields[0].frame, &info, buf,
+          GST_MAP_READ));
+  fail_unless (gst_video_frame_map (&dest_frame, &info, dest_buf,
+          GST_MAP_WRITE));
+
+  reconstruct_single (ivtc, &dest_frame, 0);
+
+  for (k = 0; k < 3; k++) {
+    GstVideoFrame *frame = &ivtc->fields[0].frame;
+    const gint height = GST_VIDEO_FRAME_COMP_HEIGHT (frame, k);
+    const gint comp_width = GST_VIDEO_FRAME_COMP_WIDTH (frame, k);
+
+    for (j = 0; j < height; j++) {
+      const guint8 *dest = GET_LINE (&dest_frame, k, j);
+
+      if ((j & 1) == parity) {
+        fail_unless (memcmp (dest, GET_LINE (frame, k, j), comp_width) == 0);
+      } else if (j == 0 || j == height - 1) {
+        fail_unless (memcmp (dest, GET_LINE (frame, k, j ^ 1),
+                comp_width) == 0);
+      } else {
+        const guint8 *line1 = GET_LINE (frame, k, j - 1);
+        const guint8 *line2 = GET_LINE (frame, k, j + 1);
+
+        for (i = 0; i < comp_width; i++) {
+          guint8 expected;
+
+          if (k == 0)
+            expected = scalar_reconstruct_sample (line1, line2, i, comp_width);
+          else
+            expected = (line1[i] + line2[i] + 1) >> 1;
+          fail_unless_equals_int (dest[i], expected);
+        }
+      }
+    }
+  }
+
+  gst_video_frame_unmap (&dest_frame);
+  gst_video_frame_unmap (&ivtc->fields[0].frame);
+  gst_object_unref (ivtc);
+  gst_buffer_unref (dest_buf);
+  gst_buffer_unref (buf);
+  g_rand_free (rand);
+}
+
+/* Test that the reconstruction of a single field matches the scalar code */
+GST_START_TEST (test_reconstruct_single)
+{
+  gint w, c;
+
+  for (w = 0; w < G_N_ELEMENTS (test_widths); w++) {
+    for (c = 0; c < N_CONTENTS; c++) {
+      check_reconstruct_single (test_widths[w], c, TOP_FIELD);
+      check_reconstruct_single (test_widths[w], c, BOTTOM_FIELD);
+    }
+  }
+}
+
+GST_END_TEST;
+
+/* The comb score the Orc kernels replaced */
+static int
+scalar_comb_score (GstVideoFrame * top, GstVideoFrame * bottom)
+{
+  int thisline[MAX_WIDTH];
+  int score = 0;
+  int height = GST_VIDEO_FRAME_COMP_HEIGHT (top, 0);
+  int width = GST_VIDEO_FRAME_COMP_WIDTH (top, 0);
+  int i, j;
+  int k = 0;
+
+  memset (thisline, 0, sizeof (thisline));
+
+  for (j = 2; j < height - 2; j++) {
+    guint8 *src1 = GET_LINE_IL (top, bottom, 0, j - 1);
+    guint8 *src2 = GET_LINE_IL (top, bottom, 0, j);
+    guint8 *src3 = GET_LINE_IL (top, bottom, 0, j + 1);
+
+    for (i = 0; i < width; i++) {
+      if (src2[i] < MIN (src1[i], src3[i]) - 5 ||
+          src2[i] > MAX (src1[i], src3[i]) + 5) {
+        if (i > 0) {
+          thisline[i] += thisline[i - 1];
+        }
+        thisline[i]++;
+        if (thisline[i] > 1000)
+          thisline[i] = 1000;
+      } else {
+        thisline[i] = 0;
+      }
+      if (thisline[i] > 100) {
+        score++;
+      }
+    }
+  }
+
+  return score;
+}
+
+static void
+check_comb_score (gint width, gint top_content, gint bottom_content)
+{
+  GstIvtcField top, bottom;
+  GstVideoInfo info;
+  GstBuffer *top_buf, *bottom_buf;
+  GRand *rand;
+  int expected, score;
+
+  gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420, width, 64);
+  rand = g_rand_new_with_seed (width * N_CONTENTS * N_CONTENTS +
+      top_content * N_CONTENTS + bottom_content);
+  top_buf = create_frame (&info, rand, top_content);
+  bottom_buf = create_frame (&info, rand, bottom_content);
+
+  memset (&top, 0, sizeof (top));
+  memset (&bottom, 0, sizeof (bottom));
+  top.parity = TOP_FIELD;
+  bottom.parity = BOTTOM_FIELD;
+  fail_unless (gst_video_frame_map (&top.frame, &info, top_buf,
+          GST_MAP_READ));
+  fail_unless (gst_video_frame_map (&bottom.frame, &info, bottom_buf,
+          GST_MAP_READ));
+
+  expected = scalar_comb_score (&top.frame, &bottom.frame);
+
+  score = get_comb_score (&top, &bottom, G_MAXINT);
+  fail_unless_equals_int (score, expected);
+
+  /* scores are exact below max_score, and at least max_score otherwise */
+  score = get_comb_score (&top, &bottom, 200);
+  if (expected < 200)
+    fail_unless_equals_int (score, expected);
+  else
+    fail_unless (score >= 200);
+
+  g_free (top.envelope[TOP_FIELD]);
+  g_free (bottom.envelope[BOTTOM_FIELD]);
+  gst_video_frame_unmap (&top.frame);
+  gst_video_frame_unmap (&bottom.frame);
+  gst_buffer_unref (top_buf);
+  gst_buffer_unref (bottom_buf);
+  g_rand_free (rand);
+}
+
+/* Test that the comb scores match the scalar code */
+GST_START_TEST (test_comb_score)
+{
+  gint w, t, b;
+
+  for (w = 0; w < G_N_ELEMENTS (test_widths); w++) {
+    for (t = 0; t < N_CONTENTS; t++) {
+      for (b = 0; b < N_CONTENTS; b++)
+        check_comb_score (test_widths[w], t, b);
+    }
+  }
+}
+
+GST_END_TEST;
+
+static Suite *
+ivtc_suite (void)
+{
+  Suite *s = suite_create ("ivtc");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_reconstruct_single);
+  tcase_add_test (tc_chain, test_comb_score);
+
+  return s;
+}
+
+GST_CHECK_MAIN (ivtc);
@@ -774,6 +774,35 @@ GST_START_TEST (test_align)
 
 GST_END_TEST;
 
+static void
+test_batching_check_output (GList * bufs)
+{
+  gsize max_size = 0;
+
+  GST_LOG ("%u buffers", g_list_length (bufs));
+  while (bufs != NULL) {
+    GstBuffer *buf = bufs->data;
+    gsize size;
+
+    size = gst_buffer_get_size (buf);
+    GST_LOG ("buffer, size = %5u", (guint) size);
+    fail_unless (size > 0);
+    fail_unless (size % 188 == 0);
+    max_size = MAX (max_size, size);
+    bufs = bufs->next;
+  }
+  /* packets must be batched into larger buffers */
+  fail_unless (max_size > 188);
+}
+
+GST_START_TEST (test_batching)
+{
+  check_tsmux_pad (&video_src_template, VIDEO_CAPS_STRING, 0xE0, 0x1b,
+      "sink_%d", test_batching_check_output, 50, -1, 0);
+}
+
+GST_END_TEST;
+
 static void
 test_keyframe_propagation_check_output (GList * bufs)
 {
@@ -803,6 +832,70 @@ GST_START_TEST (test_keyframe_flag_propagation)
 
 GST_END_TEST;
 
+GST_START_TEST (test_cbr)
+{
+  GstElement *mux;
+  GstCaps *caps;
+  gchar *padname;
+  GList *l;
+  guint64 total_bytes = 0;
+  guint null_packets = 0;
+  gint i;
+
+  mux = setup_tsmux (&video_src_template, "sink_%d", &padname);
+  g_object_set (mux, "bitrate", (guint64) 2000000, NULL);
+
+  fail_unless (gst_element_set_state (mux,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  caps = gst_caps_from_string (VIDEO_CAPS_STRING);
+  gst_check_setup_events (mysrcpad, mux, caps, GST_FORMAT_TIME);
+  gst_caps_unref (caps);
+
+  /* 25 frames of 1000 bytes in one second, far below 2 Mbit/s */
+  for (i = 0; i < 26; i++) {
+    GstBuffer *inbuffer = gst_buffer_new_and_alloc (1000);
+
+    gst_buffer_memset (inbuffer, 0, 0, 1000);
+    GST_BUFFER_PTS (inbuffer) = GST_BUFFER_DTS (inbuffer) =
+        i * 40 * GST_MSECOND;
+    if (i % KEYFRAME_DISTANCE != 0)
+      GST_BUFFER_FLAG_SET (inbuffer, GST_BUFFER_FLAG_DELTA_UNIT);
+    fail_unless (gst_pad_push (mysrcpad, inbuffer) == GST_FLOW_OK);
+  }
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+
+  for (l = buffers; l; l = l->next) {
+    GstMapInfo map;
+    gsize offset;
+
+    gst_buffer_map (GST_BUFFER (l->data), &map, GST_MAP_READ);
+    fail_unless (map.size % 188 == 0);
+    for (offset = 0; offset < map.size; offset += 188) {
+      fail_unless (map.data[offset] == 0x47);
+      if ((GST_READ_UINT16_BE (map.data + offset + 1) & 0x1FFF) == 0x1FFF)
+        null_packets++;
+    }
+    total_bytes += map.size;
+    gst_buffer_unmap (GST_BUFFER (l->data), &map);
+  }
+
+  GST_LOG ("%" G_GUINT64_FORMAT " bytes, %u null packets", total_bytes,
+      null_packets);
+
+  /* the frames span one second, so about 2 Mbit must have been output */
+  fail_unless (null_packets > 0);
+  fail_unless (total_bytes >= 2000000 / 8 * 9 / 10);
+  fail_unless (total_bytes <= 2000000 / 8 * 11 / 10);
+
+  gst_check_drop_buffers ();
+  cleanup_tsmux (mux, padname);
+  g_free (padname);
+}
+
+GST_END_TEST;
+
 static Suite *
 mpegtsmux_suite (void)
 {
@@ -819,6 +912,8 @@ mpegtsmux_suite (void)
   tcase_add_test (tc_chain, test_multiple_state_change);
   tcase_add_test (tc_chain, test_align);
   tcase_add_test (tc_chain, test_keyframe_flag_propagation);
+  tcase_add_test (tc_chain, test_batching);
+  tcase_add_test (tc_chain, test_cbr);
 
   return s;
 }
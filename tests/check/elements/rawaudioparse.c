@@ -26,6 +26,7 @@
 
 #include <gst/check/gstcheck.h>
 #include <gst/audio/audio.h>
+#include <string.h>
 
 /* Checks are hardcoded to expect stereo 16-bit data. The sample rate
  * however varies from the default of 40 kHz in some tests to see the
@@ -376,6 +377,135 @@ GST_START_TEST (test_change_caps)
 GST_END_TEST;
 
 
+static void
+check_surround_reordering (GstAudioFormat format, guint num_channels,
+    GstAudioChannelPosition const *positions)
+{
+  RawAudParseTestCtx testctx;
+  GValueArray *valarray;
+  GValue val = G_VALUE_INIT;
+  GstAudioChannelPosition sorted_positions[8];
+  guint width, bpf, num_frames = 64, i, c, num_out_frames = 0;
+  GstBuffer *inbuf;
+  GstMapInfo map_info;
+  GList *l;
+
+  /* Each sample is set to its channel position * 1000 plus its frame
+   * number. After reordering, the channels must be in the GStreamer
+   * order, which is the order of ascending channel position values. */
+
+  width = GST_AUDIO_FORMAT_INFO_WIDTH (gst_audio_format_get_info (format)) / 8;
+  bpf = width * num_channels;
+
+  setup_rawaudioparse (&testctx, FALSE, FALSE, NULL, GST_FORMAT_BYTES);
+
+  valarray = g_value_array_new (num_channels);
+  g_value_init (&val, GST_TYPE_AUDIO_CHANNEL_POSITION);
+  for (c = 0; c < num_channels; ++c) {
+    g_value_set_enum (&val, positions[c]);
+    g_value_array_insert (valarray, c, &val);
+  }
+  g_object_set (G_OBJECT (testctx.rawaudioparse), "sample-rate",
+      TEST_SAMPLE_RATE, "num-channels", num_channels, "pcm-format", format,
+      NULL);
+  g_object_set (G_OBJECT (testctx.rawaudioparse), "channel-positions",
+      valarray, NULL);
+  g_value_array_free (valarray);
+  g_value_unset (&val);
+
+  inbuf = gst_buffer_new_allocate (NULL, num_frames * bpf, NULL);
+  gst_buffer_map (inbuf, &map_info, GST_MAP_WRITE);
+  for (i = 0; i < num_frames; ++i) {
+    for (c = 0; c < num_channels; ++c) {
+      gint32 value = positions[c] * 1000 + i;
+      guint8 *sample = map_info.data + i * bpf + c * width;
+
+      if (width == 2) {
+        gint16 value16 = value;
+        memcpy (sample, &value16, 2);
+      } else {
+        memcpy (sample, &value, 4);
+      }
+    }
+  }
+  gst_buffer_unmap (inbuf, &map_info);
+
+  fail_unless (gst_pad_push (mysrcpad, inbuf) == GST_FLOW_OK);
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+
+  memcpy (sorted_positions, positions,
+      num_channels * sizeof (GstAudioChannelPosition));
+  for (i = 1; i < num_channels; ++i) {
+    for (c = i; c > 0 && sorted_positions[c - 1] > sorted_positions[c]; --c) {
+      GstAudioChannelPosition tmp = sorted_positions[c];
+      sorted_positions[c] = sorted_positions[c - 1];
+      sorted_positions[c - 1] = tmp;
+    }
+  }
+
+  for (l = buffers; l != NULL; l = l->next) {
+    GstBuffer *outbuf = GST_BUFFER (l->data);
+
+    gst_buffer_map (outbuf, &map_info, GST_MAP_READ);
+    fail_unless_equals_int (map_info.size % bpf, 0);
+
+    for (i = 0; i < map_info.size / bpf; ++i, ++num_out_frames) {
+      for (c = 0; c < num_channels; ++c) {
+        guint8 const *sample = map_info.data + i * bpf + c * width;
+        gint32 value;
+
+        if (width == 2) {
+          gint16 value16;
+          memcpy (&value16, sample, 2);
+          value = value16;
+        } else {
+          memcpy (&value, sample, 4);
+        }
+
+        fail_unless_equals_int (value,
+            sorted_positions[c] * 1000 + num_out_frames);
+      }
+    }
+
+    gst_buffer_unmap (outbuf, &map_info);
+  }
+
+  fail_unless_equals_int (num_out_frames, num_frames);
+
+  cleanup_rawaudioparse (&testctx);
+}
+
+GST_START_TEST (test_push_reordered_surround_channels)
+{
+  /* 5.1 and 7.1 in Vorbis channel order */
+  static const GstAudioChannelPosition positions_5_1[] = {
+    GST_AUDIO_CHANNEL_POSITION_FRONT_LEFT,
+    GST_AUDIO_CHANNEL_POSITION_FRONT_CENTER,
+    GST_AUDIO_CHANNEL_POSITION_FRONT_RIGHT,
+    GST_AUDIO_CHANNEL_POSITION_REAR_LEFT,
+    GST_AUDIO_CHANNEL_POSITION_REAR_RIGHT,
+    GST_AUDIO_CHANNEL_POSITION_LFE1
+  };
+  static const GstAudioChannelPosition positions_7_1[] = {
+    GST_AUDIO_CHANNEL_POSITION_FRONT_LEFT,
+    GST_AUDIO_CHANNEL_POSITION_FRONT_CENTER,
+    GST_AUDIO_CHANNEL_POSITION_FRONT_RIGHT,
+    GST_AUDIO_CHANNEL_POSITION_SIDE_LEFT,
+    GST_AUDIO_CHANNEL_POSITION_SIDE_RIGHT,
+    GST_AUDIO_CHANNEL_POSITION_REAR_LEFT,
+    GST_AUDIO_CHANNEL_POSITION_REAR_RIGHT,
+    GST_AUDIO_CHANNEL_POSITION_LFE1
+  };
+
+  check_surround_reordering (GST_AUDIO_FORMAT_S16, 6, positions_5_1);
+  check_surround_reordering (GST_AUDIO_FORMAT_S32, 6, positions_5_1);
+  check_surround_reordering (GST_AUDIO_FORMAT_S16, 8, positions_7_1);
+  check_surround_reordering (GST_AUDIO_FORMAT_S32, 8, positions_7_1);
+}
+
+GST_END_TEST;
+
+
 static Suite *
 rawaudioparse_suite (void)
 {
@@ -388,6 +518,7 @@ rawaudioparse_suite (void)
   tcase_add_test (tc_chain, test_push_swapped_channels);
   tcase_add_test (tc_chain, test_config_switch);
   tcase_add_test (tc_chain, test_change_caps);
+  tcase_add_test (tc_chain, test_push_reordered_surround_channels);
 
   return s;
 }
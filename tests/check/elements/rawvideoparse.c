@@ -25,7 +25,11 @@
 #define GLIB_DISABLE_DEPRECATION_WARNINGS
 
 #include <gst/check/gstcheck.h>
+#include <gst/base/gstbaseparse.h>
 #include <gst/video/video.h>
+#include <glib/gstdio.h>
+#include <string.h>
+#include <unistd.h>
 
 /* The checks use as test data an 8x8 Y444 image, with 25 Hz framerate. In the
  * sink caps configuration, the stride is 8 bytes, and the frames are tightly
@@ -639,6 +643,225 @@ GST_START_TEST (test_incomplete_last_buffer)
 
 GST_END_TEST;
 
+/* Check that the data of outbuf starts offset bytes into the memory of
+ * inbuf, meaning that the output shares the input memory */
+static void
+check_output_shares_input (GstBuffer * outbuf, GstBuffer * inbuf,
+    gsize offset)
+{
+  GstMapInfo in_map, out_map;
+
+  fail_unless (gst_buffer_map (inbuf, &in_map, GST_MAP_READ));
+  fail_unless (gst_buffer_map (outbuf, &out_map, GST_MAP_READ));
+  fail_unless (out_map.data == in_map.data + offset);
+  gst_buffer_unmap (outbuf, &out_map);
+  gst_buffer_unmap (inbuf, &in_map);
+}
+
+GST_START_TEST (test_zero_copy)
+{
+  GstBuffer *inbuf1, *inbuf2, *outbuf;
+  GstVideoMeta *videometa;
+
+  /* With zero-copy enabled, the output buffers must not be copied out of the
+   * input data. Like in the default mode, the extra padding bytes at the end
+   * of each frame (defined by the frame stride) are cut off by a subbuffer
+   * sharing the input memory, so the output buffers have the frame size
+   * (280 bytes). Y444 needs no special alignment, so the input data is never
+   * reallocated.
+   *
+   * The first frame lies in the first input buffer, and the third frame in
+   * the second one (at offset 2 * 500 - 511 = 489), so their output buffers
+   * must point into the input memory. The second frame straddles both input
+   * buffers and can only be output by merging them. References to the input
+   * buffers are kept so that their memory stays valid. */
+
+  setup_rawvideoparse (FALSE, TRUE, NULL, GST_FORMAT_BYTES);
+  g_object_set (G_OBJECT (rawvideoparse), "zero-copy", TRUE, NULL);
+
+  inbuf1 = gst_adapter_take_buffer (properties_ctx.data, 511);
+  fail_unless (gst_pad_push (mysrcpad, gst_buffer_ref (inbuf1)) ==
+      GST_FLOW_OK);
+  fail_unless_equals_int (g_list_length (buffers), 1);
+
+  inbuf2 = gst_adapter_take_buffer (properties_ctx.data, 1940);
+  fail_unless (gst_pad_push (mysrcpad, gst_buffer_ref (inbuf2)) ==
+      GST_FLOW_OK);
+  fail_unless_equals_int (g_list_length (buffers), 4);
+
+  outbuf = g_list_nth_data (buffers, 0);
+  fail_unless_equals_uint64 (gst_buffer_get_size (outbuf), 280);
+  fail_unless_equals_uint64 (GST_BUFFER_PTS (outbuf), GST_MSECOND * 0);
+  check_test_pattern (&properties_ctx, outbuf, 0, 0);
+  check_output_shares_input (outbuf, inbuf1, 0);
+
+  outbuf = g_list_nth_data (buffers, 2);
+  fail_unless_equals_uint64 (gst_buffer_get_size (outbuf), 280);
+  fail_unless_equals_uint64 (GST_BUFFER_PTS (outbuf), GST_MSECOND * 80);
+  check_test_pattern (&properties_ctx, outbuf, 2, 0);
+  check_output_shares_input (outbuf, inbuf2, 2 * PROP_CTX_FRAME_STRIDE - 511);
+
+  videometa = gst_buffer_get_video_meta (outbuf);
+  fail_unless (videometa != NULL);
+  fail_unless_equals_int (videometa->width, TEST_WIDTH);
+  fail_unless_equals_int (videometa->height, TEST_HEIGHT);
+  fail_unless_equals_int (videometa->stride[0], PROP_CTX_PLANE_STRIDE);
+  fail_unless_equals_uint64 (videometa->offset[1], PROP_CTX_PLANE_SIZE);
+
+  gst_buffer_unref (inbuf1);
+  gst_buffer_unref (inbuf2);
+  cleanup_rawvideoparse ();
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_frames_per_buffer)
+{
+  GstBuffer *outbuf;
+  GstVideoMeta *videometa;
+  guint i;
+
+  /* Put 3 frames into each output buffer. The frame stride padding is kept
+   * between the frames, so the buffers contain 3 full frame strides. Each
+   * frame gets its own videometa. The parser must wait until enough data
+   * for all 3 frames is available. */
+
+  setup_rawvideoparse (FALSE, TRUE, NULL, GST_FORMAT_BYTES);
+  g_object_set (G_OBJECT (rawvideoparse), "frames-per-buffer", 3, NULL);
+
+  /* Not enough data for 3 frames -> no output */
+  outbuf = gst_adapter_take_buffer (properties_ctx.data,
+      PROP_CTX_FRAME_STRIDE * 2);
+  fail_unless (gst_pad_push (mysrcpad, outbuf) == GST_FLOW_OK);
+  fail_unless_equals_int (g_list_length (buffers), 0);
+
+  outbuf = gst_adapter_take_buffer (properties_ctx.data,
+      PROP_CTX_FRAME_STRIDE);
+  fail_unless (gst_pad_push (mysrcpad, outbuf) == GST_FLOW_OK);
+  fail_unless_equals_int (g_list_length (buffers), 1);
+
+  outbuf = g_list_nth_data (buffers, 0);
+  fail_unless_equals_uint64 (gst_buffer_get_size (outbuf),
+      PROP_CTX_FRAME_STRIDE * 3);
+  fail_unless_equals_uint64 (GST_BUFFER_PTS (outbuf), 0);
+  fail_unless_equals_uint64 (GST_BUFFER_DURATION (outbuf), GST_MSECOND * 120);
+
+  for (i = 0; i < 3; ++i) {
+    GstMapInfo map_info;
+    GstBuffer *framebuf;
+
+    videometa = gst_buffer_get_video_meta_id (outbuf, i);
+    fail_unless (videometa != NULL);
+    fail_unless_equals_uint64 (videometa->offset[0],
+        PROP_CTX_FRAME_STRIDE * i);
+    fail_unless_equals_uint64 (videometa->offset[2],
+        PROP_CTX_FRAME_STRIDE * i + PROP_CTX_PLANE_SIZE * 2);
+
+    gst_buffer_map (outbuf, &map_info, GST_MAP_READ);
+    framebuf = gst_buffer_new_allocate (NULL, PROP_CTX_FRAME_STRIDE, NULL);
+    gst_buffer_fill (framebuf, 0, map_info.data + PROP_CTX_FRAME_STRIDE * i,
+        PROP_CTX_FRAME_STRIDE);
+    gst_buffer_unmap (outbuf, &map_info);
+    check_test_pattern (&properties_ctx, framebuf, i, 0);
+    gst_buffer_unref (framebuf);
+  }
+
+  cleanup_rawvideoparse ();
+}
+
+GST_END_TEST;
+
+#define MMAP_TEST_NUM_FRAMES 5
+#define MMAP_TEST_FRAME_SIZE (TEST_WIDTH * TEST_HEIGHT)
+
+static void
+mmap_handoff_cb (GstElement * sink, GstBuffer * buffer, GstPad * pad,
+    guint * num_frames)
+{
+  GstMapInfo map_info;
+  guint i;
+
+  /* Output buffers must come straight from the read-only mapping */
+  fail_unless_equals_int (gst_buffer_n_memory (buffer), 1);
+  fail_unless (GST_MEMORY_FLAG_IS_SET (gst_buffer_peek_memory (buffer, 0),
+          GST_MEMORY_FLAG_READONLY));
+
+  gst_buffer_map (buffer, &map_info, GST_MAP_READ);
+  fail_unless_equals_int (map_info.size, MMAP_TEST_FRAME_SIZE);
+  for (i = 0; i < map_info.size; ++i)
+    fail_unless_equals_int (map_info.data[i], *num_frames + 1);
+  gst_buffer_unmap (buffer, &map_info);
+
+  fail_unless_equals_uint64 (GST_BUFFER_PTS (buffer),
+      gst_util_uint64_scale (*num_frames, GST_SECOND * TEST_FRAMERATE_D,
+          TEST_FRAMERATE_N));
+
+  (*num_frames)++;
+}
+
+GST_START_TEST (test_use_mmap)
+{
+  GstElement *pipeline, *src, *parse, *sink;
+  GstMessage *msg;
+  GError *error = NULL;
+  gchar *filename;
+  guint8 *data;
+  guint num_frames = 0;
+  gint fd, i;
+
+  /* Write a few GRAY8 frames into a file, each frame filled with its
+   * number, and parse them with filesrc operating in pull mode */
+  fd = g_file_open_tmp ("rawvideoparse-XXXXXX", &filename, &error);
+  fail_unless (fd >= 0, "could not create temp file: %s",
+      error ? error->message : "");
+  close (fd);
+
+  data = g_malloc (MMAP_TEST_NUM_FRAMES * MMAP_TEST_FRAME_SIZE);
+  for (i = 0; i < MMAP_TEST_NUM_FRAMES; ++i)
+    memset (data + i * MMAP_TEST_FRAME_SIZE, i + 1, MMAP_TEST_FRAME_SIZE);
+  fail_unless (g_file_set_contents (filename, (gchar *) data,
+          MMAP_TEST_NUM_FRAMES * MMAP_TEST_FRAME_SIZE, NULL));
+  g_free (data);
+
+  pipeline = gst_pipeline_new (NULL);
+  src = gst_check_setup_element ("filesrc");
+  parse = gst_check_setup_element ("rawvideoparse");
+  sink = gst_check_setup_element ("fakesink");
+
+  g_object_set (G_OBJECT (src), "location", filename, NULL);
+  g_object_set (G_OBJECT (parse), "use-mmap", TRUE,
+      "format", GST_VIDEO_FORMAT_GRAY8, "width", TEST_WIDTH,
+      "height", TEST_HEIGHT, "framerate", TEST_FRAMERATE_N, TEST_FRAMERATE_D,
+      NULL);
+  g_object_set (G_OBJECT (sink), "signal-handoffs", TRUE, "sync", FALSE,
+      NULL);
+  g_signal_connect (sink, "handoff", G_CALLBACK (mmap_handoff_cb),
+      &num_frames);
+
+  gst_bin_add_many (GST_BIN (pipeline), src, parse, sink, NULL);
+  fail_unless (gst_element_link_many (src, parse, sink, NULL));
+
+  fail_unless (gst_element_set_state (pipeline,
+          GST_STATE_PLAYING) != GST_STATE_CHANGE_FAILURE);
+  fail_unless (GST_PAD_MODE (GST_BASE_PARSE_SINK_PAD (parse)) ==
+      GST_PAD_MODE_PULL);
+
+  msg = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipeline),
+      GST_CLOCK_TIME_NONE, GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+
+  fail_unless_equals_int (num_frames, MMAP_TEST_NUM_FRAMES);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  g_unlink (filename);
+  g_free (filename);
+}
+
+GST_END_TEST;
+
 static Suite *
 rawvideoparse_suite (void)
 {
@@ -653,6 +876,9 @@ rawvideoparse_suite (void)
   tcase_add_test (tc_chain, test_computed_plane_strides);
   tcase_add_test (tc_chain, test_change_caps);
   tcase_add_test (tc_chain, test_incomplete_last_buffer);
+  tcase_add_test (tc_chain, test_zero_copy);
+  tcase_add_test (tc_chain, test_frames_per_buffer);
+  tcase_add_test (tc_chain, test_use_mmap);
 
   return s;
 }
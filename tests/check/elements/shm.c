@@ -41,8 +41,11 @@ static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
 GstElement *src, *sink;
 GstPad *sinkpad, *srcpad;
 
+/* Size of the area small enough for the allocations to wrap around */
+#define SMALL_SHM_SIZE (16 * 1024)
+
 static void
-setup_shm (void)
+setup_shm_full (guint shm_size)
 {
   gchar *socket_path = NULL;
 
@@ -53,6 +56,8 @@ setup_shm (void)
   sinkpad = gst_check_setup_sink_pad (src, &sink_template);
 
   g_object_set (sink, "socket-path", "shm-unit-test", NULL);
+  if (shm_size)
+    g_object_set (sink, "shm-size", shm_size, NULL);
 
   fail_unless (gst_element_set_state (sink, GST_STATE_PLAYING) ==
       GST_STATE_CHANGE_ASYNC);
@@ -69,6 +74,18 @@ setup_shm (void)
       GST_STATE_CHANGE_SUCCESS);
 }
 
+static void
+setup_shm (void)
+{
+  setup_shm_full (0);
+}
+
+static void
+setup_shm_small (void)
+{
+  setup_shm_full (SMALL_SHM_SIZE);
+}
+
 static void
 teardown_shm (void)
 {
@@ -169,6 +186,106 @@ GST_START_TEST (test_shm_alloc)
 
 GST_END_TEST;
 
+static GstBuffer *
+create_filled_buffer (gsize size, guint8 value)
+{
+  GstBuffer *buf = gst_buffer_new_allocate (NULL, size, NULL);
+
+  gst_buffer_memset (buf, 0, value, size);
+
+  return buf;
+}
+
+static void
+check_filled_buffer (GstBuffer * buf, gsize size, guint8 value)
+{
+  GstMapInfo map;
+  gsize i;
+
+  fail_unless_equals_int (gst_buffer_get_size (buf), size);
+  fail_unless (gst_buffer_map (buf, &map, GST_MAP_READ));
+  for (i = 0; i < map.size; i++)
+    fail_unless_equals_int (map.data[i], value);
+  gst_buffer_unmap (buf, &map);
+}
+
+static void
+wait_for_n_buffers (guint n)
+{
+  g_mutex_lock (&check_mutex);
+  while (g_list_length (buffers) < n)
+    g_cond_wait (&check_cond, &check_mutex);
+  g_mutex_unlock (&check_mutex);
+}
+
+GST_START_TEST (test_shm_render_list)
+{
+  GstBufferList *list;
+  GstSegment segment;
+  GList *l;
+  guint i;
+
+  gst_pad_push_event (srcpad, gst_event_new_stream_start ("test"));
+  gst_segment_init (&segment, GST_FORMAT_BYTES);
+  gst_pad_push_event (srcpad, gst_event_new_segment (&segment));
+
+  /* The notifications of the whole list are sent at once, every buffer must
+   * still arrive in order */
+  list = gst_buffer_list_new ();
+  for (i = 0; i < 10; i++)
+    gst_buffer_list_add (list, create_filled_buffer (1000, i));
+
+  fail_unless (gst_pad_push_list (srcpad, list) == GST_FLOW_OK);
+
+  wait_for_n_buffers (10);
+  fail_unless_equals_int (g_list_length (buffers), 10);
+
+  for (l = buffers, i = 0; l; l = l->next, i++)
+    check_filled_buffer (l->data, 1000, i);
+
+  gst_check_drop_buffers ();
+  teardown_shm ();
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_shm_alloc_wrap_around)
+{
+  GstSegment segment;
+  GList *l;
+  guint i, first;
+
+  gst_pad_push_event (srcpad, gst_event_new_stream_start ("test"));
+  gst_segment_init (&segment, GST_FORMAT_BYTES);
+  gst_pad_push_event (srcpad, gst_event_new_segment (&segment));
+
+  /* Only three buffers fit in the area. Keep the last two received alive so
+   * that new blocks wrap around to the start of the area while blocks in the
+   * middle are still used, and check that none of them gets overwritten */
+  for (i = 0; i < 20; i++) {
+    fail_unless (gst_pad_push (srcpad,
+            create_filled_buffer (SMALL_SHM_SIZE / 3 - 256, i)) == GST_FLOW_OK);
+
+    wait_for_n_buffers (MIN (i + 1, 3));
+
+    g_mutex_lock (&check_mutex);
+    first = i + 1 - g_list_length (buffers);
+    for (l = buffers; l; l = l->next)
+      check_filled_buffer (l->data, SMALL_SHM_SIZE / 3 - 256, first++);
+
+    if (g_list_length (buffers) == 3) {
+      gst_buffer_unref (buffers->data);
+      buffers = g_list_delete_link (buffers, buffers);
+    }
+    g_mutex_unlock (&check_mutex);
+  }
+
+  gst_check_drop_buffers ();
+  teardown_shm ();
+}
+
+GST_END_TEST;
+
 static Suite *
 shm_suite (void)
 {
@@ -179,6 +296,12 @@ shm_suite (void)
   tcase_add_checked_fixture (tc, setup_shm, NULL);
   tcase_add_test (tc, test_shm_sysmem_alloc);
   tcase_add_test (tc, test_shm_alloc);
+  tcase_add_test (tc, test_shm_render_list);
+  suite_add_tcase (s, tc);
+
+  tc = tcase_create ("shm-small");
+  tcase_add_checked_fixture (tc, setup_shm_small, NULL);
+  tcase_add_test (tc, test_shm_alloc_wrap_around);
   suite_add_tcase (s, tc);
 
   return s;
@@ -560,6 +560,53 @@ GST_START_TEST (test_mpegts_dvb_descriptors)
 
 GST_END_TEST;
 
+static guint32
+reference_crc32 (const guint8 * data, gsize len)
+{
+  guint32 crc = 0xffffffff;
+  gint i;
+
+  while (len--) {
+    crc ^= (guint32) * data++ << 24;
+    for (i = 0; i < 8; i++)
+      crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04c11db7 : crc << 1;
+  }
+
+  return crc;
+}
+
+GST_START_TEST (test_mpegts_crc32)
+{
+  guint8 *data;
+  gsize len, offset;
+  guint i;
+
+  /* Check value of CRC-32/MPEG-2 */
+  fail_unless_equals_int (gst_mpegts_crc32 ((const guint8 *) "123456789", 9),
+      0x0376e6e7);
+
+  /* An intact section including its CRC gives 0 */
+  fail_unless_equals_int (gst_mpegts_crc32 (pat_data_check,
+          sizeof (pat_data_check)), 0);
+
+  /* All lengths and alignments the optimized versions handle differently */
+  data = g_malloc (4096 + 16);
+  for (i = 0; i < 4096 + 16; i++)
+    data[i] = g_random_int_range (0, 256);
+
+  for (offset = 0; offset < 16; offset++) {
+    for (len = 0; len <= 300; len++)
+      fail_unless_equals_int (gst_mpegts_crc32 (data + offset, len),
+          reference_crc32 (data + offset, len));
+    fail_unless_equals_int (gst_mpegts_crc32 (data + offset, 4096),
+        reference_crc32 (data + offset, 4096));
+  }
+
+  g_free (data);
+}
+
+GST_END_TEST;
+
 static Suite *
 mpegts_suite (void)
 {
@@ -577,6 +624,7 @@ mpegts_suite (void)
   tcase_add_test (tc_chain, test_mpegts_atsc_stt);
   tcase_add_test (tc_chain, test_mpegts_descriptors);
   tcase_add_test (tc_chain, test_mpegts_dvb_descriptors);
+  tcase_add_test (tc_chain, test_mpegts_crc32);
 
   return s;
 }
@@ -0,0 +1,119 @@
+/* GStreamer
+ *
+ * unit test for GstStripeRunner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+#include <gst/base/gststriperunner.h>
+#include <string.h>
+
+#define MAX_ROWS 1000
+
+typedef struct
+{
+  gint rows[MAX_ROWS];
+  guint stripe_starts[MAX_ROWS];
+  guint stripe_ends[MAX_ROWS];
+} StripeTestData;
+
+static void
+mark_rows (guint stripe, guint start, guint end, StripeTestData * data)
+{
+  guint i;
+
+  for (i = start; i < end; i++)
+    g_atomic_int_inc (&data->rows[i]);
+
+  data->stripe_starts[stripe] = start;
+  data->stripe_ends[stripe] = end;
+}
+
+GST_START_TEST (test_all_rows_once)
+{
+  GstStripeRunner *runner;
+  StripeTestData data;
+  guint n_threads, n_rows, align, n_stripes, i;
+
+  /* Every row must be processed exactly once, the stripes must be
+   * consecutive, and there must not be more stripes than threads */
+  runner = gst_stripe_runner_new ();
+
+  for (n_threads = 0; n_threads <= 8; n_threads++) {
+    for (n_rows = 0; n_rows <= MAX_ROWS; n_rows += 37) {
+      for (align = 1; align <= 16; align *= 4) {
+        memset (&data, 0, sizeof (data));
+
+        n_stripes = gst_stripe_runner_run (runner, n_threads, n_rows,
+            4 * align, align, (GstStripeRunnerFunc) mark_rows, &data);
+
+        fail_unless_equals_int (n_stripes,
+            gst_stripe_runner_get_n_stripes (n_threads, n_rows, 4 * align,
+                align));
+        if (n_threads > 0)
+          fail_unless (n_stripes <= n_threads);
+
+        for (i = 0; i < n_rows; i++)
+          fail_unless_equals_int (data.rows[i], 1);
+
+        for (i = 0; i < n_stripes; i++) {
+          fail_unless_equals_int (data.stripe_starts[i],
+              i > 0 ? data.stripe_ends[i - 1] : 0);
+          if (i + 1 < n_stripes)
+            fail_unless_equals_int (data.stripe_starts[i] % align, 0);
+        }
+        if (n_stripes > 0)
+          fail_unless_equals_int (data.stripe_ends[n_stripes - 1], n_rows);
+      }
+    }
+  }
+
+  gst_stripe_runner_free (runner);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_min_rows)
+{
+  /* Stripes are never smaller than the minimum, except for the last one */
+  fail_unless_equals_int (gst_stripe_runner_get_n_stripes (8, 100, 64, 1), 2);
+  fail_unless_equals_int (gst_stripe_runner_get_n_stripes (8, 64, 64, 1), 1);
+  fail_unless_equals_int (gst_stripe_runner_get_n_stripes (4, 1000, 1, 1), 4);
+  fail_unless_equals_int (gst_stripe_runner_get_n_stripes (1, 1000, 1, 1), 1);
+  fail_unless_equals_int (gst_stripe_runner_get_n_stripes (4, 0, 1, 1), 0);
+}
+
+GST_END_TEST;
+
+static Suite *
+gst_stripe_runner_suite (void)
+{
+  Suite *s = suite_create ("GstStripeRunner");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_all_rows_once);
+  tcase_add_test (tc_chain, test_min_rows);
+
+  return s;
+}
+
+GST_CHECK_MAIN (gst_stripe_runner);
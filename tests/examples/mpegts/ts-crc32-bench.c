@@ -0,0 +1,112 @@
+/* GStreamer
+ *
+ * ts-crc32-bench.c: micro-benchmark for the MPEG-TS section CRC32
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+#include <gst/mpegts/mpegts.h>
+
+/* Section sizes: a short PSI section, the PSI maximum and the private
+ * section (e.g. EIT schedule) maximum */
+static const gsize sizes[] = { 188, 1024, 4096 };
+
+#define TOTAL_BYTES (256 * 1024 * 1024)
+
+/* Bit-at-a-time reference to compare against */
+static guint32
+bytewise_crc32 (const guint8 * data, gsize len)
+{
+  guint32 crc = 0xffffffff;
+  gint i;
+
+  while (len--) {
+    crc ^= (guint32) * data++ << 24;
+    for (i = 0; i < 8; i++)
+      crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04c11db7 : crc << 1;
+  }
+
+  return crc;
+}
+
+static gdouble
+run (guint32 (*func) (const guint8 *, gsize), const guint8 * data,
+    gsize size, guint iterations, guint32 * result)
+{
+  GTimer *timer = g_timer_new ();
+  guint32 crc = 0;
+  gdouble elapsed;
+  guint i;
+
+  for (i = 0; i < iterations; i++)
+    crc ^= func (data, size);
+  elapsed = g_timer_elapsed (timer, NULL);
+  g_timer_destroy (timer);
+
+  *result = crc;
+  return elapsed;
+}
+
+static guint32
+library_crc32 (const guint8 * data, gsize len)
+{
+  return gst_mpegts_crc32 (data, len);
+}
+
+int
+main (int argc, gchar ** argv)
+{
+  guint8 *data;
+  guint i;
+
+  gst_init (&argc, &argv);
+  gst_mpegts_initialize ();
+
+  data = g_malloc (4096);
+  for (i = 0; i < 4096; i++)
+    data[i] = g_random_int_range (0, 256);
+
+  for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+    guint iterations = TOTAL_BYTES / sizes[i];
+    guint32 expected, result;
+    gdouble t_ref, t_lib;
+
+    /* The reference is much slower, run it on a fraction of the data */
+    t_ref = run (bytewise_crc32, data, sizes[i], iterations / 16, &expected)
+        * 16;
+    t_lib = run (library_crc32, data, sizes[i], iterations / 16, &result);
+    if (result != expected) {
+      g_printerr ("CRC mismatch for %" G_GSIZE_FORMAT " bytes: 0x%08x != "
+          "0x%08x\n", sizes[i], result, expected);
+      return 1;
+    }
+    t_lib = run (library_crc32, data, sizes[i], iterations, &result);
+
+    g_print ("%4" G_GSIZE_FORMAT " byte sections: bitwise %8.1f MB/s, "
+        "gst_mpegts_crc32 %8.1f MB/s, %.0f sections/s\n", sizes[i],
+        TOTAL_BYTES / t_ref / 1e6, TOTAL_BYTES / t_lib / 1e6,
+        iterations / t_lib);
+  }
+
+  g_free (data);
+
+  return 0;
+}